@@ -154,6 +154,15 @@ public:
     lldb::SBThread
     GetSelectedThread () const;
 
+    %feature("autodoc", "
+    Unwinds up to num_frames frames of every thread of the process in parallel
+    and caches them in the threads, so that walking their frames afterwards
+    doesn't unwind again. Pass UINT32_MAX to unwind the whole stacks. This is
+    much faster than walking the threads one by one when there are many of
+    them, e.g. in core files.") ComputeStackFrames;
+    lldb::SBError
+    ComputeStackFrames (uint32_t num_frames);
+
     %feature("autodoc", "
     Lazily create a thread on demand through the current OperatingSystem plug-in, if the current OperatingSystem plug-in supports it.") CreateOSPluginThread;
     lldb::SBThread
@@ -519,6 +519,17 @@ public:
     ResolveSymbolContextForAddress (const SBAddress& addr,
                                     uint32_t resolve_scope);
 
+    %feature("docstring", "
+    Get the function names of the addresses of a backtrace, e.g. one returned
+    by SBThread.GetFramePointerBacktrace. The first address is taken as a pc
+    and the others as return addresses. The function ranges found are cached
+    by their modules, so symbolizing many backtraces is cheap.
+
+    @return
+        A 'module`function' string for each address.") SymbolizeBacktrace;
+    lldb::SBStringList
+    SymbolizeBacktrace (lldb::SBData pcs);
+
      %feature("docstring", "
     Read target memory. If a target process is running then memory
     is read from here. Otherwise the memory is read from the object
@@ -327,6 +327,16 @@ public:
     lldb::SBFrame
     GetFrameAtIndex (uint32_t idx);
 
+    %feature("autodoc", "
+    Get the pcs of the frames of this thread by following its chain of saved
+    frame pointers, which is much faster than iterating over its frames. The
+    pc of frame zero is followed by the return addresses of the frames above
+    it, as 64 bit integers in an SBData:
+    thread.GetFramePointerBacktrace(128, error).uint64s. See
+    SBTarget.SymbolizeBacktrace to get their function names.") GetFramePointerBacktrace;
+    lldb::SBData
+    GetFramePointerBacktrace (uint32_t max_frames, lldb::SBError &error);
+
     lldb::SBFrame
     GetSelectedFrame ();
 
@@ -245,6 +245,27 @@ public:
                      lldb::DynamicValueType use_dynamic,
                      bool can_create_synthetic);
 
+    %feature("docstring", "
+    Get the child values at the indexes [start, start + count).
+
+    This is the same as calling GetChildAtIndex() for each index, but a
+    value with synthetic children, like a std::map or a std::list, can
+    create the whole range in one walk of its data structure. This makes
+    it the preferred way to show the children of large containers a page
+    at a time.
+
+    @param[in] start
+        The index of the first child value to get.
+
+    @param[in] count
+        The maximum number of child values to get.
+
+    @return
+        The child values, which stop after the last child or before the
+        first child that can't be created.") GetChildrenInRange;
+    lldb::SBValueList
+    GetChildrenInRange (uint32_t start, uint32_t count);
+
     lldb::SBValue
     CreateChildAtOffset (const char *name, uint32_t offset, lldb::SBType type);
 
@@ -96,6 +96,21 @@ public:
 
   lldb::SBThread GetSelectedThread() const;
 
+  /// Unwind the stacks of all the threads of the process in parallel.
+  ///
+  /// The frames are cached in the threads, so getting them afterwards with
+  /// SBThread::GetFrameAtIndex() doesn't unwind again. This is much faster
+  /// than walking the threads one by one for processes with many threads,
+  /// e.g. when loading a core file.
+  ///
+  /// \param[in] num_frames
+  ///     How many frames to unwind at most for each thread, UINT32_MAX for
+  ///     the whole stacks.
+  ///
+  /// \return
+  ///     An error if the process is running.
+  lldb::SBError ComputeStackFrames(uint32_t num_frames);
+
   // Function for lazily creating a thread using the current OS plug-in. This
   // function will be removed in the future when there are APIs to create
   // SBThread objects through the interface and add them to the process through
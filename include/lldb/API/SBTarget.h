@@ -518,6 +518,20 @@ public:
   SBSymbolContext ResolveSymbolContextForAddress(const SBAddress &addr,
                                                  uint32_t resolve_scope);
 
+  /// Get the function names of the addresses of a backtrace.
+  ///
+  /// The function ranges found are cached by their modules, so symbolizing
+  /// many backtraces going through the same functions is cheap.
+  ///
+  /// \param[in] pcs
+  ///     The pc of frame zero followed by the return addresses of the frames
+  ///     above it, as returned by SBThread::GetFramePointerBacktrace.
+  ///
+  /// \return
+  ///     A "module`function" string for each address, in the same order.
+  ///     Addresses outside any function are printed in hexadecimal.
+  lldb::SBStringList SymbolizeBacktrace(lldb::SBData pcs);
+
   /// Read target memory. If a target process is running then memory
   /// is read from here. Otherwise the memory is read from the object
   /// files. For a target whose bytes are sized as a multiple of host
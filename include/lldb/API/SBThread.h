@@ -171,6 +171,27 @@ public:
 
   lldb::SBFrame GetFrameAtIndex(uint32_t idx);
 
+  /// Get the pcs of the frames of this thread by following its chain of saved
+  /// frame pointers.
+  ///
+  /// This doesn't create any frame and doesn't use the unwind information of
+  /// the functions, so it is much faster than iterating over the frames, but
+  /// the callers of functions built without frame pointers are skipped.
+  ///
+  /// \param[in] max_frames
+  ///     The maximum number of pcs to return.
+  ///
+  /// \param[out] error
+  ///     The reason the backtrace couldn't be collected, e.g. the process is
+  ///     running or the architecture is not supported.
+  ///
+  /// \return
+  ///     The pc of frame zero followed by the return addresses of the frames
+  ///     above it, as an array of 64 bit integers in host byte order. See
+  ///     SBTarget::SymbolizeBacktrace to get their function names.
+  lldb::SBData GetFramePointerBacktrace(uint32_t max_frames,
+                                        lldb::SBError &error);
+
   lldb::SBFrame GetSelectedFrame();
 
   lldb::SBFrame SetSelectedFrame(uint32_t frame_idx);
@@ -191,6 +191,25 @@ public:
                                 lldb::DynamicValueType use_dynamic,
                                 bool can_create_synthetic);
 
+  /// Get the child values at the indexes [start, start + count).
+  ///
+  /// This is the same as calling GetChildAtIndex() for each index, but a
+  /// value with synthetic children, like a std::map or a std::list, can
+  /// create the whole range in one walk of its data structure. This makes
+  /// it the preferred way to show the children of large containers a page
+  /// at a time.
+  ///
+  /// \param[in] start
+  ///     The index of the first child value to get.
+  ///
+  /// \param[in] count
+  ///     The maximum number of child values to get.
+  ///
+  /// \return
+  ///     The child values, which stop after the last child or before the
+  ///     first child that can't be created.
+  lldb::SBValueList GetChildrenInRange(uint32_t start, uint32_t count);
+
   // Matches children of this object only and will match base classes and
   // member names if this is a clang typed object.
   uint32_t GetIndexOfChildWithName(const char *name);
@@ -11,8 +11,10 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "lldb/Breakpoint/BreakpointOptions.h"
+#include "lldb/Breakpoint/SimpleCondition.h"
 #include "lldb/Breakpoint/StoppointHitCounter.h"
 #include "lldb/Core/Address.h"
 #include "lldb/Utility/UserID.h"
@@ -293,9 +295,24 @@ protected:
 
   bool IgnoreCountShouldStop();
 
+  /// Returns the agent expression compiled from the current condition for
+  /// the current breakpoint site, or an empty vector if there is none.
+  std::vector<uint8_t> GetCurrentAgentCondition();
+
+  /// Returns whether the conditions given to the breakpoint site, which the
+  /// process plugin evaluates, include the current condition.
+  bool HasCurrentAgentCondition() {
+    return !GetCurrentAgentCondition().empty();
+  }
+
 private:
   void SwapLocation(lldb::BreakpointLocationSP swap_from);
 
+  /// Compile the simple condition to an agent expression for \a frame, and
+  /// give the breakpoint site the conditions of all its owners, so that the
+  /// process plugin only reports the hits for which one of them is true.
+  void UpdateAgentCondition(StackFrame &frame, size_t condition_hash);
+
   void BumpHitCount();
 
   void UndoBumpHitCount();
@@ -343,6 +360,20 @@ private:
                                 /// multiple processes.
   size_t m_condition_hash; ///< For testing whether the condition source code
                            ///changed.
+  /// The condition, if it can be evaluated without the expression parser.
+  std::unique_ptr<SimpleCondition> m_simple_condition_up;
+  /// The hash of the condition source code m_simple_condition_up was parsed
+  /// from.
+  size_t m_simple_condition_hash;
+  /// Guards the agent expression, which is checked when the process resumes,
+  /// possibly while m_condition_mutex is held to run the condition.
+  std::mutex m_agent_condition_mutex;
+  /// The simple condition compiled to an agent expression.
+  std::vector<uint8_t> m_agent_condition;
+  /// The hash of the condition source code and the ID of the breakpoint site
+  /// m_agent_condition was compiled for.
+  size_t m_agent_condition_hash;
+  lldb::break_id_t m_agent_condition_site_id;
   lldb::break_id_t m_loc_id; ///< Breakpoint location ID.
   StoppointHitCounter m_hit_counter; ///< Number of times this breakpoint
                                      /// location has been hit.
@@ -11,6 +11,7 @@
 
 #include <list>
 #include <mutex>
+#include <vector>
 
 
 #include "lldb/Breakpoint/BreakpointLocationCollection.h"
@@ -19,6 +20,8 @@
 #include "lldb/Utility/UserID.h"
 #include "lldb/lldb-forward.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
 namespace lldb_private {
 
 /// \class BreakpointSite BreakpointSite.h "lldb/Breakpoint/BreakpointSite.h"
@@ -193,6 +196,16 @@ public:
 
   void SetType(BreakpointSite::Type type) { m_type = type; }
 
+  /// The conditions the process plugin evaluates when the site is hit, as
+  /// agent expressions, see Process::SetBreakpointSiteConditions.
+  llvm::ArrayRef<std::vector<uint8_t>> GetAgentConditions() const {
+    return m_agent_conditions;
+  }
+
+  void SetAgentConditions(std::vector<std::vector<uint8_t>> conditions) {
+    m_agent_conditions = std::move(conditions);
+  }
+
 private:
   friend class Process;
   friend class BreakpointLocation;
@@ -221,6 +234,9 @@ private:
                                          ///that share this breakpoint site.
   std::recursive_mutex
       m_owners_mutex; ///< This mutex protects the owners collection.
+  /// The conditions one of which must be true for the process plugin to
+  /// report a hit of this site.
+  std::vector<std::vector<uint8_t>> m_agent_conditions;
 
   static lldb::break_id_t GetNextID();
 
@@ -0,0 +1,101 @@
+//===-- SimpleCondition.h ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_BREAKPOINT_SIMPLECONDITION_H
+#define LLDB_BREAKPOINT_SIMPLECONDITION_H
+
+#include "lldb/Utility/Scalar.h"
+#include "lldb/lldb-private.h"
+
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+
+#include <memory>
+#include <vector>
+
+namespace lldb_private {
+
+/// \class SimpleCondition SimpleCondition.h "lldb/Breakpoint/SimpleCondition.h"
+/// A breakpoint condition that can be evaluated without the expression
+/// parser.
+///
+/// Most breakpoint conditions only compare variables with constants, e.g.
+/// "i == 42" or "ptr->state != 3 && count > 0". Compiling them with clang and
+/// executing them in the process takes far longer than reading the values
+/// of the variables they use, which matters for breakpoints in hot loops.
+///
+/// The supported grammar is made of:
+///   - integer and floating point literals, true, false, nullptr and NULL,
+///   - variable expression paths made of member accesses and constant array
+///     indexes, e.g. "a.b->c[3]", optionally dereferenced with '*',
+///   - the ==, !=, <, <=, > and >= comparisons,
+///   - the !, && and || logical operators, unary minus and parentheses.
+///
+/// The variables must have a scalar, pointer or enumeration type. Anything
+/// else, e.g. a function call or a variable of class type with overloaded
+/// operators, is left to the expression parser.
+class SimpleCondition {
+public:
+  /// Resolves a variable expression path to its value, or returns llvm::None
+  /// if the path can't be resolved or its value isn't a scalar.
+  using PathResolver =
+      llvm::function_ref<llvm::Optional<Scalar>(llvm::StringRef path)>;
+
+  /// Parse a condition.
+  ///
+  /// \return
+  ///     The condition, or a null pointer if \a text doesn't belong to the
+  ///     supported grammar.
+  static std::unique_ptr<SimpleCondition> Parse(llvm::StringRef text);
+
+  ~SimpleCondition();
+
+  /// Evaluate the condition, resolving its variable expression paths with
+  /// \a resolver. The operands of && and || are evaluated lazily, like in C.
+  ///
+  /// \return
+  ///     Whether the condition is true, or llvm::None if one of the paths
+  ///     it needed couldn't be resolved.
+  llvm::Optional<bool> Evaluate(PathResolver resolver) const;
+
+  /// Evaluate the condition with the variables visible in \a frame.
+  llvm::Optional<bool> Evaluate(StackFrame &frame) const;
+
+  /// Compile the condition to the bytecode of an agent expression, which a
+  /// stub can evaluate when a thread stops at the pc of \a frame.
+  ///
+  /// \param[in] frame
+  ///     The frame zero of a thread stopped at the breakpoint. It provides
+  ///     the locations of the variables at that pc and the register numbers
+  ///     of the process plugin.
+  ///
+  /// \return
+  ///     The bytecode, or an error if a variable has a location or a type the
+  ///     bytecode can't express, e.g. a floating point variable or a variable
+  ///     whose location is a DWARF expression with more than one operation.
+  llvm::Expected<std::vector<uint8_t>>
+  CompileAgentExpression(StackFrame &frame) const;
+
+private:
+  struct Node;
+  class Parser;
+  class AgentCompiler;
+
+  SimpleCondition(std::unique_ptr<Node> root);
+
+  static llvm::Optional<Scalar> EvaluateNode(const Node &node,
+                                             PathResolver resolver);
+
+  std::unique_ptr<Node> m_root;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_BREAKPOINT_SIMPLECONDITION_H
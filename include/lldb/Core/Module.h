@@ -12,6 +12,7 @@
 #include "lldb/Core/Address.h"
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
+#include "lldb/Symbol/FunctionRangeCache.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/SymbolContextScope.h"
 #include "lldb/Symbol/TypeSystem.h"
@@ -559,6 +560,14 @@ public:
   ///     remains valid as long as the object is around.
   virtual ObjectFile *GetObjectFile();
 
+  /// Get the object file representation if it has already been parsed.
+  ///
+  /// \return
+  ///     The object file found by a previous call to GetObjectFile(), or
+  ///     nullptr if there was none. Unlike GetObjectFile(), this never parses
+  ///     the object file.
+  ObjectFile *GetObjectFileIfParsed();
+
   /// Get the unified section list for the module. This is the section list
   /// created by the module's object file and any debug info and symbol files
   /// created by the symbol vendor.
@@ -689,6 +698,21 @@ public:
       const Address &so_addr, lldb::SymbolContextItem resolve_scope,
       SymbolContext &sc, bool resolve_tail_call_address = false);
 
+  /// Get the name of the function or symbol containing a file address.
+  ///
+  /// The address range of every function found is cached, so that looking up
+  /// any other address of the same function doesn't need to resolve a symbol
+  /// context. This is meant for symbolizing many addresses at once, e.g. the
+  /// backtraces collected by a sampling profiler.
+  ///
+  /// \param[in] file_addr
+  ///     A file address of this module.
+  ///
+  /// \return
+  ///     The name of the function or symbol, or an empty string if there is
+  ///     none at \a file_addr.
+  ConstString GetFunctionNameAtFileAddress(lldb::addr_t file_addr);
+
   /// Resolve items in the symbol context for a given file and line.
   ///
   /// Tries to resolve \a file_path and \a line to a list of matching symbol
@@ -966,6 +990,12 @@ protected:
   llvm::Optional<UnwindTable> m_unwind_table; ///< Table of FuncUnwinders
                                               /// objects created for this
                                               /// Module's functions
+  /// Protects the creation of m_unwind_table, which the stacks of several
+  /// threads may be unwinding through at once.
+  std::mutex m_unwind_table_mutex;
+  /// Cache of GetFunctionNameAtFileAddress, indexed by file address.
+  FunctionRangeCache m_function_names;
+  std::mutex m_function_names_mutex;
   lldb::SymbolVendorUP
       m_symfile_up; ///< A pointer to the symbol vendor for this module.
   std::vector<lldb::SymbolVendorUP>
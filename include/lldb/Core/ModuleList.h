@@ -59,6 +59,13 @@ public:
   bool SetClangModulesCachePath(const FileSpec &path);
   bool GetEnableExternalLookup() const;
   bool SetEnableExternalLookup(bool new_value);
+  FileSpec GetDecompressedSectionCachePath() const;
+  bool SetDecompressedSectionCachePath(const FileSpec &path);
+  FileSpec GetBuildIDIndexCachePath() const;
+  bool SetBuildIDIndexCachePath(const FileSpec &path);
+  FileSpec GetUnwindIndexCachePath() const;
+  bool SetUnwindIndexCachePath(const FileSpec &path);
+  uint64_t GetSharedModuleMemoryBudget() const;
 
   PathMappingList GetSymlinkMappings() const;
 };
@@ -400,6 +407,13 @@ public:
 
   size_t RemoveOrphans(bool mandatory);
 
+  /// Remove orphaned modules, oldest first, until the object files of the
+  /// remaining orphans take at most \a byte_budget bytes.
+  ///
+  /// \return
+  ///     The number of modules removed.
+  size_t RemoveOrphansOverBudget(uint64_t byte_budget);
+
   bool ResolveFileAddress(lldb::addr_t vm_addr, Address &so_addr) const;
 
   /// \copydoc Module::ResolveSymbolContextForAddress (const Address
@@ -448,6 +462,10 @@ public:
 
   static size_t RemoveOrphanSharedModules(bool mandatory);
 
+  /// Enforce the shared-module-memory-budget setting on the orphaned modules
+  /// of the global shared module list.
+  static size_t RemoveOrphanSharedModulesOverBudget();
+
   static bool RemoveSharedModuleIfOrphaned(const Module *module_ptr);
 
   void ForEach(std::function<bool(const lldb::ModuleSP &module_sp)> const
@@ -36,6 +36,7 @@
 #include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -457,6 +458,14 @@ public:
 
   virtual lldb::ValueObjectSP GetChildAtIndex(size_t idx, bool can_create);
 
+  // Return the children at the indexes [start, start + count), creating the
+  // ones that don't exist yet. The result stops after the last child or
+  // before the first child that can't be created, so it can hold fewer than
+  // count children. Synthetic values hand the whole range to their front
+  // end, which can walk its data structure once for all of them.
+  virtual std::vector<lldb::ValueObjectSP> GetChildrenInRange(size_t start,
+                                                              size_t count);
+
   // this will always create the children if necessary
   lldb::ValueObjectSP GetChildAtIndexPath(llvm::ArrayRef<size_t> idxs,
                                           size_t *index_of_error = nullptr);
@@ -875,6 +884,17 @@ protected:
 
   llvm::SmallVector<uint8_t, 16> m_value_checksum;
 
+  // When target.incremental-value-updates is set, the memory of an aggregate
+  // value that isn't a part of the memory of its parent, read at once, and
+  // the hash of these bytes and of their address.
+  DataExtractor m_backing_data;
+  uint64_t m_backing_hash = 0;
+  // The value whose backing data holds the bytes of this value, or nullptr,
+  // and its generation when they were extracted. The generation of a value is
+  // incremented every time its backing data changes.
+  ValueObject *m_backing_owner = nullptr;
+  uint32_t m_backing_generation = 0;
+
   lldb::LanguageType m_preferred_display_language;
 
   uint64_t m_language_flags;
@@ -961,6 +981,22 @@ protected:
 
   bool IsChecksumEmpty();
 
+  /// Read the memory of this value at once if it is an aggregate in memory
+  /// and the target tracks value changes, so that the values inside it
+  /// extract their data from it instead of reading it. Called by the values
+  /// that read their own memory when they are updated.
+  void UpdateBackingData();
+
+  /// Make \a owner the value whose backing data holds the bytes of this
+  /// value, which are at \a addr, if it has them.
+  ///
+  /// \return
+  ///     True if the backing data of \a owner has the bytes of this value.
+  bool SetBackingOwner(ValueObject *owner, lldb::addr_t addr);
+
+  /// Set \a data to the bytes of this value in the backing data of its owner.
+  void ExtractBackingData(DataExtractor &data);
+
   void SetPreferredDisplayLanguageIfNeeded(lldb::LanguageType);
 
 protected:
@@ -968,6 +1004,10 @@ protected:
 
 private:
   virtual CompilerType MaybeCalculateCompleteType();
+
+  // Whether the bytes of this value are the same as the last time it was
+  // updated, in which case it doesn't need to be updated again.
+  bool IsBackingDataUnchanged();
   void UpdateChildrenAddressType() {
     GetRoot()->DoUpdateChildrenAddressType(*this);
   }
@@ -52,6 +52,9 @@ public:
 
   lldb::ValueObjectSP GetChildAtIndex(size_t idx, bool can_create) override;
 
+  std::vector<lldb::ValueObjectSP> GetChildrenInRange(size_t start,
+                                                      size_t count) override;
+
   lldb::ValueObjectSP GetChildMemberWithName(ConstString name,
                                              bool can_create) override;
 
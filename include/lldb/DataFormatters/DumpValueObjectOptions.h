@@ -14,6 +14,7 @@
 #include "lldb/lldb-private.h"
 #include "lldb/lldb-public.h"
 
+#include <chrono>
 #include <functional>
 #include <string>
 
@@ -50,6 +51,20 @@ public:
     operator bool() { return m_element_count > 0; }
   };
 
+  /// Limits on the work done to print a value and its children. When one is
+  /// reached, the remaining children are elided. Zero means no limit.
+  struct PrintBudget {
+    std::chrono::milliseconds m_time;
+    uint64_t m_bytes;
+    uint64_t m_values;
+
+    PrintBudget() : m_time(0), m_bytes(0), m_values(0) {}
+
+    explicit operator bool() const {
+      return m_time.count() || m_bytes || m_values;
+    }
+  };
+
   typedef std::function<bool(ConstString, ConstString,
                              const DumpValueObjectOptions &, Stream &)>
       DeclPrintingHelper;
@@ -127,6 +142,9 @@ public:
   DumpValueObjectOptions &
   SetPointerAsArray(const PointerAsArraySettings &ptr_array);
 
+  DumpValueObjectOptions &
+  SetPrintBudget(const PrintBudget &budget = PrintBudget());
+
   uint32_t m_max_depth = UINT32_MAX;
   lldb::DynamicValueType m_use_dynamic = lldb::eNoDynamicValues;
   uint32_t m_omit_summary_depth = 0;
@@ -137,6 +155,7 @@ public:
   PointerDepth m_max_ptr_depth;
   DeclPrintingHelper m_decl_printing_helper;
   PointerAsArraySettings m_pointer_as_array;
+  PrintBudget m_print_budget;
   bool m_use_synthetic : 1;
   bool m_scope_already_checked : 1;
   bool m_flat_output : 1;
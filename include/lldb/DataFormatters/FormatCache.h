@@ -10,13 +10,22 @@
 #ifndef LLDB_DATAFORMATTERS_FORMATCACHE_H
 #define LLDB_DATAFORMATTERS_FORMATCACHE_H
 
-#include <map>
+#include <array>
+#include <atomic>
 #include <mutex>
+#include <utility>
 
 #include "lldb/Utility/ConstString.h"
 #include "lldb/lldb-public.h"
 
+#include "llvm/ADT/DenseMap.h"
+
 namespace lldb_private {
+/// Caches the formatters found for a type name, including the absence of a
+/// formatter, so that the categories are only searched once per type.
+///
+/// The entries are spread over shards that each have their own lock, so
+/// threads formatting values of different types rarely wait for each other.
 class FormatCache {
 private:
   struct Entry {
@@ -45,22 +54,50 @@ private:
     void Set(lldb::TypeSummaryImplSP);
     void Set(lldb::SyntheticChildrenSP);
   };
-  typedef std::map<ConstString, Entry> CacheMap;
-  CacheMap m_map;
-  std::recursive_mutex m_mutex;
 
-  uint64_t m_cache_hits = 0;
-  uint64_t m_cache_misses = 0;
+  /// The formatters of a type can differ with the dynamic value setting, as
+  /// it changes the candidate type names, so it is part of the key.
+  typedef std::pair<ConstString, unsigned> Key;
+  typedef llvm::DenseMap<Key, Entry> CacheMap;
+
+  struct Shard {
+    std::mutex m_mutex;
+    CacheMap m_map;
+  };
+
+  static constexpr size_t g_num_shards = 16;
+
+  std::array<Shard, g_num_shards> m_shards;
+
+  std::atomic<uint64_t> m_cache_hits{0};
+  std::atomic<uint64_t> m_cache_misses{0};
+
+  static Key MakeKey(ConstString type, lldb::DynamicValueType use_dynamic);
+
+  Shard &GetShard(const Key &key);
 
-  Entry &GetEntry(ConstString type);
+  template <typename ImplSP>
+  void SetImpl(ConstString type, lldb::DynamicValueType use_dynamic,
+               ImplSP &impl_sp);
 
 public:
   FormatCache() = default;
 
-  template <typename ImplSP> bool Get(ConstString type, ImplSP &format_impl_sp);
-  void Set(ConstString type, lldb::TypeFormatImplSP &format_sp);
-  void Set(ConstString type, lldb::TypeSummaryImplSP &summary_sp);
-  void Set(ConstString type, lldb::SyntheticChildrenSP &synthetic_sp);
+  /// Look up the cached formatter of \a type.
+  ///
+  /// \return
+  ///     True if the cache knows the formatter of \a type, in which case
+  ///     \a format_impl_sp is set to it. It is set to a null pointer if the
+  ///     type has no formatter.
+  template <typename ImplSP>
+  bool Get(ConstString type, lldb::DynamicValueType use_dynamic,
+           ImplSP &format_impl_sp);
+  void Set(ConstString type, lldb::DynamicValueType use_dynamic,
+           lldb::TypeFormatImplSP &format_sp);
+  void Set(ConstString type, lldb::DynamicValueType use_dynamic,
+           lldb::TypeSummaryImplSP &summary_sp);
+  void Set(ConstString type, lldb::DynamicValueType use_dynamic,
+           lldb::SyntheticChildrenSP &synthetic_sp);
 
   void Clear();
 
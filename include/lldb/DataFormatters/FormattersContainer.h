@@ -26,6 +26,10 @@
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/StringLexer.h"
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/ADT/StringExtras.h"
+
 namespace lldb_private {
 
 class IFormatChangeListener {
@@ -45,6 +49,7 @@ class TypeMatcher {
   /// just matching by comparing with m_type_name string.
   bool m_is_regex;
 
+public:
   // if the user tries to add formatters for, say, "struct Foo" those will not
   // match any type because of the way we strip qualifiers from typenames this
   // method looks for the case where the user is adding a
@@ -67,7 +72,6 @@ class TypeMatcher {
     return ConstString(type_lexer.GetUnlexed());
   }
 
-public:
   TypeMatcher() = delete;
   /// Creates a matcher that accepts any type with exactly the given type name.
   TypeMatcher(ConstString type_name)
@@ -84,6 +88,9 @@ public:
            StripTypeName(m_type_name) == StripTypeName(type_name);
   }
 
+  /// True iff this matches type names with a regex.
+  bool IsRegex() const { return m_is_regex; }
+
   /// Returns the underlying match string for this TypeMatcher.
   ConstString GetMatchString() const {
     if (m_is_regex)
@@ -126,6 +133,7 @@ public:
     std::lock_guard<std::recursive_mutex> guard(m_map_mutex);
     Delete(matcher);
     m_map.emplace_back(std::move(matcher), std::move(entry));
+    m_lookup_index_valid = false;
     if (listener)
       listener->Changed();
   }
@@ -135,6 +143,7 @@ public:
     for (auto iter = m_map.begin(); iter != m_map.end(); ++iter)
       if (iter->first.CreatedBySameMatchString(matcher)) {
         m_map.erase(iter);
+        m_lookup_index_valid = false;
         if (listener)
           listener->Changed();
         return true;
@@ -144,13 +153,31 @@ public:
 
   bool Get(ConstString type, ValueSP &entry) {
     std::lock_guard<std::recursive_mutex> guard(m_map_mutex);
-    for (auto &formatter : llvm::reverse(m_map)) {
-      if (formatter.first.Matches(type)) {
-        entry = formatter.second;
-        return true;
+    UpdateLookupIndex();
+
+    // The formatter added last wins, so find the last exact match and then
+    // look for a regex match added after it.
+    llvm::Optional<size_t> match;
+    if (!m_exact_index.empty()) {
+      auto pos = m_exact_index.find(TypeMatcher::StripTypeName(type));
+      if (pos != m_exact_index.end())
+        match = pos->second;
+    }
+    if (!m_regex_indexes.empty() &&
+        (!m_regex_filter || m_regex_filter->Execute(type.GetStringRef()))) {
+      for (size_t index : llvm::reverse(m_regex_indexes)) {
+        if (match && index < *match)
+          break;
+        if (m_map[index].first.Matches(type)) {
+          match = index;
+          break;
+        }
       }
     }
-    return false;
+    if (!match)
+      return false;
+    entry = m_map[*match].second;
+    return true;
   }
 
   bool GetExact(TypeMatcher matcher, ValueSP &entry) {
@@ -182,6 +209,7 @@ public:
   void Clear() {
     std::lock_guard<std::recursive_mutex> guard(m_map_mutex);
     m_map.clear();
+    m_lookup_index_valid = false;
     if (listener)
       listener->Changed();
   }
@@ -227,9 +255,55 @@ protected:
     return false;
   }
 
+  /// Rebuild the lookup index of m_map after it changed.
+  void UpdateLookupIndex() {
+    if (m_lookup_index_valid)
+      return;
+    m_lookup_index_valid = true;
+    m_exact_index.clear();
+    m_regex_indexes.clear();
+    m_regex_filter.reset();
+
+    std::string filter;
+    bool can_filter = true;
+    for (size_t index = 0; index < m_map.size(); ++index) {
+      const TypeMatcher &matcher = m_map[index].first;
+      if (!matcher.IsRegex()) {
+        m_exact_index[matcher.GetMatchString()] = index;
+        continue;
+      }
+      m_regex_indexes.push_back(index);
+      llvm::StringRef pattern = matcher.GetMatchString().GetStringRef();
+      // A back-reference would refer to the wrong group of the union.
+      for (size_t pos = pattern.find('\\'); pos != llvm::StringRef::npos;
+           pos = pattern.find('\\', pos + 2))
+        if (pos + 1 < pattern.size() && llvm::isDigit(pattern[pos + 1]))
+          can_filter = false;
+      if (!filter.empty())
+        filter += '|';
+      filter += "(" + pattern.str() + ")";
+    }
+    if (can_filter && m_regex_indexes.size() > 1) {
+      auto regex = std::make_unique<RegularExpression>(filter);
+      if (regex->IsValid())
+        m_regex_filter = std::move(regex);
+    }
+  }
+
   MapType m_map;
   std::recursive_mutex m_map_mutex;
   IFormatChangeListener *listener;
+
+  /// Whether the index below matches the contents of m_map.
+  bool m_lookup_index_valid = false;
+  /// The index in m_map of the last exact matcher of each stripped type
+  /// name.
+  llvm::DenseMap<ConstString, size_t> m_exact_index;
+  /// The indexes in m_map of the regex matchers, in increasing order.
+  std::vector<size_t> m_regex_indexes;
+  /// The union of all the regexes, which rejects most type names without
+  /// executing every regex. Null if the regexes couldn't be combined.
+  std::unique_ptr<RegularExpression> m_regex_filter;
 };
 
 } // namespace lldb_private
@@ -60,6 +60,49 @@ lldb::ValueObjectSP GetValueOfLibCXXCompressedPair(ValueObject &pair);
 
 time_t GetOSXEpoch();
 
+/// Creates the children of a container whose elements are contiguous in
+/// memory, e.g. a std::vector.
+///
+/// Creating each child from its address makes every child read its own
+/// memory, which is slow for large containers, especially when debugging
+/// remotely. This reads the elements a window at a time into the memory cache
+/// of the process instead, with one memory read, so the children created from
+/// their address read their values from the cache. The children are backed by
+/// the memory of the process, so setting their value writes to it.
+class ContiguousChildrenReader {
+public:
+  /// The maximum number of bytes of elements read at once.
+  static constexpr size_t kMaxWindowSize = 64 * 1024;
+
+  /// Forget the elements read so far and describe the new element range.
+  void Reset(lldb::addr_t start, size_t num_elements,
+             const CompilerType &element_type, uint64_t element_size);
+
+  /// Returns the child at \a idx, named "[idx]", reading its window into the
+  /// memory cache if it isn't the current one.
+  ///
+  /// \return
+  ///     The child, or a null pointer if \a idx is out of range. If the
+  ///     window couldn't be read, the child reads its own memory and reports
+  ///     the error.
+  lldb::ValueObjectSP GetChildAtIndex(size_t idx,
+                                      const ExecutionContextRef &exe_ctx_ref);
+
+private:
+  lldb::addr_t m_start = LLDB_INVALID_ADDRESS;
+  size_t m_num_elements = 0;
+  CompilerType m_element_type;
+  uint64_t m_element_size = 0;
+  /// Whether a window was read into the memory cache.
+  bool m_has_window = false;
+  /// The index of the first element of the current window.
+  size_t m_window_start = 0;
+  /// The stop and memory IDs of the process when the window was read. The
+  /// process flushes the window from its cache when they change.
+  uint32_t m_window_stop_id = 0;
+  uint32_t m_window_memory_id = 0;
+};
+
 struct InferiorSizedWord {
 
   InferiorSizedWord(const InferiorSizedWord &word) : ptr_size(word.ptr_size) {
@@ -23,6 +23,10 @@
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Utility/StructuredData.h"
 
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/Support/Error.h"
+
 namespace lldb_private {
 class SyntheticChildrenFrontEnd {
 protected:
@@ -47,6 +51,14 @@ public:
 
   virtual lldb::ValueObjectSP GetChildAtIndex(size_t idx) = 0;
 
+  // return the children at the indexes [start, start + count), stopping
+  // before the first child that can't be created. The default implementation
+  // calls GetChildAtIndex() for each index in order; front ends that have to
+  // walk a data structure to reach a child should resume the walk where the
+  // previous child was found instead of starting over for every child
+  virtual std::vector<lldb::ValueObjectSP> GetChildrenInRange(size_t start,
+                                                              size_t count);
+
   virtual size_t GetIndexOfChildWithName(ConstString name) = 0;
 
   // this function is assumed to always succeed and it if fails, the front-end
@@ -384,6 +396,118 @@ private:
   const CXXSyntheticChildren &operator=(const CXXSyntheticChildren &) = delete;
 };
 
+/// Synthetic children described by the layout of a container instead of by
+/// a Python class.
+///
+/// Most synthetic children providers written in Python follow a pointer to
+/// an array of elements or walk a linked list of nodes. Their
+/// num_children() and get_child_at_index() methods are called for every
+/// child, and each call acquires the Python lock and converts its arguments
+/// and results. A layout tells where the elements of such a container are,
+/// and the front end finds them without running any script.
+///
+/// A layout is a JSON dictionary. Its "kind" key is either:
+///   - "array": "data" is the expression path of a pointer to the first
+///     element, or of an array holding the elements. The number of elements
+///     is either the value of the "size" path, or the distance between the
+///     "data" pointer and the pointer at the "end" path.
+///   - "list": "head" is the expression path of a pointer to the first node.
+///     A node has a "next" member pointing to the following node, which is
+///     null or the first node for the last one, and a "value" member holding
+///     the element. The number of elements is the value of the optional
+///     "size" path, otherwise the list is walked.
+/// The type of the elements is the one of the pointer, array or "value"
+/// member, unless the "element_type" key gives the name of another type.
+class DeclarativeSyntheticChildren : public SyntheticChildren {
+public:
+  struct Layout {
+    enum class Kind { Array, List };
+
+    Kind kind = Kind::Array;
+    std::string data;
+    std::string end;
+    std::string size;
+    std::string head;
+    std::string next;
+    std::string value;
+    std::string element_type;
+  };
+
+  /// Parse the JSON description of a layout.
+  static llvm::Expected<Layout> ParseLayout(llvm::StringRef json);
+
+  DeclarativeSyntheticChildren(const SyntheticChildren::Flags &flags,
+                               Layout layout, llvm::StringRef json)
+      : SyntheticChildren(flags), m_layout(std::move(layout)),
+        m_json(json.str()) {}
+
+  const Layout &GetLayout() const { return m_layout; }
+
+  bool IsScripted() override { return false; }
+
+  std::string GetDescription() override;
+
+  class FrontEnd : public SyntheticChildrenFrontEnd {
+  public:
+    FrontEnd(const Layout &layout, ValueObject &backend);
+
+    size_t CalculateNumChildren() override;
+
+    size_t CalculateNumChildren(uint32_t max) override;
+
+    lldb::ValueObjectSP GetChildAtIndex(size_t idx) override;
+
+    bool Update() override;
+
+    bool MightHaveChildren() override { return true; }
+
+    size_t GetIndexOfChildWithName(ConstString name) override;
+
+  private:
+    lldb::ValueObjectSP GetValueAtPath(llvm::StringRef path);
+    CompilerType GetElementType(CompilerType deduced_type);
+    bool UpdateArray();
+    bool UpdateList();
+    bool ReadNodes(size_t count);
+
+    const Layout &m_layout;
+    /// The type named by the "element_type" key, looked up once.
+    llvm::Optional<CompilerType> m_named_element_type;
+    CompilerType m_element_type;
+    uint64_t m_element_size = 0;
+    /// The number of elements, or UINT32_MAX if a list has to be walked to
+    /// count them.
+    size_t m_count = 0;
+    /// The address of the first element of an array.
+    lldb::addr_t m_first_element = LLDB_INVALID_ADDRESS;
+    /// The addresses of the nodes of a list read so far, in order.
+    std::vector<lldb::addr_t> m_nodes;
+    llvm::DenseSet<lldb::addr_t> m_visited_nodes;
+    /// The node after the last one of m_nodes, or LLDB_INVALID_ADDRESS once
+    /// the walk reached the end of the list or a node it couldn't read.
+    lldb::addr_t m_next_node = LLDB_INVALID_ADDRESS;
+    uint64_t m_next_offset = 0;
+    uint64_t m_value_offset = 0;
+
+    FrontEnd(const FrontEnd &) = delete;
+    const FrontEnd &operator=(const FrontEnd &) = delete;
+  };
+
+  SyntheticChildrenFrontEnd::AutoPointer
+  GetFrontEnd(ValueObject &backend) override {
+    return SyntheticChildrenFrontEnd::AutoPointer(
+        new FrontEnd(m_layout, backend));
+  }
+
+private:
+  Layout m_layout;
+  std::string m_json;
+
+  DeclarativeSyntheticChildren(const DeclarativeSyntheticChildren &) = delete;
+  const DeclarativeSyntheticChildren &
+  operator=(const DeclarativeSyntheticChildren &) = delete;
+};
+
 class ScriptedSyntheticChildren : public SyntheticChildren {
   std::string m_python_class;
   std::string m_python_code;
@@ -18,6 +18,10 @@
 #include "lldb/DataFormatters/DumpValueObjectOptions.h"
 #include "lldb/Symbol/CompilerType.h"
 
+#include "llvm/ADT/StringMap.h"
+
+#include <chrono>
+
 namespace lldb_private {
 
 class ValueObjectPrinter {
@@ -37,13 +41,37 @@ protected:
 
   InstancePointersSetSP m_printed_instance_pointers;
 
+  // the state shared by the printers of a value and of all its children
+  struct PrintState {
+    enum class StopReason { None, Time, Bytes, Values, Interrupted };
+
+    std::chrono::steady_clock::time_point m_start;
+    size_t m_start_bytes = 0;
+    uint64_t m_num_values = 0;
+    // why the remaining children are elided, if they are
+    StopReason m_stop_reason = StopReason::None;
+
+    // the time spent printing the values of each type, without their
+    // children, and the number of these values, only measured when the data
+    // formatters log is enabled
+    bool m_measure_time = false;
+    std::chrono::nanoseconds m_children_time{0};
+    llvm::StringMap<std::pair<std::chrono::nanoseconds, uint64_t>>
+        m_time_by_type;
+  };
+  typedef std::shared_ptr<PrintState> PrintStateSP;
+
+  PrintStateSP m_print_state;
+  bool m_owns_print_state;
+
   // only this class (and subclasses, if any) should ever be concerned with the
   // depth mechanism
   ValueObjectPrinter(ValueObject *valobj, Stream *s,
                      const DumpValueObjectOptions &options,
                      const DumpValueObjectOptions::PointerDepth &ptr_depth,
                      uint32_t curr_depth,
-                     InstancePointersSetSP printed_instance_pointers);
+                     InstancePointersSetSP printed_instance_pointers,
+                     PrintStateSP print_state);
 
   // we should actually be using delegating constructors here but some versions
   // of GCC still have trouble with those
@@ -51,7 +79,15 @@ protected:
             const DumpValueObjectOptions &options,
             const DumpValueObjectOptions::PointerDepth &ptr_depth,
             uint32_t curr_depth,
-            InstancePointersSetSP printed_instance_pointers);
+            InstancePointersSetSP printed_instance_pointers,
+            PrintStateSP print_state);
+
+  // check the budget of the options and whether the command was interrupted,
+  // returns true if the remaining children should be elided
+  bool ShouldStopPrinting();
+
+  // called by the printer of the root value once it is printed
+  void FinishPrinting();
 
   bool GetMostSpecializedValue();
 
@@ -0,0 +1,90 @@
+//===-- UserExpressionCache.h -----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_EXPRESSION_USEREXPRESSIONCACHE_H
+#define LLDB_EXPRESSION_USEREXPRESSIONCACHE_H
+
+#include "lldb/Expression/Expression.h"
+#include "lldb/Target/Target.h"
+#include "lldb/lldb-private.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace lldb_private {
+
+/// \class UserExpressionCache UserExpressionCache.h
+/// "lldb/Expression/UserExpressionCache.h"
+/// A cache of the user expressions a target already parsed.
+///
+/// Parsing an expression, i.e. compiling it with clang and JIT compiling or
+/// preparing the interpretation of its IR, takes most of the time of its
+/// evaluation. A parsed expression can be executed again as long as it is
+/// executed in the context it was parsed for, which is what breakpoint
+/// conditions already do. This cache extends that to UserExpression::Evaluate,
+/// so that evaluating the same expression repeatedly at the same stop or
+/// at the same pc only parses it once.
+///
+/// Expressions are taken out of the cache while they execute and put back
+/// once they completed, so that an expression is never executed twice at
+/// the same time. The cache must be cleared whenever the names an expression
+/// could have found while parsing may have changed, e.g. when modules are
+/// loaded or unloaded.
+class UserExpressionCache {
+public:
+  /// Everything the result of parsing an expression depends on, other than
+  /// the state of the target.
+  struct Key {
+    std::string text;
+    std::string prefix;
+    lldb::LanguageType language;
+    Expression::ResultType desired_type;
+    ExecutionPolicy execution_policy;
+    bool generate_debug_info;
+    ImportStdModule import_std_module;
+    /// The load address of the code of the frame the expression is parsed
+    /// in, which determines the variables it can see, or
+    /// LLDB_INVALID_ADDRESS without a frame.
+    lldb::addr_t frame_pc;
+
+    bool operator<(const Key &rhs) const;
+  };
+
+  UserExpressionCache(size_t max_size = 64);
+
+  /// Take the expression parsed for \a key out of the cache.
+  ///
+  /// \return
+  ///     The expression, or a null pointer if there is none or if it can't
+  ///     be executed in \a exe_ctx, in which case it is dropped.
+  lldb::UserExpressionSP Take(const Key &key, ExecutionContext &exe_ctx);
+
+  /// Add a parsed expression to the cache, evicting the least recently
+  /// added one if the cache is full.
+  void Insert(const Key &key, lldb::UserExpressionSP expr_sp);
+
+  void Clear();
+
+  size_t GetSize() const;
+
+private:
+  struct Entry {
+    lldb::UserExpressionSP expr_sp;
+    uint64_t generation;
+  };
+
+  mutable std::mutex m_mutex;
+  std::map<Key, Entry> m_entries;
+  const size_t m_max_size;
+  uint64_t m_generation = 0;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_EXPRESSION_USEREXPRESSIONCACHE_H
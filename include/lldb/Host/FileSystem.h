@@ -21,9 +21,12 @@
 
 #include "lldb/lldb-types.h"
 
+#include <map>
+#include <mutex>
 #include <stdint.h>
 #include <stdio.h>
 #include <sys/stat.h>
+#include <tuple>
 
 namespace lldb_private {
 class FileSystem {
@@ -152,6 +155,23 @@ public:
                                                    uint64_t offset = 0);
   /// \}
 
+  /// Create memory buffer from path, sharing it with any other live buffer
+  /// created by this method for the same region of the same, unmodified file.
+  ///
+  /// Object files are mapped through this method so that the targets of all
+  /// the debuggers in the process, which often load the same binaries, don't
+  /// each end up with their own copy of the file contents. Buffers are only
+  /// kept alive by their users; the file system doesn't own them. Users must
+  /// not write to these buffers.
+  /// \{
+  std::shared_ptr<DataBufferLLVM>
+  CreateSharedDataBuffer(const llvm::Twine &path, uint64_t size = 0,
+                         uint64_t offset = 0);
+  std::shared_ptr<DataBufferLLVM>
+  CreateSharedDataBuffer(const FileSpec &file_spec, uint64_t size = 0,
+                         uint64_t offset = 0);
+  /// \}
+
   /// Call into the Host to see if it can help find the file.
   bool ResolveExecutableLocation(FileSpec &file_spec);
 
@@ -202,6 +222,16 @@ private:
   std::shared_ptr<llvm::FileCollectorBase> m_collector;
   std::string m_home_directory;
   bool m_mapped;
+
+  struct SharedDataBuffer {
+    llvm::sys::TimePoint<> mod_time;
+    std::weak_ptr<DataBufferLLVM> buffer;
+  };
+  /// Buffers created by CreateSharedDataBuffer indexed by external path, size
+  /// and offset.
+  std::map<std::tuple<std::string, uint64_t, uint64_t>, SharedDataBuffer>
+      m_shared_buffers;
+  std::mutex m_shared_buffers_mutex;
 };
 } // namespace lldb_private
 
@@ -22,10 +22,13 @@
 #include "lldb/lldb-types.h"
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include <memory>
 #include <mutex>
+#include <new>
 #include <unordered_map>
 #include <vector>
 
@@ -142,6 +145,16 @@ public:
 
   virtual Status RemoveBreakpoint(lldb::addr_t addr, bool hardware = false);
 
+  /// Set the conditions of the software breakpoint at \a addr, replacing
+  /// the ones it had.
+  ///
+  /// \param[in] conditions
+  ///     The bytecode of agent expressions, see AgentExpression. A thread
+  ///     hitting the breakpoint only stops if one of them is true. An empty
+  ///     list makes the breakpoint unconditional.
+  Status SetBreakpointConditions(lldb::addr_t addr,
+                                 std::vector<std::vector<uint8_t>> conditions);
+
   // Hardware Breakpoint functions
   virtual const HardwareBreakpointMap &GetHardwareBreakpointMap() const;
 
@@ -379,6 +392,27 @@ public:
     return Status("Not implemented");
   }
 
+  /// Similar API as \a GetData except that \a callback is called with the
+  /// trace data instead of copying it into a buffer. Tracing instances that
+  /// consume their trace buffer incrementally pass the data straight from
+  /// the trace buffer, so it is only valid during the call.
+  ///
+  /// \param[in] size
+  ///     The maximum number of bytes to read.
+  virtual Status
+  ReadData(lldb::user_id_t traceid, lldb::tid_t thread, size_t size,
+           size_t offset,
+           llvm::function_ref<void(llvm::ArrayRef<uint8_t>)> callback) {
+    std::unique_ptr<uint8_t[]> buffer(new (std::nothrow) uint8_t[size]);
+    if (!buffer)
+      return Status("couldn't allocate a buffer of %zu bytes", size);
+    llvm::MutableArrayRef<uint8_t> data(buffer.get(), size);
+    Status error = GetData(traceid, thread, data, offset);
+    if (error.Success())
+      callback(data);
+    return error;
+  }
+
   /// API to query the TraceOptions for a given user id
   ///
   /// \param[in] traceid
@@ -402,6 +436,9 @@ protected:
     uint32_t ref_count;
     llvm::SmallVector<uint8_t, 4> saved_opcodes;
     llvm::ArrayRef<uint8_t> breakpoint_opcodes;
+    /// The agent expressions one of which must be true for a thread hitting
+    /// the breakpoint to stop.
+    std::vector<std::vector<uint8_t>> conditions;
   };
 
   std::unordered_map<lldb::addr_t, SoftwareBreakpoint> m_software_breakpoints;
@@ -450,6 +487,20 @@ protected:
   Status SetSoftwareBreakpoint(lldb::addr_t addr, uint32_t size_hint);
   Status RemoveSoftwareBreakpoint(lldb::addr_t addr);
 
+  /// Evaluate the conditions of the software breakpoint at \a addr for
+  /// \a thread, which is stopped at it.
+  ///
+  /// \return
+  ///     False if the breakpoint has conditions and all of them are false,
+  ///     true otherwise, including when a condition couldn't be evaluated.
+  bool BreakpointConditionsSayStop(NativeThreadProtocol &thread,
+                                   lldb::addr_t addr);
+
+  /// Write the original opcodes or the trap opcodes of the software
+  /// breakpoint at \a addr, e.g. to step a thread over the breakpoint
+  /// without removing it.
+  Status SetSoftwareBreakpointTrapInserted(lldb::addr_t addr, bool inserted);
+
   virtual llvm::Expected<llvm::ArrayRef<uint8_t>>
   GetSoftwareBreakpointTrapOpcode(size_t size_hint);
 
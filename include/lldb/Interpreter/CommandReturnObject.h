@@ -88,6 +88,18 @@ public:
     return m_err_stream.GetStreamAtIndex(eImmediateStreamIndex);
   }
 
+  /// Set the stream the output of the command is printed to once the
+  /// command is done, which lets a long running command print its output
+  /// while it runs by calling StreamOutput().
+  void SetDeferredOutputStream(const lldb::StreamSP &stream_sp) {
+    m_deferred_out_stream_sp = stream_sp;
+  }
+
+  /// Print the output of the command to the deferred output stream, if there
+  /// is one, and make it the immediate output stream, so the rest of the
+  /// output is printed as it is written.
+  void StreamOutput();
+
   void Clear();
 
   void AppendMessage(llvm::StringRef in_string);
@@ -149,6 +161,7 @@ private:
 
   StreamTee m_out_stream;
   StreamTee m_err_stream;
+  lldb::StreamSP m_deferred_out_stream_sp;
 
   lldb::ReturnStatus m_status;
   bool m_did_change_process_state;
@@ -10,6 +10,7 @@
 #define LLDB_INTERPRETER_OPTIONGROUPVALUEOBJECTDISPLAY_H
 
 #include "lldb/Core/ValueObject.h"
+#include "lldb/DataFormatters/DumpValueObjectOptions.h"
 #include "lldb/Interpreter/Options.h"
 
 namespace lldb_private {
@@ -51,6 +52,7 @@ public:
   uint32_t ptr_depth;
   uint32_t elem_count;
   lldb::DynamicValueType use_dynamic;
+  DumpValueObjectOptions::PrintBudget print_budget;
 };
 
 } // namespace lldb_private
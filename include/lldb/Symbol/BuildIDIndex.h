@@ -0,0 +1,107 @@
+//===-- BuildIDIndex.h ------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_SYMBOL_BUILDIDINDEX_H
+#define LLDB_SYMBOL_BUILDIDINDEX_H
+
+#include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/UUID.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Chrono.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace lldb_private {
+
+/// \class BuildIDIndex BuildIDIndex.h "lldb/Symbol/BuildIDIndex.h"
+/// An index of the debug files of a build-id symbol store.
+///
+/// A symbol store is a directory whose ".build-id" subdirectory contains the
+/// separate debug files of binaries named after their build-id, e.g.
+/// /usr/lib/debug/.build-id/ff/e7fe727889ad82bb153de2ad065b2189693315.debug.
+///
+/// Instead of checking whether the debug file of every module exists, the
+/// index lists each bucket directory (the "ff" above) once and answers all
+/// the lookups, found or not, from memory. The contents of each bucket are
+/// revalidated against its modification time the first time it is used in a
+/// session, which for an unchanged store costs a single stat per bucket.
+///
+/// If the symbols.build-id-index-cache-path setting is set, the index is
+/// saved there by Save() and later sessions don't need to list the store
+/// again. The buckets of a saved index are checked against their modification
+/// time when it is loaded, and only the ones that changed are listed again.
+class BuildIDIndex {
+public:
+  /// Get the index of the symbol store rooted at \a directory, creating it if
+  /// needed. Indexes are kept until Clear() is called.
+  static std::shared_ptr<BuildIDIndex>
+  GetIndexForDirectory(const FileSpec &directory);
+
+  /// Discard all the indexes, e.g. after the contents of the stores changed
+  /// during the session. The indexes are created again on their next use,
+  /// from the index cache if there is one.
+  static void Clear();
+
+  /// Look up the debug files of a set of build-ids.
+  ///
+  /// \param[in] uuids
+  ///     The build-ids to look up.
+  ///
+  /// \return
+  ///     The paths of the debug files in the same order as \a uuids. The path
+  ///     of the build-ids that are not in the store is empty.
+  std::vector<FileSpec> Lookup(llvm::ArrayRef<UUID> uuids);
+
+  /// Look up the debug file of a single build-id.
+  FileSpec Lookup(const UUID &uuid);
+
+  /// Save the index in the index cache if it changed since it was loaded or
+  /// last saved. Lookups don't save the index themselves, so that looking up
+  /// a batch of build-ids writes the index once.
+  void Save();
+
+private:
+  struct Bucket {
+    llvm::sys::TimePoint<> mod_time;
+    /// The file names in the bucket directory.
+    llvm::StringSet<> files;
+    /// Whether the bucket was checked against the store since the index was
+    /// created.
+    bool validated = false;
+  };
+
+  explicit BuildIDIndex(const FileSpec &directory);
+
+  FileSpec LookupLocked(const UUID &uuid);
+
+  /// Make sure the contents of \a name reflect the store, listing the bucket
+  /// directory again if it changed since it was indexed.
+  Bucket &GetValidatedBucket(llvm::StringRef name);
+
+  FileSpec GetIndexCacheFile() const;
+  void LoadIndex();
+  void SaveIndex();
+
+  /// The ".build-id" directory of the store.
+  FileSpec m_build_id_dir;
+  llvm::StringMap<Bucket> m_buckets;
+  /// Whether the ".build-id" directory exists, checked once per session.
+  bool m_exists = false;
+  /// Whether the index changed since it was loaded or saved.
+  bool m_dirty = false;
+  std::mutex m_mutex;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_SYMBOL_BUILDIDINDEX_H
@@ -0,0 +1,102 @@
+//===-- CompiledUnwindTable.h -----------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_SYMBOL_COMPILEDUNWINDTABLE_H
+#define LLDB_SYMBOL_COMPILEDUNWINDTABLE_H
+
+#include "lldb/lldb-private.h"
+
+#include <mutex>
+#include <vector>
+
+namespace lldb_private {
+
+/// \class CompiledUnwindTable CompiledUnwindTable.h
+/// "lldb/Symbol/CompiledUnwindTable.h"
+/// A compact form of the call site unwind rules of the eh_frame section of a
+/// module.
+///
+/// Unwinding a frame above frame zero normally requires creating the
+/// FuncUnwinders of its function and finding the right row of its eh_frame
+/// UnwindPlan. The rows of most compiler generated functions are simple: the
+/// CFA is a register plus an offset and the saved registers, including the
+/// return address, are stored at fixed offsets from the CFA. This table
+/// compiles those rows into sorted arrays of address ranges, so that finding
+/// the rule for a pc is a couple of binary searches.
+///
+/// Functions are compiled the first time one of their addresses is looked up.
+/// Functions with rows that don't fit the compact form are remembered as such
+/// so that the caller falls back to the full UnwindPlan machinery for them.
+class CompiledUnwindTable {
+public:
+  explicit CompiledUnwindTable(DWARFCallFrameInfo &eh_frame);
+
+  /// Get an UnwindPlan with the single eh_frame row covering \a addr.
+  ///
+  /// \param[in] addr
+  ///     An address inside the call instruction of a frame. Callers usually
+  ///     pass the return address minus one.
+  ///
+  /// \return
+  ///     A plan shared by all the frames using the same row, or nullptr if
+  ///     there is no eh_frame row for \a addr or if it's not in compact form.
+  lldb::UnwindPlanSP GetUnwindPlanAtCallSite(const Address &addr);
+
+private:
+  struct SavedRegister {
+    uint32_t reg_num;
+    /// The register is saved at CFA + offset, or unchanged if \a same is set.
+    int32_t cfa_offset;
+    bool same;
+  };
+
+  struct Row {
+    lldb::addr_t start;
+    uint32_t cfa_reg_num;
+    int32_t cfa_offset;
+    uint32_t return_addr_reg_num;
+    /// Range of the saved registers of this row in m_saved_registers.
+    uint32_t first_saved_register;
+    uint32_t num_saved_registers;
+  };
+
+  struct Function {
+    lldb::addr_t start;
+    lldb::addr_t end;
+    /// Range of the rows of this function in m_rows. Functions that don't
+    /// fit the compact form have no rows.
+    uint32_t first_row;
+    uint32_t num_rows;
+  };
+
+  /// Find the compiled function containing \a file_addr, compiling it if
+  /// needed. The mutex must be held.
+  const Function *GetFunction(const Address &addr, lldb::addr_t file_addr);
+
+  /// Append the compact form of \a plan to the table.
+  ///
+  /// \return
+  ///     \b false if any row of the plan doesn't fit the compact form.
+  bool CompileUnwindPlan(UnwindPlan &plan, lldb::addr_t function_start);
+
+  lldb::UnwindPlanSP CreateUnwindPlanForRow(const Row &row);
+
+  DWARFCallFrameInfo &m_eh_frame;
+  /// The compiled functions sorted by start address.
+  std::vector<Function> m_functions;
+  std::vector<Row> m_rows;
+  std::vector<SavedRegister> m_saved_registers;
+  /// The plans created for the rows of m_rows, in the same order.
+  std::vector<lldb::UnwindPlanSP> m_row_plans;
+  lldb::RegisterKind m_register_kind = lldb::eRegisterKindEHFrame;
+  std::mutex m_mutex;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_SYMBOL_COMPILEDUNWINDTABLE_H
@@ -9,6 +9,7 @@
 #ifndef LLDB_SYMBOL_DWARFCALLFRAMEINFO_H
 #define LLDB_SYMBOL_DWARFCALLFRAMEINFO_H
 
+#include <atomic>
 #include <map>
 #include <mutex>
 
@@ -21,6 +22,8 @@
 #include "lldb/Utility/VMRange.h"
 #include "lldb/lldb-private.h"
 
+#include "llvm/Support/Threading.h"
+
 namespace lldb_private {
 
 // DWARFCallFrameInfo is a class which can read eh_frame and DWARF Call Frame
@@ -29,6 +32,11 @@ namespace lldb_private {
 // address via the information in the eh_frame / debug_frame, and one to
 // generate an UnwindPlan based on the FDE in the eh_frame / debug_frame
 // section.
+//
+// FDEs are found by address through the sorted table of the .eh_frame_hdr
+// section when there is one, without scanning the eh_frame section. Otherwise
+// the whole section is indexed the first time it is used, and the index is
+// saved in the symbols.unwind-index-cache-path directory if it is set.
 
 class DWARFCallFrameInfo {
 public:
@@ -126,6 +134,34 @@ private:
 
   void GetFDEIndex();
 
+  /// Decode the start address and size of the function described by the FDE
+  /// at \a fde_offset.
+  llvm::Optional<FDEEntryMap::Entry> ParseFDEEntry(dw_offset_t fde_offset);
+
+  /// Locate the .eh_frame_hdr lookup table of an eh_frame section, once.
+  ///
+  /// \return
+  ///     \b true if the section has a table with fixed size entries that can
+  ///     be binary searched.
+  bool HasEHFrameHdrTable();
+
+  /// Find the FDE containing \a file_addr in the .eh_frame_hdr table, or if
+  /// \a or_follows is set the first FDE following it if none contains it.
+  llvm::Optional<FDEEntryMap::Entry>
+  FindFDEEntryInEHFrameHdr(lldb::addr_t file_addr, bool or_follows);
+
+  /// \return
+  ///     The start address and eh_frame offset of the FDE at \a idx in the
+  ///     .eh_frame_hdr table.
+  std::pair<lldb::addr_t, lldb::addr_t> GetEHFrameHdrEntry(uint32_t idx);
+
+  FileSpec GetFDEIndexCacheFile() const;
+  bool LoadFDEIndex();
+  void SaveFDEIndex();
+
+  /// Check that \a offset is the start of a CIE before parsing it on demand.
+  bool IsCIE(dw_offset_t offset);
+
   bool FDEToUnwindPlan(uint32_t offset, Address startaddr,
                        UnwindPlan &unwind_plan);
 
@@ -145,13 +181,32 @@ private:
   ObjectFile &m_objfile;
   lldb::SectionSP m_section_sp;
   Flags m_flags = 0;
+  /// The parsed CIEs by offset. CIEs are parsed on demand when FDEs are found
+  /// without indexing the whole section, hence the mutex.
   cie_map_t m_cie_map;
+  std::mutex m_cie_map_mutex;
 
   DataExtractor m_cfi_data;
-  bool m_cfi_data_initialized = false; // only copy the section into the DE once
-
+  llvm::once_flag m_cfi_data_once; // only copy the section into the DE once
+
+  /// The lookup table of the .eh_frame_hdr section: the start address and
+  /// the FDE address of every function, both as signed 4 byte offsets from
+  /// m_eh_frame_hdr_addr and sorted by start address.
+  DataExtractor m_eh_frame_hdr_table;
+  lldb::addr_t m_eh_frame_hdr_addr = LLDB_INVALID_ADDRESS;
+  uint32_t m_eh_frame_hdr_fde_count = 0;
+  llvm::once_flag m_eh_frame_hdr_once;
+
+  /// Whether the addresses of functions have their zeroth bit set to mark
+  /// them as Thumb code.
+  bool m_clear_address_zeroth_bit = false;
+
+  // The FDE index is only modified while it's built. Once
+  // m_fde_index_initialized is set it is read-only and can be used by several
+  // threads without locking.
   FDEEntryMap m_fde_index;
-  bool m_fde_index_initialized = false; // only scan the section for FDEs once
+  // only scan the section for FDEs once
+  std::atomic<bool> m_fde_index_initialized{false};
   std::mutex m_fde_index_mutex; // and isolate the thread that does it
 
   Type m_type;
@@ -0,0 +1,75 @@
+//===-- FunctionRangeCache.h ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_SYMBOL_FUNCTIONRANGECACHE_H
+#define LLDB_SYMBOL_FUNCTIONRANGECACHE_H
+
+#include "lldb/Utility/ConstString.h"
+#include "lldb/lldb-private.h"
+#include "llvm/ADT/Optional.h"
+
+#include <map>
+#include <utility>
+
+namespace lldb_private {
+
+/// \class FunctionRangeCache FunctionRangeCache.h
+/// "lldb/Symbol/FunctionRangeCache.h"
+/// A cache of the address ranges of the functions containing a set of
+/// addresses, for clients that name many addresses, most of which belong to
+/// functions they already looked up, e.g. the pcs of a trace or of sampled
+/// backtraces.
+///
+/// Each resolved symbol context adds the whole address range of its function
+/// or symbol, so that any other address of that range is named without
+/// resolving a symbol context again. Addresses without a function or symbol
+/// are cached individually. The cache isn't thread safe.
+class FunctionRangeCache {
+public:
+  FunctionRangeCache() = default;
+  FunctionRangeCache(const FunctionRangeCache &) = delete;
+  const FunctionRangeCache &operator=(const FunctionRangeCache &) = delete;
+
+  /// \return
+  ///     The name cached for the range containing \a addr, or llvm::None if
+  ///     \a addr isn't in a cached range.
+  llvm::Optional<ConstString> Lookup(lldb::addr_t addr);
+
+  /// Cache \a name for the range of the function or symbol of \a sc that
+  /// contains \a addr.
+  ///
+  /// \param[in] addr
+  ///     The address whose symbol context is \a sc.
+  ///
+  /// \param[in] sc
+  ///     The symbol context of \a addr, resolved with at least
+  ///     eSymbolContextFunction and eSymbolContextSymbol.
+  ///
+  /// \param[in] name
+  ///     The name to return for the addresses of the range.
+  ///
+  /// \param[in] target
+  ///     If not null, \a addr and the cached ranges are load addresses in this
+  ///     target, otherwise they are file addresses.
+  void Insert(lldb::addr_t addr, const SymbolContext &sc, ConstString name,
+              Target *target = nullptr);
+
+  void Clear();
+
+private:
+  /// The end address and name of each range indexed by its start address.
+  typedef std::map<lldb::addr_t, std::pair<lldb::addr_t, ConstString>>
+      collection;
+  collection m_ranges;
+  /// The last range found, which very likely contains the next address.
+  collection::const_iterator m_last_range = m_ranges.end();
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_SYMBOL_FUNCTIONRANGECACHE_H
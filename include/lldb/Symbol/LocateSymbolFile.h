@@ -10,13 +10,16 @@
 #define LLDB_SYMBOL_LOCATESYMBOLFILE_H
 
 #include <stdint.h>
+#include <vector>
 
 #include "lldb/Core/FileSpecList.h"
 #include "lldb/Utility/FileSpec.h"
+#include "llvm/ADT/ArrayRef.h"
 
 namespace lldb_private {
 
 class ArchSpec;
+class ModuleList;
 class ModuleSpec;
 class UUID;
 
@@ -36,6 +39,28 @@ public:
   LocateExecutableSymbolFile(const ModuleSpec &module_spec,
                              const FileSpecList &default_search_paths);
 
+  // Locate the symbol files of a set of modules, returned in the same order
+  // as the module specifications.
+  //
+  // This gives the same results as calling LocateExecutableSymbolFile for
+  // each module, but the build-id symbol stores of the search paths are
+  // queried for all the modules at once, which is much cheaper when loading
+  // many modules.
+  static std::vector<FileSpec>
+  LocateExecutableSymbolFiles(llvm::ArrayRef<ModuleSpec> module_specs,
+                              const FileSpecList &default_search_paths);
+
+  // Locate the separate symbol files of the modules of a list that was just
+  // loaded, with a single call to LocateExecutableSymbolFiles, and make them
+  // the symbol files of their modules.
+  //
+  // Modules that already have a symbol file, that contain their own debug
+  // info or that have no UUID are skipped. The other ones still look for
+  // their symbol file one at a time when their symbols are first needed.
+  static void
+  LocateSymbolFilesForModules(const ModuleList &module_list,
+                              const FileSpecList &default_search_paths);
+
   static FileSpec FindSymbolFileInBundle(const FileSpec &dsym_bundle_fspec,
                                          const lldb_private::UUID *uuid,
                                          const ArchSpec *arch);
@@ -641,6 +641,11 @@ public:
   virtual size_t ReadSectionData(Section *section,
                                  DataExtractor &section_data);
 
+  // Prepare the contents of sections that are about to be read together, for
+  // example by decompressing them in parallel. The sections are still read
+  // with ReadSectionData. Sections owned by other object files are ignored.
+  virtual void PrefetchSectionData(llvm::ArrayRef<lldb::SectionSP> sections) {}
+
   bool IsInMemory() const { return m_memory_addr != LLDB_INVALID_ADDRESS; }
 
   // Strip linker annotations (such as @@VERSION) from symbol names.
@@ -698,6 +703,10 @@ protected:
 
   ConstString GetNextSyntheticSymbolName();
 
+  /// Map the given region of an object file. The mapping is shared with all
+  /// the other object files created from the same region of the same file, so
+  /// its contents must not be modified. Object files that apply relocations
+  /// in place must switch to a private copy of the file first.
   static lldb::DataBufferSP MapFileData(const FileSpec &file, uint64_t Size,
                                         uint64_t Offset);
 
@@ -18,6 +18,8 @@
 #include "lldb/Utility/Stream.h"
 #include "lldb/lldb-private.h"
 
+#include "llvm/ADT/STLExtras.h"
+
 namespace lldb_private {
 
 // The UnwindPlan object specifies how to unwind out of a function - where this
@@ -334,6 +336,15 @@ public:
 
     void RemoveRegisterInfo(uint32_t reg_num);
 
+    /// Call \a callback with the number and location of every register that
+    /// has a location in this row, in increasing register number order.
+    void ForEachRegisterLocation(
+        llvm::function_ref<void(uint32_t, const RegisterLocation &)> callback)
+        const {
+      for (const auto &entry : m_register_locations)
+        callback(entry.first, entry.second);
+    }
+
     lldb::addr_t GetOffset() const { return m_offset; }
 
     void SetOffset(lldb::addr_t offset) { m_offset = offset; }
@@ -9,16 +9,20 @@
 #ifndef LLDB_SYMBOL_UNWINDTABLE_H
 #define LLDB_SYMBOL_UNWINDTABLE_H
 
+#include <atomic>
 #include <map>
-#include <mutex>
 
 #include "lldb/lldb-private.h"
 
+#include "llvm/Support/RWMutex.h"
+
 namespace lldb_private {
 
 // A class which holds all the FuncUnwinders objects for a given ObjectFile.
 // The UnwindTable is populated with FuncUnwinders objects lazily during the
-// debug session.
+// debug session. It can be used by several threads at once, e.g. when the
+// stacks of the threads of a process are unwound in parallel; lookups of
+// existing FuncUnwinders only take a reader lock.
 
 class UnwindTable {
 public:
@@ -37,6 +41,14 @@ public:
   ArmUnwindInfo *GetArmUnwindInfo();
   SymbolFile *GetSymbolFile();
 
+  /// Get the compiled form of the eh_frame call site rules of this module.
+  ///
+  /// \return
+  ///     nullptr if the module has no eh_frame section or if it has other
+  ///     sources of call site unwind information, e.g. debug_frame, that
+  ///     take precedence over it.
+  CompiledUnwindTable *GetCompiledUnwindTable();
+
   lldb::FuncUnwindersSP GetFuncUnwindersContainingAddress(const Address &addr,
                                                           SymbolContext &sc);
 
@@ -60,6 +72,11 @@ private:
   void Dump(Stream &s);
 
   void Initialize();
+
+  /// Find the cached FuncUnwinders containing \a addr. The mutex must be
+  /// held, at least for reading.
+  lldb::FuncUnwindersSP FindFuncUnwinders(const Address &addr);
+
   llvm::Optional<AddressRange> GetAddressRange(const Address &addr,
                                                SymbolContext &sc);
 
@@ -70,14 +87,16 @@ private:
   Module &m_module;
   collection m_unwinds;
 
-  bool m_initialized; // delay some initialization until ObjectFile is set up
-  std::mutex m_mutex;
+  // delay some initialization until ObjectFile is set up
+  std::atomic<bool> m_initialized;
+  llvm::sys::RWMutex m_mutex;
 
   std::unique_ptr<CallFrameInfo> m_object_file_unwind_up;
   std::unique_ptr<DWARFCallFrameInfo> m_eh_frame_up;
   std::unique_ptr<DWARFCallFrameInfo> m_debug_frame_up;
   std::unique_ptr<CompactUnwindInfo> m_compact_unwind_up;
   std::unique_ptr<ArmUnwindInfo> m_arm_unwind_up;
+  std::unique_ptr<CompiledUnwindTable> m_compiled_unwind_up;
 
   UnwindTable(const UnwindTable &) = delete;
   const UnwindTable &operator=(const UnwindTable &) = delete;
@@ -1453,6 +1453,28 @@ public:
   size_t ReadMemoryFromInferior(lldb::addr_t vm_addr, void *buf, size_t size,
                                 Status &error);
 
+  /// Read a range of memory with one read and add it to the memory cache.
+  ///
+  /// The following calls to ReadMemory inside the range then don't need to
+  /// access the process, until the cache is flushed when the process resumes
+  /// or the range is written to. Nothing is read if the memory cache is
+  /// disabled.
+  ///
+  /// \param[in] vm_addr
+  ///     A virtual load address that indicates where to start reading
+  ///     memory from.
+  ///
+  /// \param[in] size
+  ///     The number of bytes to read.
+  ///
+  /// \param[out] error
+  ///     An error that indicates the success or failure of this
+  ///     operation.
+  ///
+  /// \return
+  ///     True if the whole range was read and cached.
+  bool PrefetchMemory(lldb::addr_t vm_addr, size_t size, Status &error);
+
   /// Read a NULL terminated string from memory
   ///
   /// This function will read a cache page at a time until a NULL string
@@ -1475,7 +1497,7 @@ public:
   ///     The error status of the read operation.
   ///
   /// \param[in] type_width
-  ///     The size of the null terminator (1 to 4 bytes per
+  ///     The size of the null terminator (1, 2 or 4 bytes per
   ///     character).  Defaults to 1.
   ///
   /// \return
@@ -1975,6 +1997,28 @@ public:
     return error;
   }
 
+  /// \return
+  ///     Whether SetBreakpointSiteConditions is supported.
+  virtual bool SupportsBreakpointSiteConditions() { return false; }
+
+  /// Make the process evaluate conditions when a breakpoint site is hit and
+  /// only report the hits for which one of them is true, which saves the
+  /// cost of stopping for the hits of a breakpoint whose condition is false.
+  ///
+  /// \param[in] bp_site
+  ///     The site, whose conditions are replaced.
+  ///
+  /// \param[in] conditions
+  ///     The bytecode of the conditions, as agent expressions, see
+  ///     AgentExpression. An empty list makes the process report every hit
+  ///     of the site again.
+  virtual Status
+  SetBreakpointSiteConditions(BreakpointSite &bp_site,
+                              std::vector<std::vector<uint8_t>> conditions) {
+    return Status("%s does not support breakpoint site conditions",
+                  GetPluginName().GetCString());
+  }
+
   // This is implemented completely using the lldb::Process API. Subclasses
   // don't need to implement this function unless the standard flow of read
   // existing opcode, write breakpoint opcode, verify breakpoint opcode doesn't
@@ -2927,6 +2971,11 @@ protected:
 
   virtual Status UpdateAutomaticSignalFiltering();
 
+  /// Make the process report every hit of the breakpoint sites whose
+  /// conditions don't match the conditions of their locations anymore, e.g.
+  /// because a condition was changed or a location was added to the site.
+  void UpdateBreakpointSiteConditions();
+
   void LoadOperatingSystemPlugin(bool flush);
 
 private:
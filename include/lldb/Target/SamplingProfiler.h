@@ -0,0 +1,117 @@
+//===-- SamplingProfiler.h --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_TARGET_SAMPLINGPROFILER_H
+#define LLDB_TARGET_SAMPLINGPROFILER_H
+
+#include "lldb/Utility/Status.h"
+#include "lldb/lldb-private.h"
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace lldb_private {
+
+/// \class SamplingProfiler SamplingProfiler.h "lldb/Target/SamplingProfiler.h"
+/// A profiler that periodically interrupts a process and collects the stacks
+/// of all its threads.
+///
+/// Each sample resumes the process, lets it run for the sampling interval,
+/// interrupts it and unwinds all its threads, either with the regular
+/// unwinder and its cached unwind plans or by following the frame pointer
+/// chains. The time the process spends stopped for each sample is recorded,
+/// so that the overhead of profiling can be reported along with the profile.
+///
+/// Identical stacks are aggregated as they are collected. The profile can be
+/// written as folded stacks, the input of flame graph tools, or as an
+/// uncompressed pprof protocol buffer.
+class SamplingProfiler {
+public:
+  struct Options {
+    /// The number of samples to collect.
+    uint32_t sample_count = 100;
+    /// The time the process runs between two samples.
+    std::chrono::microseconds interval = std::chrono::milliseconds(10);
+    /// The maximum number of frames collected per stack.
+    uint32_t max_depth = 128;
+    /// Whether to unwind with UnwindFramePointer instead of the unwinder of
+    /// the threads.
+    bool use_frame_pointers = false;
+  };
+
+  /// A frame of a collected stack.
+  struct Frame {
+    /// The load address used to symbolize the frame, which is the return
+    /// address minus one for frames above frame zero.
+    lldb::addr_t address;
+    /// The "module`function" description of the address.
+    std::string name;
+  };
+
+  /// Profile a process.
+  ///
+  /// \param[in] process
+  ///     A stopped process, which is left stopped.
+  ///
+  /// \param[in] options
+  ///     The sampling options.
+  ///
+  /// \return
+  ///     An error if the process couldn't be resumed or interrupted. The
+  ///     profile ends early without an error if the process stops for another
+  ///     reason, e.g. a breakpoint, or exits.
+  Status Profile(Process &process, const Options &options);
+
+  /// Add a stack to the profile.
+  ///
+  /// \param[in] frames
+  ///     The frames of the stack, from frame zero up.
+  void AddStack(llvm::ArrayRef<Frame> frames);
+
+  /// Record the time the process was stopped to collect a sample.
+  void AddPause(std::chrono::nanoseconds pause);
+
+  /// \return
+  ///     Whether the last call to \a Profile ended early because the process
+  ///     stopped for another reason or exited.
+  bool StoppedEarly() const { return m_stopped_early; }
+
+  /// Dump the stacks in the folded format, with a line for each distinct
+  /// stack made of the names of its frames from the outermost one, separated
+  /// by semicolons, followed by the number of times it was seen.
+  void DumpFoldedStacks(Stream &s) const;
+
+  /// Write the profile as an uncompressed protocol buffer in the format of
+  /// the pprof tool.
+  void WritePprof(Stream &s) const;
+
+  /// Dump the number of samples and stacks and the statistics of the pause
+  /// times.
+  void DumpStatistics(Stream &s) const;
+
+private:
+  /// Collect the stacks of all the threads of a stopped process.
+  void CollectStacks(Process &process, const Options &options);
+
+  /// The distinct stacks, as frame addresses from frame zero up, and the
+  /// number of times they were seen.
+  std::map<std::vector<lldb::addr_t>, uint64_t> m_stacks;
+  /// The names of the frame addresses of m_stacks.
+  std::map<lldb::addr_t, std::string> m_frame_names;
+  std::vector<std::chrono::nanoseconds> m_pauses;
+  std::chrono::microseconds m_interval{0};
+  bool m_stopped_early = false;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_TARGET_SAMPLINGPROFILER_H
@@ -9,6 +9,7 @@
 #ifndef LLDB_TARGET_TARGET_H
 #define LLDB_TARGET_TARGET_H
 
+#include <chrono>
 #include <list>
 #include <map>
 #include <memory>
@@ -38,6 +39,7 @@
 namespace lldb_private {
 
 class ClangModulesDeclVendor;
+class UserExpressionCache;
 
 OptionEnumValues GetDynamicValueTypes();
 
@@ -149,10 +151,14 @@ public:
 
   bool GetEnableNotifyAboutFixIts() const;
 
+  bool GetEnableExpressionCache() const;
+
   bool GetEnableSaveObjects() const;
 
   bool GetEnableSyntheticValue() const;
 
+  bool GetIncrementalValueUpdates() const;
+
   uint32_t GetMaxZeroPaddingInFloatFormat() const;
 
   uint32_t GetMaximumNumberOfChildrenToDisplay() const;
@@ -161,6 +167,12 @@ public:
 
   uint32_t GetMaximumMemReadSize() const;
 
+  std::chrono::milliseconds GetMaximumValuePrintTime() const;
+
+  uint64_t GetMaximumValuePrintBytes() const;
+
+  uint64_t GetMaximumValuePrintValues() const;
+
   FileSpec GetStandardInputPath() const;
   FileSpec GetStandardErrorPath() const;
   FileSpec GetStandardOutputPath() const;
@@ -181,6 +193,10 @@ public:
 
   uint64_t GetExprErrorLimit() const;
 
+  uint64_t GetExprInterpreterInstructionLimit() const;
+
+  bool GetExprPrecompilePrefix() const;
+
   bool GetUseHexImmediates() const;
 
   bool GetUseFastStepping() const;
@@ -1095,6 +1111,21 @@ public:
   bool ResolveLoadAddress(lldb::addr_t load_addr, Address &so_addr,
                           uint32_t stop_id = SectionLoadHistory::eStopIDNow);
 
+  /// Get a short "module`function" description of a load address, meant for
+  /// profiles and other lists of many addresses.
+  ///
+  /// The function is looked up through Module::GetFunctionNameAtFileAddress,
+  /// so looking up many addresses of the same functions is cheap. Addresses
+  /// outside any function or module are described in hexadecimal.
+  ///
+  /// \param[in] is_return_address
+  ///     Whether \a load_addr is the return address of a frame above frame
+  ///     zero. Return addresses may be right past the end of a function
+  ///     ending with a call, so they are looked up in the call instruction,
+  ///     but \a load_addr is still the address that is described.
+  std::string SymbolizeLoadAddress(lldb::addr_t load_addr,
+                                   bool is_return_address = false);
+
   bool SetSectionLoadAddress(const lldb::SectionSP &section,
                              lldb::addr_t load_addr,
                              bool warn_multiple = false);
@@ -1347,6 +1378,10 @@ public:
     return *m_frame_recognizer_manager_up;
   }
 
+  UserExpressionCache &GetUserExpressionCache() {
+    return *m_user_expression_cache_up;
+  }
+
 protected:
   /// Implementing of ModuleList::Notifier.
 
@@ -1426,6 +1461,8 @@ protected:
   lldb::TraceSP m_trace_sp;
   /// Stores the frame recognizers of this target.
   lldb::StackFrameRecognizerManagerUP m_frame_recognizer_manager_up;
+  /// The expressions that were parsed by UserExpression::Evaluate.
+  std::unique_ptr<UserExpressionCache> m_user_expression_cache_up;
 
   static void ImageSearchPathsChanged(const PathMappingList &path_list,
                                       void *baton);
@@ -55,6 +55,8 @@ public:
   bool GetStepOutAvoidsNoDebug() const;
 
   uint64_t GetMaxBacktraceDepth() const;
+
+  bool GetFramePointerUnwind() const;
 };
 
 typedef std::shared_ptr<ThreadProperties> ThreadPropertiesSP;
@@ -1273,6 +1275,10 @@ protected:
                                             ///resume.
   /// It gets set in Thread::ShouldResume.
   std::unique_ptr<lldb_private::Unwind> m_unwinder_up;
+  /// Whether GetUnwinder created an UnwindFramePointer, to replace it when
+  /// the frame-pointer-unwind setting changes. Unwinders set by subclasses
+  /// leave it as eLazyBoolCalculate and are never replaced.
+  LazyBool m_unwinder_is_frame_pointer = eLazyBoolCalculate;
   bool m_destroy_called; // This is used internally to make sure derived Thread
                          // classes call DestroyThread.
   LazyBool m_override_should_notify;
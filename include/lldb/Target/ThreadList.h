@@ -18,6 +18,8 @@
 #include "lldb/Utility/UserID.h"
 #include "lldb/lldb-private.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
 namespace lldb_private {
 
 // This is a thread list with lots of functionality for use only by the process
@@ -79,6 +81,21 @@ public:
 
   void Flush();
 
+  /// Unwind the stacks of several threads on a pool of worker threads.
+  ///
+  /// The frames are cached in the StackFrameList of each thread, so walking
+  /// them afterwards, e.g. to print backtraces, doesn't unwind again. The
+  /// process must be stopped.
+  ///
+  /// \param[in] tids
+  ///     The threads to unwind. Threads that are not in the list are ignored.
+  ///
+  /// \param[in] num_frames
+  ///     How many frames to unwind at most for each thread, UINT32_MAX for
+  ///     the whole stacks.
+  void ComputeStackFrames(llvm::ArrayRef<lldb::tid_t> tids,
+                          uint32_t num_frames);
+
   void Destroy();
 
   // Note that "idx" is not the same as the "thread_index". It is a zero based
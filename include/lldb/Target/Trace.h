@@ -145,6 +145,32 @@ public:
   void DumpTraceInstructions(Thread &thread, Stream &s, size_t count,
                              size_t end_position, bool raw);
 
+  /// Dump the function call tree reconstructed from the trace of the given
+  /// thread, along with the number of instructions and, if available, the
+  /// time spent in each function.
+  ///
+  /// \param[in] thread
+  ///     The thread whose trace will be analyzed.
+  ///
+  /// \param[in] s
+  ///     The stream object where the call tree is printed.
+  ///
+  /// \param[in] flat
+  ///     Instead of the call tree, dump a flat profile of the functions sorted
+  ///     by the number of instructions executed in each of them.
+  ///
+  /// \param[in] count
+  ///     When dumping the call tree, the maximum depth to print. When dumping a
+  ///     flat profile, the maximum number of functions to print.
+  ///
+  /// \return
+  ///     An \a llvm::Error if the trace plug-in can't reconstruct function
+  ///     calls, or \b llvm::Error::success() otherwise.
+  virtual llvm::Error DumpTraceFunctionCalls(Thread &thread, Stream &s,
+                                             bool flat, size_t count) {
+    return llvm::make_error<UnimplementedError>();
+  }
+
   /// Run the provided callback on the instructions of the trace of the given
   /// thread.
   ///
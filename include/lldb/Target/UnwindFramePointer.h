@@ -0,0 +1,103 @@
+//===-- UnwindFramePointer.h ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_TARGET_UNWINDFRAMEPOINTER_H
+#define LLDB_TARGET_UNWINDFRAMEPOINTER_H
+
+#include "lldb/Target/Unwind.h"
+#include "lldb/lldb-private.h"
+
+#include "llvm/Support/Error.h"
+
+#include <vector>
+
+namespace lldb_private {
+
+/// \class UnwindFramePointer UnwindFramePointer.h
+/// "lldb/Target/UnwindFramePointer.h"
+/// An unwinder that only follows the chain of saved frame pointers.
+///
+/// Every frame of code built with frame pointers stores the frame pointer of
+/// its caller at [fp] and its return address at [fp + address size]. Walking
+/// that chain doesn't need any unwind information, so it is much cheaper than
+/// UnwindLLDB, at the cost of losing the callers of functions that don't set
+/// up a frame, e.g. leaf functions or code built with -fomit-frame-pointer.
+///
+/// The stack is read in page sized blocks, so that most frames of a thread
+/// are found with a single memory read. Frames above frame zero only know
+/// their pc, which makes this unwinder mostly useful for collecting
+/// backtraces, e.g. from a sampling profiler.
+///
+/// Threads use this unwinder instead of UnwindLLDB when the
+/// target.process.thread.frame-pointer-unwind setting is enabled.
+class UnwindFramePointer : public Unwind {
+public:
+  UnwindFramePointer(Thread &thread);
+
+  ~UnwindFramePointer() override = default;
+
+  /// Get the pcs of the frames of \a thread by walking its frame pointer
+  /// chain.
+  ///
+  /// \param[in] thread
+  ///     A stopped thread.
+  ///
+  /// \param[in] max_frames
+  ///     The maximum number of pcs to return.
+  ///
+  /// \return
+  ///     The pc of frame zero followed by the return addresses of the frames
+  ///     above it, or an error if the architecture of the thread is not
+  ///     supported or its registers can't be read.
+  static llvm::Expected<std::vector<lldb::addr_t>>
+  GetBacktrace(Thread &thread, uint32_t max_frames);
+
+protected:
+  void DoClear() override;
+
+  uint32_t DoGetFrameCount() override;
+
+  bool DoGetFrameInfoAtIndex(uint32_t frame_idx, lldb::addr_t &cfa,
+                             lldb::addr_t &pc,
+                             bool &behaves_like_zeroth_frame) override;
+
+  lldb::RegisterContextSP
+  DoCreateRegisterContextForFrame(StackFrame *frame) override;
+
+private:
+  struct Frame {
+    lldb::addr_t fp;
+    lldb::addr_t pc;
+  };
+
+  /// Read the registers of frame zero.
+  llvm::Error Initialize();
+
+  /// Walk the chain until there are more than \a frame_idx frames or until
+  /// its end is reached.
+  void UnwindUpTo(uint32_t frame_idx);
+
+  /// Read a pointer from the stack, reading the block containing it first if
+  /// it's not the cached one.
+  bool ReadPointer(lldb::addr_t addr, lldb::addr_t &value);
+
+  std::vector<Frame> m_frames;
+  /// Whether the frames were initialized since the last DoClear.
+  bool m_initialized = false;
+  /// Whether the end of the frame pointer chain was reached.
+  bool m_complete = false;
+  uint32_t m_addr_size = 0;
+  lldb::ByteOrder m_byte_order = lldb::eByteOrderInvalid;
+  /// The last block of stack memory that was read.
+  lldb::addr_t m_block_addr = LLDB_INVALID_ADDRESS;
+  std::vector<uint8_t> m_block;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_TARGET_UNWINDFRAMEPOINTER_H
@@ -0,0 +1,152 @@
+//===-- AgentExpression.h ---------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_UTILITY_AGENTEXPRESSION_H
+#define LLDB_UTILITY_AGENTEXPRESSION_H
+
+#include "lldb/lldb-types.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Error.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace lldb_private {
+
+/// \class AgentExpression AgentExpression.h "lldb/Utility/AgentExpression.h"
+/// A builder and an evaluator for the bytecode of GDB agent expressions.
+///
+/// Agent expressions are the bytecode the gdb remote protocol uses to send
+/// breakpoint conditions to a stub, in the X<len>,<bytes> items following
+/// the kind of a Z0 packet. The stub evaluates them when the breakpoint is
+/// hit and only reports the stop if one of them is true, which saves the
+/// round trips of reporting the stop, reading the variables and resuming.
+///
+/// The bytecode runs a stack machine with 64-bit entries. Operands are
+/// encoded in big endian, whatever the byte order of the target. Only the
+/// subset of the bytecode without side effects is supported, i.e. there is
+/// no tracing and no printf.
+class AgentExpression {
+public:
+  enum Opcode : uint8_t {
+    eOpAdd = 0x02,
+    eOpSub = 0x03,
+    eOpMul = 0x04,
+    eOpDivSigned = 0x05,
+    eOpDivUnsigned = 0x06,
+    eOpRemSigned = 0x07,
+    eOpRemUnsigned = 0x08,
+    eOpLsh = 0x09,
+    eOpRshSigned = 0x0a,
+    eOpRshUnsigned = 0x0b,
+    eOpLogNot = 0x0e,
+    eOpBitAnd = 0x0f,
+    eOpBitOr = 0x10,
+    eOpBitXor = 0x11,
+    eOpBitNot = 0x12,
+    eOpEqual = 0x13,
+    eOpLessSigned = 0x14,
+    eOpLessUnsigned = 0x15,
+    /// Sign extend the top of the stack from the number of bits given by
+    /// its 1-byte operand.
+    eOpExt = 0x16,
+    /// Replace the address on top of the stack with the 1, 2, 4 or 8 bytes
+    /// of memory at that address.
+    eOpRef8 = 0x17,
+    eOpRef16 = 0x18,
+    eOpRef32 = 0x19,
+    eOpRef64 = 0x1a,
+    /// Pop the top of the stack and jump to the offset given by the 2-byte
+    /// operand if it is not zero.
+    eOpIfGoto = 0x20,
+    eOpGoto = 0x21,
+    eOpConst8 = 0x22,
+    eOpConst16 = 0x23,
+    eOpConst32 = 0x24,
+    eOpConst64 = 0x25,
+    /// Push the value of the register whose number, in the numbering of
+    /// the stub, is given by the 2-byte operand.
+    eOpReg = 0x26,
+    eOpEnd = 0x27,
+    eOpDup = 0x28,
+    eOpPop = 0x29,
+    /// Zero extend the top of the stack from the number of bits given by
+    /// its 1-byte operand.
+    eOpZeroExt = 0x2a,
+    eOpSwap = 0x2b,
+    eOpPick = 0x32,
+    eOpRot = 0x33,
+  };
+
+  /// Reads the register with the given number of the thread that hit the
+  /// breakpoint.
+  using RegisterReader =
+      llvm::function_ref<llvm::Expected<uint64_t>(uint32_t reg_num)>;
+  /// Reads an unsigned integer of the given size, 1, 2, 4 or 8 bytes, in
+  /// the byte order of the target.
+  using MemoryReader = llvm::function_ref<llvm::Expected<uint64_t>(
+      lldb::addr_t addr, uint32_t byte_size)>;
+
+  /// The maximum number of entries on the stack.
+  static constexpr size_t kMaxStackSize = 64;
+  /// The maximum number of instructions an evaluation executes, which
+  /// bounds the time a stub spends in an expression with a loop.
+  static constexpr size_t kMaxSteps = 10000;
+
+  /// Evaluate an expression.
+  ///
+  /// \return
+  ///     The value on top of the stack when the expression ends, or an
+  ///     error if the bytecode is malformed or reading a register or memory
+  ///     failed.
+  static llvm::Expected<uint64_t> Evaluate(llvm::ArrayRef<uint8_t> bytecode,
+                                           RegisterReader read_register,
+                                           MemoryReader read_memory);
+
+  void AppendOpcode(Opcode op) { m_bytecode.push_back(op); }
+
+  /// Push a constant with the smallest of the constN instructions.
+  void AppendConstant(uint64_t value);
+
+  void AppendRegister(uint32_t reg_num);
+
+  /// Append the refN instruction reading \a byte_size bytes, which must be
+  /// 1, 2, 4 or 8.
+  void AppendReference(uint32_t byte_size);
+
+  void AppendSignExtend(uint8_t bits);
+
+  void AppendZeroExtend(uint8_t bits);
+
+  /// Append a goto or an if_goto instruction whose target is set later.
+  ///
+  /// \return
+  ///     The label to pass to \a SetJumpTarget.
+  size_t AppendJump(Opcode op);
+
+  /// Make the jump appended at \a label go to the end of the bytecode
+  /// appended so far.
+  void SetJumpTarget(size_t label);
+
+  llvm::ArrayRef<uint8_t> GetBytecode() const { return m_bytecode; }
+
+  /// Terminate the expression with an end instruction and return its
+  /// bytecode.
+  std::vector<uint8_t> Finish();
+
+private:
+  void AppendBigEndian(uint64_t value, size_t byte_size);
+
+  std::vector<uint8_t> m_bytecode;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_UTILITY_AGENTEXPRESSION_H
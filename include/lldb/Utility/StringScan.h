@@ -0,0 +1,45 @@
+//===-- StringScan.h --------------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_UTILITY_STRINGSCAN_H
+#define LLDB_UTILITY_STRINGSCAN_H
+
+#include "llvm/ADT/ArrayRef.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lldb_private {
+
+/// Find the first null character of a string read from memory.
+///
+/// The buffer is scanned a machine word at a time, which is what makes
+/// reading and printing long strings fast.
+///
+/// \param[in] data
+///     The bytes of the string, starting with its first character.
+///
+/// \param[in] char_size
+///     The size of a character in bytes, which must be 1, 2 or 4. Only the
+///     characters aligned on this size from the start of \a data are
+///     considered and an incomplete last character is ignored.
+///
+/// \return
+///     The offset in bytes of the first null character, or the size of the
+///     complete characters of \a data if there is none.
+size_t FindStringTerminator(llvm::ArrayRef<uint8_t> data, size_t char_size);
+
+/// Return the length of the longest prefix of \a data made of printable
+/// ASCII characters that are printed as they are in a quoted string, i.e.
+/// all the characters between ' ' and '~' except the quotes and the
+/// backslash.
+size_t GetPlainASCIIPrefixLength(llvm::ArrayRef<uint8_t> data);
+
+} // namespace lldb_private
+
+#endif // LLDB_UTILITY_STRINGSCAN_H
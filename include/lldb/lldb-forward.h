@@ -54,6 +54,7 @@ class CommandObjectMultiword;
 class CommandReturnObject;
 class Communication;
 class CompactUnwindInfo;
+class CompiledUnwindTable;
 class CompileUnit;
 class CompilerDecl;
 class CompilerDeclContext;
@@ -213,7 +213,15 @@ enum StatisticKind {
   ExpressionFailure = 1,
   FrameVarSuccess = 2,
   FrameVarFailure = 3,
-  StatisticMax = 4
+  ExpressionCacheHit = 4,
+  ExpressionCacheMiss = 5,
+  ExpressionInterpreted = 6,
+  ExpressionJIT = 7,
+  ExpressionPrefixPrecompiled = 8,
+  ExpressionPrefixReused = 9,
+  FormatCacheHit = 10,
+  FormatCacheMiss = 11,
+  StatisticMax = 12
 };
 
 
@@ -227,6 +235,22 @@ inline std::string GetStatDescription(lldb_private::StatisticKind K) {
      return "Number of frame var successes";
    case StatisticKind::FrameVarFailure:
      return "Number of frame var failures";
+   case StatisticKind::ExpressionCacheHit:
+     return "Number of expr evaluations reusing a parsed expression";
+   case StatisticKind::ExpressionCacheMiss:
+     return "Number of expr evaluations parsing an expression";
+   case StatisticKind::ExpressionInterpreted:
+     return "Number of expr executions by the IR interpreter";
+   case StatisticKind::ExpressionJIT:
+     return "Number of expr executions of JIT compiled code";
+   case StatisticKind::ExpressionPrefixPrecompiled:
+     return "Number of expr prefixes precompiled";
+   case StatisticKind::ExpressionPrefixReused:
+     return "Number of expr parses reusing a precompiled prefix";
+   case StatisticKind::FormatCacheHit:
+     return "Number of formatter lookups answered by the format cache";
+   case StatisticKind::FormatCacheMiss:
+     return "Number of formatter lookups missing the format cache";
    case StatisticKind::StatisticMax:
      return "";
    }
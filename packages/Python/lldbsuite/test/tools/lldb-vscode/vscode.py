@@ -868,12 +868,15 @@ class DebugCommunication(object):
             self.threads = None
         return response
 
-    def request_variables(self, variablesReference, start=None, count=None):
+    def request_variables(self, variablesReference, start=None, count=None,
+                          filter=None):
         args_dict = {'variablesReference': variablesReference}
         if start is not None:
             args_dict['start'] = start
         if count is not None:
             args_dict['count'] = count
+        if filter is not None:
+            args_dict['filter'] = filter
         command_dict = {
             'command': 'variables',
             'type': 'request',
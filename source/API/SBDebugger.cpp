@@ -887,6 +887,7 @@ bool SBDebugger::DeleteTarget(lldb::SBTarget &target) {
       result = m_opaque_sp->GetTargetList().DeleteTarget(target_sp);
       target_sp->Destroy();
       target.Clear();
+      ModuleList::RemoveOrphanSharedModulesOverBudget();
     }
   }
 
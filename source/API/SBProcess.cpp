@@ -224,6 +224,32 @@ SBThread SBProcess::GetSelectedThread() const {
   return LLDB_RECORD_RESULT(sb_thread);
 }
 
+SBError SBProcess::ComputeStackFrames(uint32_t num_frames) {
+  LLDB_RECORD_METHOD(lldb::SBError, SBProcess, ComputeStackFrames, (uint32_t),
+                     num_frames);
+
+  SBError sb_error;
+  ProcessSP process_sp(GetSP());
+  if (process_sp) {
+    Process::StopLocker stop_locker;
+    if (stop_locker.TryLock(&process_sp->GetRunLock())) {
+      std::lock_guard<std::recursive_mutex> guard(
+          process_sp->GetTarget().GetAPIMutex());
+      ThreadList &thread_list = process_sp->GetThreadList();
+      std::vector<lldb::tid_t> tids;
+      for (ThreadSP thread_sp : thread_list.Threads())
+        tids.push_back(thread_sp->GetID());
+      thread_list.ComputeStackFrames(tids, num_frames);
+    } else {
+      sb_error.SetErrorString("process is running");
+    }
+  } else {
+    sb_error.SetErrorString("SBProcess is invalid");
+  }
+
+  return LLDB_RECORD_RESULT(sb_error);
+}
+
 SBThread SBProcess::CreateOSPluginThread(lldb::tid_t tid,
                                          lldb::addr_t context) {
   LLDB_RECORD_METHOD(lldb::SBThread, SBProcess, CreateOSPluginThread,
@@ -1334,6 +1360,8 @@ void RegisterMethods<SBProcess>(Registry &R) {
   LLDB_REGISTER_METHOD(uint32_t, SBProcess, GetNumThreads, ());
   LLDB_REGISTER_METHOD_CONST(lldb::SBThread, SBProcess, GetSelectedThread,
                              ());
+  LLDB_REGISTER_METHOD(lldb::SBError, SBProcess, ComputeStackFrames,
+                       (uint32_t));
   LLDB_REGISTER_METHOD(lldb::SBThread, SBProcess, CreateOSPluginThread,
                        (lldb::tid_t, lldb::addr_t));
   LLDB_REGISTER_METHOD_CONST(lldb::SBTarget, SBProcess, GetTarget, ());
@@ -12,6 +12,7 @@
 #include "lldb/lldb-public.h"
 
 #include "lldb/API/SBBreakpoint.h"
+#include "lldb/API/SBData.h"
 #include "lldb/API/SBDebugger.h"
 #include "lldb/API/SBEnvironment.h"
 #include "lldb/API/SBEvent.h"
@@ -694,6 +695,28 @@ SBTarget::ResolveSymbolContextForAddress(const SBAddress &addr,
   return LLDB_RECORD_RESULT(sc);
 }
 
+SBStringList SBTarget::SymbolizeBacktrace(SBData pcs) {
+  LLDB_RECORD_METHOD(lldb::SBStringList, SBTarget, SymbolizeBacktrace,
+                     (lldb::SBData), pcs);
+
+  SBStringList names;
+  TargetSP target_sp(GetSP());
+  if (!target_sp || !pcs.IsValid())
+    return LLDB_RECORD_RESULT(names);
+
+  std::lock_guard<std::recursive_mutex> guard(target_sp->GetAPIMutex());
+  const DataExtractor &data = *pcs.get();
+  for (offset_t offset = 0;
+       data.ValidOffsetForDataOfSize(offset, sizeof(uint64_t));) {
+    // Every pc but the first one is a return address.
+    bool is_return_address = offset != 0;
+    addr_t pc = data.GetU64(&offset);
+    names.AppendString(
+        target_sp->SymbolizeLoadAddress(pc, is_return_address).c_str());
+  }
+  return LLDB_RECORD_RESULT(names);
+}
+
 size_t SBTarget::ReadMemory(const SBAddress addr, void *buf, size_t size,
                             lldb::SBError &error) {
   LLDB_RECORD_METHOD(size_t, SBTarget, ReadMemory,
@@ -2505,6 +2528,8 @@ void RegisterMethods<SBTarget>(Registry &R) {
   LLDB_REGISTER_METHOD(lldb::SBSymbolContext, SBTarget,
                        ResolveSymbolContextForAddress,
                        (const lldb::SBAddress &, uint32_t));
+  LLDB_REGISTER_METHOD(lldb::SBStringList, SBTarget, SymbolizeBacktrace,
+                       (lldb::SBData));
   LLDB_REGISTER_METHOD(lldb::SBBreakpoint, SBTarget,
                        BreakpointCreateByLocation, (const char *, uint32_t));
   LLDB_REGISTER_METHOD(lldb::SBBreakpoint, SBTarget,
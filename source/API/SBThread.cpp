@@ -10,6 +10,7 @@
 #include "SBReproducerPrivate.h"
 #include "Utils.h"
 #include "lldb/API/SBAddress.h"
+#include "lldb/API/SBData.h"
 #include "lldb/API/SBDebugger.h"
 #include "lldb/API/SBEvent.h"
 #include "lldb/API/SBFileSpec.h"
@@ -40,6 +41,8 @@
 #include "lldb/Target/ThreadPlanStepInstruction.h"
 #include "lldb/Target/ThreadPlanStepOut.h"
 #include "lldb/Target/ThreadPlanStepRange.h"
+#include "lldb/Target/UnwindFramePointer.h"
+#include "lldb/Utility/Endian.h"
 #include "lldb/Utility/State.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/StructuredData.h"
@@ -1117,6 +1120,41 @@ uint32_t SBThread::GetNumFrames() {
   return num_frames;
 }
 
+SBData SBThread::GetFramePointerBacktrace(uint32_t max_frames,
+                                          SBError &error) {
+  LLDB_RECORD_METHOD(lldb::SBData, SBThread, GetFramePointerBacktrace,
+                     (uint32_t, lldb::SBError &), max_frames, error);
+
+  SBData sb_data;
+  std::unique_lock<std::recursive_mutex> lock;
+  ExecutionContext exe_ctx(m_opaque_sp.get(), lock);
+
+  if (!exe_ctx.HasThreadScope()) {
+    error.SetErrorString("invalid thread");
+    return LLDB_RECORD_RESULT(sb_data);
+  }
+
+  Process::StopLocker stop_locker;
+  if (!stop_locker.TryLock(&exe_ctx.GetProcessPtr()->GetRunLock())) {
+    error.SetErrorString("process is running");
+    return LLDB_RECORD_RESULT(sb_data);
+  }
+
+  llvm::Expected<std::vector<addr_t>> pcs =
+      UnwindFramePointer::GetBacktrace(*exe_ctx.GetThreadPtr(), max_frames);
+  if (!pcs) {
+    error.SetErrorString(llvm::toString(pcs.takeError()).c_str());
+    return LLDB_RECORD_RESULT(sb_data);
+  }
+
+  error.Clear();
+  std::vector<uint64_t> values(pcs->begin(), pcs->end());
+  sb_data = SBData::CreateDataFromUInt64Array(
+      endian::InlHostByteOrder(), sizeof(uint64_t), values.data(),
+      values.size());
+  return LLDB_RECORD_RESULT(sb_data);
+}
+
 SBFrame SBThread::GetFrameAtIndex(uint32_t idx) {
   LLDB_RECORD_METHOD(lldb::SBFrame, SBThread, GetFrameAtIndex, (uint32_t), idx);
 
@@ -1422,6 +1460,8 @@ void RegisterMethods<SBThread>(Registry &R) {
   LLDB_REGISTER_METHOD(bool, SBThread, IsStopped, ());
   LLDB_REGISTER_METHOD(lldb::SBProcess, SBThread, GetProcess, ());
   LLDB_REGISTER_METHOD(uint32_t, SBThread, GetNumFrames, ());
+  LLDB_REGISTER_METHOD(lldb::SBData, SBThread, GetFramePointerBacktrace,
+                       (uint32_t, lldb::SBError &));
   LLDB_REGISTER_METHOD(lldb::SBFrame, SBThread, GetFrameAtIndex, (uint32_t));
   LLDB_REGISTER_METHOD(lldb::SBFrame, SBThread, GetSelectedFrame, ());
   LLDB_REGISTER_METHOD(lldb::SBFrame, SBThread, SetSelectedFrame, (uint32_t));
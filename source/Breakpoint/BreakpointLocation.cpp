@@ -8,6 +8,8 @@
 
 #include "lldb/Breakpoint/BreakpointLocation.h"
 #include "lldb/Breakpoint/BreakpointID.h"
+#include "lldb/Breakpoint/BreakpointSite.h"
+#include "lldb/Breakpoint/SimpleCondition.h"
 #include "lldb/Breakpoint/StoppointCallbackContext.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
@@ -18,7 +20,9 @@
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/TypeSystem.h"
+#include "lldb/Target/Language.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadSpec.h"
@@ -34,7 +38,11 @@ BreakpointLocation::BreakpointLocation(break_id_t loc_id, Breakpoint &owner,
     : m_being_created(true), m_should_resolve_indirect_functions(false),
       m_is_reexported(false), m_is_indirect(false), m_address(addr),
       m_owner(owner), m_options_up(), m_bp_site_sp(), m_condition_mutex(),
-      m_condition_hash(0), m_loc_id(loc_id), m_hit_counter() {
+      m_condition_hash(0), m_simple_condition_hash(0),
+      m_agent_condition_mutex(), m_agent_condition(),
+      m_agent_condition_hash(0),
+      m_agent_condition_site_id(LLDB_INVALID_BREAK_ID), m_loc_id(loc_id),
+      m_hit_counter() {
   if (check_for_resolver) {
     Symbol *symbol = m_address.CalculateSymbolContextSymbol();
     if (symbol && symbol->IsIndirect()) {
@@ -236,22 +244,54 @@ bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
 
   if (!condition_text) {
     m_user_expression_sp.reset();
+    m_simple_condition_up.reset();
     return false;
   }
 
   error.Clear();
 
+  LanguageType language = eLanguageTypeUnknown;
+  // See if we can figure out the language from the frame, otherwise use the
+  // default language:
+  CompileUnit *comp_unit = m_address.CalculateSymbolContextCompileUnit();
+  if (comp_unit)
+    language = comp_unit->GetLanguage();
+
+  // Conditions that only compare variables with constants are evaluated with
+  // the values of the variables, without compiling and running them in the
+  // process. The member accesses of other languages, like Objective-C
+  // properties, may call code, so this is restricted to C and C++.
+  if (condition_hash != m_simple_condition_hash) {
+    m_simple_condition_hash = condition_hash;
+    m_simple_condition_up.reset();
+    if (Language::LanguageIsC(language) ||
+        Language::LanguageIsCPlusPlus(language))
+      m_simple_condition_up = SimpleCondition::Parse(condition_text);
+  }
+  if (m_simple_condition_up) {
+    llvm::Optional<bool> result;
+    StackFrame *frame = exe_ctx.GetFramePtr();
+    if (frame)
+      result = m_simple_condition_up->Evaluate(*frame);
+    if (result) {
+      LLDB_LOGF(log,
+                "Condition evaluated without the expression parser, result "
+                "is %s.",
+                *result ? "true" : "false");
+      UpdateAgentCondition(*frame, condition_hash);
+      return *result;
+    }
+    // The condition uses something that isn't a variable with a scalar
+    // value, e.g. an enumerator or a class with overloaded operators, which
+    // only the expression parser can evaluate.
+    LLDB_LOGF(log, "Condition needs the expression parser.");
+    m_simple_condition_up.reset();
+  }
+
   DiagnosticManager diagnostics;
 
   if (condition_hash != m_condition_hash || !m_user_expression_sp ||
       !m_user_expression_sp->MatchesContext(exe_ctx)) {
-    LanguageType language = eLanguageTypeUnknown;
-    // See if we can figure out the language from the frame, otherwise use the
-    // default language:
-    CompileUnit *comp_unit = m_address.CalculateSymbolContextCompileUnit();
-    if (comp_unit)
-      language = comp_unit->GetLanguage();
-
     m_user_expression_sp.reset(GetTarget().GetUserExpressionForLanguage(
         condition_text, llvm::StringRef(), language, Expression::eResultTypeAny,
         EvaluateExpressionOptions(), nullptr, error));
@@ -331,6 +371,71 @@ bool BreakpointLocation::ConditionSaysStop(ExecutionContext &exe_ctx,
   return ret;
 }
 
+std::vector<uint8_t> BreakpointLocation::GetCurrentAgentCondition() {
+  size_t condition_hash;
+  if (!GetConditionText(&condition_hash) || !m_bp_site_sp)
+    return {};
+  std::lock_guard<std::mutex> guard(m_agent_condition_mutex);
+  if (condition_hash != m_agent_condition_hash ||
+      m_bp_site_sp->GetID() != m_agent_condition_site_id)
+    return {};
+  return m_agent_condition;
+}
+
+void BreakpointLocation::UpdateAgentCondition(StackFrame &frame,
+                                              size_t condition_hash) {
+  BreakpointSiteSP bp_site_sp = m_bp_site_sp;
+  if (!bp_site_sp)
+    return;
+  {
+    // Conditions that can't be compiled are only tried once.
+    std::lock_guard<std::mutex> guard(m_agent_condition_mutex);
+    if (condition_hash == m_agent_condition_hash &&
+        bp_site_sp->GetID() == m_agent_condition_site_id)
+      return;
+    m_agent_condition_hash = condition_hash;
+    m_agent_condition_site_id = bp_site_sp->GetID();
+    m_agent_condition.clear();
+  }
+
+  ProcessSP process_sp = frame.CalculateProcess();
+  if (!process_sp || !process_sp->SupportsBreakpointSiteConditions())
+    return;
+
+  Log *log = lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_BREAKPOINTS);
+  llvm::Expected<std::vector<uint8_t>> bytecode =
+      m_simple_condition_up->CompileAgentExpression(frame);
+  if (!bytecode) {
+    LLDB_LOG_ERROR(log, bytecode.takeError(),
+                   "Condition can't be evaluated by the process plugin: {0}");
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> guard(m_agent_condition_mutex);
+    m_agent_condition = *bytecode;
+  }
+
+  // The site stops when one of its conditions is true, so it can only have
+  // conditions if all the locations that own it have one.
+  std::vector<std::vector<uint8_t>> conditions;
+  const size_t num_owners = bp_site_sp->GetNumberOfOwners();
+  for (size_t i = 0; i < num_owners; ++i) {
+    BreakpointLocationSP location_sp = bp_site_sp->GetOwnerAtIndex(i);
+    std::vector<uint8_t> condition;
+    if (location_sp)
+      condition = location_sp->GetCurrentAgentCondition();
+    if (condition.empty())
+      return;
+    conditions.push_back(std::move(condition));
+  }
+
+  Status error = process_sp->SetBreakpointSiteConditions(
+      *bp_site_sp, std::move(conditions));
+  LLDB_LOGF(log, "Giving the condition to breakpoint site %d: %s.",
+            bp_site_sp->GetID(),
+            error.Success() ? "success" : error.AsCString());
+}
+
 uint32_t BreakpointLocation::GetIgnoreCount() const {
   return GetOptionsSpecifyingKind(BreakpointOptions::eIgnoreCount)
       ->GetIgnoreCount();
@@ -0,0 +1,987 @@
+//===-- SimpleCondition.cpp -----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Breakpoint/SimpleCondition.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Core/dwarf.h"
+#include "lldb/Expression/DWARFExpression.h"
+#include "lldb/Symbol/FuncUnwinders.h"
+#include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/Type.h"
+#include "lldb/Symbol/UnwindPlan.h"
+#include "lldb/Symbol/UnwindTable.h"
+#include "lldb/Symbol/Variable.h"
+#include "lldb/Symbol/VariableList.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StackFrame.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+#include "lldb/Utility/AgentExpression.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Status.h"
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FormatVariadic.h"
+
+#include <limits>
+
+using namespace lldb;
+using namespace lldb_private;
+
+struct SimpleCondition::Node {
+  enum class Kind { Literal, Path, LogicalNot, Negate, Binary };
+  enum class BinaryOp {
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    LogicalAnd,
+    LogicalOr
+  };
+
+  Kind kind;
+  /// The value of a literal.
+  Scalar value;
+  /// The variable expression path of a path.
+  std::string path;
+  BinaryOp op = BinaryOp::Equal;
+  /// The operand of unary operators and the operands of binary ones.
+  std::unique_ptr<Node> lhs;
+  std::unique_ptr<Node> rhs;
+};
+
+/// A recursive descent parser with the precedence levels of C.
+class SimpleCondition::Parser {
+public:
+  Parser(llvm::StringRef text) : m_text(text) {}
+
+  std::unique_ptr<Node> ParseCondition() {
+    std::unique_ptr<Node> node = ParseLogicalOr();
+    SkipSpaces();
+    if (!m_text.empty())
+      return nullptr;
+    return node;
+  }
+
+private:
+  using BinaryOp = Node::BinaryOp;
+
+  void SkipSpaces() { m_text = m_text.ltrim(); }
+
+  bool Consume(llvm::StringRef token) {
+    SkipSpaces();
+    return m_text.consume_front(token);
+  }
+
+  static std::unique_ptr<Node> MakeBinary(BinaryOp op,
+                                          std::unique_ptr<Node> lhs,
+                                          std::unique_ptr<Node> rhs) {
+    if (!lhs || !rhs)
+      return nullptr;
+    auto node = std::make_unique<Node>();
+    node->kind = Node::Kind::Binary;
+    node->op = op;
+    node->lhs = std::move(lhs);
+    node->rhs = std::move(rhs);
+    return node;
+  }
+
+  static std::unique_ptr<Node> MakeUnary(Node::Kind kind,
+                                         std::unique_ptr<Node> operand) {
+    if (!operand)
+      return nullptr;
+    auto node = std::make_unique<Node>();
+    node->kind = kind;
+    node->lhs = std::move(operand);
+    return node;
+  }
+
+  static std::unique_ptr<Node> MakeLiteral(Scalar value) {
+    auto node = std::make_unique<Node>();
+    node->kind = Node::Kind::Literal;
+    node->value = value;
+    return node;
+  }
+
+  std::unique_ptr<Node> ParseLogicalOr() {
+    std::unique_ptr<Node> node = ParseLogicalAnd();
+    while (node && Consume("||"))
+      node = MakeBinary(BinaryOp::LogicalOr, std::move(node),
+                        ParseLogicalAnd());
+    return node;
+  }
+
+  std::unique_ptr<Node> ParseLogicalAnd() {
+    std::unique_ptr<Node> node = ParseEquality();
+    while (node && Consume("&&"))
+      node = MakeBinary(BinaryOp::LogicalAnd, std::move(node), ParseEquality());
+    return node;
+  }
+
+  std::unique_ptr<Node> ParseEquality() {
+    std::unique_ptr<Node> node = ParseRelational();
+    while (node) {
+      if (Consume("=="))
+        node = MakeBinary(BinaryOp::Equal, std::move(node), ParseRelational());
+      else if (Consume("!="))
+        node =
+            MakeBinary(BinaryOp::NotEqual, std::move(node), ParseRelational());
+      else
+        break;
+    }
+    return node;
+  }
+
+  std::unique_ptr<Node> ParseRelational() {
+    std::unique_ptr<Node> node = ParseUnary();
+    while (node) {
+      BinaryOp op;
+      // Shifts are not supported, and the unary operand following the first
+      // '<' of "<<" fails to parse.
+      if (Consume("<="))
+        op = BinaryOp::LessEqual;
+      else if (Consume(">="))
+        op = BinaryOp::GreaterEqual;
+      else if (Consume("<"))
+        op = BinaryOp::Less;
+      else if (Consume(">"))
+        op = BinaryOp::Greater;
+      else
+        break;
+      node = MakeBinary(op, std::move(node), ParseUnary());
+    }
+    return node;
+  }
+
+  std::unique_ptr<Node> ParseUnary() {
+    // Decrements have side effects.
+    SkipSpaces();
+    if (m_text.startswith("--"))
+      return nullptr;
+    if (Consume("!"))
+      return MakeUnary(Node::Kind::LogicalNot, ParseUnary());
+    if (Consume("-"))
+      return MakeUnary(Node::Kind::Negate, ParseUnary());
+    if (Consume("(")) {
+      std::unique_ptr<Node> node = ParseLogicalOr();
+      if (!Consume(")"))
+        return nullptr;
+      return node;
+    }
+    return ParsePrimary();
+  }
+
+  std::unique_ptr<Node> ParsePrimary() {
+    SkipSpaces();
+    if (m_text.empty())
+      return nullptr;
+    if (llvm::isDigit(m_text.front()) ||
+        (m_text.size() > 1 && m_text[0] == '.' && llvm::isDigit(m_text[1])))
+      return ParseNumber();
+
+    std::string path;
+    if (Consume("*"))
+      path = "*";
+    llvm::StringRef identifier = ParseIdentifier();
+    if (identifier.empty())
+      return nullptr;
+    if (path.empty()) {
+      if (identifier == "true")
+        return MakeLiteral(Scalar(1));
+      if (identifier == "false" || identifier == "nullptr" ||
+          identifier == "NULL")
+        return MakeLiteral(Scalar(0));
+    }
+    path += identifier.str();
+
+    while (true) {
+      if (Consume("->")) {
+        path += "->";
+      } else if (Consume(".")) {
+        path += '.';
+      } else if (Consume("[")) {
+        // Only constant indexes are supported, as variable expression paths
+        // can't contain other variables.
+        SkipSpaces();
+        llvm::StringRef digits =
+            m_text.take_while([](char c) { return llvm::isDigit(c); });
+        m_text = m_text.drop_front(digits.size());
+        if (digits.empty() || !Consume("]"))
+          return nullptr;
+        path += ("[" + digits + "]").str();
+        continue;
+      } else {
+        break;
+      }
+      llvm::StringRef member = ParseIdentifier();
+      if (member.empty())
+        return nullptr;
+      path += member.str();
+    }
+
+    // Function calls and scoped names are left to the expression parser.
+    SkipSpaces();
+    if (m_text.startswith("(") || m_text.startswith("::"))
+      return nullptr;
+
+    auto node = std::make_unique<Node>();
+    node->kind = Node::Kind::Path;
+    node->path = std::move(path);
+    return node;
+  }
+
+  llvm::StringRef ParseIdentifier() {
+    SkipSpaces();
+    if (m_text.empty() ||
+        !(llvm::isAlpha(m_text.front()) || m_text.front() == '_'))
+      return llvm::StringRef();
+    llvm::StringRef identifier = m_text.take_while(
+        [](char c) { return llvm::isAlnum(c) || c == '_'; });
+    m_text = m_text.drop_front(identifier.size());
+    return identifier;
+  }
+
+  /// Parse an integer literal with the type C would give it, or a floating
+  /// point literal without an exponent sign.
+  std::unique_ptr<Node> ParseNumber() {
+    llvm::StringRef number = m_text.take_while(
+        [](char c) { return llvm::isAlnum(c) || c == '.'; });
+    m_text = m_text.drop_front(number.size());
+
+    const bool is_hex = number.startswith("0x") || number.startswith("0X");
+    if (number.contains('.') ||
+        (!is_hex && number.find_first_of("eE") != llvm::StringRef::npos)) {
+      double value;
+      if (number.endswith("f") || number.endswith("F"))
+        number = number.drop_back();
+      if (number.getAsDouble(value))
+        return nullptr;
+      return MakeLiteral(Scalar(value));
+    }
+
+    llvm::StringRef suffix = number.take_back(
+        number.size() - number.rtrim("uUlL").size());
+    number = number.drop_back(suffix.size());
+    const bool is_unsigned =
+        suffix.find_first_of("uU") != llvm::StringRef::npos;
+    const bool is_long = suffix.find_first_of("lL") != llvm::StringRef::npos;
+    uint64_t value;
+    if (number.getAsInteger(0, value))
+      return nullptr;
+
+    if (is_unsigned) {
+      if (!is_long && value <= std::numeric_limits<unsigned>::max())
+        return MakeLiteral(Scalar(static_cast<unsigned>(value)));
+      return MakeLiteral(Scalar(static_cast<unsigned long long>(value)));
+    }
+    if (!is_long && value <= std::numeric_limits<int>::max())
+      return MakeLiteral(Scalar(static_cast<int>(value)));
+    if (value <= std::numeric_limits<long long>::max())
+      return MakeLiteral(Scalar(static_cast<long long>(value)));
+    return MakeLiteral(Scalar(static_cast<unsigned long long>(value)));
+  }
+
+  llvm::StringRef m_text;
+};
+
+SimpleCondition::SimpleCondition(std::unique_ptr<Node> root)
+    : m_root(std::move(root)) {}
+
+SimpleCondition::~SimpleCondition() = default;
+
+std::unique_ptr<SimpleCondition> SimpleCondition::Parse(llvm::StringRef text) {
+  std::unique_ptr<Node> root = Parser(text).ParseCondition();
+  if (!root)
+    return nullptr;
+  return std::unique_ptr<SimpleCondition>(new SimpleCondition(std::move(root)));
+}
+
+llvm::Optional<Scalar> SimpleCondition::EvaluateNode(const Node &node,
+                                                     PathResolver resolver) {
+  switch (node.kind) {
+  case Node::Kind::Literal:
+    return node.value;
+  case Node::Kind::Path:
+    return resolver(node.path);
+  case Node::Kind::LogicalNot: {
+    llvm::Optional<Scalar> operand = EvaluateNode(*node.lhs, resolver);
+    if (!operand)
+      return llvm::None;
+    return Scalar(operand->IsZero() ? 1 : 0);
+  }
+  case Node::Kind::Negate: {
+    llvm::Optional<Scalar> operand = EvaluateNode(*node.lhs, resolver);
+    if (!operand || !operand->UnaryNegate())
+      return llvm::None;
+    return operand;
+  }
+  case Node::Kind::Binary:
+    break;
+  }
+
+  llvm::Optional<Scalar> lhs = EvaluateNode(*node.lhs, resolver);
+  if (!lhs)
+    return llvm::None;
+  if (node.op == Node::BinaryOp::LogicalAnd && lhs->IsZero())
+    return Scalar(0);
+  if (node.op == Node::BinaryOp::LogicalOr && !lhs->IsZero())
+    return Scalar(1);
+  llvm::Optional<Scalar> rhs = EvaluateNode(*node.rhs, resolver);
+  if (!rhs)
+    return llvm::None;
+
+  bool result = false;
+  switch (node.op) {
+  case Node::BinaryOp::Equal:
+    result = *lhs == *rhs;
+    break;
+  case Node::BinaryOp::NotEqual:
+    result = *lhs != *rhs;
+    break;
+  case Node::BinaryOp::Less:
+    result = *lhs < *rhs;
+    break;
+  case Node::BinaryOp::LessEqual:
+    result = *lhs <= *rhs;
+    break;
+  case Node::BinaryOp::Greater:
+    result = *lhs > *rhs;
+    break;
+  case Node::BinaryOp::GreaterEqual:
+    result = *lhs >= *rhs;
+    break;
+  case Node::BinaryOp::LogicalAnd:
+  case Node::BinaryOp::LogicalOr:
+    result = !rhs->IsZero();
+    break;
+  }
+  return Scalar(result ? 1 : 0);
+}
+
+llvm::Optional<bool> SimpleCondition::Evaluate(PathResolver resolver) const {
+  llvm::Optional<Scalar> result = EvaluateNode(*m_root, resolver);
+  if (!result)
+    return llvm::None;
+  return !result->IsZero();
+}
+
+llvm::Optional<bool> SimpleCondition::Evaluate(StackFrame &frame) const {
+  // Synthetic children don't have the semantics of the operators in the
+  // source language, e.g. indexing a std::vector calls its operator[].
+  const uint32_t options =
+      StackFrame::eExpressionPathOptionCheckPtrVsMember |
+      StackFrame::eExpressionPathOptionsNoSyntheticChildren |
+      StackFrame::eExpressionPathOptionsAllowDirectIVarAccess;
+  return Evaluate([&](llvm::StringRef path) -> llvm::Optional<Scalar> {
+    VariableSP var_sp;
+    Status error;
+    ValueObjectSP valobj_sp = frame.GetValueForVariableExpressionPath(
+        path, eNoDynamicValues, options, var_sp, error);
+    if (!valobj_sp || error.Fail())
+      return llvm::None;
+    // The value of a reference is the address of what it refers to.
+    const uint32_t type_info = valobj_sp->GetTypeInfo();
+    if (!(type_info & (eTypeIsScalar | eTypeIsPointer | eTypeIsEnumeration)) ||
+        (type_info & (eTypeIsReference | eTypeIsComplex | eTypeIsVector)))
+      return llvm::None;
+    Scalar value;
+    if (!valobj_sp->ResolveValue(value) || !value.IsValid())
+      return llvm::None;
+    return value;
+  });
+}
+
+/// Compiles a condition to an agent expression that computes the same value
+/// as SimpleCondition::Evaluate at the pc of a frame zero.
+///
+/// The value of each subexpression is kept on the stack extended to 64 bits
+/// according to its signedness, and the operands of comparisons are
+/// converted to their common type like Scalar does before comparing them.
+class SimpleCondition::AgentCompiler {
+public:
+  AgentCompiler(StackFrame &frame)
+      : m_frame(frame), m_target_sp(frame.CalculateTarget()) {}
+
+  llvm::Expected<std::vector<uint8_t>> Compile(const Node &root) {
+    if (!m_target_sp || m_frame.GetFrameIndex() != 0)
+      return MakeError("conditions can only be compiled for a frame zero");
+    m_pc = m_frame.GetFrameCodeAddress().GetLoadAddress(m_target_sp.get());
+    llvm::Expected<Operand> result = CompileNode(root);
+    if (!result)
+      return result.takeError();
+    // Jump targets are 16 bits.
+    if (m_expr.GetBytecode().size() >= UINT16_MAX)
+      return MakeError("the condition is too large");
+    return m_expr.Finish();
+  }
+
+private:
+  /// The integer type of the value on top of the stack.
+  struct Operand {
+    uint32_t bits;
+    bool is_signed;
+  };
+
+  /// Where the value of a variable expression path is while compiling it.
+  struct Location {
+    CompilerType type;
+    /// Whether the stack holds the value itself, e.g. read from a register,
+    /// instead of its address.
+    bool is_value = false;
+    /// The offset to add to the address on the stack.
+    int64_t offset = 0;
+  };
+
+  /// A DWARF location made of a single operation.
+  struct DWARFLocation {
+    enum class Kind {
+      Register,
+      RegisterOffset,
+      FrameBaseOffset,
+      FileAddress,
+      CallFrameCFA
+    };
+    Kind kind = Kind::Register;
+    RegisterKind reg_kind = eRegisterKindDWARF;
+    uint32_t reg_num = LLDB_INVALID_REGNUM;
+    int64_t offset = 0;
+    addr_t file_addr = LLDB_INVALID_ADDRESS;
+  };
+
+  static const Operand kBool;
+
+  static llvm::Error MakeError(const llvm::Twine &message) {
+    return llvm::make_error<llvm::StringError>(message,
+                                               llvm::inconvertibleErrorCode());
+  }
+
+  llvm::Expected<Operand> CompileNode(const Node &node) {
+    switch (node.kind) {
+    case Node::Kind::Literal:
+      return CompileLiteral(node.value);
+    case Node::Kind::Path:
+      return CompilePath(node.path);
+    case Node::Kind::LogicalNot: {
+      llvm::Expected<Operand> operand = CompileNode(*node.lhs);
+      if (!operand)
+        return operand.takeError();
+      m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+      return kBool;
+    }
+    case Node::Kind::Negate: {
+      m_expr.AppendConstant(0);
+      llvm::Expected<Operand> operand = CompileNode(*node.lhs);
+      if (!operand)
+        return operand.takeError();
+      m_expr.AppendOpcode(AgentExpression::eOpSub);
+      Extend(*operand);
+      return *operand;
+    }
+    case Node::Kind::Binary:
+      break;
+    }
+
+    if (node.op == Node::BinaryOp::LogicalAnd ||
+        node.op == Node::BinaryOp::LogicalOr)
+      return CompileLogical(node);
+
+    llvm::Expected<Operand> lhs = CompileNode(*node.lhs);
+    if (!lhs)
+      return lhs.takeError();
+    llvm::Expected<Operand> rhs = CompileNode(*node.rhs);
+    if (!rhs)
+      return rhs.takeError();
+
+    // The wider type wins, and the unsigned one if they have the same width.
+    Operand common = lhs->bits == rhs->bits
+                         ? Operand{lhs->bits, lhs->is_signed && rhs->is_signed}
+                         : (lhs->bits > rhs->bits ? *lhs : *rhs);
+    if (NeedsConversion(*rhs, common))
+      Extend(common);
+    if (NeedsConversion(*lhs, common)) {
+      m_expr.AppendOpcode(AgentExpression::eOpSwap);
+      Extend(common);
+      m_expr.AppendOpcode(AgentExpression::eOpSwap);
+    }
+
+    const AgentExpression::Opcode less = common.is_signed
+                                             ? AgentExpression::eOpLessSigned
+                                             : AgentExpression::eOpLessUnsigned;
+    switch (node.op) {
+    case Node::BinaryOp::Equal:
+      m_expr.AppendOpcode(AgentExpression::eOpEqual);
+      break;
+    case Node::BinaryOp::NotEqual:
+      m_expr.AppendOpcode(AgentExpression::eOpEqual);
+      m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+      break;
+    case Node::BinaryOp::Less:
+      m_expr.AppendOpcode(less);
+      break;
+    case Node::BinaryOp::LessEqual:
+      m_expr.AppendOpcode(AgentExpression::eOpSwap);
+      m_expr.AppendOpcode(less);
+      m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+      break;
+    case Node::BinaryOp::Greater:
+      m_expr.AppendOpcode(AgentExpression::eOpSwap);
+      m_expr.AppendOpcode(less);
+      break;
+    case Node::BinaryOp::GreaterEqual:
+      m_expr.AppendOpcode(less);
+      m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+      break;
+    case Node::BinaryOp::LogicalAnd:
+    case Node::BinaryOp::LogicalOr:
+      llvm_unreachable("logical operators are compiled above");
+    }
+    return kBool;
+  }
+
+  /// Compile && and || with jumps, as their rhs is only evaluated when the
+  /// lhs doesn't decide the result.
+  llvm::Expected<Operand> CompileLogical(const Node &node) {
+    const bool is_and = node.op == Node::BinaryOp::LogicalAnd;
+    llvm::Expected<Operand> lhs = CompileNode(*node.lhs);
+    if (!lhs)
+      return lhs.takeError();
+    if (is_and)
+      m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    const size_t short_circuit = m_expr.AppendJump(AgentExpression::eOpIfGoto);
+    llvm::Expected<Operand> rhs = CompileNode(*node.rhs);
+    if (!rhs)
+      return rhs.takeError();
+    m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    m_expr.AppendOpcode(AgentExpression::eOpLogNot);
+    const size_t end = m_expr.AppendJump(AgentExpression::eOpGoto);
+    if (llvm::Error error = SetJumpTarget(short_circuit))
+      return std::move(error);
+    m_expr.AppendConstant(is_and ? 0 : 1);
+    if (llvm::Error error = SetJumpTarget(end))
+      return std::move(error);
+    return kBool;
+  }
+
+  /// Make the jump at \a label go to the end of the bytecode, unless the
+  /// bytecode is already too large for the 16 bit jump targets.
+  llvm::Error SetJumpTarget(size_t label) {
+    if (m_expr.GetBytecode().size() >= UINT16_MAX)
+      return MakeError("the condition is too large");
+    m_expr.SetJumpTarget(label);
+    return llvm::Error::success();
+  }
+
+  llvm::Expected<Operand> CompileLiteral(const Scalar &value) {
+    if (value.GetType() != Scalar::e_int)
+      return MakeError("floating point literals are not supported");
+    const bool is_signed = value.IsSigned();
+    m_expr.AppendConstant(is_signed ? static_cast<uint64_t>(value.SLongLong())
+                                    : value.ULongLong());
+    return Operand{static_cast<uint32_t>(value.GetByteSize() * 8), is_signed};
+  }
+
+  llvm::Expected<Operand> CompilePath(llvm::StringRef path) {
+    auto is_identifier_char = [](char c) {
+      return llvm::isAlnum(c) || c == '_';
+    };
+    const bool dereference = path.consume_front("*");
+    llvm::StringRef name = path.take_while(is_identifier_char);
+    path = path.drop_front(name.size());
+
+    VariableListSP variables_sp = m_frame.GetInScopeVariableList(true);
+    VariableSP var_sp =
+        variables_sp ? variables_sp->FindVariable(ConstString(name), false)
+                     : VariableSP();
+    if (!var_sp)
+      return MakeError("no variable named '" + name + "' is in scope");
+
+    Location location;
+    if (llvm::Error error = PushVariable(*var_sp, location))
+      return std::move(error);
+
+    while (!path.empty()) {
+      if (path.consume_front("[")) {
+        llvm::StringRef digits =
+            path.take_while([](char c) { return llvm::isDigit(c); });
+        path = path.drop_front(digits.size()).drop_front(); // ']'
+        uint64_t index;
+        if (digits.getAsInteger(10, index))
+          return MakeError("invalid index in '" + path + "'");
+        if (llvm::Error error = Index(location, index))
+          return std::move(error);
+        continue;
+      }
+      if (path.consume_front("->")) {
+        if (llvm::Error error = Dereference(location))
+          return std::move(error);
+      } else if (!path.consume_front(".")) {
+        return MakeError("unexpected '" + path + "'");
+      }
+      llvm::StringRef member = path.take_while(is_identifier_char);
+      path = path.drop_front(member.size());
+      if (llvm::Error error = AccessMember(location, member))
+        return std::move(error);
+    }
+
+    if (dereference)
+      if (llvm::Error error = Dereference(location))
+        return std::move(error);
+    return Load(location);
+  }
+
+  /// Push the address or the value of \a var at the pc.
+  llvm::Error PushVariable(Variable &var, Location &location) {
+    Type *type = var.GetType();
+    if (type)
+      location.type = type->GetFullCompilerType();
+    if (!location.type.IsValid())
+      return MakeError("variable '" + var.GetName().GetStringRef() +
+                       "' has no type");
+    if (var.GetLocationIsConstantValueData())
+      return MakeError("variable '" + var.GetName().GetStringRef() +
+                       "' is a constant");
+
+    llvm::Expected<DWARFLocation> dwarf_location =
+        ParseLocation(var.LocationExpression());
+    if (!dwarf_location)
+      return dwarf_location.takeError();
+    switch (dwarf_location->kind) {
+    case DWARFLocation::Kind::Register:
+      location.is_value = true;
+      return PushRegister(dwarf_location->reg_kind, dwarf_location->reg_num);
+    case DWARFLocation::Kind::RegisterOffset:
+      location.offset = dwarf_location->offset;
+      return PushRegister(dwarf_location->reg_kind, dwarf_location->reg_num);
+    case DWARFLocation::Kind::FrameBaseOffset:
+      location.offset = dwarf_location->offset;
+      return PushFrameBase();
+    case DWARFLocation::Kind::FileAddress: {
+      SymbolContext sc;
+      var.CalculateSymbolContext(&sc);
+      Address address;
+      if (!sc.module_sp ||
+          !sc.module_sp->ResolveFileAddress(dwarf_location->file_addr,
+                                            address))
+        return MakeError("can't resolve the address of variable '" +
+                         var.GetName().GetStringRef() + "'");
+      const addr_t load_addr = address.GetLoadAddress(m_target_sp.get());
+      if (load_addr == LLDB_INVALID_ADDRESS)
+        return MakeError("variable '" + var.GetName().GetStringRef() +
+                         "' isn't loaded");
+      m_expr.AppendConstant(load_addr);
+      return llvm::Error::success();
+    }
+    case DWARFLocation::Kind::CallFrameCFA:
+      break;
+    }
+    return MakeError("unsupported location of variable '" +
+                     var.GetName().GetStringRef() + "'");
+  }
+
+  /// Push the frame base of the function, i.e. the value of DW_OP_fbreg.
+  llvm::Error PushFrameBase() {
+    Status error;
+    DWARFExpression *frame_base = m_frame.GetFrameBaseExpression(&error);
+    if (!frame_base)
+      return error.ToError();
+    llvm::Expected<DWARFLocation> dwarf_location = ParseLocation(*frame_base);
+    if (!dwarf_location)
+      return dwarf_location.takeError();
+    switch (dwarf_location->kind) {
+    case DWARFLocation::Kind::Register:
+    case DWARFLocation::Kind::RegisterOffset:
+      if (llvm::Error error = PushRegister(dwarf_location->reg_kind,
+                                           dwarf_location->reg_num))
+        return error;
+      AppendOffset(dwarf_location->offset);
+      return llvm::Error::success();
+    case DWARFLocation::Kind::CallFrameCFA:
+      return PushCallFrameCFA();
+    case DWARFLocation::Kind::FrameBaseOffset:
+    case DWARFLocation::Kind::FileAddress:
+      break;
+    }
+    return MakeError("unsupported frame base");
+  }
+
+  /// Push the canonical frame address, which the unwind plan of the pc
+  /// computes from a register.
+  llvm::Error PushCallFrameCFA() {
+    SymbolContext sc = m_frame.GetSymbolContext(
+        eSymbolContextModule | eSymbolContextFunction | eSymbolContextSymbol);
+    ThreadSP thread_sp = m_frame.GetThread();
+    const Address &pc_addr = m_frame.GetFrameCodeAddress();
+    Address func_start;
+    if (sc.function)
+      func_start = sc.function->GetAddressRange().GetBaseAddress();
+    else if (sc.symbol)
+      func_start = sc.symbol->GetAddress();
+    if (!sc.module_sp || !thread_sp || !func_start.IsValid())
+      return MakeError("no function contains the pc");
+
+    FuncUnwindersSP unwinders_sp =
+        sc.module_sp->GetUnwindTable().GetFuncUnwindersContainingAddress(
+            pc_addr, sc);
+    UnwindPlanSP plan_sp =
+        unwinders_sp
+            ? unwinders_sp->GetUnwindPlanAtNonCallSite(*m_target_sp, *thread_sp)
+            : UnwindPlanSP();
+    UnwindPlan::RowSP row_sp =
+        plan_sp ? plan_sp->GetRowForFunctionOffset(pc_addr.GetFileAddress() -
+                                                   func_start.GetFileAddress())
+                : UnwindPlan::RowSP();
+    if (!row_sp || row_sp->GetCFAValue().GetValueType() !=
+                       UnwindPlan::Row::FAValue::isRegisterPlusOffset)
+      return MakeError("the canonical frame address isn't a register plus "
+                       "an offset");
+    const UnwindPlan::Row::FAValue &cfa = row_sp->GetCFAValue();
+    if (llvm::Error error =
+            PushRegister(plan_sp->GetRegisterKind(), cfa.GetRegisterNumber()))
+      return error;
+    AppendOffset(cfa.GetOffset());
+    return llvm::Error::success();
+  }
+
+  /// Parse a location that is a single operation, selecting the entry of
+  /// the pc in location lists.
+  llvm::Expected<DWARFLocation> ParseLocation(DWARFExpression &expr) {
+    DataExtractor data;
+    if (expr.IsLocationList()) {
+      SymbolContext sc = m_frame.GetSymbolContext(eSymbolContextFunction);
+      if (!sc.function)
+        return MakeError("location lists need a function");
+      const addr_t func_load_addr =
+          sc.function->GetAddressRange().GetBaseAddress().GetLoadAddress(
+              m_target_sp.get());
+      llvm::Optional<DataExtractor> entry =
+          expr.GetLocationExpression(func_load_addr, m_pc);
+      if (!entry)
+        return MakeError("the variable isn't available at the pc");
+      data = *entry;
+    } else if (!expr.GetExpressionData(data)) {
+      return MakeError("the variable has no location");
+    }
+
+    DWARFLocation location;
+    location.reg_kind = static_cast<RegisterKind>(expr.GetRegisterKind());
+    lldb::offset_t offset = 0;
+    const uint8_t op = data.GetU8(&offset);
+    if (op >= DW_OP_reg0 && op <= DW_OP_reg31) {
+      location.kind = DWARFLocation::Kind::Register;
+      location.reg_num = op - DW_OP_reg0;
+    } else if (op >= DW_OP_breg0 && op <= DW_OP_breg31) {
+      location.kind = DWARFLocation::Kind::RegisterOffset;
+      location.reg_num = op - DW_OP_breg0;
+      location.offset = data.GetSLEB128(&offset);
+    } else {
+      switch (op) {
+      case DW_OP_regx:
+        location.kind = DWARFLocation::Kind::Register;
+        location.reg_num = data.GetULEB128(&offset);
+        break;
+      case DW_OP_bregx:
+        location.kind = DWARFLocation::Kind::RegisterOffset;
+        location.reg_num = data.GetULEB128(&offset);
+        location.offset = data.GetSLEB128(&offset);
+        break;
+      case DW_OP_fbreg:
+        location.kind = DWARFLocation::Kind::FrameBaseOffset;
+        location.offset = data.GetSLEB128(&offset);
+        break;
+      case DW_OP_addr:
+        location.kind = DWARFLocation::Kind::FileAddress;
+        location.file_addr = data.GetAddress(&offset);
+        break;
+      case DW_OP_call_frame_cfa:
+        location.kind = DWARFLocation::Kind::CallFrameCFA;
+        break;
+      default:
+        return MakeError(
+            llvm::formatv("unsupported location operation {0:x}", op).str());
+      }
+    }
+    if (offset != data.GetByteSize())
+      return MakeError("locations with more than one operation are not "
+                       "supported");
+    return location;
+  }
+
+  /// Push a register, converting its number to the numbering of the stub.
+  llvm::Error PushRegister(RegisterKind kind, uint32_t reg_num) {
+    RegisterContextSP reg_ctx_sp = m_frame.GetRegisterContext();
+    if (!reg_ctx_sp)
+      return MakeError("the frame has no registers");
+    const uint32_t lldb_reg_num =
+        reg_ctx_sp->ConvertRegisterKindToRegisterNumber(kind, reg_num);
+    const RegisterInfo *reg_info =
+        lldb_reg_num == LLDB_INVALID_REGNUM
+            ? nullptr
+            : reg_ctx_sp->GetRegisterInfoAtIndex(lldb_reg_num);
+    if (!reg_info)
+      return MakeError(llvm::formatv("unknown register {0}", reg_num).str());
+    const uint32_t remote_reg_num = reg_info->kinds[eRegisterKindProcessPlugin];
+    if (remote_reg_num == LLDB_INVALID_REGNUM || remote_reg_num > UINT16_MAX)
+      return MakeError(
+          llvm::formatv("register {0} has no number in the stub",
+                        reg_info->name)
+              .str());
+    m_expr.AppendRegister(remote_reg_num);
+    return llvm::Error::success();
+  }
+
+  void AppendOffset(int64_t offset) {
+    if (offset == 0)
+      return;
+    if (offset > 0) {
+      m_expr.AppendConstant(offset);
+      m_expr.AppendOpcode(AgentExpression::eOpAdd);
+    } else {
+      m_expr.AppendConstant(-static_cast<uint64_t>(offset));
+      m_expr.AppendOpcode(AgentExpression::eOpSub);
+    }
+  }
+
+  /// Make the stack hold the address of \a location.
+  llvm::Error RequireAddress(Location &location) {
+    if (location.is_value)
+      return MakeError("the variable is in a register, not in memory");
+    AppendOffset(location.offset);
+    location.offset = 0;
+    return llvm::Error::success();
+  }
+
+  llvm::Expected<uint32_t> GetByteSize(const CompilerType &type) {
+    llvm::Optional<uint64_t> byte_size = type.GetByteSize(&m_frame);
+    if (!byte_size)
+      return MakeError("the type " + type.GetTypeName().GetStringRef() +
+                       " has no size");
+    return static_cast<uint32_t>(*byte_size);
+  }
+
+  /// Replace the pointer in \a location with what it points to.
+  llvm::Error Dereference(Location &location) {
+    CompilerType pointee_type;
+    if (!location.type.IsPointerType(&pointee_type))
+      return MakeError("the type " +
+                       location.type.GetTypeName().GetStringRef() +
+                       " is not a pointer");
+    llvm::Expected<Operand> pointer = Load(location);
+    if (!pointer)
+      return pointer.takeError();
+    location.type = pointee_type;
+    location.is_value = false;
+    location.offset = 0;
+    return llvm::Error::success();
+  }
+
+  llvm::Error Index(Location &location, uint64_t index) {
+    CompilerType element_type;
+    if (!location.type.IsArrayType(&element_type, nullptr, nullptr)) {
+      if (llvm::Error error = Dereference(location))
+        return error;
+      element_type = location.type;
+    } else if (location.is_value) {
+      return MakeError("the array is in a register, not in memory");
+    }
+    llvm::Expected<uint32_t> element_size = GetByteSize(element_type);
+    if (!element_size)
+      return element_size.takeError();
+    location.type = element_type;
+    location.offset += index * *element_size;
+    return llvm::Error::success();
+  }
+
+  llvm::Error AccessMember(Location &location, llvm::StringRef name) {
+    if (location.is_value)
+      return MakeError("the variable is in a register, not in memory");
+    const uint32_t num_fields = location.type.GetNumFields();
+    for (uint32_t idx = 0; idx < num_fields; ++idx) {
+      std::string field_name;
+      uint64_t bit_offset = 0;
+      uint32_t bitfield_bit_size = 0;
+      bool is_bitfield = false;
+      CompilerType field_type = location.type.GetFieldAtIndex(
+          idx, field_name, &bit_offset, &bitfield_bit_size, &is_bitfield);
+      if (field_name != name)
+        continue;
+      if (is_bitfield || bit_offset % 8)
+        return MakeError("bitfields are not supported");
+      location.type = field_type;
+      location.offset += bit_offset / 8;
+      return llvm::Error::success();
+    }
+    return MakeError("no member named '" + name + "' in " +
+                     location.type.GetTypeName().GetStringRef());
+  }
+
+  /// Replace the address on the stack with the value of \a location, which
+  /// must be an integer, an enumeration or a pointer.
+  llvm::Expected<Operand> Load(Location &location) {
+    const CompilerType type = location.type.GetCanonicalType();
+    bool is_signed = false;
+    if (type.IsPointerType())
+      is_signed = false;
+    else if (!type.IsIntegerOrEnumerationType(is_signed))
+      return MakeError("the type " + type.GetTypeName().GetStringRef() +
+                       " is not an integer, an enumeration or a pointer");
+    llvm::Expected<uint32_t> byte_size = GetByteSize(type);
+    if (!byte_size)
+      return byte_size.takeError();
+    if (*byte_size != 1 && *byte_size != 2 && *byte_size != 4 &&
+        *byte_size != 8)
+      return MakeError(
+          llvm::formatv("unsupported size {0}", *byte_size).str());
+
+    // Registers hold more bits than the value, which need to be truncated,
+    // while references zero extend what they read.
+    const bool in_register = location.is_value;
+    if (!location.is_value) {
+      if (llvm::Error error = RequireAddress(location))
+        return std::move(error);
+      m_expr.AppendReference(*byte_size);
+    }
+    location.is_value = true;
+    const Operand operand{*byte_size * 8, is_signed};
+    if (is_signed || in_register)
+      Extend(operand);
+    return operand;
+  }
+
+  static bool NeedsConversion(Operand from, Operand to) {
+    return to.bits < 64 &&
+           (from.bits != to.bits || from.is_signed != to.is_signed);
+  }
+
+  /// Extend the low bits of the top of the stack to 64 bits, according to
+  /// the signedness of \a operand.
+  void Extend(Operand operand) {
+    if (operand.bits >= 64)
+      return;
+    if (operand.is_signed)
+      m_expr.AppendSignExtend(operand.bits);
+    else
+      m_expr.AppendZeroExtend(operand.bits);
+  }
+
+  StackFrame &m_frame;
+  TargetSP m_target_sp;
+  addr_t m_pc = LLDB_INVALID_ADDRESS;
+  AgentExpression m_expr;
+};
+
+const SimpleCondition::AgentCompiler::Operand
+    SimpleCondition::AgentCompiler::kBool = {32, true};
+
+llvm::Expected<std::vector<uint8_t>>
+SimpleCondition::CompileAgentExpression(StackFrame &frame) const {
+  return AgentCompiler(frame).Compile(*m_root);
+}
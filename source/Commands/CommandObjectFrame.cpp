@@ -487,6 +487,10 @@ protected:
 
     Stream &s = result.GetOutputStream();
 
+    // The values can be large, print them as they are dumped instead of once
+    // they all are.
+    result.StreamOutput();
+
     // Be careful about the stack frame, if any summary formatter runs code, it
     // might clear the StackFrameList for the thread.  So hold onto a shared
     // pointer to the frame so it stays alive.
@@ -526,6 +530,8 @@ protected:
         // If we have any args to the variable command, we will make variable
         // objects from them...
         for (auto &entry : command) {
+          if (m_interpreter.WasInterrupted())
+            break;
           if (m_option_variable.use_regex) {
             const size_t regex_start_index = regex_var_list.GetSize();
             llvm::StringRef name_str = entry.ref();
@@ -627,6 +633,8 @@ protected:
         const size_t num_variables = variable_list->GetSize();
         if (num_variables > 0) {
           for (size_t i = 0; i < num_variables; i++) {
+            if (m_interpreter.WasInterrupted())
+              break;
             var_sp = variable_list->GetVariableAtIndex(i);
             switch (var_sp->GetScope()) {
             case eValueTypeVariableGlobal:
@@ -13,6 +13,8 @@
 #include "lldb/Breakpoint/BreakpointSite.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Core/StreamFile.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Host/OptionParser.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/CommandReturnObject.h"
@@ -20,6 +22,7 @@
 #include "lldb/Interpreter/Options.h"
 #include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
+#include "lldb/Target/SamplingProfiler.h"
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
@@ -1210,6 +1213,151 @@ protected:
   }
 };
 
+// CommandObjectProcessProfile
+#pragma mark CommandObjectProcessProfile
+#define LLDB_OPTIONS_process_profile
+#include "CommandOptions.inc"
+
+class CommandObjectProcessProfile : public CommandObjectParsed {
+public:
+  CommandObjectProcessProfile(CommandInterpreter &interpreter)
+      : CommandObjectParsed(
+            interpreter, "process profile",
+            "Profile the current process by periodically interrupting it and "
+            "collecting the stacks of all its threads.",
+            "process profile [<cmd-options>]",
+            eCommandRequiresProcess | eCommandTryTargetAPILock |
+                eCommandProcessMustBeLaunched | eCommandProcessMustBePaused),
+        m_options() {}
+
+  ~CommandObjectProcessProfile() override = default;
+
+  Options *GetOptions() override { return &m_options; }
+
+  class CommandOptions : public Options {
+  public:
+    CommandOptions() : Options() { OptionParsingStarting(nullptr); }
+
+    ~CommandOptions() override = default;
+
+    Status SetOptionValue(uint32_t option_idx, llvm::StringRef option_arg,
+                          ExecutionContext *execution_context) override {
+      Status error;
+      const int short_option = m_getopt_table[option_idx].val;
+
+      switch (short_option) {
+      case 'c':
+        if (option_arg.getAsInteger(0, m_profile_options.sample_count) ||
+            m_profile_options.sample_count == 0)
+          error.SetErrorStringWithFormat("invalid sample count '%s'",
+                                         option_arg.str().c_str());
+        break;
+      case 'r': {
+        uint32_t rate;
+        if (option_arg.getAsInteger(0, rate) || rate == 0 || rate > 1000000)
+          error.SetErrorStringWithFormat("invalid sampling rate '%s'",
+                                         option_arg.str().c_str());
+        else
+          m_profile_options.interval =
+              std::chrono::microseconds(1000000 / rate);
+        break;
+      }
+      case 'm':
+        if (option_arg.getAsInteger(0, m_profile_options.max_depth) ||
+            m_profile_options.max_depth == 0)
+          error.SetErrorStringWithFormat("invalid maximum depth '%s'",
+                                         option_arg.str().c_str());
+        break;
+      case 'F':
+        m_profile_options.use_frame_pointers = true;
+        break;
+      case 'p':
+        m_pprof = true;
+        break;
+      case 'o':
+        m_outfile.SetFile(option_arg, FileSpec::Style::native);
+        FileSystem::Instance().Resolve(m_outfile);
+        break;
+      default:
+        llvm_unreachable("Unimplemented option");
+      }
+
+      return error;
+    }
+
+    void OptionParsingStarting(ExecutionContext *execution_context) override {
+      m_profile_options = SamplingProfiler::Options();
+      m_pprof = false;
+      m_outfile.Clear();
+    }
+
+    Status OptionParsingFinished(ExecutionContext *execution_context) override {
+      if (m_pprof && !m_outfile)
+        return Status("the pprof format requires an output file");
+      return Status();
+    }
+
+    llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
+      return llvm::makeArrayRef(g_process_profile_options);
+    }
+
+    SamplingProfiler::Options m_profile_options;
+    bool m_pprof;
+    FileSpec m_outfile;
+  };
+
+protected:
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (command.GetArgumentCount()) {
+      result.AppendError("'process profile' takes no arguments");
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    Process *process = m_exe_ctx.GetProcessPtr();
+    SamplingProfiler profiler;
+    Status error = profiler.Profile(*process, m_options.m_profile_options);
+    if (error.Fail()) {
+      result.AppendErrorWithFormat("profiling failed: %s", error.AsCString());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    Stream &strm = result.GetOutputStream();
+    if (m_options.m_outfile) {
+      auto outfile = FileSystem::Instance().Open(
+          m_options.m_outfile, File::eOpenOptionWrite |
+                                   File::eOpenOptionCanCreate |
+                                   File::eOpenOptionTruncate);
+      if (!outfile) {
+        result.AppendErrorWithFormat(
+            "couldn't open '%s': %s", m_options.m_outfile.GetPath().c_str(),
+            llvm::toString(outfile.takeError()).c_str());
+        result.SetStatus(eReturnStatusFailed);
+        return false;
+      }
+      StreamFile outfile_stream(std::move(outfile.get()));
+      if (m_options.m_pprof)
+        profiler.WritePprof(outfile_stream);
+      else
+        profiler.DumpFoldedStacks(outfile_stream);
+      strm.Printf("Profile written to '%s'\n",
+                  m_options.m_outfile.GetPath().c_str());
+    } else {
+      profiler.DumpFoldedStacks(strm);
+    }
+
+    profiler.DumpStatistics(strm);
+    if (profiler.StoppedEarly())
+      strm.PutCString("The profile ended early because the process stopped.\n");
+    result.SetStatus(eReturnStatusSuccessFinishResult);
+    return true;
+  }
+
+private:
+  CommandOptions m_options;
+};
+
 // CommandObjectProcessStatus
 #pragma mark CommandObjectProcessStatus
 #define LLDB_OPTIONS_process_status
@@ -1587,6 +1735,8 @@ CommandObjectMultiwordProcess::CommandObjectMultiwordProcess(
                  CommandObjectSP(new CommandObjectProcessHandle(interpreter)));
   LoadSubCommand("status",
                  CommandObjectSP(new CommandObjectProcessStatus(interpreter)));
+  LoadSubCommand("profile",
+                 CommandObjectSP(new CommandObjectProcessProfile(interpreter)));
   LoadSubCommand("interrupt", CommandObjectSP(new CommandObjectProcessInterrupt(
                                   interpreter)));
   LoadSubCommand("kill",
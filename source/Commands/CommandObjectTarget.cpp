@@ -31,6 +31,7 @@
 #include "lldb/Interpreter/OptionGroupValueObjectDisplay.h"
 #include "lldb/Interpreter/OptionGroupVariable.h"
 #include "lldb/Interpreter/Options.h"
+#include "lldb/Symbol/BuildIDIndex.h"
 #include "lldb/Symbol/CompileUnit.h"
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/LineTable.h"
@@ -636,6 +637,8 @@ protected:
     if (m_cleanup_option.GetOptionValue()) {
       const bool mandatory = true;
       ModuleList::RemoveOrphanSharedModules(mandatory);
+    } else {
+      ModuleList::RemoveOrphanSharedModulesOverBudget();
     }
     result.GetOutputStream().Printf("%u targets deleted.\n",
                                     (uint32_t)num_targets_to_delete);
@@ -4222,6 +4225,11 @@ protected:
     result.SetStatus(eReturnStatusFailed);
     bool flush = false;
     ModuleSpec module_spec;
+
+    // Symbol files may have been added to the build-id symbol stores since
+    // they were indexed, e.g. by installing a debug info package. Drop the
+    // indexes so that the lookups below see them.
+    BuildIDIndex::Clear();
     const bool uuid_option_set =
         m_uuid_option_group.GetOptionValue().OptionWasSet();
     const bool file_option_set = m_file_option.GetOptionValue().OptionWasSet();
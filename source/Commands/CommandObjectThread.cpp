@@ -80,6 +80,9 @@ public:
           error.SetErrorStringWithFormat(
               "invalid boolean value for option '%c'", short_option);
       } break;
+      case 'p':
+        m_parallel = true;
+        break;
       default:
         llvm_unreachable("Unimplemented option");
       }
@@ -90,6 +93,7 @@ public:
       m_count = UINT32_MAX;
       m_start = 0;
       m_extended_backtrace = false;
+      m_parallel = false;
     }
 
     llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
@@ -100,6 +104,7 @@ public:
     uint32_t m_count;
     uint32_t m_start;
     bool m_extended_backtrace;
+    bool m_parallel;
   };
 
   CommandObjectThreadBacktrace(CommandInterpreter &interpreter)
@@ -146,6 +151,19 @@ protected:
     }
   }
 
+  void WillHandleThreads(llvm::ArrayRef<lldb::tid_t> tids) override {
+    if (!m_options.m_parallel || tids.size() < 2)
+      return;
+
+    // Unique stacks are bucketed by their whole call stack.
+    uint32_t num_frames = UINT32_MAX;
+    if (!m_unique_stacks && m_options.m_count != UINT32_MAX &&
+        m_options.m_count <= UINT32_MAX - m_options.m_start)
+      num_frames = m_options.m_start + m_options.m_count;
+    m_exe_ctx.GetProcessPtr()->GetThreadList().ComputeStackFrames(tids,
+                                                                  num_frames);
+  }
+
   bool HandleOneThread(lldb::tid_t tid, CommandReturnObject &result) override {
     ThreadSP thread_sp =
         m_exe_ctx.GetProcessPtr()->GetThreadList().FindThreadByID(tid);
@@ -2203,6 +2221,100 @@ protected:
   size_t m_consecutive_repetitions = 0;
 };
 
+// CommandObjectTraceDumpFunctionCalls
+#define LLDB_OPTIONS_thread_trace_dump_function_calls
+#include "CommandOptions.inc"
+
+class CommandObjectTraceDumpFunctionCalls
+    : public CommandObjectIterateOverThreads {
+public:
+  class CommandOptions : public Options {
+  public:
+    CommandOptions() : Options() { OptionParsingStarting(nullptr); }
+
+    ~CommandOptions() override = default;
+
+    Status SetOptionValue(uint32_t option_idx, llvm::StringRef option_arg,
+                          ExecutionContext *execution_context) override {
+      Status error;
+      const int short_option = m_getopt_table[option_idx].val;
+
+      switch (short_option) {
+      case 'c': {
+        int32_t count;
+        if (option_arg.empty() || option_arg.getAsInteger(0, count) ||
+            count < 0)
+          error.SetErrorStringWithFormat(
+              "invalid integer value for option '%s'",
+              option_arg.str().c_str());
+        else
+          m_count = count;
+        break;
+      }
+      case 'f': {
+        m_flat = true;
+        break;
+      }
+      default:
+        llvm_unreachable("Unimplemented option");
+      }
+      return error;
+    }
+
+    void OptionParsingStarting(ExecutionContext *execution_context) override {
+      m_count = llvm::None;
+      m_flat = false;
+    }
+
+    llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
+      return llvm::makeArrayRef(g_thread_trace_dump_function_calls_options);
+    }
+
+    static const size_t kDefaultFlatCount = 20;
+
+    // Instance variables to hold the values for command options.
+    llvm::Optional<size_t> m_count;
+    bool m_flat;
+  };
+
+  CommandObjectTraceDumpFunctionCalls(CommandInterpreter &interpreter)
+      : CommandObjectIterateOverThreads(
+            interpreter, "thread trace dump function-calls",
+            "Dump the function call tree reconstructed from the trace of one "
+            "or more threads, along with the instructions and time spent in "
+            "each function.  If no threads are specified, show the current "
+            "thread.  Use the thread-index \"all\" to see all threads.",
+            nullptr,
+            eCommandRequiresProcess | eCommandTryTargetAPILock |
+                eCommandProcessMustBeLaunched | eCommandProcessMustBePaused |
+                eCommandProcessMustBeTraced),
+        m_options() {}
+
+  ~CommandObjectTraceDumpFunctionCalls() override = default;
+
+  Options *GetOptions() override { return &m_options; }
+
+protected:
+  bool HandleOneThread(lldb::tid_t tid, CommandReturnObject &result) override {
+    const TraceSP &trace_sp = m_exe_ctx.GetTargetSP()->GetTrace();
+    ThreadSP thread_sp =
+        m_exe_ctx.GetProcessPtr()->GetThreadList().FindThreadByID(tid);
+
+    size_t count = m_options.m_count.getValueOr(
+        m_options.m_flat ? CommandOptions::kDefaultFlatCount : SIZE_MAX);
+    if (llvm::Error err = trace_sp->DumpTraceFunctionCalls(
+            *thread_sp, result.GetOutputStream(), m_options.m_flat, count)) {
+      result.AppendErrorWithFormat("Failed dumping function calls: %s\n",
+                                   toString(std::move(err)).c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+    return true;
+  }
+
+  CommandOptions m_options;
+};
+
 // CommandObjectMultiwordTraceDump
 class CommandObjectMultiwordTraceDump : public CommandObjectMultiword {
 public:
@@ -2215,6 +2327,9 @@ public:
     LoadSubCommand(
         "instructions",
         CommandObjectSP(new CommandObjectTraceDumpInstructions(interpreter)));
+    LoadSubCommand(
+        "function-calls",
+        CommandObjectSP(new CommandObjectTraceDumpFunctionCalls(interpreter)));
   }
   ~CommandObjectMultiwordTraceDump() override = default;
 };
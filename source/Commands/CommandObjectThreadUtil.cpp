@@ -76,6 +76,8 @@ bool CommandObjectIterateOverThreads::DoExecute(Args &command,
     }
   }
 
+  WillHandleThreads(tids);
+
   if (m_unique_stacks) {
     // Iterate over threads, finding unique stack buckets.
     std::set<UniqueStack> unique_stacks;
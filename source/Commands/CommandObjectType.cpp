@@ -310,6 +310,10 @@ private:
         m_class_name = std::string(option_arg);
         is_class_based = true;
         break;
+      case 'L':
+        m_layout = std::string(option_arg);
+        is_layout_based = true;
+        break;
       case 'p':
         m_skip_pointers = true;
         break;
@@ -336,6 +340,8 @@ private:
       m_skip_references = false;
       m_category = "default";
       is_class_based = false;
+      m_layout.clear();
+      is_layout_based = false;
       handwrite_python = false;
       m_regex = false;
     }
@@ -353,6 +359,8 @@ private:
     bool m_input_python;
     std::string m_category;
     bool is_class_based;
+    std::string m_layout;
+    bool is_layout_based;
     bool handwrite_python;
     bool m_regex;
   };
@@ -365,6 +373,8 @@ private:
 
   bool Execute_PythonClass(Args &command, CommandReturnObject &result);
 
+  bool Execute_Layout(Args &command, CommandReturnObject &result);
+
 protected:
   bool DoExecute(Args &command, CommandReturnObject &result) override {
     WarnOnPotentialUnquotedUnsignedType(command, result);
@@ -373,9 +383,11 @@ protected:
       return Execute_HandwritePython(command, result);
     else if (m_options.is_class_based)
       return Execute_PythonClass(command, result);
+    else if (m_options.is_layout_based)
+      return Execute_Layout(command, result);
     else {
       result.AppendError("must either provide a children list, a Python class "
-                         "name, or use -P and type a Python class "
+                         "name, a layout, or use -P and type a Python class "
                          "line-by-line");
       result.SetStatus(eReturnStatusFailed);
       return false;
@@ -2403,6 +2415,54 @@ CommandObjectTypeSynthAdd::CommandObjectTypeSynthAdd(
   m_arguments.push_back(type_arg);
 }
 
+bool CommandObjectTypeSynthAdd::Execute_Layout(Args &command,
+                                               CommandReturnObject &result) {
+  if (command.GetArgumentCount() < 1) {
+    result.AppendErrorWithFormat("%s takes one or more args.\n",
+                                 m_cmd_name.c_str());
+    result.SetStatus(eReturnStatusFailed);
+    return false;
+  }
+
+  llvm::Expected<DeclarativeSyntheticChildren::Layout> layout =
+      DeclarativeSyntheticChildren::ParseLayout(m_options.m_layout);
+  if (!layout) {
+    result.AppendErrorWithFormat("invalid layout: %s",
+                                 llvm::toString(layout.takeError()).c_str());
+    result.SetStatus(eReturnStatusFailed);
+    return false;
+  }
+
+  SyntheticChildrenSP entry = std::make_shared<DeclarativeSyntheticChildren>(
+      SyntheticChildren::Flags()
+          .SetCascades(m_options.m_cascade)
+          .SetSkipPointers(m_options.m_skip_pointers)
+          .SetSkipReferences(m_options.m_skip_references),
+      std::move(*layout), m_options.m_layout);
+
+  Status error;
+
+  for (auto &arg_entry : command.entries()) {
+    if (arg_entry.ref().empty()) {
+      result.AppendError("empty typenames not allowed");
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    ConstString typeCS(arg_entry.ref());
+    if (!AddSynth(typeCS, entry,
+                  m_options.m_regex ? eRegexSynth : eRegularSynth,
+                  m_options.m_category, &error)) {
+      result.AppendError(error.AsCString());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+  }
+
+  result.SetStatus(eReturnStatusSuccessFinishNoResult);
+  return result.Succeeded();
+}
+
 bool CommandObjectTypeSynthAdd::AddSynth(ConstString type_name,
                                          SyntheticChildrenSP entry,
                                          SynthFormatType type,
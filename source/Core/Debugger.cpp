@@ -758,6 +758,7 @@ void Debugger::Clear() {
         target_sp->Destroy();
       }
     }
+    ModuleList::RemoveOrphanSharedModulesOverBudget();
     m_broadcaster_manager_sp->Clear();
 
     // Close the input file _before_ we close the input read communications
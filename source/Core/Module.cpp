@@ -579,6 +579,29 @@ uint32_t Module::ResolveSymbolContextForAddress(
   return resolved_flags;
 }
 
+ConstString Module::GetFunctionNameAtFileAddress(addr_t file_addr) {
+  {
+    std::lock_guard<std::mutex> guard(m_function_names_mutex);
+    if (llvm::Optional<ConstString> name = m_function_names.Lookup(file_addr))
+      return *name;
+  }
+
+  // The symbol context is resolved without holding the cache mutex, as that
+  // needs the module mutex, which is held while the cache is cleared.
+  Address so_addr;
+  SymbolContext sc;
+  if (ResolveFileAddress(file_addr, so_addr))
+    ResolveSymbolContextForAddress(
+        so_addr, eSymbolContextFunction | eSymbolContextSymbol, sc);
+
+  ConstString name;
+  if (sc.function || sc.symbol)
+    name = sc.GetFunctionName();
+  std::lock_guard<std::mutex> guard(m_function_names_mutex);
+  m_function_names.Insert(file_addr, sc, name);
+  return name;
+}
+
 uint32_t Module::ResolveSymbolContextForFilePath(
     const char *file_path, uint32_t line, bool check_inlines,
     lldb::SymbolContextItem resolve_scope, SymbolContextList &sc_list) {
@@ -1271,6 +1294,11 @@ ObjectFile *Module::GetObjectFile() {
   return m_objfile_sp.get();
 }
 
+ObjectFile *Module::GetObjectFileIfParsed() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  return m_objfile_sp.get();
+}
+
 SectionList *Module::GetSectionList() {
   // Populate m_sections_up with sections from objfile.
   if (!m_sections_up) {
@@ -1290,6 +1318,7 @@ void Module::SectionFileAddressesChanged() {
 }
 
 UnwindTable &Module::GetUnwindTable() {
+  std::lock_guard<std::mutex> guard(m_unwind_table_mutex);
   if (!m_unwind_table)
     m_unwind_table.emplace(*this);
   return *m_unwind_table;
@@ -1412,7 +1441,10 @@ void Module::SetSymbolFileFileSpec(const FileSpec &file) {
 
         // Clear the unwind table too, as that may also be affected by the
         // symbol file information.
-        m_unwind_table.reset();
+        {
+          std::lock_guard<std::mutex> guard(m_unwind_table_mutex);
+          m_unwind_table.reset();
+        }
 
         // The symbol file might be a directory bundle ("/tmp/a.out.dSYM")
         // instead of a full path to the symbol file within the bundle
@@ -1448,6 +1480,8 @@ void Module::SetSymbolFileFileSpec(const FileSpec &file) {
   m_symfile_spec = file;
   m_symfile_up.reset();
   m_did_load_symfile = false;
+  std::lock_guard<std::mutex> guard(m_function_names_mutex);
+  m_function_names.Clear();
 }
 
 bool Module::IsExecutable() {
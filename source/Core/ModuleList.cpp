@@ -110,6 +110,49 @@ bool ModuleListProperties::SetClangModulesCachePath(const FileSpec &path) {
       nullptr, ePropertyClangModulesCachePath, path);
 }
 
+FileSpec ModuleListProperties::GetDecompressedSectionCachePath() const {
+  return m_collection_sp
+      ->GetPropertyAtIndexAsOptionValueFileSpec(
+          nullptr, false, ePropertyDecompressedSectionCachePath)
+      ->GetCurrentValue();
+}
+
+bool ModuleListProperties::SetDecompressedSectionCachePath(
+    const FileSpec &path) {
+  return m_collection_sp->SetPropertyAtIndexAsFileSpec(
+      nullptr, ePropertyDecompressedSectionCachePath, path);
+}
+
+FileSpec ModuleListProperties::GetBuildIDIndexCachePath() const {
+  return m_collection_sp
+      ->GetPropertyAtIndexAsOptionValueFileSpec(
+          nullptr, false, ePropertyBuildIDIndexCachePath)
+      ->GetCurrentValue();
+}
+
+bool ModuleListProperties::SetBuildIDIndexCachePath(const FileSpec &path) {
+  return m_collection_sp->SetPropertyAtIndexAsFileSpec(
+      nullptr, ePropertyBuildIDIndexCachePath, path);
+}
+
+FileSpec ModuleListProperties::GetUnwindIndexCachePath() const {
+  return m_collection_sp
+      ->GetPropertyAtIndexAsOptionValueFileSpec(
+          nullptr, false, ePropertyUnwindIndexCachePath)
+      ->GetCurrentValue();
+}
+
+bool ModuleListProperties::SetUnwindIndexCachePath(const FileSpec &path) {
+  return m_collection_sp->SetPropertyAtIndexAsFileSpec(
+      nullptr, ePropertyUnwindIndexCachePath, path);
+}
+
+uint64_t ModuleListProperties::GetSharedModuleMemoryBudget() const {
+  const uint32_t idx = ePropertySharedModuleMemoryBudget;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_modulelist_properties[idx].default_uint_value);
+}
+
 void ModuleListProperties::UpdateSymlinkMappings() {
   FileSpecList list = m_collection_sp
                           ->GetPropertyAtIndexAsOptionValueFileSpecList(
@@ -320,6 +363,46 @@ size_t ModuleList::RemoveOrphans(bool mandatory) {
   return remove_count;
 }
 
+/// \return
+///     The number of bytes of object file data mapped by \a module, without
+///     parsing its object file if that wasn't done yet.
+static uint64_t GetObjectFileByteSize(Module &module) {
+  ObjectFile *objfile = module.GetObjectFileIfParsed();
+  if (!objfile)
+    return 0;
+  return objfile->GetByteSize();
+}
+
+size_t ModuleList::RemoveOrphansOverBudget(uint64_t byte_budget) {
+  std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
+  size_t remove_count = 0;
+  // Removing a module might make other modules orphans, so keep going while
+  // we are over budget and still able to remove modules.
+  bool made_progress = true;
+  while (made_progress) {
+    made_progress = false;
+    uint64_t orphan_bytes = 0;
+    for (const ModuleSP &module_sp : m_modules)
+      if (module_sp.unique())
+        orphan_bytes += GetObjectFileByteSize(*module_sp);
+
+    // Modules are kept in the order they were added, so the oldest orphans
+    // are the first ones to go.
+    collection::iterator pos = m_modules.begin();
+    while (orphan_bytes > byte_budget && pos != m_modules.end()) {
+      if (pos->unique()) {
+        orphan_bytes -= GetObjectFileByteSize(**pos);
+        pos = RemoveImpl(pos);
+        ++remove_count;
+        made_progress = true;
+      } else {
+        ++pos;
+      }
+    }
+  }
+  return remove_count;
+}
+
 size_t ModuleList::Remove(ModuleList &module_list) {
   std::lock_guard<std::recursive_mutex> guard(m_modules_mutex);
   size_t num_removed = 0;
@@ -743,6 +826,14 @@ size_t ModuleList::RemoveOrphanSharedModules(bool mandatory) {
   return GetSharedModuleList().RemoveOrphans(mandatory);
 }
 
+size_t ModuleList::RemoveOrphanSharedModulesOverBudget() {
+  const uint64_t byte_budget =
+      GetGlobalModuleListProperties().GetSharedModuleMemoryBudget();
+  if (byte_budget == 0)
+    return 0;
+  return GetSharedModuleList().RemoveOrphansOverBudget(byte_budget);
+}
+
 Status
 ModuleList::GetSharedModule(const ModuleSpec &module_spec, ModuleSP &module_sp,
                             const FileSpecList *module_search_paths_ptr,
@@ -49,7 +49,9 @@
 #include "lldb/Utility/StreamString.h"
 #include "lldb/lldb-private-types.h"
 
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Support/Compiler.h"
+#include "llvm/Support/xxhash.h"
 
 #include <algorithm>
 #include <cstdint>
@@ -197,9 +199,17 @@ bool ValueObject::UpdateValueIfNeeded(bool update_format) {
                   old_checksum.begin());
       }
 
-      bool success = UpdateValue();
-
-      SetValueIsValid(success);
+      bool success;
+      if (!first_update && value_was_valid && IsBackingDataUnchanged()) {
+        // The bytes of the value didn't change, so its data and the values
+        // inside it are still valid.
+        need_compare_checksums = false;
+        success = true;
+        SetValueIsValid(true);
+      } else {
+        success = UpdateValue();
+        SetValueIsValid(success);
+      }
 
       if (success) {
         UpdateChildrenAddressType();
@@ -231,6 +241,80 @@ bool ValueObject::UpdateValueIfNeeded(bool update_format) {
   return m_error.Success();
 }
 
+// The largest value whose memory is read at once.
+static const uint64_t g_max_backing_data_size = 64 * 1024;
+
+void ValueObject::UpdateBackingData() {
+  m_backing_owner = nullptr;
+  // The values that have a value read their memory anyway, and their
+  // children, if any, aren't in it.
+  if (CanProvideValue() ||
+      m_value.GetValueType() != Value::eValueTypeLoadAddress) {
+    m_backing_data.Clear();
+    return;
+  }
+
+  ProcessSP process_sp(GetProcessSP());
+  const lldb::addr_t addr = m_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS);
+  llvm::Optional<uint64_t> size = GetByteSize();
+  if (!process_sp || !process_sp->GetTarget().GetIncrementalValueUpdates() ||
+      addr == LLDB_INVALID_ADDRESS || addr == 0 || !size || *size == 0 ||
+      *size > g_max_backing_data_size) {
+    m_backing_data.Clear();
+    return;
+  }
+
+  auto buffer_sp = std::make_shared<DataBufferHeap>(*size, 0);
+  Status error;
+  if (process_sp->ReadMemory(addr, buffer_sp->GetBytes(), *size, error) !=
+      *size) {
+    m_backing_data.Clear();
+    return;
+  }
+
+  const uint64_t hash = llvm::hash_combine(
+      llvm::xxHash64(llvm::makeArrayRef(buffer_sp->GetBytes(), *size)), addr);
+  if (!m_backing_data.GetByteSize() || hash != m_backing_hash)
+    ++m_backing_generation;
+  m_backing_hash = hash;
+  m_backing_data.SetData(buffer_sp);
+  m_backing_data.SetByteOrder(m_data.GetByteOrder());
+  m_backing_data.SetAddressByteSize(m_data.GetAddressByteSize());
+  m_backing_owner = this;
+}
+
+bool ValueObject::SetBackingOwner(ValueObject *owner, lldb::addr_t addr) {
+  m_backing_owner = nullptr;
+  if (!owner || owner->m_backing_owner != owner)
+    return false;
+  const lldb::addr_t owner_addr =
+      owner->m_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS);
+  llvm::Optional<uint64_t> size = GetByteSize();
+  if (!size || addr < owner_addr ||
+      addr - owner_addr + *size > owner->m_backing_data.GetByteSize())
+    return false;
+  m_backing_owner = owner;
+  m_backing_generation = owner->m_backing_generation;
+  return true;
+}
+
+void ValueObject::ExtractBackingData(DataExtractor &data) {
+  assert(m_backing_owner && "value without backing data");
+  const lldb::addr_t owner_addr =
+      m_backing_owner->m_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS);
+  const lldb::addr_t addr = m_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS);
+  data.SetData(m_backing_owner->m_backing_data, addr - owner_addr,
+               GetByteSize().getValueOr(0));
+}
+
+bool ValueObject::IsBackingDataUnchanged() {
+  ValueObject *owner = m_backing_owner;
+  if (!owner || owner == this)
+    return false;
+  return owner->UpdateValueIfNeeded(false) && owner->m_backing_owner == owner &&
+         owner->m_backing_generation == m_backing_generation;
+}
+
 bool ValueObject::UpdateFormatsIfNeeded() {
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_DATAFORMATTERS));
   LLDB_LOGF(log,
@@ -445,6 +529,23 @@ ValueObjectSP ValueObject::GetChildAtIndex(size_t idx, bool can_create) {
   return child_sp;
 }
 
+std::vector<ValueObjectSP> ValueObject::GetChildrenInRange(size_t start,
+                                                           size_t count) {
+  std::vector<ValueObjectSP> children;
+  const size_t num_children = GetNumChildren();
+  if (start >= num_children)
+    return children;
+  const size_t end = start + std::min(count, num_children - start);
+  children.reserve(end - start);
+  for (size_t idx = start; idx < end; ++idx) {
+    ValueObjectSP child_sp = GetChildAtIndex(idx, true);
+    if (!child_sp)
+      break;
+    children.push_back(child_sp);
+  }
+  return children;
+}
+
 lldb::ValueObjectSP
 ValueObject::GetChildAtIndexPath(llvm::ArrayRef<size_t> idxs,
                                  size_t *index_of_error) {
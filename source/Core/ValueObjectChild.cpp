@@ -103,6 +103,7 @@ LazyBool ValueObjectChild::CanUpdateWithInvalidExecutionContext() {
 bool ValueObjectChild::UpdateValue() {
   m_error.Clear();
   SetValueIsValid(false);
+  m_backing_owner = nullptr;
   ValueObject *parent = m_parent;
   if (parent) {
     if (parent->UpdateValueIfNeeded(false)) {
@@ -117,8 +118,10 @@ bool ValueObjectChild::UpdateValue() {
       const bool is_instance_ptr_base =
           ((m_is_base_class) &&
            (parent_type_flags.AnySet(lldb::eTypeInstanceIsPointer)));
+      const bool is_pointee =
+          parent->GetCompilerType().ShouldTreatScalarValueAsAddress();
 
-      if (parent->GetCompilerType().ShouldTreatScalarValueAsAddress()) {
+      if (is_pointee) {
         m_value.GetScalar() = parent->GetPointerValue();
 
         switch (parent->GetAddressTypeOfChildren()) {
@@ -196,12 +199,26 @@ bool ValueObjectChild::UpdateValue() {
         const bool thread_and_frame_only_if_stopped = true;
         ExecutionContext exe_ctx(
             GetExecutionContextRef().Lock(thread_and_frame_only_if_stopped));
+        // Use the bytes of the memory of an ancestor read at once if this
+        // value is in it, and otherwise read them at once if this value is an
+        // aggregate, e.g. the pointee of a pointer.
+        bool has_backing_data = false;
+        if (!is_pointee && !is_instance_ptr_base &&
+            m_value.GetValueType() == Value::eValueTypeLoadAddress)
+          has_backing_data = SetBackingOwner(
+              parent->m_backing_owner,
+              m_value.GetScalar().ULongLong(LLDB_INVALID_ADDRESS));
         if (GetCompilerType().GetTypeInfo() & lldb::eTypeHasValue) {
           Value &value = is_instance_ptr_base ? m_parent->GetValue() : m_value;
-          m_error =
-              value.GetValueAsData(&exe_ctx, m_data, GetModule().get());
+          if (has_backing_data)
+            ExtractBackingData(m_data);
+          else
+            m_error =
+                value.GetValueAsData(&exe_ctx, m_data, GetModule().get());
         } else {
           m_error.Clear(); // No value so nothing to read...
+          if (!has_backing_data)
+            UpdateBackingData();
         }
       }
 
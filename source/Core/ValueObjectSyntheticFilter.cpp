@@ -304,6 +304,64 @@ lldb::ValueObjectSP ValueObjectSynthetic::GetChildAtIndex(size_t idx,
   }
 }
 
+std::vector<lldb::ValueObjectSP>
+ValueObjectSynthetic::GetChildrenInRange(size_t start, size_t count) {
+  Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_DATAFORMATTERS);
+
+  UpdateValueIfNeeded();
+
+  std::vector<lldb::ValueObjectSP> children;
+  const size_t num_children = GetNumChildren();
+  if (start >= num_children)
+    return children;
+  const size_t end = start + std::min(count, num_children - start);
+  children.reserve(end - start);
+
+  // Take the children at the beginning of the range from the cache, the
+  // front end only has to create the ones after the first missing child.
+  size_t first_missing = end;
+  {
+    std::lock_guard<std::mutex> guard(m_child_mutex);
+    for (size_t idx = start; idx < end; ++idx) {
+      auto cached_child_it = m_children_byindex.find(idx);
+      if (cached_child_it == m_children_byindex.end()) {
+        first_missing = idx;
+        break;
+      }
+      children.push_back(cached_child_it->second->GetSP());
+    }
+  }
+  if (first_missing == end || m_synth_filter_up == nullptr)
+    return children;
+
+  LLDB_LOGF(log,
+            "[ValueObjectSynthetic::GetChildrenInRange] name=%s, creating "
+            "the children at indexes [%zu, %zu)",
+            GetName().AsCString(), first_missing, end);
+
+  std::vector<lldb::ValueObjectSP> created =
+      m_synth_filter_up->GetChildrenInRange(first_missing,
+                                            end - first_missing);
+  for (size_t i = 0; i < created.size() && created[i]; ++i) {
+    lldb::ValueObjectSP child_sp = created[i];
+    {
+      std::lock_guard<std::mutex> guard(m_child_mutex);
+      auto cached_child_it = m_children_byindex.find(first_missing + i);
+      if (cached_child_it != m_children_byindex.end()) {
+        children.push_back(cached_child_it->second->GetSP());
+        continue;
+      }
+      if (child_sp->IsSyntheticChildrenGenerated())
+        m_synthetic_children_cache.push_back(child_sp);
+      m_children_byindex[first_missing + i] = child_sp.get();
+    }
+    child_sp->SetPreferredDisplayLanguageIfNeeded(
+        GetPreferredDisplayLanguage());
+    children.push_back(child_sp);
+  }
+  return children;
+}
+
 lldb::ValueObjectSP
 ValueObjectSynthetic::GetChildMemberWithName(ConstString name,
                                              bool can_create) {
@@ -125,6 +125,7 @@ lldb::ValueType ValueObjectVariable::GetValueType() const {
 bool ValueObjectVariable::UpdateValue() {
   SetValueIsValid(false);
   m_error.Clear();
+  m_backing_owner = nullptr;
 
   Variable *variable = m_variable_sp.get();
   DWARFExpression &expr = variable->LocationExpression();
@@ -223,6 +224,7 @@ bool ValueObjectVariable::UpdateValue() {
           // location has changed.
           SetValueDidChange(value_type != old_value.GetValueType() ||
                             m_value.GetScalar() != old_value.GetScalar());
+          UpdateBackingData();
         } else {
           // Copy the Value and set the context to use our Variable so it can
           // extract read its value into m_data appropriately
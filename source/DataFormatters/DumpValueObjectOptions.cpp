@@ -198,3 +198,9 @@ DumpValueObjectOptions &DumpValueObjectOptions::SetPointerAsArray(
   m_pointer_as_array = ptr_array;
   return *this;
 }
+
+DumpValueObjectOptions &
+DumpValueObjectOptions::SetPrintBudget(const PrintBudget &budget) {
+  m_print_budget = budget;
+  return *this;
+}
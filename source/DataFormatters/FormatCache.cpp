@@ -51,12 +51,13 @@ void FormatCache::Entry::Set(lldb::SyntheticChildrenSP synthetic_sp) {
   m_synthetic_sp = synthetic_sp;
 }
 
-FormatCache::Entry &FormatCache::GetEntry(ConstString type) {
-  auto i = m_map.find(type), e = m_map.end();
-  if (i != e)
-    return i->second;
-  m_map[type] = FormatCache::Entry();
-  return m_map[type];
+FormatCache::Key FormatCache::MakeKey(ConstString type,
+                                      lldb::DynamicValueType use_dynamic) {
+  return Key(type, static_cast<unsigned>(use_dynamic));
+}
+
+FormatCache::Shard &FormatCache::GetShard(const Key &key) {
+  return m_shards[llvm::DenseMapInfo<Key>::getHashValue(key) % g_num_shards];
 }
 
 namespace lldb_private {
@@ -74,12 +75,15 @@ template<> bool FormatCache::Entry::IsCached<lldb::SyntheticChildrenSP>() {
 } // namespace lldb_private
 
 template <typename ImplSP>
-bool FormatCache::Get(ConstString type, ImplSP &format_impl_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
-  if (entry.IsCached<ImplSP>()) {
+bool FormatCache::Get(ConstString type, lldb::DynamicValueType use_dynamic,
+                      ImplSP &format_impl_sp) {
+  const Key key = MakeKey(type, use_dynamic);
+  Shard &shard = GetShard(key);
+  std::lock_guard<std::mutex> guard(shard.m_mutex);
+  auto pos = shard.m_map.find(key);
+  if (pos != shard.m_map.end() && pos->second.IsCached<ImplSP>()) {
     m_cache_hits++;
-    entry.Get(format_impl_sp);
+    pos->second.Get(format_impl_sp);
     return true;
   }
   m_cache_misses++;
@@ -89,33 +93,41 @@ bool FormatCache::Get(ConstString type, ImplSP &format_impl_sp) {
 
 /// Explicit instantiations for the three types.
 /// \{
-template bool
-FormatCache::Get<lldb::TypeFormatImplSP>(ConstString, lldb::TypeFormatImplSP &);
-template bool
-FormatCache::Get<lldb::TypeSummaryImplSP>(ConstString,
-                                          lldb::TypeSummaryImplSP &);
-template bool
-FormatCache::Get<lldb::SyntheticChildrenSP>(ConstString,
-                                            lldb::SyntheticChildrenSP &);
+template bool FormatCache::Get<lldb::TypeFormatImplSP>(
+    ConstString, lldb::DynamicValueType, lldb::TypeFormatImplSP &);
+template bool FormatCache::Get<lldb::TypeSummaryImplSP>(
+    ConstString, lldb::DynamicValueType, lldb::TypeSummaryImplSP &);
+template bool FormatCache::Get<lldb::SyntheticChildrenSP>(
+    ConstString, lldb::DynamicValueType, lldb::SyntheticChildrenSP &);
 /// \}
 
-void FormatCache::Set(ConstString type, lldb::TypeFormatImplSP &format_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  GetEntry(type).Set(format_sp);
+template <typename ImplSP>
+void FormatCache::SetImpl(ConstString type, lldb::DynamicValueType use_dynamic,
+                          ImplSP &impl_sp) {
+  const Key key = MakeKey(type, use_dynamic);
+  Shard &shard = GetShard(key);
+  std::lock_guard<std::mutex> guard(shard.m_mutex);
+  shard.m_map[key].Set(impl_sp);
+}
+
+void FormatCache::Set(ConstString type, lldb::DynamicValueType use_dynamic,
+                      lldb::TypeFormatImplSP &format_sp) {
+  SetImpl(type, use_dynamic, format_sp);
 }
 
-void FormatCache::Set(ConstString type, lldb::TypeSummaryImplSP &summary_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  GetEntry(type).Set(summary_sp);
+void FormatCache::Set(ConstString type, lldb::DynamicValueType use_dynamic,
+                      lldb::TypeSummaryImplSP &summary_sp) {
+  SetImpl(type, use_dynamic, summary_sp);
 }
 
-void FormatCache::Set(ConstString type,
+void FormatCache::Set(ConstString type, lldb::DynamicValueType use_dynamic,
                       lldb::SyntheticChildrenSP &synthetic_sp) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  GetEntry(type).Set(synthetic_sp);
+  SetImpl(type, use_dynamic, synthetic_sp);
 }
 
 void FormatCache::Clear() {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  m_map.clear();
+  for (Shard &shard : m_shards) {
+    std::lock_guard<std::mutex> guard(shard.m_mutex);
+    shard.m_map.clear();
+  }
 }
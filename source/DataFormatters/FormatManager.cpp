@@ -16,6 +16,7 @@
 #include "lldb/DataFormatters/LanguageCategory.h"
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Language.h"
+#include "lldb/Target/Target.h"
 #include "lldb/Utility/Log.h"
 
 using namespace lldb;
@@ -639,9 +640,15 @@ ImplSP FormatManager::GetCached(FormattersMatchData &match_data) {
   ImplSP retval_sp;
   Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_DATAFORMATTERS));
   if (match_data.GetTypeForCache()) {
+    // The cache is shared by all the debuggers, so count its hits and misses
+    // in the target of the value.
+    TargetSP target_sp = match_data.GetValueObject().GetTargetSP();
     LLDB_LOGF(log, "\n\n[%s] Looking into cache for type %s", __FUNCTION__,
               match_data.GetTypeForCache().AsCString("<invalid>"));
-    if (m_format_cache.Get(match_data.GetTypeForCache(), retval_sp)) {
+    if (m_format_cache.Get(match_data.GetTypeForCache(),
+                           match_data.GetDynamicValueType(), retval_sp)) {
+      if (target_sp)
+        target_sp->IncrementStats(StatisticKind::FormatCacheHit);
       if (log) {
         LLDB_LOGF(log, "[%s] Cache search success. Returning.", __FUNCTION__);
         LLDB_LOGV(log, "Cache hits: {0} - Cache Misses: {1}",
@@ -650,6 +657,8 @@ ImplSP FormatManager::GetCached(FormattersMatchData &match_data) {
       }
       return retval_sp;
     }
+    if (target_sp)
+      target_sp->IncrementStats(StatisticKind::FormatCacheMiss);
     LLDB_LOGF(log, "[%s] Cache search failed. Going normal route",
               __FUNCTION__);
   }
@@ -659,7 +668,8 @@ ImplSP FormatManager::GetCached(FormattersMatchData &match_data) {
     LLDB_LOGF(log, "[%s] Caching %p for type %s", __FUNCTION__,
               static_cast<void *>(retval_sp.get()),
               match_data.GetTypeForCache().AsCString("<invalid>"));
-    m_format_cache.Set(match_data.GetTypeForCache(), retval_sp);
+    m_format_cache.Set(match_data.GetTypeForCache(),
+                       match_data.GetDynamicValueType(), retval_sp);
   }
   LLDB_LOGV(log, "Cache hits: {0} - Cache Misses: {1}",
             m_format_cache.GetCacheHits(), m_format_cache.GetCacheMisses());
@@ -11,11 +11,14 @@
 
 #include "lldb/DataFormatters/FormattersHelpers.h"
 
+#include "lldb/Core/ValueObject.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Utility/ConstString.h"
 #include "lldb/Utility/RegularExpression.h"
+#include "lldb/Utility/StreamString.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -153,3 +156,52 @@ lldb_private::formatters::GetValueOfLibCXXCompressedPair(ValueObject &pair) {
   }
   return value;
 }
+
+void ContiguousChildrenReader::Reset(lldb::addr_t start, size_t num_elements,
+                                     const CompilerType &element_type,
+                                     uint64_t element_size) {
+  m_start = start;
+  m_num_elements = num_elements;
+  m_element_type = element_type;
+  m_element_size = element_size;
+  m_has_window = false;
+  m_window_start = 0;
+}
+
+lldb::ValueObjectSP ContiguousChildrenReader::GetChildAtIndex(
+    size_t idx, const ExecutionContextRef &exe_ctx_ref) {
+  if (idx >= m_num_elements || m_start == LLDB_INVALID_ADDRESS ||
+      m_element_size == 0)
+    return {};
+
+  ExecutionContext exe_ctx(exe_ctx_ref);
+  ProcessSP process_sp = exe_ctx.GetProcessSP();
+  if (process_sp && m_element_size <= kMaxWindowSize) {
+    const size_t window_length = kMaxWindowSize / m_element_size;
+    const size_t window_start = idx - idx % window_length;
+    const uint32_t stop_id = process_sp->GetModIDRef().GetStopID();
+    const uint32_t memory_id = process_sp->GetModIDRef().GetMemoryID();
+    if (!m_has_window || window_start != m_window_start ||
+        stop_id != m_window_stop_id || memory_id != m_window_memory_id) {
+      const size_t count =
+          std::min(window_length, m_num_elements - window_start);
+      // If the window can't be read, the child reads its own memory below.
+      Status error;
+      m_has_window = process_sp->PrefetchMemory(
+          m_start + window_start * m_element_size, count * m_element_size,
+          error);
+      m_window_start = window_start;
+      m_window_stop_id = stop_id;
+      m_window_memory_id = memory_id;
+    }
+  }
+
+  StreamString name;
+  name.Printf("[%" PRIu64 "]", (uint64_t)idx);
+  ValueObjectSP child_sp = ValueObject::CreateValueObjectFromAddress(
+      name.GetString(), m_start + idx * m_element_size, exe_ctx,
+      m_element_type);
+  if (child_sp)
+    child_sp->SetSyntheticChildrenGenerated(true);
+  return child_sp;
+}
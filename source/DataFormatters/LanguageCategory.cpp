@@ -40,7 +40,8 @@ bool LanguageCategory::Get(FormattersMatchData &match_data,
     return false;
 
   if (match_data.GetTypeForCache()) {
-    if (m_format_cache.Get(match_data.GetTypeForCache(), retval_sp))
+    if (m_format_cache.Get(match_data.GetTypeForCache(),
+                           match_data.GetDynamicValueType(), retval_sp))
       return (bool)retval_sp;
   }
 
@@ -49,7 +50,8 @@ bool LanguageCategory::Get(FormattersMatchData &match_data,
                                    match_data.GetMatchesVector(), retval_sp);
   if (match_data.GetTypeForCache() &&
       (!retval_sp || !retval_sp->NonCacheable())) {
-    m_format_cache.Set(match_data.GetTypeForCache(), retval_sp);
+    m_format_cache.Set(match_data.GetTypeForCache(),
+                       match_data.GetDynamicValueType(), retval_sp);
   }
   return result;
 }
@@ -14,6 +14,7 @@
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/Status.h"
+#include "lldb/Utility/StringScan.h"
 
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/ConvertUTF.h"
@@ -282,15 +283,12 @@ static bool DumpEncodedBufferToStream(
     const bool zero_is_terminator = dump_options.GetBinaryZeroIsTerminator();
 
     if (zero_is_terminator) {
-      while (data_ptr < data_end_ptr) {
-        if (!*data_ptr) {
-          data_end_ptr = data_ptr;
-          break;
-        }
-        data_ptr++;
-      }
-
-      data_ptr = (const SourceDataType *)data.GetDataStart();
+      llvm::ArrayRef<uint8_t> bytes(
+          reinterpret_cast<const uint8_t *>(data_ptr),
+          (data_end_ptr - data_ptr) * sizeof(SourceDataType));
+      data_end_ptr =
+          data_ptr + FindStringTerminator(bytes, sizeof(SourceDataType)) /
+                         sizeof(SourceDataType);
     }
 
     lldb::DataBufferSP utf8_data_buffer_sp;
@@ -329,6 +327,22 @@ static bool DumpEncodedBufferToStream(
     // we might end up with no NULL terminator before the end_ptr hence we need
     // to take a slower route and ensure we stay within boundaries
     for (; utf8_data_ptr < utf8_data_end_ptr;) {
+      // Print the characters that don't need to be escaped in one go, as
+      // strings are mostly made of them.
+      llvm::ArrayRef<uint8_t> remaining(utf8_data_ptr, utf8_data_end_ptr);
+      size_t run_length;
+      if (escape_non_printables)
+        run_length = GetPlainASCIIPrefixLength(remaining);
+      else if (zero_is_terminator)
+        run_length = FindStringTerminator(remaining, 1);
+      else
+        run_length = remaining.size();
+      if (run_length) {
+        stream.Write(utf8_data_ptr, run_length);
+        utf8_data_ptr += run_length;
+        continue;
+      }
+
       if (zero_is_terminator && !*utf8_data_ptr)
         break;
 
@@ -343,12 +357,8 @@ static bool DumpEncodedBufferToStream(
         if (!printable_bytes || !next_data)
           return false;
 
-        for (unsigned c = 0; c < printable_size; c++)
-          stream.Printf("%c", *(printable_bytes + c));
+        stream.Write(printable_bytes, printable_size);
         utf8_data_ptr = (uint8_t *)next_data;
-      } else {
-        stream.Printf("%c", *utf8_data_ptr);
-        utf8_data_ptr++;
       }
     }
   }
@@ -13,13 +13,19 @@
 #include "lldb/lldb-public.h"
 
 #include "lldb/Core/Debugger.h"
+#include "lldb/DataFormatters/FormattersHelpers.h"
 #include "lldb/DataFormatters/TypeSynthetic.h"
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Interpreter/ScriptInterpreter.h"
 #include "lldb/Symbol/CompilerType.h"
+#include "lldb/Symbol/Type.h"
+#include "lldb/Symbol/TypeList.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/StreamString.h"
 
+#include "llvm/Support/FormatVariadic.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -114,6 +120,18 @@ lldb::ValueObjectSP SyntheticChildrenFrontEnd::CreateValueObjectFromAddress(
   return valobj_sp;
 }
 
+std::vector<lldb::ValueObjectSP>
+SyntheticChildrenFrontEnd::GetChildrenInRange(size_t start, size_t count) {
+  std::vector<lldb::ValueObjectSP> children;
+  for (size_t idx = start; idx < start + count; ++idx) {
+    lldb::ValueObjectSP child_sp = GetChildAtIndex(idx);
+    if (!child_sp)
+      break;
+    children.push_back(child_sp);
+  }
+  return children;
+}
+
 lldb::ValueObjectSP SyntheticChildrenFrontEnd::CreateValueObjectFromData(
     llvm::StringRef name, const DataExtractor &data,
     const ExecutionContext &exe_ctx, CompilerType type) {
@@ -124,6 +142,311 @@ lldb::ValueObjectSP SyntheticChildrenFrontEnd::CreateValueObjectFromData(
   return valobj_sp;
 }
 
+llvm::Expected<DeclarativeSyntheticChildren::Layout>
+DeclarativeSyntheticChildren::ParseLayout(llvm::StringRef json) {
+  StructuredData::ObjectSP object_sp = StructuredData::ParseJSON(json.str());
+  StructuredData::Dictionary *dict =
+      object_sp ? object_sp->GetAsDictionary() : nullptr;
+  if (!dict)
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "the layout isn't a JSON dictionary");
+
+  Layout layout;
+  // The error of the key that stopped the iteration, if any.
+  std::string error;
+  dict->ForEach([&](ConstString key, StructuredData::Object *value) {
+    llvm::StringRef string_value;
+    if (StructuredData::String *string = value->GetAsString())
+      string_value = string->GetValue();
+    else {
+      error = llvm::formatv("the value of \"{0}\" isn't a string", key).str();
+      return false;
+    }
+
+    llvm::StringRef name = key.GetStringRef();
+    if (name == "kind") {
+      if (string_value == "array")
+        layout.kind = Layout::Kind::Array;
+      else if (string_value == "list")
+        layout.kind = Layout::Kind::List;
+      else {
+        error = llvm::formatv("unknown kind \"{0}\"", string_value).str();
+        return false;
+      }
+    } else if (name == "data")
+      layout.data = string_value.str();
+    else if (name == "end")
+      layout.end = string_value.str();
+    else if (name == "size")
+      layout.size = string_value.str();
+    else if (name == "head")
+      layout.head = string_value.str();
+    else if (name == "next")
+      layout.next = string_value.str();
+    else if (name == "value")
+      layout.value = string_value.str();
+    else if (name == "element_type")
+      layout.element_type = string_value.str();
+    else {
+      error = llvm::formatv("unknown key \"{0}\"", key).str();
+      return false;
+    }
+    return true;
+  });
+  if (!error.empty())
+    return llvm::createStringError(llvm::inconvertibleErrorCode(), "%s",
+                                   error.c_str());
+
+  if (!dict->HasKey("kind"))
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "the layout has no \"kind\"");
+  switch (layout.kind) {
+  case Layout::Kind::Array:
+    if (layout.data.empty())
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "an array layout needs a \"data\" path");
+    if (layout.size.empty() == layout.end.empty())
+      return llvm::createStringError(
+          llvm::inconvertibleErrorCode(),
+          "an array layout needs either a \"size\" or an \"end\" path");
+    if (!layout.head.empty() || !layout.next.empty() || !layout.value.empty())
+      return llvm::createStringError(
+          llvm::inconvertibleErrorCode(),
+          "\"head\", \"next\" and \"value\" only apply to lists");
+    break;
+  case Layout::Kind::List:
+    if (layout.head.empty() || layout.next.empty() || layout.value.empty())
+      return llvm::createStringError(
+          llvm::inconvertibleErrorCode(),
+          "a list layout needs \"head\", \"next\" and \"value\"");
+    if (!layout.data.empty() || !layout.end.empty())
+      return llvm::createStringError(
+          llvm::inconvertibleErrorCode(),
+          "\"data\" and \"end\" only apply to arrays");
+    break;
+  }
+  return layout;
+}
+
+std::string DeclarativeSyntheticChildren::GetDescription() {
+  StreamString sstr;
+  sstr.Printf("%s%s%s layout %s", Cascades() ? "" : " (not cascading)",
+              SkipsPointers() ? " (skip pointers)" : "",
+              SkipsReferences() ? " (skip references)" : "",
+              m_json.c_str());
+
+  return std::string(sstr.GetString());
+}
+
+DeclarativeSyntheticChildren::FrontEnd::FrontEnd(const Layout &layout,
+                                                 ValueObject &backend)
+    : SyntheticChildrenFrontEnd(backend), m_layout(layout) {}
+
+lldb::ValueObjectSP
+DeclarativeSyntheticChildren::FrontEnd::GetValueAtPath(llvm::StringRef path) {
+  // Accept the same paths as "type filter add".
+  std::string full_path = path.str();
+  if (!path.startswith(".") && !path.startswith("->") &&
+      !path.startswith("["))
+    full_path.insert(0, ".");
+  return m_backend.GetValueForExpressionPath(full_path);
+}
+
+CompilerType DeclarativeSyntheticChildren::FrontEnd::GetElementType(
+    CompilerType deduced_type) {
+  if (m_layout.element_type.empty())
+    return deduced_type;
+  if (m_named_element_type)
+    return *m_named_element_type;
+
+  TargetSP target_sp = m_backend.GetTargetSP();
+  if (!target_sp)
+    return CompilerType();
+  // Look into the module of the container first.
+  ModuleSP module_sp = m_backend.GetModule();
+  TypeList types;
+  llvm::DenseSet<SymbolFile *> searched_symbol_files;
+  target_sp->GetImages().FindTypes(
+      module_sp.get(), ConstString(m_layout.element_type),
+      /*name_is_fully_qualified=*/true, 1, searched_symbol_files, types);
+  m_named_element_type = CompilerType();
+  if (TypeSP type_sp = types.GetTypeAtIndex(0))
+    m_named_element_type = type_sp->GetFullCompilerType();
+  return *m_named_element_type;
+}
+
+bool DeclarativeSyntheticChildren::FrontEnd::Update() {
+  m_element_type.Clear();
+  m_element_size = 0;
+  m_count = 0;
+  m_first_element = LLDB_INVALID_ADDRESS;
+  m_nodes.clear();
+  m_visited_nodes.clear();
+  m_next_node = LLDB_INVALID_ADDRESS;
+
+  bool valid = m_layout.kind == Layout::Kind::Array ? UpdateArray()
+                                                    : UpdateList();
+  if (valid)
+    m_element_size = m_element_type.GetByteSize(m_backend.GetTargetSP().get())
+                         .getValueOr(0);
+  if (m_element_size == 0) {
+    m_count = 0;
+    m_next_node = LLDB_INVALID_ADDRESS;
+  }
+  return false;
+}
+
+bool DeclarativeSyntheticChildren::FrontEnd::UpdateArray() {
+  ValueObjectSP data_sp = GetValueAtPath(m_layout.data);
+  if (!data_sp)
+    return false;
+
+  CompilerType data_type = data_sp->GetCompilerType();
+  CompilerType deduced_type;
+  if (data_type.IsArrayType(&deduced_type, nullptr, nullptr)) {
+    AddressType address_type;
+    m_first_element = data_sp->GetAddressOf(true, &address_type);
+    if (address_type != eAddressTypeLoad)
+      return false;
+  } else {
+    deduced_type = data_type.GetPointeeType();
+    m_first_element = data_sp->GetValueAsUnsigned(LLDB_INVALID_ADDRESS);
+  }
+  if (m_first_element == LLDB_INVALID_ADDRESS)
+    return false;
+
+  m_element_type = GetElementType(deduced_type);
+  llvm::Optional<uint64_t> element_size =
+      m_element_type.GetByteSize(m_backend.GetTargetSP().get());
+  if (!element_size || *element_size == 0)
+    return false;
+
+  if (!m_layout.size.empty()) {
+    ValueObjectSP size_sp = GetValueAtPath(m_layout.size);
+    bool success = false;
+    if (size_sp)
+      m_count = size_sp->GetValueAsUnsigned(0, &success);
+    return success;
+  }
+
+  ValueObjectSP end_sp = GetValueAtPath(m_layout.end);
+  if (!end_sp)
+    return false;
+  const lldb::addr_t end = end_sp->GetValueAsUnsigned(LLDB_INVALID_ADDRESS);
+  if (end == LLDB_INVALID_ADDRESS || end < m_first_element ||
+      (end - m_first_element) % *element_size != 0)
+    return false;
+  m_count = (end - m_first_element) / *element_size;
+  return true;
+}
+
+bool DeclarativeSyntheticChildren::FrontEnd::UpdateList() {
+  ValueObjectSP head_sp = GetValueAtPath(m_layout.head);
+  if (!head_sp)
+    return false;
+  CompilerType node_type = head_sp->GetCompilerType().GetPointeeType();
+  if (!node_type.IsValid())
+    return false;
+
+  // Find the members of a node once instead of creating a value for every
+  // node.
+  bool found_next = false;
+  CompilerType value_type;
+  for (uint32_t idx = 0; idx < node_type.GetNumFields(); ++idx) {
+    std::string name;
+    uint64_t bit_offset = 0;
+    CompilerType field_type =
+        node_type.GetFieldAtIndex(idx, name, &bit_offset, nullptr, nullptr);
+    if (name == m_layout.next) {
+      found_next = field_type.IsPointerType();
+      m_next_offset = bit_offset / 8;
+    } else if (name == m_layout.value) {
+      value_type = field_type;
+      m_value_offset = bit_offset / 8;
+    }
+  }
+  if (!found_next || !value_type.IsValid())
+    return false;
+  m_element_type = GetElementType(value_type);
+
+  m_next_node = head_sp->GetValueAsUnsigned(0);
+  m_count = UINT32_MAX;
+  if (!m_layout.size.empty()) {
+    ValueObjectSP size_sp = GetValueAtPath(m_layout.size);
+    bool success = false;
+    if (size_sp)
+      m_count = size_sp->GetValueAsUnsigned(0, &success);
+    return success;
+  }
+  return true;
+}
+
+// Extend m_nodes to the first count nodes of the list, if it has that many,
+// by reading the next pointers from the memory cache of the process.
+bool DeclarativeSyntheticChildren::FrontEnd::ReadNodes(size_t count) {
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  while (m_nodes.size() < count) {
+    // A circular list ends when it comes back to a node, e.g. the first one.
+    if (!process_sp || m_next_node == 0 ||
+        m_next_node == LLDB_INVALID_ADDRESS ||
+        !m_visited_nodes.insert(m_next_node).second) {
+      m_next_node = LLDB_INVALID_ADDRESS;
+      return false;
+    }
+    m_nodes.push_back(m_next_node);
+
+    Status error;
+    const lldb::addr_t next_addr = m_nodes.back() + m_next_offset;
+    m_next_node = process_sp->ReadPointerFromMemory(next_addr, error);
+    if (error.Fail())
+      m_next_node = LLDB_INVALID_ADDRESS;
+  }
+  return true;
+}
+
+size_t DeclarativeSyntheticChildren::FrontEnd::CalculateNumChildren() {
+  if (m_count != UINT32_MAX)
+    return m_count;
+  // Don't walk more of a list than can be displayed.
+  uint32_t capping_size = 0;
+  if (TargetSP target_sp = m_backend.GetTargetSP())
+    capping_size = target_sp->GetMaximumNumberOfChildrenToDisplay();
+  return CalculateNumChildren(capping_size ? capping_size : 255);
+}
+
+size_t DeclarativeSyntheticChildren::FrontEnd::CalculateNumChildren(
+    uint32_t max) {
+  if (m_count != UINT32_MAX)
+    return std::min<size_t>(m_count, max);
+  if (!ReadNodes(max))
+    m_count = m_nodes.size();
+  return std::min<size_t>(m_nodes.size(), max);
+}
+
+lldb::ValueObjectSP
+DeclarativeSyntheticChildren::FrontEnd::GetChildAtIndex(size_t idx) {
+  if (m_element_size == 0 || (m_count != UINT32_MAX && idx >= m_count))
+    return lldb::ValueObjectSP();
+
+  lldb::addr_t address;
+  if (m_layout.kind == Layout::Kind::Array)
+    address = m_first_element + idx * m_element_size;
+  else if (ReadNodes(idx + 1))
+    address = m_nodes[idx] + m_value_offset;
+  else
+    return lldb::ValueObjectSP();
+
+  return CreateValueObjectFromAddress(llvm::formatv("[{0}]", idx).str(),
+                                      address,
+                                      m_backend.GetExecutionContextRef(),
+                                      m_element_type);
+}
+
+size_t DeclarativeSyntheticChildren::FrontEnd::GetIndexOfChildWithName(
+    ConstString name) {
+  return formatters::ExtractIndexFromString(name.GetCString());
+}
+
 ScriptedSyntheticChildren::FrontEnd::FrontEnd(std::string pclass,
                                               ValueObject &backend)
     : SyntheticChildrenFrontEnd(backend), m_python_class(pclass),
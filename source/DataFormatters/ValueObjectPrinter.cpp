@@ -13,37 +13,43 @@
 #include "lldb/Interpreter/CommandInterpreter.h"
 #include "lldb/Target/Language.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Utility/Log.h"
 #include "lldb/Utility/Stream.h"
 
+#include "llvm/Support/Chrono.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
 ValueObjectPrinter::ValueObjectPrinter(ValueObject *valobj, Stream *s) {
   if (valobj) {
     DumpValueObjectOptions options(*valobj);
-    Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr);
+    Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr, nullptr);
   } else {
     DumpValueObjectOptions options;
-    Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr);
+    Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr, nullptr);
   }
 }
 
 ValueObjectPrinter::ValueObjectPrinter(ValueObject *valobj, Stream *s,
                                        const DumpValueObjectOptions &options) {
-  Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr);
+  Init(valobj, s, options, m_options.m_max_ptr_depth, 0, nullptr, nullptr);
 }
 
 ValueObjectPrinter::ValueObjectPrinter(
     ValueObject *valobj, Stream *s, const DumpValueObjectOptions &options,
     const DumpValueObjectOptions::PointerDepth &ptr_depth, uint32_t curr_depth,
-    InstancePointersSetSP printed_instance_pointers) {
-  Init(valobj, s, options, ptr_depth, curr_depth, printed_instance_pointers);
+    InstancePointersSetSP printed_instance_pointers,
+    PrintStateSP print_state) {
+  Init(valobj, s, options, ptr_depth, curr_depth, printed_instance_pointers,
+       print_state);
 }
 
 void ValueObjectPrinter::Init(
     ValueObject *valobj, Stream *s, const DumpValueObjectOptions &options,
     const DumpValueObjectOptions::PointerDepth &ptr_depth, uint32_t curr_depth,
-    InstancePointersSetSP printed_instance_pointers) {
+    InstancePointersSetSP printed_instance_pointers,
+    PrintStateSP print_state) {
   m_orig_valobj = valobj;
   m_valobj = nullptr;
   m_stream = s;
@@ -68,12 +74,30 @@ void ValueObjectPrinter::Init(
       printed_instance_pointers
           ? printed_instance_pointers
           : InstancePointersSetSP(new InstancePointersSet());
+  m_owns_print_state = !print_state;
+  m_print_state = print_state ? print_state : std::make_shared<PrintState>();
+  if (m_owns_print_state) {
+    m_print_state->m_start = std::chrono::steady_clock::now();
+    m_print_state->m_start_bytes = m_stream->GetWrittenBytes();
+    m_print_state->m_measure_time =
+        GetLogIfAllCategoriesSet(LIBLLDB_LOG_DATAFORMATTERS) != nullptr;
+  }
 }
 
 bool ValueObjectPrinter::PrintValueObject() {
   if (!GetMostSpecializedValue() || m_valobj == nullptr)
     return false;
 
+  PrintState &state = *m_print_state;
+  ++state.m_num_values;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::nanoseconds parent_children_time(0);
+  if (state.m_measure_time) {
+    start = std::chrono::steady_clock::now();
+    parent_children_time = state.m_children_time;
+    state.m_children_time = std::chrono::nanoseconds(0);
+  }
+
   if (ShouldPrintValueObject()) {
     PrintLocationIfNeeded();
     m_stream->Indent();
@@ -92,9 +116,88 @@ bool ValueObjectPrinter::PrintValueObject() {
   else
     m_stream->EOL();
 
+  if (state.m_measure_time) {
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+    auto &type_time =
+        state.m_time_by_type[m_valobj->GetDisplayTypeName().GetStringRef()];
+    type_time.first += elapsed - state.m_children_time;
+    ++type_time.second;
+    state.m_children_time = parent_children_time + elapsed;
+  }
+
+  if (m_owns_print_state)
+    FinishPrinting();
+
   return true;
 }
 
+bool ValueObjectPrinter::ShouldStopPrinting() {
+  PrintState &state = *m_print_state;
+  if (state.m_stop_reason != PrintState::StopReason::None)
+    return true;
+
+  const DumpValueObjectOptions::PrintBudget &budget = m_options.m_print_budget;
+  TargetSP target_sp = m_valobj->GetTargetSP();
+  if (target_sp &&
+      target_sp->GetDebugger().GetCommandInterpreter().WasInterrupted())
+    state.m_stop_reason = PrintState::StopReason::Interrupted;
+  else if (budget.m_values && state.m_num_values >= budget.m_values)
+    state.m_stop_reason = PrintState::StopReason::Values;
+  else if (budget.m_bytes &&
+           m_stream->GetWrittenBytes() - state.m_start_bytes >= budget.m_bytes)
+    state.m_stop_reason = PrintState::StopReason::Bytes;
+  else if (budget.m_time.count() &&
+           std::chrono::steady_clock::now() - state.m_start >= budget.m_time)
+    state.m_stop_reason = PrintState::StopReason::Time;
+  return state.m_stop_reason != PrintState::StopReason::None;
+}
+
+void ValueObjectPrinter::FinishPrinting() {
+  PrintState &state = *m_print_state;
+  const DumpValueObjectOptions::PrintBudget &budget = m_options.m_print_budget;
+  switch (state.m_stop_reason) {
+  case PrintState::StopReason::None:
+    break;
+  case PrintState::StopReason::Time:
+    m_stream->Printf("*** Some children were elided after printing for %" PRIu64
+                     " ms, the value of target.max-value-print-time.\n",
+                     static_cast<uint64_t>(budget.m_time.count()));
+    break;
+  case PrintState::StopReason::Bytes:
+    m_stream->Printf("*** Some children were elided after printing %" PRIu64
+                     " bytes, the value of target.max-value-print-bytes.\n",
+                     budget.m_bytes);
+    break;
+  case PrintState::StopReason::Values:
+    m_stream->Printf("*** Some children were elided after printing %" PRIu64
+                     " values, the value of target.max-value-print-values.\n",
+                     budget.m_values);
+    break;
+  case PrintState::StopReason::Interrupted:
+    m_stream->PutCString("... Interrupted.\n");
+    break;
+  }
+
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_DATAFORMATTERS));
+  if (!log || !state.m_measure_time)
+    return;
+  std::vector<std::pair<llvm::StringRef, std::pair<std::chrono::nanoseconds,
+                                                   uint64_t>>>
+      times;
+  for (const auto &entry : state.m_time_by_type)
+    times.emplace_back(entry.getKey(), entry.getValue());
+  llvm::sort(times, [](const auto &lhs, const auto &rhs) {
+    return lhs.second.first > rhs.second.first;
+  });
+  LLDB_LOG(log, "Printed {0} values in {1}", state.m_num_values,
+           std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - state.m_start));
+  for (const auto &entry : times)
+    LLDB_LOG(log, "  {0} values of type {1} took {2}", entry.second.second,
+             entry.first,
+             std::chrono::duration<double, std::milli>(entry.second.first));
+}
+
 bool ValueObjectPrinter::GetMostSpecializedValue() {
   if (m_valobj)
     return true;
@@ -581,7 +684,8 @@ void ValueObjectPrinter::PrintChild(
     ValueObjectPrinter child_printer(
         child_sp.get(), m_stream, child_options,
         does_consume_ptr_depth ? --curr_ptr_depth : curr_ptr_depth,
-        m_curr_depth + consumed_depth, m_printed_instance_pointers);
+        m_curr_depth + consumed_depth, m_printed_instance_pointers,
+        m_print_state);
     child_printer.PrintValueObject();
   }
 }
@@ -670,8 +774,15 @@ void ValueObjectPrinter::PrintChildren(
   size_t num_children = GetMaxNumChildrenToPrint(print_dotdotdot);
   if (num_children) {
     bool any_children_printed = false;
+    bool stopped = false;
 
     for (size_t idx = 0; idx < num_children; ++idx) {
+      // Check the budget before creating each child, as it is what can take
+      // long, e.g. for a synthetic child of a large container.
+      if (ShouldStopPrinting()) {
+        stopped = true;
+        break;
+      }
       if (ValueObjectSP child_sp = GenerateChild(synth_m_valobj, idx)) {
         if (!any_children_printed) {
           PrintChildrenPreamble();
@@ -681,9 +792,16 @@ void ValueObjectPrinter::PrintChildren(
       }
     }
 
-    if (any_children_printed)
-      PrintChildrenPostamble(print_dotdotdot);
-    else {
+    if (any_children_printed) {
+      if (stopped && !m_options.m_flat_output)
+        m_stream->Indent("...\n");
+      PrintChildrenPostamble(print_dotdotdot && !stopped);
+    } else if (stopped) {
+      if (ShouldPrintValueObject())
+        m_stream->PutCString(" {...}\n");
+      else
+        m_stream->EOL();
+    } else {
       if (ShouldPrintEmptyBrackets(value_printed, summary_printed)) {
         if (ShouldPrintValueObject())
           m_stream->PutCString(" {}\n");
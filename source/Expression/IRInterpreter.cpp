@@ -23,6 +23,7 @@
 
 #include "lldb/Target/ABI.h"
 #include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Target/Thread.h"
 #include "lldb/Target/ThreadPlan.h"
@@ -36,8 +37,10 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Operator.h"
+#include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
 #include <map>
 
 using namespace llvm;
@@ -81,6 +84,8 @@ static bool CanIgnoreCall(const CallInst *call) {
       break;
     case llvm::Intrinsic::dbg_declare:
     case llvm::Intrinsic::dbg_value:
+    case llvm::Intrinsic::lifetime_start:
+    case llvm::Intrinsic::lifetime_end:
       return true;
     }
   }
@@ -88,6 +93,158 @@ static bool CanIgnoreCall(const CallInst *call) {
   return false;
 }
 
+/// The largest block of memory the memory intrinsics and the string
+/// functions below read or write.
+static const uint64_t max_memory_operation_size = 1 << 20;
+
+static bool IsMemoryIntrinsic(const CallInst *call) {
+  const llvm::Function *called_function = call->getCalledFunction();
+
+  if (!called_function || !called_function->isIntrinsic())
+    return false;
+
+  switch (called_function->getIntrinsicID()) {
+  default:
+    return false;
+  case llvm::Intrinsic::memcpy:
+  case llvm::Intrinsic::memmove:
+  case llvm::Intrinsic::memset:
+    return true;
+  }
+}
+
+/// Functions of the C library that the interpreter evaluates itself by
+/// reading the memory they would read, as they have no side effects. Calls
+/// to them are assumed to have the semantics of the C standard.
+enum class KnownFunction { None, Strlen, Strcmp, Strncmp, Memcmp, Abs };
+
+static KnownFunction GetKnownFunction(const CallInst *call) {
+  // Functions without a prototype in the expression are called through a
+  // bitcast of their declaration.
+  const llvm::Function *called_function =
+      dyn_cast<llvm::Function>(call->getCalledOperand()->stripPointerCasts());
+
+  if (!called_function || !called_function->isDeclaration() ||
+      !call->getType()->isIntegerTy() ||
+      call->getType()->getIntegerBitWidth() > 64)
+    return KnownFunction::None;
+
+  KnownFunction known_function =
+      llvm::StringSwitch<KnownFunction>(called_function->getName())
+          .Case("strlen", KnownFunction::Strlen)
+          .Case("strcmp", KnownFunction::Strcmp)
+          .Case("strncmp", KnownFunction::Strncmp)
+          .Case("memcmp", KnownFunction::Memcmp)
+          .Cases("abs", "labs", "llabs", KnownFunction::Abs)
+          .Default(KnownFunction::None);
+
+  // The number of arguments and how many of them, first, are pointers.
+  unsigned num_args = 0;
+  unsigned num_pointer_args = 0;
+  switch (known_function) {
+  case KnownFunction::None:
+    return KnownFunction::None;
+  case KnownFunction::Strlen:
+    num_args = num_pointer_args = 1;
+    break;
+  case KnownFunction::Strcmp:
+    num_args = num_pointer_args = 2;
+    break;
+  case KnownFunction::Strncmp:
+  case KnownFunction::Memcmp:
+    num_args = 3;
+    num_pointer_args = 2;
+    break;
+  case KnownFunction::Abs:
+    num_args = 1;
+    break;
+  }
+
+  if (call->getNumArgOperands() != num_args)
+    return KnownFunction::None;
+  for (unsigned i = 0; i < num_args; ++i) {
+    Type *arg_type = call->getArgOperand(i)->getType();
+    if (i < num_pointer_args ? !arg_type->isPointerTy()
+                             : !arg_type->isIntegerTy())
+      return KnownFunction::None;
+  }
+
+  // Comparisons of more memory than the interpreter reads are left to the
+  // JIT when their size is known up front.
+  if (known_function == KnownFunction::Strncmp ||
+      known_function == KnownFunction::Memcmp) {
+    if (const auto *size = dyn_cast<ConstantInt>(call->getArgOperand(2)))
+      if (size->getValue().ugt(max_memory_operation_size))
+        return KnownFunction::None;
+  }
+  return known_function;
+}
+
+/// Compare the memory at \a lhs and \a rhs like memcmp, or like strncmp if
+/// \a stop_at_nul is true. The memory is read in chunks that don't cross a
+/// 64-byte boundary, so that comparing strings never reads a page past the
+/// first difference or terminator. Comparisons that go on past
+/// max_memory_operation_size bytes fail like StringLength does.
+static bool CompareMemory(lldb_private::IRExecutionUnit &execution_unit,
+                          lldb::addr_t lhs, lldb::addr_t rhs, uint64_t size,
+                          bool stop_at_nul, int &result,
+                          lldb_private::Status &error) {
+  const uint64_t chunk_size = 64;
+  uint8_t lhs_chunk[chunk_size];
+  uint8_t rhs_chunk[chunk_size];
+
+  result = 0;
+  uint64_t remaining = std::min(size, max_memory_operation_size);
+  while (remaining) {
+    const uint64_t count =
+        std::min({remaining, chunk_size - lhs % chunk_size,
+                  chunk_size - rhs % chunk_size});
+    execution_unit.ReadMemory(lhs_chunk, lhs, count, error);
+    if (error.Fail())
+      return false;
+    execution_unit.ReadMemory(rhs_chunk, rhs, count, error);
+    if (error.Fail())
+      return false;
+    for (uint64_t i = 0; i < count; ++i) {
+      if (lhs_chunk[i] != rhs_chunk[i]) {
+        result = lhs_chunk[i] < rhs_chunk[i] ? -1 : 1;
+        return true;
+      }
+      if (stop_at_nul && !lhs_chunk[i])
+        return true;
+    }
+    lhs += count;
+    rhs += count;
+    remaining -= count;
+  }
+  if (size > max_memory_operation_size) {
+    error.SetErrorString("comparison is too long");
+    return false;
+  }
+  return true;
+}
+
+static bool StringLength(lldb_private::IRExecutionUnit &execution_unit,
+                         lldb::addr_t str, uint64_t &length,
+                         lldb_private::Status &error) {
+  const uint64_t chunk_size = 64;
+  uint8_t chunk[chunk_size];
+
+  length = 0;
+  while (length < max_memory_operation_size) {
+    const uint64_t count = chunk_size - (str + length) % chunk_size;
+    execution_unit.ReadMemory(chunk, str + length, count, error);
+    if (error.Fail())
+      return false;
+    const uint8_t *nul = std::find(chunk, chunk + count, 0);
+    length += nul - chunk;
+    if (nul != chunk + count)
+      return true;
+  }
+  error.SetErrorString("string is too long");
+  return false;
+}
+
 class InterpreterStackFrame {
 public:
   typedef std::map<const Value *, lldb::addr_t> ValueMap;
@@ -443,10 +600,152 @@ static const char *memory_allocation_error =
     "Interpreter couldn't allocate memory";
 static const char *memory_write_error = "Interpreter couldn't write to memory";
 static const char *memory_read_error = "Interpreter couldn't read from memory";
-static const char *infinite_loop_error = "Interpreter ran for too many cycles";
+static const char *infinite_loop_error =
+    "Interpreter ran for too many cycles, see "
+    "target.expr-interpreter-instruction-limit";
 static const char *too_many_functions_error =
     "Interpreter doesn't handle modules with multiple function bodies.";
 
+/// Copy or set memory on behalf of a call to llvm.memcpy, llvm.memmove or
+/// llvm.memset.
+static bool InterpretMemoryIntrinsic(const CallInst *call,
+                                     InterpreterStackFrame &frame,
+                                     llvm::Module &module,
+                                     lldb_private::Status &error) {
+  lldb_private::Log *log(
+      lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+
+  lldb_private::Scalar dest;
+  lldb_private::Scalar source;
+  lldb_private::Scalar size;
+  if (!frame.EvaluateValue(dest, call->getArgOperand(0), module) ||
+      !frame.EvaluateValue(source, call->getArgOperand(1), module) ||
+      !frame.EvaluateValue(size, call->getArgOperand(2), module)) {
+    LLDB_LOGF(log, "Couldn't evaluate the arguments of %s",
+              PrintValue(call).c_str());
+    error.SetErrorToGenericError();
+    error.SetErrorString(bad_value_error);
+    return false;
+  }
+
+  const uint64_t byte_size = size.ULongLong();
+  if (byte_size > max_memory_operation_size) {
+    LLDB_LOGF(log, "Memory intrinsic of %" PRIu64 " bytes is too large",
+              byte_size);
+    error.SetErrorToGenericError();
+    error.SetErrorString(memory_allocation_error);
+    return false;
+  }
+
+  lldb_private::DataBufferHeap buffer(byte_size, 0);
+  const bool is_memset =
+      call->getCalledFunction()->getIntrinsicID() == llvm::Intrinsic::memset;
+  if (is_memset) {
+    memset(buffer.GetBytes(), source.UInt(), byte_size);
+  } else {
+    frame.m_execution_unit.ReadMemory(buffer.GetBytes(),
+                                      source.ULongLong(), byte_size, error);
+    if (!error.Success()) {
+      LLDB_LOGF(log, "Couldn't read the source of %s",
+                PrintValue(call).c_str());
+      error.SetErrorString(memory_read_error);
+      return false;
+    }
+  }
+
+  frame.m_execution_unit.WriteMemory(dest.ULongLong(), buffer.GetBytes(),
+                                     byte_size, error);
+  if (!error.Success()) {
+    LLDB_LOGF(log, "Couldn't write the destination of %s",
+              PrintValue(call).c_str());
+    error.SetErrorString(memory_write_error);
+    return false;
+  }
+
+  if (log) {
+    LLDB_LOGF(log, "Interpreted a %s", is_memset ? "memset" : "memory copy");
+    LLDB_LOGF(log, "  Dest : 0x%" PRIx64, dest.ULongLong());
+    LLDB_LOGF(log, "  Size : %" PRIu64, byte_size);
+  }
+  return true;
+}
+
+/// Compute the result of a call to a KnownFunction.
+static bool InterpretKnownFunction(const CallInst *call,
+                                   KnownFunction known_function,
+                                   InterpreterStackFrame &frame,
+                                   llvm::Module &module,
+                                   lldb_private::Status &error) {
+  lldb_private::Log *log(
+      lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+
+  std::vector<lldb_private::Scalar> args(call->getNumArgOperands());
+  for (unsigned i = 0; i < args.size(); ++i) {
+    if (!frame.EvaluateValue(args[i], call->getArgOperand(i), module)) {
+      LLDB_LOGF(log, "Couldn't evaluate %s",
+                PrintValue(call->getArgOperand(i)).c_str());
+      error.SetErrorToGenericError();
+      error.SetErrorString(bad_value_error);
+      return false;
+    }
+  }
+
+  lldb_private::IRExecutionUnit &execution_unit = frame.m_execution_unit;
+  lldb_private::Scalar result;
+  bool success = true;
+  switch (known_function) {
+  case KnownFunction::None:
+    llvm_unreachable("not a known function");
+  case KnownFunction::Strlen: {
+    uint64_t length = 0;
+    success = StringLength(execution_unit, args[0].ULongLong(), length, error);
+    result = lldb_private::Scalar(length);
+    break;
+  }
+  case KnownFunction::Strcmp:
+  case KnownFunction::Strncmp:
+  case KnownFunction::Memcmp: {
+    const uint64_t size = known_function == KnownFunction::Strcmp
+                              ? UINT64_MAX
+                              : args[2].ULongLong();
+    int comparison = 0;
+    success = CompareMemory(execution_unit, args[0].ULongLong(),
+                            args[1].ULongLong(), size,
+                            known_function != KnownFunction::Memcmp,
+                            comparison, error);
+    result = lldb_private::Scalar(comparison);
+    break;
+  }
+  case KnownFunction::Abs: {
+    // The argument is extended to 64 bits according to its own width, and
+    // the result truncated back to it.
+    const unsigned bits =
+        call->getArgOperand(0)->getType()->getIntegerBitWidth();
+    const int64_t value = llvm::SignExtend64(args[0].ULongLong(), bits);
+    const uint64_t magnitude = value < 0 ? 0 - static_cast<uint64_t>(value)
+                                         : static_cast<uint64_t>(value);
+    result = lldb_private::Scalar(static_cast<unsigned long long>(magnitude));
+    break;
+  }
+  }
+
+  // The error is the one of the memory read, or says that the call reads
+  // more memory than the interpreter does.
+  if (!success) {
+    LLDB_LOGF(log, "Couldn't interpret %s: %s", PrintValue(call).c_str(),
+              error.AsCString());
+    return false;
+  }
+
+  frame.AssignValue(call, result, module);
+
+  if (log) {
+    LLDB_LOGF(log, "Interpreted a call to a known function");
+    LLDB_LOGF(log, "  = : %s", frame.SummarizeValue(call).c_str());
+  }
+  return true;
+}
+
 static bool CanResolveConstant(llvm::Constant *constant) {
   switch (constant->getValueID()) {
   default:
@@ -481,6 +780,23 @@ static bool CanResolveConstant(llvm::Constant *constant) {
   }
 }
 
+static bool IsSupportedVectorOperand(const Instruction &inst,
+                                     Type *vector_type, llvm::Module &module) {
+  switch (inst.getOpcode()) {
+  default:
+    return false;
+  case Instruction::ExtractElement:
+  case Instruction::InsertElement:
+  case Instruction::Load:
+  case Instruction::Store:
+    break;
+  }
+  // The elements must be whole bytes, as the interpreter copies them.
+  const uint64_t element_bits = module.getDataLayout().getTypeSizeInBits(
+      cast<FixedVectorType>(vector_type)->getElementType());
+  return element_bits % 8 == 0 && element_bits <= 64;
+}
+
 bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
                                  lldb_private::Status &error,
                                  const bool support_function_calls) {
@@ -524,7 +840,9 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
           return false;
         }
 
-        if (!CanIgnoreCall(call_inst) && !support_function_calls) {
+        if (!CanIgnoreCall(call_inst) && !IsMemoryIntrinsic(call_inst) &&
+            GetKnownFunction(call_inst) == KnownFunction::None &&
+            !support_function_calls) {
           LLDB_LOGF(log, "Unsupported instruction: %s",
                     PrintValue(&ii).c_str());
           error.SetErrorToGenericError();
@@ -532,7 +850,11 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
           return false;
         }
       } break;
+      case Instruction::ExtractElement:
       case Instruction::GetElementPtr:
+      case Instruction::InsertElement:
+      case Instruction::Select:
+      case Instruction::Switch:
         break;
       case Instruction::ICmp: {
         ICmpInst *icmp_inst = dyn_cast<ICmpInst>(&ii);
@@ -596,6 +918,11 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
         default:
           break;
         case Type::FixedVectorTyID:
+          // Vectors are only loaded, stored and accessed element by element,
+          // which copies their bytes.
+          if (IsSupportedVectorOperand(ii, operand_type, module))
+            break;
+          LLVM_FALLTHROUGH;
         case Type::ScalableVectorTyID: {
           LLDB_LOGF(log, "Unsupported operand type: %s",
                     PrintType(operand_type).c_str());
@@ -608,7 +935,8 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
         // 128-bit integers. As they're not that frequent,
         // we can just fall back to the JIT rather than
         // choking.
-        if (operand_type->getPrimitiveSizeInBits() > 64) {
+        if (!operand_type->isVectorTy() &&
+            operand_type->getPrimitiveSizeInBits() > 64) {
           LLDB_LOGF(log, "Unsupported operand type: %s",
                     PrintType(operand_type).c_str());
           error.SetErrorString(unsupported_operand_error);
@@ -676,11 +1004,17 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
     frame.MakeArgument(&*ai, ptr);
   }
 
-  uint32_t num_insts = 0;
+  // Bounds the time spent in loops, e.g. infinite ones.
+  lldb_private::Target *target = exe_ctx.GetTargetPtr();
+  const uint64_t instruction_limit =
+      target ? target->GetExprInterpreterInstructionLimit()
+             : lldb_private::Target::GetGlobalProperties()
+                   ->GetExprInterpreterInstructionLimit();
+  uint64_t num_insts = 0;
 
   frame.Jump(&function.front());
 
-  while (frame.m_ii != frame.m_ie && (++num_insts < 4096)) {
+  while (frame.m_ii != frame.m_ie && (++num_insts < instruction_limit)) {
     const Instruction *inst = &*frame.m_ii;
 
     LLDB_LOGF(log, "Interpreting %s", PrintValue(inst).c_str());
@@ -931,6 +1265,71 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
       }
     }
       continue;
+    case Instruction::Switch: {
+      const SwitchInst *switch_inst = cast<SwitchInst>(inst);
+      Value *condition = switch_inst->getCondition();
+
+      lldb_private::Scalar C;
+
+      if (!frame.EvaluateValue(C, condition, module)) {
+        LLDB_LOGF(log, "Couldn't evaluate %s", PrintValue(condition).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      const BasicBlock *destination = switch_inst->getDefaultDest();
+      for (auto switch_case : switch_inst->cases()) {
+        lldb_private::Scalar case_value;
+        if (!frame.EvaluateValue(case_value, switch_case.getCaseValue(),
+                                 module)) {
+          error.SetErrorToGenericError();
+          error.SetErrorString(bad_value_error);
+          return false;
+        }
+        if (case_value == C) {
+          destination = switch_case.getCaseSuccessor();
+          break;
+        }
+      }
+      frame.Jump(destination);
+
+      if (log) {
+        LLDB_LOGF(log, "Interpreted a SwitchInst");
+        LLDB_LOGF(log, "  cond : %s", frame.SummarizeValue(condition).c_str());
+      }
+    }
+      continue;
+    case Instruction::Select: {
+      const SelectInst *select_inst = cast<SelectInst>(inst);
+      const Value *condition = select_inst->getCondition();
+
+      lldb_private::Scalar C;
+
+      if (!frame.EvaluateValue(C, condition, module)) {
+        LLDB_LOGF(log, "Couldn't evaluate %s", PrintValue(condition).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      const Value *value = C.IsZero() ? select_inst->getFalseValue()
+                                      : select_inst->getTrueValue();
+      lldb_private::Scalar result;
+      if (!frame.EvaluateValue(result, value, module)) {
+        LLDB_LOGF(log, "Couldn't evaluate %s", PrintValue(value).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+      frame.AssignValue(inst, result, module);
+
+      if (log) {
+        LLDB_LOGF(log, "Interpreted a SelectInst");
+        LLDB_LOGF(log, "  cond : %s", frame.SummarizeValue(condition).c_str());
+        LLDB_LOGF(log, "  =    : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
     case Instruction::PHI: {
       const PHINode *phi_inst = cast<PHINode>(inst);
       if (!frame.m_prev_bb) {
@@ -1020,6 +1419,95 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
         LLDB_LOGF(log, "  Poffset : %s", frame.SummarizeValue(inst).c_str());
       }
     } break;
+    case Instruction::ExtractElement:
+    case Instruction::InsertElement: {
+      // The semantics of ExtractElement and InsertElement are:
+      //   Resolve the region V containing the vector
+      //   Resolve the region D that will contain the result
+      //   Transfer the indexed element of V to D, or copy V to D and
+      //   transfer the inserted element into the indexed element of D
+
+      const bool is_extract = inst->getOpcode() == Instruction::ExtractElement;
+      const Value *vector_operand = inst->getOperand(0);
+      const Value *index_operand = inst->getOperand(is_extract ? 1 : 2);
+      auto *vector_ty = cast<FixedVectorType>(vector_operand->getType());
+      const size_t element_size =
+          data_layout.getTypeStoreSize(vector_ty->getElementType());
+
+      lldb_private::Scalar I;
+
+      if (!frame.EvaluateValue(I, index_operand, module)) {
+        LLDB_LOGF(log, "Couldn't evaluate %s",
+                  PrintValue(index_operand).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      const uint64_t index = I.ULongLong();
+      if (index >= vector_ty->getNumElements()) {
+        LLDB_LOGF(log, "Vector index %" PRIu64 " is out of range", index);
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      lldb::addr_t V = frame.ResolveValue(vector_operand, module);
+      lldb::addr_t D = frame.ResolveValue(inst, module);
+
+      if (V == LLDB_INVALID_ADDRESS || D == LLDB_INVALID_ADDRESS) {
+        LLDB_LOGF(log, "Vector or result doesn't resolve to anything");
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      // The element is copied from or to memory next to the vector's.
+      lldb::addr_t element_source = V + index * element_size;
+      lldb::addr_t element_dest = D;
+      size_t copy_size = data_layout.getTypeStoreSize(vector_ty);
+      if (!is_extract) {
+        element_source = frame.ResolveValue(inst->getOperand(1), module);
+        element_dest = D + index * element_size;
+        if (element_source == LLDB_INVALID_ADDRESS) {
+          LLDB_LOGF(log, "InsertElement's element doesn't resolve to anything");
+          error.SetErrorToGenericError();
+          error.SetErrorString(bad_value_error);
+          return false;
+        }
+      }
+
+      lldb_private::DataBufferHeap buffer(std::max(copy_size, element_size),
+                                          0);
+      lldb_private::Status memory_error;
+      if (!is_extract) {
+        execution_unit.ReadMemory(buffer.GetBytes(), V, copy_size,
+                                  memory_error);
+        if (memory_error.Success())
+          execution_unit.WriteMemory(D, buffer.GetBytes(), copy_size,
+                                     memory_error);
+      }
+      if (memory_error.Success())
+        execution_unit.ReadMemory(buffer.GetBytes(), element_source,
+                                  element_size, memory_error);
+      if (memory_error.Success())
+        execution_unit.WriteMemory(element_dest, buffer.GetBytes(),
+                                   element_size, memory_error);
+      if (!memory_error.Success()) {
+        LLDB_LOGF(log, "Couldn't copy the element of a %s",
+                  inst->getOpcodeName());
+        error.SetErrorToGenericError();
+        error.SetErrorString(memory_write_error);
+        return false;
+      }
+
+      if (log) {
+        LLDB_LOGF(log, "Interpreted a %s", inst->getOpcodeName());
+        LLDB_LOGF(log, "  V : 0x%" PRIx64, V);
+        LLDB_LOGF(log, "  I : %" PRIu64, index);
+        LLDB_LOGF(log, "  D : 0x%" PRIx64, D);
+      }
+    } break;
     case Instruction::ICmp: {
       const ICmpInst *icmp_inst = cast<ICmpInst>(inst);
 
@@ -1337,6 +1825,20 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
       if (CanIgnoreCall(call_inst))
         break;
 
+      if (IsMemoryIntrinsic(call_inst)) {
+        if (!InterpretMemoryIntrinsic(call_inst, frame, module, error))
+          return false;
+        break;
+      }
+
+      KnownFunction known_function = GetKnownFunction(call_inst);
+      if (known_function != KnownFunction::None) {
+        if (!InterpretKnownFunction(call_inst, known_function, frame, module,
+                                    error))
+          return false;
+        break;
+      }
+
       // Get the return type
       llvm::Type *returnType = call_inst->getType();
       if (returnType == nullptr) {
@@ -1528,7 +2030,7 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
     ++frame.m_ii;
   }
 
-  if (num_insts >= 4096) {
+  if (num_insts >= instruction_limit) {
     error.SetErrorToGenericError();
     error.SetErrorString(infinite_loop_error);
     return false;
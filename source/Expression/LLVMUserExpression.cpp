@@ -91,6 +91,11 @@ LLVMUserExpression::DoExecute(DiagnosticManager &diagnostic_manager,
   lldb::addr_t function_stack_bottom = LLDB_INVALID_ADDRESS;
   lldb::addr_t function_stack_top = LLDB_INVALID_ADDRESS;
 
+  if (Target *target = exe_ctx.GetTargetPtr())
+    target->IncrementStats(m_can_interpret
+                               ? StatisticKind::ExpressionInterpreted
+                               : StatisticKind::ExpressionJIT);
+
   if (m_can_interpret) {
     llvm::Module *module = m_execution_unit_sp->GetModule();
     llvm::Function *function = m_execution_unit_sp->GetFunction();
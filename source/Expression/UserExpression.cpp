@@ -26,6 +26,7 @@
 #include "lldb/Expression/IRInterpreter.h"
 #include "lldb/Expression/Materializer.h"
 #include "lldb/Expression/UserExpression.h"
+#include "lldb/Expression/UserExpressionCache.h"
 #include "lldb/Host/HostInfo.h"
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/Function.h"
@@ -219,34 +220,78 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, ctx_obj,
-                                           error));
-  if (error.Fail()) {
-    LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
-             error.AsCString());
-    return lldb::eExpressionSetupError;
-  }
-
-  LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
-           expr.str());
-
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
 
+  // Expressions mentioning persistent variables are always parsed, as they
+  // may declare them or refer to ones that were redeclared since. So are
+  // the ones whose meaning depends on more than the frame they are parsed
+  // in.
+  UserExpressionCache &expression_cache = target->GetUserExpressionCache();
+  llvm::Optional<UserExpressionCache::Key> cache_key;
+  if (target->GetEnableExpressionCache() && !ctx_obj &&
+      execution_policy != eExecutionPolicyTopLevel &&
+      !options.GetREPLEnabled() && !expr.contains('$')) {
+    StackFrame *frame = exe_ctx.GetFramePtr();
+    cache_key = UserExpressionCache::Key{
+        expr.str(),
+        full_prefix.str(),
+        language,
+        desired_type,
+        execution_policy,
+        generate_debug_info,
+        target->GetImportStdModule(),
+        frame ? frame->GetFrameCodeAddress().GetLoadAddress(target)
+              : LLDB_INVALID_ADDRESS};
+  }
+
+  lldb::UserExpressionSP user_expression_sp;
+  if (cache_key) {
+    user_expression_sp = expression_cache.Take(*cache_key, exe_ctx);
+    target->IncrementStats(user_expression_sp
+                               ? StatisticKind::ExpressionCacheHit
+                               : StatisticKind::ExpressionCacheMiss);
+  }
+  const bool reused_expression = user_expression_sp != nullptr;
+
+  if (!reused_expression) {
+    user_expression_sp.reset(target->GetUserExpressionForLanguage(
+        expr, full_prefix, language, desired_type, options, ctx_obj, error));
+    if (error.Fail()) {
+      LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
+               error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
+  }
+
   if (options.InvokeCancelCallback(lldb::eExpressionEvaluationParse)) {
     error.SetErrorString("expression interrupted by callback before parse");
     result_valobj_sp = ValueObjectConstResult::Create(
         exe_ctx.GetBestExecutionContextScope(), error);
+    if (reused_expression)
+      expression_cache.Insert(*cache_key, user_expression_sp);
     return lldb::eExpressionInterrupted;
   }
 
   DiagnosticManager diagnostic_manager;
 
-  bool parse_success =
-      user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
-                                keep_expression_in_memory, generate_debug_info);
+  bool parse_success = true;
+  if (reused_expression) {
+    LLDB_LOG(log,
+             "== [UserExpression::Evaluate] Reusing parsed expression {0} ==",
+             expr.str());
+  } else {
+    LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
+             expr.str());
+    auto parse_start = std::chrono::steady_clock::now();
+    parse_success = user_expression_sp->Parse(
+        diagnostic_manager, exe_ctx, execution_policy,
+        keep_expression_in_memory, generate_debug_info);
+    LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing took {0:f3} ms ==",
+             std::chrono::duration<double, std::milli>(
+                 std::chrono::steady_clock::now() - parse_start)
+                 .count());
+  }
 
   // Calculate the fixed expression always, since we need it for errors.
   std::string tmp_fixed_expression;
@@ -262,6 +307,8 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
     // Delete the expression that failed to parse before attempting to parse
     // the next expression.
     user_expression_sp.reset();
+    // A fixed expression must not be found under the original text.
+    cache_key.reset();
 
     execution_results = lldb::eExpressionParseError;
     if (fixed_expression && !fixed_expression->empty() &&
@@ -325,6 +372,9 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
         error.SetExpressionError(lldb::eExpressionSetupError,
                                  "expression needed to run but couldn't");
     } else if (execution_policy == eExecutionPolicyTopLevel) {
+      // The new declarations may change what the names used by the cached
+      // expressions refer to.
+      expression_cache.Clear();
       error.SetError(UserExpression::kNoResult, lldb::eErrorTypeGeneric);
       return lldb::eExpressionCompleted;
     } else {
@@ -345,6 +395,11 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
           user_expression_sp->Execute(diagnostic_manager, exe_ctx, options,
                                       user_expression_sp, expr_result);
 
+      // An expression that didn't complete may still be referenced by the
+      // thread plan that ran it, and must not be executed again.
+      if (cache_key && execution_results == lldb::eExpressionCompleted)
+        expression_cache.Insert(*cache_key, user_expression_sp);
+
       if (execution_results != lldb::eExpressionCompleted) {
         LLDB_LOG(log, "== [UserExpression::Evaluate] Execution completed "
                       "abnormally ==");
@@ -0,0 +1,82 @@
+//===-- UserExpressionCache.cpp -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/UserExpressionCache.h"
+#include "lldb/Expression/UserExpression.h"
+
+#include <algorithm>
+#include <tuple>
+
+using namespace lldb;
+using namespace lldb_private;
+
+bool UserExpressionCache::Key::operator<(const Key &rhs) const {
+  return std::tie(text, prefix, language, desired_type, execution_policy,
+                  generate_debug_info, import_std_module, frame_pc) <
+         std::tie(rhs.text, rhs.prefix, rhs.language, rhs.desired_type,
+                  rhs.execution_policy, rhs.generate_debug_info,
+                  rhs.import_std_module, rhs.frame_pc);
+}
+
+UserExpressionCache::UserExpressionCache(size_t max_size)
+    : m_max_size(max_size) {}
+
+UserExpressionSP UserExpressionCache::Take(const Key &key,
+                                           ExecutionContext &exe_ctx) {
+  UserExpressionSP expr_sp;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+      return UserExpressionSP();
+    expr_sp = std::move(it->second.expr_sp);
+    m_entries.erase(it);
+  }
+
+  // The expression was parsed for a process that is gone, e.g. because the
+  // program was relaunched.
+  if (!expr_sp->MatchesContext(exe_ctx))
+    return UserExpressionSP();
+  return expr_sp;
+}
+
+void UserExpressionCache::Insert(const Key &key, UserExpressionSP expr_sp) {
+  // Destroyed after the lock is released, see Clear.
+  UserExpressionSP evicted_sp;
+  UserExpressionSP replaced_sp;
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (m_max_size == 0)
+    return;
+  if (m_entries.size() >= m_max_size && !m_entries.count(key)) {
+    auto oldest = std::min_element(m_entries.begin(), m_entries.end(),
+                                   [](const auto &lhs, const auto &rhs) {
+                                     return lhs.second.generation <
+                                            rhs.second.generation;
+                                   });
+    evicted_sp = std::move(oldest->second.expr_sp);
+    m_entries.erase(oldest);
+  }
+  Entry &entry = m_entries[key];
+  replaced_sp = std::move(entry.expr_sp);
+  entry = {std::move(expr_sp), m_generation++};
+}
+
+void UserExpressionCache::Clear() {
+  // Destroying an expression frees the memory it allocated in the process,
+  // which is done without holding the lock.
+  std::map<Key, Entry> entries;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    entries.swap(m_entries);
+  }
+}
+
+size_t UserExpressionCache::GetSize() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_entries.size();
+}
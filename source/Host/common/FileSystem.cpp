@@ -327,6 +327,62 @@ FileSystem::CreateDataBuffer(const FileSpec &file_spec, uint64_t size,
   return CreateDataBuffer(file_spec.GetPath(), size, offset);
 }
 
+std::shared_ptr<DataBufferLLVM>
+FileSystem::CreateSharedDataBuffer(const llvm::Twine &path, uint64_t size,
+                                   uint64_t offset) {
+  const ErrorOr<std::string> external_path = GetExternalPath(path);
+  if (!external_path)
+    return nullptr;
+
+  // The modification time is part of the validation of a cached buffer, so
+  // that a rebuilt binary is never served from the mapping of its previous
+  // version.
+  llvm::sys::TimePoint<> mod_time = GetModificationTime(path);
+  auto key = std::make_tuple(*external_path, size, offset);
+  {
+    std::lock_guard<std::mutex> guard(m_shared_buffers_mutex);
+    auto pos = m_shared_buffers.find(key);
+    if (pos != m_shared_buffers.end() && pos->second.mod_time == mod_time) {
+      if (std::shared_ptr<DataBufferLLVM> buffer_sp =
+              pos->second.buffer.lock()) {
+        Collect(path);
+        return buffer_sp;
+      }
+    }
+  }
+
+  // Map the file without holding the lock, another thread might be doing the
+  // same for the same file, in which case the first buffer inserted wins.
+  std::shared_ptr<DataBufferLLVM> buffer_sp =
+      CreateDataBuffer(path, size, offset);
+  if (!buffer_sp)
+    return nullptr;
+
+  std::lock_guard<std::mutex> guard(m_shared_buffers_mutex);
+  // Drop the entries of the buffers that are gone while we are here.
+  for (auto pos = m_shared_buffers.begin(); pos != m_shared_buffers.end();) {
+    if (pos->second.buffer.expired())
+      pos = m_shared_buffers.erase(pos);
+    else
+      ++pos;
+  }
+
+  SharedDataBuffer &entry = m_shared_buffers[key];
+  if (entry.mod_time == mod_time) {
+    if (std::shared_ptr<DataBufferLLVM> existing_sp = entry.buffer.lock())
+      return existing_sp;
+  }
+  entry.mod_time = mod_time;
+  entry.buffer = buffer_sp;
+  return buffer_sp;
+}
+
+std::shared_ptr<DataBufferLLVM>
+FileSystem::CreateSharedDataBuffer(const FileSpec &file_spec, uint64_t size,
+                                   uint64_t offset) {
+  return CreateSharedDataBuffer(file_spec.GetPath(), size, offset);
+}
+
 bool FileSystem::ResolveExecutableLocation(FileSpec &file_spec) {
   // If the directory is set there's nothing to do.
   ConstString directory = file_spec.GetDirectory();
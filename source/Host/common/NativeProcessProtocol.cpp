@@ -11,8 +11,11 @@
 #include "lldb/Host/common/NativeBreakpointList.h"
 #include "lldb/Host/common/NativeRegisterContext.h"
 #include "lldb/Host/common/NativeThreadProtocol.h"
+#include "lldb/Utility/AgentExpression.h"
+#include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/RegisterValue.h"
 #include "lldb/Utility/State.h"
 #include "lldb/lldb-enumerations.h"
 
@@ -437,6 +440,98 @@ Status NativeProcessProtocol::RemoveSoftwareBreakpoint(lldb::addr_t addr) {
   return Status();
 }
 
+Status NativeProcessProtocol::SetBreakpointConditions(
+    lldb::addr_t addr, std::vector<std::vector<uint8_t>> conditions) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  LLDB_LOG(log, "addr = {0:x}, {1} conditions", addr, conditions.size());
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end())
+    return Status("Breakpoint not found.");
+  it->second.conditions = std::move(conditions);
+  return Status();
+}
+
+bool NativeProcessProtocol::BreakpointConditionsSayStop(
+    NativeThreadProtocol &thread, lldb::addr_t addr) {
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end() || it->second.conditions.empty())
+    return true;
+
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  NativeRegisterContext &reg_ctx = thread.GetRegisterContext();
+  auto read_register = [&](uint32_t reg_num) -> llvm::Expected<uint64_t> {
+    const RegisterInfo *reg_info = reg_ctx.GetRegisterInfoAtIndex(reg_num);
+    if (!reg_info)
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "invalid register %u", reg_num);
+    RegisterValue value;
+    Status error = reg_ctx.ReadRegister(reg_info, value);
+    if (error.Fail())
+      return error.ToError();
+    bool success = false;
+    uint64_t result = value.GetAsUInt64(0, &success);
+    if (!success)
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "register %s isn't an integer",
+                                     reg_info->name);
+    return result;
+  };
+  auto read_memory = [&](lldb::addr_t mem_addr,
+                         uint32_t byte_size) -> llvm::Expected<uint64_t> {
+    uint8_t buffer[8];
+    size_t bytes_read = 0;
+    Status error =
+        ReadMemoryWithoutTrap(mem_addr, buffer, byte_size, bytes_read);
+    if (error.Fail())
+      return error.ToError();
+    if (bytes_read != byte_size)
+      return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                     "failed to read memory at 0x%" PRIx64,
+                                     mem_addr);
+    const ArchSpec &arch = GetArchitecture();
+    DataExtractor data(buffer, byte_size, arch.GetByteOrder(),
+                       arch.GetAddressByteSize());
+    lldb::offset_t offset = 0;
+    return data.GetMaxU64(&offset, byte_size);
+  };
+
+  for (const std::vector<uint8_t> &condition : it->second.conditions) {
+    llvm::Expected<uint64_t> result =
+        AgentExpression::Evaluate(condition, read_register, read_memory);
+    if (!result) {
+      // Let the client evaluate the condition.
+      LLDB_LOG_ERROR(log, result.takeError(),
+                     "failed to evaluate condition at {1:x}: {0}", addr);
+      return true;
+    }
+    if (*result != 0)
+      return true;
+  }
+  LLDB_LOG(log, "tid {0}: conditions at {1:x} are false", thread.GetID(),
+           addr);
+  return false;
+}
+
+Status NativeProcessProtocol::SetSoftwareBreakpointTrapInserted(
+    lldb::addr_t addr, bool inserted) {
+  auto it = m_software_breakpoints.find(addr);
+  if (it == m_software_breakpoints.end())
+    return Status("Breakpoint not found.");
+  llvm::ArrayRef<uint8_t> opcodes =
+      inserted ? it->second.breakpoint_opcodes
+               : llvm::makeArrayRef(it->second.saved_opcodes);
+  size_t bytes_written = 0;
+  Status error =
+      WriteMemory(addr, opcodes.data(), opcodes.size(), bytes_written);
+  if (error.Fail())
+    return error;
+  if (bytes_written != opcodes.size())
+    return Status("addr=0x%" PRIx64
+                  ": tried to write %zu bytes but only wrote %zu",
+                  addr, opcodes.size(), bytes_written);
+  return Status();
+}
+
 llvm::Expected<NativeProcessProtocol::SoftwareBreakpoint>
 NativeProcessProtocol::EnableSoftwareBreakpoint(lldb::addr_t addr,
                                                 uint32_t size_hint) {
@@ -2832,6 +2832,10 @@ void CommandInterpreter::IOHandlerInputComplete(IOHandler &io_handler,
   StartHandlingCommand();
 
   lldb_private::CommandReturnObject result(m_debugger.GetUseColor());
+  // Let commands with a lot of output, e.g. printing a large value, print it
+  // as it is generated.
+  if (io_handler.GetFlags().Test(eHandleCommandFlagPrintResult))
+    result.SetDeferredOutputStream(io_handler.GetOutputStreamFileSP());
   HandleCommand(line.c_str(), eLazyBoolCalculate, result);
 
   // Now emit the command output text from the command we just executed
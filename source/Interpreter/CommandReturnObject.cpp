@@ -152,6 +152,14 @@ bool CommandReturnObject::HasResult() {
           m_status == eReturnStatusSuccessContinuingResult);
 }
 
+void CommandReturnObject::StreamOutput() {
+  if (!m_deferred_out_stream_sp || GetImmediateOutputStream())
+    return;
+  m_deferred_out_stream_sp->PutCString(GetOutputData());
+  m_deferred_out_stream_sp->Flush();
+  SetImmediateOutputStream(m_deferred_out_stream_sp);
+}
+
 void CommandReturnObject::Clear() {
   lldb::StreamSP stream_sp;
   stream_sp = m_out_stream.GetStreamAtIndex(eStreamStringIndex);
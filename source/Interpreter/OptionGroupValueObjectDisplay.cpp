@@ -176,9 +176,13 @@ void OptionGroupValueObjectDisplay::OptionParsingStarting(
 
   TargetSP target_sp =
       execution_context ? execution_context->GetTargetSP() : TargetSP();
-  if (target_sp)
+  print_budget = DumpValueObjectOptions::PrintBudget();
+  if (target_sp) {
     use_dynamic = target_sp->GetPreferDynamicValue();
-  else {
+    print_budget.m_time = target_sp->GetMaximumValuePrintTime();
+    print_budget.m_bytes = target_sp->GetMaximumValuePrintBytes();
+    print_budget.m_values = target_sp->GetMaximumValuePrintValues();
+  } else {
     // If we don't have any targets, then dynamic values won't do us much good.
     use_dynamic = lldb::eNoDynamicValues;
   }
@@ -217,5 +221,7 @@ DumpValueObjectOptions OptionGroupValueObjectDisplay::GetAsDumpOptions(
 
   options.SetElementCount(elem_count);
 
+  options.SetPrintBudget(print_budget);
+
   return options;
 }
@@ -15,6 +15,7 @@
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/LocateSymbolFile.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Target/MemoryRegionInfo.h"
 #include "lldb/Target/Platform.h"
@@ -456,6 +457,8 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
         new_modules.Append(module_sp);
       }
     }
+    Symbols::LocateSymbolFilesForModules(
+        new_modules, Target::GetDefaultDebugFileSearchPaths());
     m_process->GetTarget().ModulesDidLoad(new_modules);
   }
 
@@ -619,6 +622,10 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
     }
   }
 
+  // Look the symbol files of all the modules up at once, instead of one at a
+  // time when their symbols are first needed.
+  Symbols::LocateSymbolFilesForModules(
+      module_list, Target::GetDefaultDebugFileSearchPaths());
   m_process->GetTarget().ModulesDidLoad(module_list);
 }
 
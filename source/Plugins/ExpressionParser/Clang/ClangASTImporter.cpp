@@ -11,6 +11,7 @@
 #include "lldb/Utility/Log.h"
 #include "clang/AST/Decl.h"
 #include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclLookups.h"
 #include "clang/AST/DeclObjC.h"
 #include "clang/Sema/Lookup.h"
 #include "clang/Sema/Sema.h"
@@ -262,6 +263,10 @@ public:
       if (auto *tag_decl = dyn_cast<TagDecl>(decl)) {
         if (auto *original_tag_decl = dyn_cast<TagDecl>(original_decl)) {
           if (original_tag_decl->isCompleteDefinition()) {
+            // The copy can't look up the members the symbol file deferred
+            // once it's detached from its origin, so load all of them.
+            if (original_tag_decl->hasExternalVisibleStorage())
+              original_tag_decl->lookups();
             m_delegate->ImportDefinitionTo(tag_decl, original_tag_decl);
             tag_decl->setCompleteDefinition(true);
           }
@@ -925,6 +930,8 @@ void ClangASTImporter::ASTImporterDelegate::ImportDefinitionTo(
   if (clang::TagDecl *to_tag = dyn_cast<clang::TagDecl>(to)) {
     if (clang::TagDecl *from_tag = dyn_cast<clang::TagDecl>(from)) {
       to_tag->setCompleteDefinition(from_tag->isCompleteDefinition());
+      if (isa<CXXRecordDecl>(from_tag) && from_tag->hasExternalVisibleStorage())
+        to_tag->setHasExternalVisibleStorage();
 
       if (Log *log_ast =
               lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_AST)) {
@@ -1142,6 +1149,12 @@ void ClangASTImporter::ASTImporterDelegate::Imported(clang::Decl *from,
     to_tag_decl->setHasExternalLexicalStorage();
     to_tag_decl->getPrimaryContext()->setMustBuildLookupTable();
     auto from_tag_decl = cast<TagDecl>(from);
+    // A complete C++ record with external visible storage has members that
+    // the symbol file only parses when they are looked up by name.
+    if (isa<CXXRecordDecl>(from_tag_decl) &&
+        from_tag_decl->isCompleteDefinition() &&
+        from_tag_decl->hasExternalVisibleStorage())
+      to_tag_decl->setHasExternalVisibleStorage();
 
     LLDB_LOG(
         log,
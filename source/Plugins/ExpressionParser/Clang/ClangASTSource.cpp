@@ -20,6 +20,7 @@
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/Log.h"
 #include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclLookups.h"
 #include "clang/AST/RecordLayout.h"
 #include "clang/Basic/SourceManager.h"
 
@@ -451,6 +452,13 @@ void ClangASTSource::FindExternalLexicalDecls(
 
     if (external_source)
       external_source->CompleteType(original_tag_decl);
+
+    // The symbol file may have deferred some members of the record until
+    // they are looked up, so forward the lookups to LookupInRecord.
+    TagDecl *original_definition = original_tag_decl->getDefinition();
+    if (original_definition && isa<CXXRecordDecl>(original_definition) &&
+        original_definition->hasExternalVisibleStorage())
+      decl_context->setHasExternalVisibleStorage(true);
   }
 
   const DeclContext *original_decl_context =
@@ -517,6 +525,60 @@ void ClangASTSource::FindExternalLexicalDecls(
   return;
 }
 
+/// Return the definition of the record \a decl_context was copied from.
+static CXXRecordDecl *GetOriginalRecord(ClangASTImporter &importer,
+                                        const DeclContext *decl_context) {
+  ClangASTImporter::DeclOrigin original =
+      importer.GetDeclOrigin(cast<Decl>(decl_context));
+  if (!original.Valid())
+    return nullptr;
+  if (auto *original_record = dyn_cast<CXXRecordDecl>(original.decl))
+    return original_record->getDefinition();
+  return nullptr;
+}
+
+void ClangASTSource::completeVisibleDeclsMap(const DeclContext *decl_context) {
+  if (!isa<CXXRecordDecl>(decl_context))
+    return;
+
+  CXXRecordDecl *original_record =
+      GetOriginalRecord(*m_ast_importer_sp, decl_context);
+  if (!original_record)
+    return;
+
+  // Enumerating the lookups of the original record parses the members the
+  // symbol file deferred.
+  for (DeclContext::lookup_result result : original_record->lookups())
+    for (NamedDecl *decl : result)
+      CopyDecl(decl);
+}
+
+void ClangASTSource::LookupInRecord(NameSearchContext &context) {
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+
+  if (!context.m_decl_name.isIdentifier())
+    return;
+
+  CXXRecordDecl *original_record =
+      GetOriginalRecord(*m_ast_importer_sp, context.m_decl_context);
+  if (!original_record)
+    return;
+
+  // The lookup in the original record parses the members with this name
+  // that the symbol file deferred.
+  IdentifierInfo &original_name = original_record->getASTContext().Idents.get(
+      context.m_decl_name.getAsIdentifierInfo()->getName());
+  for (NamedDecl *decl : original_record->lookup(&original_name)) {
+    auto *copied_decl = dyn_cast_or_null<NamedDecl>(CopyDecl(decl));
+    if (!copied_decl)
+      continue;
+
+    LLDB_LOG(log, "  CAS::FEVD Found {0}Decl {1} in the original record",
+             copied_decl->getDeclKindName(), ClangUtil::DumpDecl(copied_decl));
+    context.AddNamedDecl(copied_decl);
+  }
+}
+
 void ClangASTSource::FindExternalVisibleDecls(NameSearchContext &context) {
   assert(m_ast_context);
 
@@ -549,6 +611,8 @@ void ClangASTSource::FindExternalVisibleDecls(NameSearchContext &context) {
     LookupInNamespace(context);
   } else if (isa<ObjCInterfaceDecl>(context.m_decl_context)) {
     FindObjCPropertyAndIvarDecls(context);
+  } else if (isa<CXXRecordDecl>(context.m_decl_context)) {
+    LookupInRecord(context);
   } else if (!isa<TranslationUnitDecl>(context.m_decl_context)) {
     // we shouldn't be getting FindExternalVisibleDecls calls for these
     return;
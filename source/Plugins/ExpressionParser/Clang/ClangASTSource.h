@@ -102,6 +102,14 @@ public:
       llvm::function_ref<bool(clang::Decl::Kind)> IsKindWeWant,
       llvm::SmallVectorImpl<clang::Decl *> &Decls) override;
 
+  /// Copy all the members of a C++ record, including the ones the symbol
+  /// file deferred, from its origin.
+  ///
+  /// \param[in] DC
+  ///     The record (in the parser's AST context) whose members are needed,
+  ///     e.g. because it's about to be copied to another AST context.
+  void completeVisibleDeclsMap(const clang::DeclContext *DC) override;
+
   /// Specify the layout of the contents of a RecordDecl.
   ///
   /// \param[in] Record
@@ -223,6 +231,10 @@ public:
       return m_original.FindExternalLexicalDecls(DC, IsKindWeWant, Decls);
     }
 
+    void completeVisibleDeclsMap(const clang::DeclContext *DC) override {
+      return m_original.completeVisibleDeclsMap(DC);
+    }
+
     void CompleteType(clang::TagDecl *Tag) override {
       return m_original.CompleteType(Tag);
     }
@@ -304,6 +316,13 @@ protected:
   ///     The NameSearchContext for a lookup inside a namespace.
   void LookupInNamespace(NameSearchContext &context);
 
+  /// Performs lookup into a C++ record, for the members that the symbol file
+  /// only parses when they are looked up by name.
+  ///
+  /// \param context
+  ///     The NameSearchContext for a lookup inside a record.
+  void LookupInRecord(NameSearchContext &context);
+
   /// A wrapper for TypeSystemClang::CopyType that sets a flag that
   /// indicates that we should not respond to queries during import.
   ///
@@ -25,6 +25,7 @@
 #include "clang/Frontend/FrontendActions.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
 #include "clang/Frontend/FrontendPluginRegistry.h"
+#include "clang/Frontend/PrecompiledPreamble.h"
 #include "clang/Frontend/TextDiagnosticBuffer.h"
 #include "clang/Frontend/TextDiagnosticPrinter.h"
 #include "clang/Lex/Preprocessor.h"
@@ -351,6 +352,50 @@ static void SetupDefaultClangDiagnostics(CompilerInstance &compiler) {
   }
 }
 
+/// Returns the precompiled prefix of \a expr, compiling it if the target
+/// doesn't have it yet.
+///
+/// \param[in,out] vfs
+///     The file system of the compiler. On success, it is replaced with one
+///     that also provides the in-memory preamble at \a pch_path.
+static std::shared_ptr<PrecompiledPreamble>
+GetPrefixPreamble(Target &target, CompilerInstance &compiler,
+                  ClangUserExpression &expr, llvm::StringRef filename,
+                  IntrusiveRefCntPtr<llvm::vfs::FileSystem> &vfs,
+                  std::string &pch_path) {
+  const size_t prefix_size = expr.GetPrefixSize();
+  if (!prefix_size)
+    return nullptr;
+  auto *persistent_vars = llvm::cast_or_null<ClangPersistentVariables>(
+      target.GetPersistentExpressionStateForLanguage(lldb::eLanguageTypeC));
+  if (!persistent_vars)
+    return nullptr;
+
+  bool cached = false;
+  llvm::StringRef text(expr.Text());
+  std::shared_ptr<PrecompiledPreamble> preamble =
+      persistent_vars->GetExpressionPrefixCache().GetPreamble(
+          compiler.getInvocation(), compiler.getPCHContainerOperations(),
+          text.take_front(prefix_size), cached);
+  if (!preamble)
+    return nullptr;
+  target.IncrementStats(cached ? lldb_private::ExpressionPrefixReused
+                               : lldb_private::ExpressionPrefixPrecompiled);
+
+  // Let the preamble configure a copy of the invocation, which only serves
+  // to get the path of the preamble and the file system providing it. The
+  // compiler itself loads the preamble once it has an ASTContext, without
+  // the implicit include of the file the preamble was made from.
+  CompilerInvocation invocation(compiler.getInvocation());
+  invocation.getFrontendOpts().Inputs.emplace_back(
+      filename, InputKind(clang::Language::CXX));
+  std::unique_ptr<MemoryBuffer> buffer =
+      MemoryBuffer::getMemBuffer(text, filename);
+  preamble->AddImplicitPreamble(invocation, vfs, buffer.get());
+  pch_path = invocation.getPreprocessorOpts().ImplicitPCHInclude;
+  return preamble;
+}
+
 //===----------------------------------------------------------------------===//
 // Implementation of ClangExpressionParser
 //===----------------------------------------------------------------------===//
@@ -665,8 +710,21 @@ ClangExpressionParser::ClangExpressionParser(
       m_compiler->getDiagnostics().getDiagnosticOptions());
   m_compiler->getDiagnostics().setClient(diag_mgr);
 
-  // 7. Set up the source management objects inside the compiler
-  m_compiler->createFileManager();
+  // 7. Set up the source management objects inside the compiler. If the
+  // prefix of the expression is precompiled, the file manager also provides
+  // the preamble.
+  IntrusiveRefCntPtr<llvm::vfs::FileSystem> vfs(
+      &m_compiler->getFileManager().getVirtualFileSystem());
+  std::string pch_path;
+  if (clang_expr && !lang_opts.Modules &&
+      target_sp->GetExprPrecompilePrefix()) {
+    m_prefix_preamble = GetPrefixPreamble(*target_sp, *m_compiler,
+                                          *clang_expr, m_filename, vfs,
+                                          pch_path);
+    if (m_prefix_preamble)
+      m_prefix_size = clang_expr->GetPrefixSize();
+  }
+  m_compiler->createFileManager(vfs);
   if (!m_compiler->hasSourceManager())
     m_compiler->createSourceManager(m_compiler->getFileManager());
   m_compiler->createPreprocessor(TU_Complete);
@@ -711,6 +769,28 @@ ClangExpressionParser::ClangExpressionParser(
   m_compiler->createASTContext();
   clang::ASTContext &ast_context = m_compiler->getASTContext();
 
+  // Load the precompiled prefix, which the preprocessor then skips in the
+  // source code. The ASTReader becomes the external source of the context
+  // and is combined with the one of the expression in ParseInternal, like
+  // the reader of the C++ modules.
+  if (m_prefix_preamble) {
+    PreprocessorOptions &pp_opts = m_compiler->getPreprocessorOpts();
+    pp_opts.PrecompiledPreambleBytes = {m_prefix_size, true};
+    m_compiler->createPCHExternalASTSource(
+        pch_path, /*DisablePCHValidation=*/true,
+        /*AllowPCHWithCompilerErrors=*/false,
+        /*DeserializationListener=*/nullptr,
+        /*OwnDeserializationListener=*/false);
+    if (ast_context.getExternalSource()) {
+      PP.setSkipMainFilePreamble(m_prefix_size, true);
+    } else {
+      LLDB_LOGF(log, "Couldn't load the precompiled expression prefix");
+      pp_opts.PrecompiledPreambleBytes = {0, false};
+      m_prefix_preamble.reset();
+      m_prefix_size = 0;
+    }
+  }
+
   m_ast_context = std::make_unique<TypeSystemClang>(
       "Expression ASTContext for '" + m_filename + "'", ast_context);
 
@@ -26,6 +26,7 @@ namespace clang {
 class CodeGenerator;
 class CodeCompleteConsumer;
 class CompilerInstance;
+class PrecompiledPreamble;
 } // namespace clang
 
 namespace lldb_private {
@@ -167,6 +168,13 @@ private:
                          unsigned completion_line = 0,
                          unsigned completion_column = 0);
 
+  /// The precompiled prefix of the expression, or null if the parser parses
+  /// the whole source code of the expression. It provides the in-memory file
+  /// the compiler reads the prefix from, so it outlives the compiler.
+  std::shared_ptr<clang::PrecompiledPreamble> m_prefix_preamble;
+  /// The size of the prefix the preprocessor skips in the source code.
+  unsigned m_prefix_size = 0;
+
   std::unique_ptr<llvm::LLVMContext>
       m_llvm_context; ///< The LLVM context to generate IR into
   std::unique_ptr<clang::CompilerInstance>
@@ -0,0 +1,116 @@
+//===-- ClangExpressionPrefixCache.cpp ------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "ClangExpressionPrefixCache.h"
+#include "ClangExpressionSourceCode.h"
+
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Utility/Log.h"
+
+#include "clang/Basic/DiagnosticOptions.h"
+#include "clang/Frontend/CompilerInstance.h"
+#include "clang/Frontend/CompilerInvocation.h"
+#include "clang/Frontend/PrecompiledPreamble.h"
+#include "clang/Frontend/TextDiagnosticBuffer.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+using namespace lldb_private;
+
+/// Compile \a prefix on its own with the options of \a invocation.
+static std::shared_ptr<clang::PrecompiledPreamble>
+CompilePreamble(const clang::CompilerInvocation &invocation,
+                std::shared_ptr<clang::PCHContainerOperations> pch_operations,
+                llvm::StringRef prefix) {
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+
+  // The expression parser doesn't have an input file, so give the preamble
+  // compiler one with the language of the expression.
+  clang::CompilerInvocation preamble_invocation(invocation);
+  clang::FrontendOptions &frontend_opts =
+      preamble_invocation.getFrontendOpts();
+  const clang::Language language = preamble_invocation.getLangOpts()->ObjC
+                                       ? clang::Language::ObjCXX
+                                       : clang::Language::CXX;
+  frontend_opts.Inputs.clear();
+  frontend_opts.Inputs.emplace_back(
+      ClangExpressionSourceCode::g_prefix_file_name,
+      clang::InputKind(language));
+
+  std::unique_ptr<llvm::MemoryBuffer> buffer =
+      llvm::MemoryBuffer::getMemBuffer(
+          prefix, ClangExpressionSourceCode::g_prefix_file_name,
+          /*RequiresNullTerminator=*/false);
+
+  // Preambles are emitted even if they have errors, but an error here
+  // usually means the prefix needs the declarations the expression parser
+  // looks up in the program, so count them to fall back to parsing it.
+  clang::TextDiagnosticBuffer diagnostic_buffer;
+  llvm::IntrusiveRefCntPtr<clang::DiagnosticsEngine> diagnostics =
+      clang::CompilerInstance::createDiagnostics(
+          new clang::DiagnosticOptions, &diagnostic_buffer,
+          /*ShouldOwnClient=*/false);
+
+  clang::PreambleCallbacks callbacks;
+  llvm::ErrorOr<clang::PrecompiledPreamble> preamble =
+      clang::PrecompiledPreamble::Build(
+          preamble_invocation, buffer.get(),
+          clang::PreambleBounds(prefix.size(),
+                                /*PreambleEndsAtStartOfLine=*/true),
+          *diagnostics, FileSystem::Instance().GetVirtualFileSystem(),
+          std::move(pch_operations), /*StoreInMemory=*/true, callbacks);
+  if (!preamble) {
+    LLDB_LOG(log, "Couldn't precompile the expression prefix: {0}",
+             preamble.getError().message());
+    return nullptr;
+  }
+  if (diagnostic_buffer.getNumErrors()) {
+    LLDB_LOG(log, "Couldn't precompile the expression prefix: {0}",
+             diagnostic_buffer.err_begin()->second);
+    return nullptr;
+  }
+
+  LLDB_LOG(log, "Precompiled an expression prefix of {0} bytes",
+           prefix.size());
+  return std::make_shared<clang::PrecompiledPreamble>(std::move(*preamble));
+}
+
+ClangExpressionPrefixCache::ClangExpressionPrefixCache(size_t max_size)
+    : m_max_size(max_size) {}
+
+ClangExpressionPrefixCache::~ClangExpressionPrefixCache() = default;
+
+std::shared_ptr<clang::PrecompiledPreamble>
+ClangExpressionPrefixCache::GetPreamble(
+    const clang::CompilerInvocation &invocation,
+    std::shared_ptr<clang::PCHContainerOperations> pch_operations,
+    llvm::StringRef prefix, bool &cached) {
+  // The module hash covers the language, target and preprocessor options
+  // that change the meaning of the prefix.
+  std::string key = invocation.getModuleHash();
+  key.push_back('\0');
+  key.append(prefix.begin(), prefix.end());
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto pos = llvm::find_if(
+      m_entries, [&key](const Entry &entry) { return entry.first == key; });
+  if (pos != m_entries.end()) {
+    m_entries.splice(m_entries.begin(), m_entries, pos);
+    cached = true;
+    return m_entries.front().second;
+  }
+
+  cached = false;
+  std::shared_ptr<clang::PrecompiledPreamble> preamble =
+      CompilePreamble(invocation, std::move(pch_operations), prefix);
+  m_entries.emplace_front(std::move(key), preamble);
+  if (m_entries.size() > m_max_size)
+    m_entries.pop_back();
+  return preamble;
+}
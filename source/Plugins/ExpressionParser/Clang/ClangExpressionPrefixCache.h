@@ -0,0 +1,87 @@
+//===-- ClangExpressionPrefixCache.h ----------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_SOURCE_PLUGINS_EXPRESSIONPARSER_CLANG_CLANGEXPRESSIONPREFIXCACHE_H
+#define LLDB_SOURCE_PLUGINS_EXPRESSIONPARSER_CLANG_CLANGEXPRESSIONPREFIXCACHE_H
+
+#include "llvm/ADT/StringRef.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace clang {
+class CompilerInvocation;
+class PCHContainerOperations;
+class PrecompiledPreamble;
+} // namespace clang
+
+namespace lldb_private {
+
+/// \class ClangExpressionPrefixCache ClangExpressionPrefixCache.h
+/// Keeps the precompiled prefixes of the expressions of a target.
+///
+/// The source code of every wrapped expression starts with the same prefix:
+/// the builtin declarations of ClangExpressionSourceCode, the macros of the
+/// modules and of the compile unit of the frame and the contents of
+/// target.expr-prefix. Parsing it again for every expression is a large part
+/// of the cost of simple expressions when the prefix is big, e.g. with the
+/// macros of a program built with -g3 or with an expression prefix including
+/// headers. The expression parser instead compiles the prefix once into a
+/// precompiled preamble that the following expressions load, so they only
+/// parse their wrapper function.
+class ClangExpressionPrefixCache {
+public:
+  /// \param[in] max_size
+  ///     The maximum number of prefixes kept. The least recently used prefix
+  ///     is dropped when a new one is added to a full cache.
+  ClangExpressionPrefixCache(size_t max_size = 8);
+
+  ~ClangExpressionPrefixCache();
+
+  /// Return the preamble of \a prefix, compiling it if the cache doesn't
+  /// hold it yet.
+  ///
+  /// \param[in] invocation
+  ///     The invocation of the compiler that parses the expression. The
+  ///     preamble is compiled with the same options and is only reused by
+  ///     expressions parsed with the same options.
+  ///
+  /// \param[in] prefix
+  ///     The beginning of the source code of the expression, which must end
+  ///     with a new line.
+  ///
+  /// \param[out] cached
+  ///     Set to true if the preamble was compiled by an earlier expression.
+  ///
+  /// \return
+  ///     The preamble, or a null pointer if the prefix couldn't be compiled on
+  ///     its own, e.g. because target.expr-prefix refers to declarations of
+  ///     the program. The failure is remembered so the prefix isn't compiled
+  ///     again.
+  std::shared_ptr<clang::PrecompiledPreamble>
+  GetPreamble(const clang::CompilerInvocation &invocation,
+              std::shared_ptr<clang::PCHContainerOperations> pch_operations,
+              llvm::StringRef prefix, bool &cached);
+
+private:
+  using Entry =
+      std::pair<std::string, std::shared_ptr<clang::PrecompiledPreamble>>;
+
+  std::mutex m_mutex;
+  /// The entries ordered from the most to the least recently used, keyed by
+  /// the hash of the compiler options followed by the prefix.
+  std::list<Entry> m_entries;
+  const size_t m_max_size;
+};
+
+} // namespace lldb_private
+
+#endif // LLDB_SOURCE_PLUGINS_EXPRESSIONPARSER_CLANG_CLANGEXPRESSIONPREFIXCACHE_H
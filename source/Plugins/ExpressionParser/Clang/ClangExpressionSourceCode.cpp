@@ -294,7 +294,8 @@ void ClangExpressionSourceCode::AddLocalVariableDecls(
 
 bool ClangExpressionSourceCode::GetText(
     std::string &text, ExecutionContext &exe_ctx, bool add_locals,
-    bool force_add_all_locals, llvm::ArrayRef<std::string> modules) const {
+    bool force_add_all_locals, llvm::ArrayRef<std::string> modules,
+    size_t *prefix_size) const {
   const char *target_specific_defines = "typedef signed char BOOL;\n";
   std::string module_macros;
   llvm::raw_string_ostream module_macros_stream(module_macros);
@@ -395,6 +396,8 @@ bool ClangExpressionSourceCode::GetText(
     wrap_stream.Printf("%s\n%s\n%s\n%s\n%s\n", g_expression_prefix,
                        module_macros.c_str(), debug_macros_stream.GetData(),
                        target_specific_defines, m_prefix.c_str());
+    if (prefix_size)
+      *prefix_size = wrap_stream.GetSize();
 
     // First construct a tagged form of the user expression so we can find it
     // later:
@@ -464,6 +467,8 @@ bool ClangExpressionSourceCode::GetText(
     text = std::string(wrap_stream.GetString());
   } else {
     text.append(m_body);
+    if (prefix_size)
+      *prefix_size = 0;
   }
 
   return true;
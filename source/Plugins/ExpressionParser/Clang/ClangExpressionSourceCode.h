@@ -59,11 +59,15 @@ public:
   /// \param force_add_all_locals True iff all local variables should be
   ///        injected even if they are not used in the expression.
   /// \param modules A list of (C++) modules that the expression should import.
+  /// \param prefix_size If not null, output parameter containing the size of
+  ///        the prefix that precedes the wrapper function in the source code.
+  ///        The prefix ends with a new line and doesn't depend on the body of
+  ///        the expression.
   ///
   /// \return true iff the source code was successfully generated.
   bool GetText(std::string &text, ExecutionContext &exe_ctx, bool add_locals,
-               bool force_add_all_locals,
-               llvm::ArrayRef<std::string> modules) const;
+               bool force_add_all_locals, llvm::ArrayRef<std::string> modules,
+               size_t *prefix_size = nullptr) const;
 
   // Given a string returned by GetText, find the beginning and end of the body
   // passed to CreateWrapped. Return true if the bounds could be found.  This
@@ -58,9 +58,28 @@ bool ClangExternalASTSourceCallbacks::FindExternalVisibleDeclsByName(
       if (omd->getDeclName() == Name)
         decls.push_back(omd);
   }
+  // C++ records have external visible storage when the symbol file deferred
+  // some of their members, which are parsed when their name is looked up.
+  if (auto *record_decl = llvm::dyn_cast<clang::CXXRecordDecl>(DC)) {
+    if (Name.isIdentifier())
+      m_ast.CompleteDeferredMembers(
+          const_cast<clang::CXXRecordDecl *>(record_decl),
+          ConstString(Name.getAsString()));
+    for (clang::Decl *decl : record_decl->noload_decls())
+      if (auto *named_decl = llvm::dyn_cast<clang::NamedDecl>(decl))
+        if (named_decl->getDeclName() == Name)
+          decls.push_back(named_decl);
+  }
   return !SetExternalVisibleDeclsForName(DC, Name, decls).empty();
 }
 
+void ClangExternalASTSourceCallbacks::completeVisibleDeclsMap(
+    const clang::DeclContext *DC) {
+  if (auto *record_decl = llvm::dyn_cast<clang::CXXRecordDecl>(DC))
+    m_ast.CompleteDeferredMembers(
+        const_cast<clang::CXXRecordDecl *>(record_decl), ConstString());
+}
+
 OptionalClangModuleID
 ClangExternalASTSourceCallbacks::RegisterModule(clang::Module *module) {
   m_modules.push_back(module);
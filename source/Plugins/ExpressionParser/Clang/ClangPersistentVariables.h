@@ -11,6 +11,7 @@
 
 #include "llvm/ADT/DenseMap.h"
 
+#include "ClangExpressionPrefixCache.h"
 #include "ClangExpressionVariable.h"
 #include "ClangModulesDeclVendor.h"
 
@@ -78,6 +79,11 @@ public:
     return m_hand_loaded_clang_modules;
   }
 
+  /// Returns the precompiled prefixes of the expressions of the target.
+  ClangExpressionPrefixCache &GetExpressionPrefixCache() {
+    return m_expression_prefix_cache;
+  }
+
 protected:
   llvm::StringRef
   GetPersistentVariablePrefix(bool is_error = false) const override {
@@ -106,6 +112,7 @@ private:
                                    ///these are the highest-
                                    ///< priority source for macros.
   std::shared_ptr<ClangASTImporter> m_ast_importer_sp;
+  ClangExpressionPrefixCache m_expression_prefix_cache;
 };
 
 } // namespace lldb_private
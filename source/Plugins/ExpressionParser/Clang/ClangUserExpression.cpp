@@ -418,6 +418,7 @@ void ClangUserExpression::CreateSourceCode(
     std::vector<std::string> modules_to_import, bool for_completion) {
 
   std::string prefix = m_expr_prefix;
+  m_prefix_size = 0;
 
   if (m_options.GetExecutionPolicy() == eExecutionPolicyTopLevel) {
     m_transformed_text = m_expr_text;
@@ -426,7 +427,8 @@ void ClangUserExpression::CreateSourceCode(
         m_filename, prefix, m_expr_text, GetWrapKind()));
 
     if (!m_source_code->GetText(m_transformed_text, exe_ctx, !m_ctx_obj,
-                                for_completion, modules_to_import)) {
+                                for_completion, modules_to_import,
+                                &m_prefix_size)) {
       diagnostic_manager.PutString(eDiagnosticSeverityError,
                                    "couldn't construct expression body");
       return;
@@ -171,6 +171,10 @@ public:
   /// Returns true iff this expression is using any imported C++ modules.
   bool DidImportCxxModules() const { return !m_imported_cpp_modules.empty(); }
 
+  /// Returns the size of the prefix of the transformed source code that
+  /// precedes the wrapper function, or 0 if the expression isn't wrapped.
+  size_t GetPrefixSize() const { return m_prefix_size; }
+
 private:
   /// Populate m_in_cplusplus_method and m_in_objectivec_method based on the
   /// environment.
@@ -227,6 +231,9 @@ private:
   /// user code (as typed by the user) starts. If the variable is empty, then we
   /// were not able to calculate this position.
   llvm::Optional<size_t> m_user_expression_start_pos;
+  /// The size of the prefix of the transformed source code, which the parser
+  /// can load precompiled instead of parsing it.
+  size_t m_prefix_size = 0;
   ResultDelegate m_result_delegate;
   ClangPersistentVariables *m_clang_state;
   std::unique_ptr<ClangExpressionSourceCode> m_source_code;
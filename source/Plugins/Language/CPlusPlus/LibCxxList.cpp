@@ -18,97 +18,14 @@
 #include "lldb/Utility/Status.h"
 #include "lldb/Utility/Stream.h"
 
+#include "llvm/ADT/DenseSet.h"
+
 using namespace lldb;
 using namespace lldb_private;
 using namespace lldb_private::formatters;
 
 namespace {
 
-class ListEntry {
-public:
-  ListEntry() = default;
-  ListEntry(ValueObjectSP entry_sp) : m_entry_sp(entry_sp) {}
-  ListEntry(const ListEntry &rhs) = default;
-  ListEntry(ValueObject *entry)
-      : m_entry_sp(entry ? entry->GetSP() : ValueObjectSP()) {}
-
-  ListEntry next() {
-    static ConstString g_next("__next_");
-
-    if (!m_entry_sp)
-      return ListEntry();
-    return ListEntry(m_entry_sp->GetChildMemberWithName(g_next, true));
-  }
-
-  ListEntry prev() {
-    static ConstString g_prev("__prev_");
-
-    if (!m_entry_sp)
-      return ListEntry();
-    return ListEntry(m_entry_sp->GetChildMemberWithName(g_prev, true));
-  }
-
-  uint64_t value() const {
-    if (!m_entry_sp)
-      return 0;
-    return m_entry_sp->GetValueAsUnsigned(0);
-  }
-
-  bool null() { return (value() == 0); }
-
-  explicit operator bool() { return GetEntry() && !null(); }
-
-  ValueObjectSP GetEntry() { return m_entry_sp; }
-
-  void SetEntry(ValueObjectSP entry) { m_entry_sp = entry; }
-
-  bool operator==(const ListEntry &rhs) const { return value() == rhs.value(); }
-
-  bool operator!=(const ListEntry &rhs) const { return !(*this == rhs); }
-
-private:
-  ValueObjectSP m_entry_sp;
-};
-
-class ListIterator {
-public:
-  ListIterator() = default;
-  ListIterator(ListEntry entry) : m_entry(entry) {}
-  ListIterator(ValueObjectSP entry) : m_entry(entry) {}
-  ListIterator(const ListIterator &rhs) = default;
-  ListIterator(ValueObject *entry) : m_entry(entry) {}
-
-  ValueObjectSP value() { return m_entry.GetEntry(); }
-
-  ValueObjectSP advance(size_t count) {
-    if (count == 0)
-      return m_entry.GetEntry();
-    if (count == 1) {
-      next();
-      return m_entry.GetEntry();
-    }
-    while (count > 0) {
-      next();
-      count--;
-      if (m_entry.null())
-        return lldb::ValueObjectSP();
-    }
-    return m_entry.GetEntry();
-  }
-
-  bool operator==(const ListIterator &rhs) const {
-    return (rhs.m_entry == m_entry);
-  }
-
-protected:
-  void next() { m_entry = m_entry.next(); }
-
-  void prev() { m_entry = m_entry.prev(); }
-
-private:
-  ListEntry m_entry;
-};
-
 class AbstractListFrontEnd : public SyntheticChildrenFrontEnd {
 public:
   size_t GetIndexOfChildWithName(ConstString name) override {
@@ -124,17 +41,25 @@ protected:
   size_t m_count;
   ValueObject *m_head;
 
-  static constexpr bool g_use_loop_detect = true;
-  size_t m_loop_detected; // The number of elements that have had loop detection
-                          // run over them.
-  ListEntry m_slow_runner; // Used for loop detection
-  ListEntry m_fast_runner; // Used for loop detection
-
   size_t m_list_capping_size;
   CompilerType m_element_type;
-  std::map<size_t, ListIterator> m_iterators;
 
-  bool HasLoop(size_t count);
+  // The addresses of the nodes of the list in order, read up to the furthest
+  // element that was needed since the last Update().
+  std::vector<lldb::addr_t> m_nodes;
+  // The nodes in m_nodes, a node found twice means the list has a loop.
+  llvm::DenseSet<lldb::addr_t> m_visited_nodes;
+  // The node after the last one of m_nodes, or LLDB_INVALID_ADDRESS once the
+  // walk reached the end of the list, a loop or a node it couldn't read.
+  lldb::addr_t m_next_node;
+  // The node that ends the list.
+  lldb::addr_t m_end_node;
+  // The offsets of the __next_ pointer and of the value in a node.
+  uint64_t m_next_offset;
+  uint64_t m_value_offset;
+
+  void StartWalk(lldb::addr_t end_node, uint32_t num_links);
+  bool ReadNodes(size_t count);
   ValueObjectSP GetItem(size_t idx);
 };
 
@@ -167,13 +92,15 @@ private:
 } // end anonymous namespace
 
 bool AbstractListFrontEnd::Update() {
-  m_loop_detected = 0;
   m_count = UINT32_MAX;
   m_head = nullptr;
   m_list_capping_size = 0;
-  m_slow_runner.SetEntry(nullptr);
-  m_fast_runner.SetEntry(nullptr);
-  m_iterators.clear();
+  m_nodes.clear();
+  m_visited_nodes.clear();
+  m_next_node = LLDB_INVALID_ADDRESS;
+  m_end_node = 0;
+  m_next_offset = 0;
+  m_value_offset = 0;
 
   if (m_backend.GetTargetSP())
     m_list_capping_size =
@@ -192,53 +119,72 @@ bool AbstractListFrontEnd::Update() {
   return false;
 }
 
-bool AbstractListFrontEnd::HasLoop(size_t count) {
-  if (!g_use_loop_detect)
-    return false;
-  // don't bother checking for a loop if we won't actually need to jump nodes
-  if (m_count < 2)
-    return false;
+// Prepare walking the list from m_head. A node starts with num_links
+// pointers, the last of which is __next_, followed by the value.
+void AbstractListFrontEnd::StartWalk(lldb::addr_t end_node,
+                                     uint32_t num_links) {
+  static ConstString g_value("__value_");
 
-  if (m_loop_detected == 0) {
-    // This is the first time we are being run (after the last update). Set up
-    // the loop invariant for the first element.
-    m_slow_runner = ListEntry(m_head).next();
-    m_fast_runner = m_slow_runner.next();
-    m_loop_detected = 1;
-  }
+  if (!m_head)
+    return;
+  const uint64_t pointer_size = m_head->GetByteSize().getValueOr(0);
+  if (pointer_size == 0)
+    return;
+  m_end_node = end_node;
+  m_next_offset = (num_links - 1) * pointer_size;
+  m_value_offset = num_links * pointer_size;
+  // If the links point to the full node type, it tells where the value is.
+  ValueObjectSP value_sp = m_head->GetChildAtIndex(1, true);
+  if (value_sp && value_sp->GetName() == g_value)
+    m_value_offset = value_sp->GetByteOffset();
+  m_next_node = m_head->GetValueAsUnsigned(LLDB_INVALID_ADDRESS);
+}
+
+// Extend m_nodes to the first count nodes of the list, if it has that many.
+// The nodes are found by reading their __next_ pointer from the memory
+// cache of the process instead of creating a value for each of them. The
+// nodes of a list are often allocated close to each other, so most of
+// them are in a memory cache line that was already read.
+bool AbstractListFrontEnd::ReadNodes(size_t count) {
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  while (m_nodes.size() < count) {
+    if (!process_sp || m_next_node == 0 ||
+        m_next_node == LLDB_INVALID_ADDRESS || m_next_node == m_end_node ||
+        !m_visited_nodes.insert(m_next_node).second) {
+      m_next_node = LLDB_INVALID_ADDRESS;
+      return false;
+    }
+    m_nodes.push_back(m_next_node);
 
-  // Loop invariant:
-  // Loop detection has been run over the first m_loop_detected elements. If
-  // m_slow_runner == m_fast_runner then the loop has been detected after
-  // m_loop_detected elements.
-  const size_t steps_to_run = std::min(count, m_count);
-  while (m_loop_detected < steps_to_run && m_slow_runner && m_fast_runner &&
-         m_slow_runner != m_fast_runner) {
-
-    m_slow_runner = m_slow_runner.next();
-    m_fast_runner = m_fast_runner.next().next();
-    m_loop_detected++;
+    Status error;
+    const lldb::addr_t next_addr = m_nodes.back() + m_next_offset;
+    m_next_node = process_sp->ReadPointerFromMemory(next_addr, error);
+    if (error.Fail())
+      m_next_node = LLDB_INVALID_ADDRESS;
   }
-  if (count <= m_loop_detected)
-    return false; // No loop in the first m_loop_detected elements.
-  if (!m_slow_runner || !m_fast_runner)
-    return false; // Reached the end of the list. Definitely no loops.
-  return m_slow_runner == m_fast_runner;
+  return true;
 }
 
 ValueObjectSP AbstractListFrontEnd::GetItem(size_t idx) {
-  size_t advance = idx;
-  ListIterator current(m_head);
-  if (idx > 0) {
-    auto cached_iterator = m_iterators.find(idx - 1);
-    if (cached_iterator != m_iterators.end()) {
-      current = cached_iterator->second;
-      advance = 1;
-    }
-  }
-  ValueObjectSP value_sp = current.advance(advance);
-  m_iterators[idx] = current;
-  return value_sp;
+  if (!ReadNodes(idx + 1))
+    return nullptr;
+
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  llvm::Optional<uint64_t> size = m_element_type.GetByteSize(process_sp.get());
+  if (!size || *size == 0)
+    return nullptr;
+
+  // Copy the value, otherwise all the items would be named __value_.
+  DataBufferSP buffer_sp(new DataBufferHeap(*size, 0));
+  Status error;
+  if (process_sp->ReadMemory(m_nodes[idx] + m_value_offset,
+                             buffer_sp->GetBytes(), *size, error) != *size)
+    return nullptr;
+  DataExtractor data(buffer_sp, process_sp->GetByteOrder(),
+                     process_sp->GetAddressByteSize());
+  return CreateValueObjectFromData(llvm::formatv("[{0}]", idx).str(), data,
+                                   m_backend.GetExecutionContextRef(),
+                                   m_element_type);
 }
 
 ForwardListFrontEnd::ForwardListFrontEnd(ValueObject &valobj)
@@ -250,12 +196,8 @@ size_t ForwardListFrontEnd::CalculateNumChildren() {
   if (m_count != UINT32_MAX)
     return m_count;
 
-  ListEntry current(m_head);
-  m_count = 0;
-  while (current && m_count < m_list_capping_size) {
-    ++m_count;
-    current = current.next();
-  }
+  ReadNodes(m_list_capping_size);
+  m_count = m_nodes.size();
   return m_count;
 }
 
@@ -266,28 +208,7 @@ ValueObjectSP ForwardListFrontEnd::GetChildAtIndex(size_t idx) {
   if (!m_head)
     return nullptr;
 
-  if (HasLoop(idx + 1))
-    return nullptr;
-
-  ValueObjectSP current_sp = GetItem(idx);
-  if (!current_sp)
-    return nullptr;
-
-  current_sp = current_sp->GetChildAtIndex(1, true); // get the __value_ child
-  if (!current_sp)
-    return nullptr;
-
-  // we need to copy current_sp into a new object otherwise we will end up with
-  // all items named __value_
-  DataExtractor data;
-  Status error;
-  current_sp->GetData(data, error);
-  if (error.Fail())
-    return nullptr;
-
-  return CreateValueObjectFromData(llvm::formatv("[{0}]", idx).str(), data,
-                                   m_backend.GetExecutionContextRef(),
-                                   m_element_type);
+  return GetItem(idx);
 }
 
 bool ForwardListFrontEnd::Update() {
@@ -306,6 +227,7 @@ bool ForwardListFrontEnd::Update() {
   if (!impl_sp)
     return false;
   m_head = impl_sp->GetChildMemberWithName(ConstString("__next_"), true).get();
+  StartWalk(/*end_node=*/0, /*num_links=*/1);
   return false;
 }
 
@@ -339,67 +261,19 @@ size_t ListFrontEnd::CalculateNumChildren() {
       return 0;
     if (next_val == prev_val)
       return 1;
-    uint64_t size = 2;
-    ListEntry current(m_head);
-    while (current.next() && current.next().value() != m_node_address) {
-      size++;
-      current = current.next();
-      if (size > m_list_capping_size)
-        break;
-    }
-    return m_count = (size - 1);
+    ReadNodes(m_list_capping_size);
+    return m_count = m_nodes.size();
   }
 }
 
 lldb::ValueObjectSP ListFrontEnd::GetChildAtIndex(size_t idx) {
-  static ConstString g_value("__value_");
-  static ConstString g_next("__next_");
-
   if (idx >= CalculateNumChildren())
     return lldb::ValueObjectSP();
 
   if (!m_head || !m_tail || m_node_address == 0)
     return lldb::ValueObjectSP();
 
-  if (HasLoop(idx + 1))
-    return lldb::ValueObjectSP();
-
-  ValueObjectSP current_sp = GetItem(idx);
-  if (!current_sp)
-    return lldb::ValueObjectSP();
-
-  current_sp = current_sp->GetChildAtIndex(1, true); // get the __value_ child
-  if (!current_sp)
-    return lldb::ValueObjectSP();
-
-  if (current_sp->GetName() == g_next) {
-    ProcessSP process_sp(current_sp->GetProcessSP());
-    if (!process_sp)
-      return lldb::ValueObjectSP();
-
-    // if we grabbed the __next_ pointer, then the child is one pointer deep-er
-    lldb::addr_t addr = current_sp->GetParent()->GetPointerValue();
-    addr = addr + 2 * process_sp->GetAddressByteSize();
-    ExecutionContext exe_ctx(process_sp);
-    current_sp =
-        CreateValueObjectFromAddress("__value_", addr, exe_ctx, m_element_type);
-    if (!current_sp)
-      return lldb::ValueObjectSP();
-  }
-
-  // we need to copy current_sp into a new object otherwise we will end up with
-  // all items named __value_
-  DataExtractor data;
-  Status error;
-  current_sp->GetData(data, error);
-  if (error.Fail())
-    return lldb::ValueObjectSP();
-
-  StreamString name;
-  name.Printf("[%" PRIu64 "]", (uint64_t)idx);
-  return CreateValueObjectFromData(name.GetString(), data,
-                                   m_backend.GetExecutionContextRef(),
-                                   m_element_type);
+  return GetItem(idx);
 }
 
 bool ListFrontEnd::Update() {
@@ -420,6 +294,7 @@ bool ListFrontEnd::Update() {
     return false;
   m_head = impl_sp->GetChildMemberWithName(ConstString("__next_"), true).get();
   m_tail = impl_sp->GetChildMemberWithName(ConstString("__prev_"), true).get();
+  StartWalk(/*end_node=*/m_node_address, /*num_links=*/2);
   return false;
 }
 
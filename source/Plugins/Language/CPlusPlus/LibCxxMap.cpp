@@ -22,154 +22,6 @@ using namespace lldb;
 using namespace lldb_private;
 using namespace lldb_private::formatters;
 
-class MapEntry {
-public:
-  MapEntry() = default;
-  explicit MapEntry(ValueObjectSP entry_sp) : m_entry_sp(entry_sp) {}
-  MapEntry(const MapEntry &rhs) = default;
-  explicit MapEntry(ValueObject *entry)
-      : m_entry_sp(entry ? entry->GetSP() : ValueObjectSP()) {}
-
-  ValueObjectSP left() const {
-    static ConstString g_left("__left_");
-    if (!m_entry_sp)
-      return m_entry_sp;
-    return m_entry_sp->GetSyntheticChildAtOffset(
-        0, m_entry_sp->GetCompilerType(), true);
-  }
-
-  ValueObjectSP right() const {
-    static ConstString g_right("__right_");
-    if (!m_entry_sp)
-      return m_entry_sp;
-    return m_entry_sp->GetSyntheticChildAtOffset(
-        m_entry_sp->GetProcessSP()->GetAddressByteSize(),
-        m_entry_sp->GetCompilerType(), true);
-  }
-
-  ValueObjectSP parent() const {
-    static ConstString g_parent("__parent_");
-    if (!m_entry_sp)
-      return m_entry_sp;
-    return m_entry_sp->GetSyntheticChildAtOffset(
-        2 * m_entry_sp->GetProcessSP()->GetAddressByteSize(),
-        m_entry_sp->GetCompilerType(), true);
-  }
-
-  uint64_t value() const {
-    if (!m_entry_sp)
-      return 0;
-    return m_entry_sp->GetValueAsUnsigned(0);
-  }
-
-  bool error() const {
-    if (!m_entry_sp)
-      return true;
-    return m_entry_sp->GetError().Fail();
-  }
-
-  bool null() const { return (value() == 0); }
-
-  ValueObjectSP GetEntry() const { return m_entry_sp; }
-
-  void SetEntry(ValueObjectSP entry) { m_entry_sp = entry; }
-
-  bool operator==(const MapEntry &rhs) const {
-    return (rhs.m_entry_sp.get() == m_entry_sp.get());
-  }
-
-private:
-  ValueObjectSP m_entry_sp;
-};
-
-class MapIterator {
-public:
-  MapIterator() = default;
-  MapIterator(MapEntry entry, size_t depth = 0)
-      : m_entry(entry), m_max_depth(depth), m_error(false) {}
-  MapIterator(ValueObjectSP entry, size_t depth = 0)
-      : m_entry(entry), m_max_depth(depth), m_error(false) {}
-  MapIterator(const MapIterator &rhs)
-      : m_entry(rhs.m_entry), m_max_depth(rhs.m_max_depth), m_error(false) {}
-  MapIterator(ValueObject *entry, size_t depth = 0)
-      : m_entry(entry), m_max_depth(depth), m_error(false) {}
-
-  MapIterator &operator=(const MapIterator &) = default;
-
-  ValueObjectSP value() { return m_entry.GetEntry(); }
-
-  ValueObjectSP advance(size_t count) {
-    ValueObjectSP fail;
-    if (m_error)
-      return fail;
-    size_t steps = 0;
-    while (count > 0) {
-      next();
-      count--, steps++;
-      if (m_error || m_entry.null() || (steps > m_max_depth))
-        return fail;
-    }
-    return m_entry.GetEntry();
-  }
-
-protected:
-  void next() {
-    if (m_entry.null())
-      return;
-    MapEntry right(m_entry.right());
-    if (!right.null()) {
-      m_entry = tree_min(std::move(right));
-      return;
-    }
-    size_t steps = 0;
-    while (!is_left_child(m_entry)) {
-      if (m_entry.error()) {
-        m_error = true;
-        return;
-      }
-      m_entry.SetEntry(m_entry.parent());
-      steps++;
-      if (steps > m_max_depth) {
-        m_entry = MapEntry();
-        return;
-      }
-    }
-    m_entry = MapEntry(m_entry.parent());
-  }
-
-private:
-  MapEntry tree_min(MapEntry &&x) {
-    if (x.null())
-      return MapEntry();
-    MapEntry left(x.left());
-    size_t steps = 0;
-    while (!left.null()) {
-      if (left.error()) {
-        m_error = true;
-        return MapEntry();
-      }
-      x = left;
-      left.SetEntry(x.left());
-      steps++;
-      if (steps > m_max_depth)
-        return MapEntry();
-    }
-    return x;
-  }
-
-  bool is_left_child(const MapEntry &x) {
-    if (x.null())
-      return false;
-    MapEntry rhs(x.parent());
-    rhs.SetEntry(rhs.left());
-    return x.value() == rhs.value();
-  }
-
-  MapEntry m_entry;
-  size_t m_max_depth;
-  bool m_error;
-};
-
 namespace lldb_private {
 namespace formatters {
 class LibcxxStdMapSyntheticFrontEnd : public SyntheticChildrenFrontEnd {
@@ -193,12 +45,22 @@ private:
 
   void GetValueOffset(const lldb::ValueObjectSP &node);
 
+  bool ReadNodeLinks(lldb::addr_t node, lldb::addr_t &left,
+                     lldb::addr_t &right, lldb::addr_t &parent);
+
+  bool ReadNodes(size_t count);
+
   ValueObject *m_tree;
   ValueObject *m_root_node;
   CompilerType m_element_type;
   uint32_t m_skip_size;
   size_t m_count;
-  std::map<size_t, MapIterator> m_iterators;
+  // The addresses of the nodes of the tree in order, read up to the furthest
+  // element that was needed since the last Update().
+  std::vector<lldb::addr_t> m_nodes;
+  // The number of links followed to find m_nodes. The walk stops when it
+  // takes more steps than a walk of a valid tree would.
+  size_t m_walk_steps;
 };
 } // namespace formatters
 } // namespace lldb_private
@@ -207,7 +69,7 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::
     LibcxxStdMapSyntheticFrontEnd(lldb::ValueObjectSP valobj_sp)
     : SyntheticChildrenFrontEnd(*valobj_sp), m_tree(nullptr),
       m_root_node(nullptr), m_element_type(), m_skip_size(UINT32_MAX),
-      m_count(UINT32_MAX), m_iterators() {
+      m_count(UINT32_MAX), m_nodes(), m_walk_steps(0) {
   if (valobj_sp)
     Update();
 }
@@ -328,86 +190,134 @@ void lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetValueOffset(
   }
 }
 
+// Read the __left_, __right_ and __parent_ pointers at the start of a node.
+// The reads go through the memory cache of the process, which usually
+// holds the nodes close to the ones already read.
+bool lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::ReadNodeLinks(
+    lldb::addr_t node, lldb::addr_t &left, lldb::addr_t &right,
+    lldb::addr_t &parent) {
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  if (!process_sp || node == 0 || node == LLDB_INVALID_ADDRESS)
+    return false;
+  const uint32_t pointer_size = process_sp->GetAddressByteSize();
+  uint8_t buffer[3 * sizeof(lldb::addr_t)];
+  Status error;
+  if (process_sp->ReadMemory(node, buffer, 3 * pointer_size, error) !=
+      3 * pointer_size)
+    return false;
+  DataExtractor data(buffer, 3 * pointer_size, process_sp->GetByteOrder(),
+                     pointer_size);
+  lldb::offset_t offset = 0;
+  left = data.GetAddress(&offset);
+  right = data.GetAddress(&offset);
+  parent = data.GetAddress(&offset);
+  return true;
+}
+
+// Extend m_nodes to the first count nodes of the tree with an in-order walk
+// that follows the links of the nodes by address.
+bool lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::ReadNodes(
+    size_t count) {
+  if (m_nodes.empty()) {
+    lldb::addr_t begin = m_root_node->GetValueAsUnsigned(0);
+    if (begin == 0 || begin == LLDB_INVALID_ADDRESS)
+      return false;
+    m_nodes.push_back(begin);
+  }
+
+  // Walking a whole tree follows each link at most twice, once down and once
+  // up, and takes one more step per node.
+  const size_t max_steps = 3 * CalculateNumChildren() + 3;
+  lldb::addr_t left, right, parent;
+  while (m_nodes.size() < count) {
+    lldb::addr_t node = m_nodes.back();
+    if (!ReadNodeLinks(node, left, right, parent))
+      return false;
+    if (right != 0) {
+      // The next node is the leftmost node of the right subtree.
+      node = right;
+      while (true) {
+        if (!ReadNodeLinks(node, left, right, parent))
+          return false;
+        if (left == 0)
+          break;
+        node = left;
+        if (++m_walk_steps > max_steps)
+          return false;
+      }
+    } else {
+      // The next node is the first ancestor whose left subtree holds node.
+      lldb::addr_t parent_left, parent_right, grand_parent;
+      while (true) {
+        if (!ReadNodeLinks(parent, parent_left, parent_right, grand_parent))
+          return false;
+        if (++m_walk_steps > max_steps)
+          return false;
+        if (parent_left == node)
+          break;
+        node = parent;
+        parent = grand_parent;
+      }
+      node = parent;
+    }
+    if (++m_walk_steps > max_steps)
+      return false;
+    m_nodes.push_back(node);
+  }
+  return true;
+}
+
 lldb::ValueObjectSP
 lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetChildAtIndex(
     size_t idx) {
   static ConstString g___cc("__cc");
   static ConstString g___nc("__nc");
-  static ConstString g___value_("__value_");
 
   if (idx >= CalculateNumChildren())
     return lldb::ValueObjectSP();
   if (m_tree == nullptr || m_root_node == nullptr)
     return lldb::ValueObjectSP();
 
-  MapIterator iterator(m_root_node, CalculateNumChildren());
-
-  const bool need_to_skip = (idx > 0);
-  size_t actual_advancde = idx;
-  if (need_to_skip) {
-    auto cached_iterator = m_iterators.find(idx - 1);
-    if (cached_iterator != m_iterators.end()) {
-      iterator = cached_iterator->second;
-      actual_advancde = 1;
-    }
-  }
-
-  ValueObjectSP iterated_sp(iterator.advance(actual_advancde));
-  if (!iterated_sp) {
+  if (!ReadNodes(idx + 1) || !GetDataType()) {
     // this tree is garbage - stop
     m_tree =
         nullptr; // this will stop all future searches until an Update() happens
-    return iterated_sp;
+    return lldb::ValueObjectSP();
   }
-  if (GetDataType()) {
-    if (!need_to_skip) {
-      Status error;
-      iterated_sp = iterated_sp->Dereference(error);
-      if (!iterated_sp || error.Fail()) {
-        m_tree = nullptr;
-        return lldb::ValueObjectSP();
-      }
-      GetValueOffset(iterated_sp);
-      auto child_sp = iterated_sp->GetChildMemberWithName(g___value_, true);
-      if (child_sp)
-        iterated_sp = child_sp;
-      else
-        iterated_sp = iterated_sp->GetSyntheticChildAtOffset(
-            m_skip_size, m_element_type, true);
-      if (!iterated_sp) {
-        m_tree = nullptr;
-        return lldb::ValueObjectSP();
-      }
-    } else {
-      // because of the way our debug info is made, we need to read item 0
-      // first so that we can cache information used to generate other elements
-      if (m_skip_size == UINT32_MAX)
-        GetChildAtIndex(0);
-      if (m_skip_size == UINT32_MAX) {
-        m_tree = nullptr;
-        return lldb::ValueObjectSP();
-      }
-      iterated_sp = iterated_sp->GetSyntheticChildAtOffset(
-          m_skip_size, m_element_type, true);
-      if (!iterated_sp) {
-        m_tree = nullptr;
-        return lldb::ValueObjectSP();
-      }
+
+  // because of the way our debug info is made, we need to look at the first
+  // node to find where the value is in a node
+  if (m_skip_size == UINT32_MAX) {
+    Status error;
+    ValueObjectSP node_sp = m_root_node->Dereference(error);
+    if (!node_sp || error.Fail()) {
+      m_tree = nullptr;
+      return lldb::ValueObjectSP();
     }
-  } else {
+    GetValueOffset(node_sp);
+    if (m_skip_size == UINT32_MAX) {
+      m_tree = nullptr;
+      return lldb::ValueObjectSP();
+    }
+  }
+
+  // we need to copy the value into a new object otherwise we will end up with
+  // all items named __value_
+  ProcessSP process_sp = m_backend.GetProcessSP();
+  llvm::Optional<uint64_t> size = m_element_type.GetByteSize(process_sp.get());
+  if (!process_sp || !size || *size == 0) {
     m_tree = nullptr;
     return lldb::ValueObjectSP();
   }
-  // at this point we have a valid
-  // we need to copy current_sp into a new object otherwise we will end up with
-  // all items named __value_
-  DataExtractor data;
+  DataBufferSP buffer_sp(new DataBufferHeap(*size, 0));
   Status error;
-  iterated_sp->GetData(data, error);
-  if (error.Fail()) {
+  if (process_sp->ReadMemory(m_nodes[idx] + m_skip_size,
+                             buffer_sp->GetBytes(), *size, error) != *size) {
     m_tree = nullptr;
     return lldb::ValueObjectSP();
   }
+  DataExtractor data(buffer_sp, process_sp->GetByteOrder(),
+                     process_sp->GetAddressByteSize());
   StreamString name;
   name.Printf("[%" PRIu64 "]", (uint64_t)idx);
   auto potential_child_sp = CreateValueObjectFromData(
@@ -431,7 +341,6 @@ lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::GetChildAtIndex(
     }
     }
   }
-  m_iterators[idx] = iterator;
   return potential_child_sp;
 }
 
@@ -440,7 +349,8 @@ bool lldb_private::formatters::LibcxxStdMapSyntheticFrontEnd::Update() {
   static ConstString g___begin_node_("__begin_node_");
   m_count = UINT32_MAX;
   m_tree = m_root_node = nullptr;
-  m_iterators.clear();
+  m_nodes.clear();
+  m_walk_steps = 0;
   m_tree = m_backend.GetChildMemberWithName(g___tree_, true).get();
   if (!m_tree)
     return false;
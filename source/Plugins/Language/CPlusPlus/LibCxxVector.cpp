@@ -39,6 +39,7 @@ private:
   ValueObject *m_finish;
   CompilerType m_element_type;
   uint32_t m_element_size;
+  ContiguousChildrenReader m_children_reader;
 };
 
 class LibcxxVectorBoolSyntheticFrontEnd : public SyntheticChildrenFrontEnd {
@@ -107,17 +108,13 @@ lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::GetChildAtIndex(
   if (!m_start || !m_finish)
     return lldb::ValueObjectSP();
 
-  uint64_t offset = idx * m_element_size;
-  offset = offset + m_start->GetValueAsUnsigned(0);
-  StreamString name;
-  name.Printf("[%" PRIu64 "]", (uint64_t)idx);
-  return CreateValueObjectFromAddress(name.GetString(), offset,
-                                      m_backend.GetExecutionContextRef(),
-                                      m_element_type);
+  return m_children_reader.GetChildAtIndex(idx,
+                                          m_backend.GetExecutionContextRef());
 }
 
 bool lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::Update() {
   m_start = m_finish = nullptr;
+  m_children_reader.Reset(LLDB_INVALID_ADDRESS, 0, CompilerType(), 0);
   ValueObjectSP data_type_finder_sp(
       m_backend.GetChildMemberWithName(ConstString("__end_cap_"), true));
   if (!data_type_finder_sp)
@@ -155,6 +152,10 @@ bool lldb_private::formatters::LibcxxStdVectorSyntheticFrontEnd::Update() {
           m_backend.GetChildMemberWithName(ConstString("__end_"), true).get();
     }
   }
+  if (m_start && m_finish)
+    m_children_reader.Reset(m_start->GetValueAsUnsigned(0),
+                            CalculateNumChildren(), m_element_type,
+                            m_element_size);
   return false;
 }
 
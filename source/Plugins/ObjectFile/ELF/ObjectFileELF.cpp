@@ -14,6 +14,7 @@
 
 #include "lldb/Core/FileSpecList.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
@@ -37,9 +38,14 @@
 #include "llvm/Object/Decompressor.h"
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/CRC.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/MipsABIFlags.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/xxhash.h"
 
 #define CASE_AND_STREAM(s, def, width)                                         \
   case def:                                                                    \
@@ -2667,6 +2673,18 @@ unsigned ObjectFileELF::ApplyRelocations(
   return 0;
 }
 
+void ObjectFileELF::MakeDataPrivate() {
+  if (IsInMemory() || !m_file)
+    return;
+  // A new private mapping only copies the pages that get relocated.
+  DataBufferSP data_sp = FileSystem::Instance().CreateDataBuffer(
+      m_file.GetPath(), m_data.GetByteSize(), m_file_offset);
+  if (!data_sp || data_sp->GetByteSize() != m_data.GetByteSize())
+    data_sp = std::make_shared<DataBufferHeap>(m_data.GetDataStart(),
+                                               m_data.GetByteSize());
+  m_data.SetData(data_sp);
+}
+
 unsigned ObjectFileELF::RelocateDebugSections(const ELFSectionHeader *rel_hdr,
                                               user_id_t rel_id,
                                               lldb_private::Symtab *thetab) {
@@ -2700,6 +2718,8 @@ unsigned ObjectFileELF::RelocateDebugSections(const ELFSectionHeader *rel_hdr,
   if (!debug)
     return 0;
 
+  std::call_once(m_private_data_once, [this]() { MakeDataPrivate(); });
+
   DataExtractor rel_data;
   DataExtractor symtab_data;
   DataExtractor debug_data;
@@ -3336,13 +3356,137 @@ size_t ObjectFileELF::ReadSectionData(Section *section,
   if (!section->Test(SHF_COMPRESSED))
     return ObjectFile::ReadSectionData(section, section_offset, dst, dst_len);
 
-  // For compressed sections we need to read to full data to be able to
-  // decompress.
+  // For compressed sections we need the full decompressed data, which is only
+  // computed on the first read of the section.
   DataExtractor data;
   ReadSectionData(section, data);
   return data.CopyData(section_offset, dst_len, dst);
 }
 
+/// \return
+///     The file where the decompressed contents of the given section are
+///     cached, or an empty FileSpec if the cache is disabled or the object file
+///     has no build-id. Besides the build-id, the file is keyed on a hash of the
+///     compressed contents of the section, so that a rebuilt file that kept its
+///     build-id never gets the contents of the old one.
+static FileSpec
+GetDecompressedSectionCacheFile(const UUID &uuid, llvm::StringRef section_name,
+                                const DataExtractor &compressed_data) {
+  FileSpec cache_dir = ModuleList::GetGlobalModuleListProperties()
+                           .GetDecompressedSectionCachePath();
+  if (!cache_dir || !uuid.IsValid())
+    return FileSpec();
+  uint64_t hash = llvm::xxHash64(llvm::StringRef(
+      reinterpret_cast<const char *>(compressed_data.GetDataStart()),
+      compressed_data.GetByteSize()));
+  FileSpec cache_file = cache_dir.CopyByAppendingPathComponent(
+      uuid.GetAsString(/*separator*/ ""));
+  cache_file.AppendPathComponent(
+      llvm::formatv("{0}-{1:x-16}", section_name, hash).str());
+  return cache_file;
+}
+
+/// Load the decompressed contents of a section from the cache.
+///
+/// \return
+///     The contents, or nullptr if the section is not cached or the cached
+///     file doesn't have the expected size.
+static DataBufferSP LoadDecompressedSection(const FileSpec &cache_file,
+                                            uint64_t size) {
+  FileSystem &fs = FileSystem::Instance();
+  if (!cache_file || !fs.Exists(cache_file) ||
+      fs.GetByteSize(cache_file) != size)
+    return nullptr;
+  return fs.CreateDataBuffer(cache_file);
+}
+
+/// Store the decompressed contents of a section in the cache.
+static void StoreDecompressedSection(const FileSpec &cache_file,
+                                     const DataBuffer &data) {
+  if (!cache_file)
+    return;
+
+  Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_OBJECT);
+  std::string path = cache_file.GetPath();
+  if (std::error_code ec = llvm::sys::fs::create_directories(
+          cache_file.GetDirectory().GetStringRef())) {
+    LLDB_LOG(log, "failed to create directory for {0}: {1}", path,
+             ec.message());
+    return;
+  }
+
+  llvm::Error error = llvm::writeFileAtomically(
+      path + "-%%%%%%.tmp", path, [&data](llvm::raw_ostream &os) {
+        os.write(reinterpret_cast<const char *>(data.GetBytes()),
+                 data.GetByteSize());
+        return llvm::Error::success();
+      });
+  if (error)
+    LLDB_LOG_ERROR(log, std::move(error), "failed to save {1}: {0}", path);
+}
+
+/// Decompress a compressed section, using the decompressed section cache if it
+/// is enabled.
+static llvm::Expected<DataBufferSP>
+DecompressSection(llvm::StringRef section_name,
+                  const DataExtractor &compressed_data, const UUID &uuid,
+                  bool is_little_endian, bool is_64bit) {
+  auto decompressor = llvm::object::Decompressor::create(
+      section_name,
+      {reinterpret_cast<const char *>(compressed_data.GetDataStart()),
+       size_t(compressed_data.GetByteSize())},
+      is_little_endian, is_64bit);
+  if (!decompressor)
+    return llvm::createStringError(
+        llvm::inconvertibleErrorCode(),
+        "Unable to initialize decompressor for section '%s': %s",
+        section_name.str().c_str(),
+        llvm::toString(decompressor.takeError()).c_str());
+
+  uint64_t size = decompressor->getDecompressedSize();
+  FileSpec cache_file =
+      GetDecompressedSectionCacheFile(uuid, section_name, compressed_data);
+  if (DataBufferSP cached_sp = LoadDecompressedSection(cache_file, size))
+    return cached_sp;
+
+  auto buffer_sp = std::make_shared<DataBufferHeap>(size, 0);
+  if (auto error = decompressor->decompress(
+          {reinterpret_cast<char *>(buffer_sp->GetBytes()),
+           size_t(buffer_sp->GetByteSize())}))
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "Decompression of section '%s' failed: %s",
+                                   section_name.str().c_str(),
+                                   llvm::toString(std::move(error)).c_str());
+
+  StoreDecompressedSection(cache_file, *buffer_sp);
+  return buffer_sp;
+}
+
+DataBufferSP
+ObjectFileELF::GetDecompressedSectionData(Section &section,
+                                          const DataExtractor &compressed_data) {
+  {
+    std::lock_guard<std::mutex> guard(m_decompressed_sections_mutex);
+    auto it = m_decompressed_sections.find(section.GetID());
+    if (it != m_decompressed_sections.end())
+      return it->second;
+  }
+
+  DataBufferSP data_sp;
+  llvm::Expected<DataBufferSP> data_or_err = DecompressSection(
+      section.GetName().GetStringRef(), compressed_data, GetUUID(),
+      GetByteOrder() == eByteOrderLittle, GetAddressByteSize() == 8);
+  if (data_or_err)
+    data_sp = *data_or_err;
+  else
+    GetModule()->ReportWarning(
+        "%s", llvm::toString(data_or_err.takeError()).c_str());
+
+  std::lock_guard<std::mutex> guard(m_decompressed_sections_mutex);
+  return m_decompressed_sections.emplace(section.GetID(), data_sp)
+      .first->second;
+}
+
 size_t ObjectFileELF::ReadSectionData(Section *section,
                                       DataExtractor &section_data) {
   // If some other objectfile owns this data, pass this to them.
@@ -3354,29 +3498,8 @@ size_t ObjectFileELF::ReadSectionData(Section *section,
                          section->Get(), section->GetName().GetStringRef()))
     return result;
 
-  auto Decompressor = llvm::object::Decompressor::create(
-      section->GetName().GetStringRef(),
-      {reinterpret_cast<const char *>(section_data.GetDataStart()),
-       size_t(section_data.GetByteSize())},
-      GetByteOrder() == eByteOrderLittle, GetAddressByteSize() == 8);
-  if (!Decompressor) {
-    GetModule()->ReportWarning(
-        "Unable to initialize decompressor for section '%s': %s",
-        section->GetName().GetCString(),
-        llvm::toString(Decompressor.takeError()).c_str());
-    section_data.Clear();
-    return 0;
-  }
-
-  auto buffer_sp =
-      std::make_shared<DataBufferHeap>(Decompressor->getDecompressedSize(), 0);
-  if (auto error = Decompressor->decompress(
-          {reinterpret_cast<char *>(buffer_sp->GetBytes()),
-           size_t(buffer_sp->GetByteSize())})) {
-    GetModule()->ReportWarning(
-        "Decompression of section '%s' failed: %s",
-        section->GetName().GetCString(),
-        llvm::toString(std::move(error)).c_str());
+  DataBufferSP buffer_sp = GetDecompressedSectionData(*section, section_data);
+  if (!buffer_sp) {
     section_data.Clear();
     return 0;
   }
@@ -3385,6 +3508,61 @@ size_t ObjectFileELF::ReadSectionData(Section *section,
   return buffer_sp->GetByteSize();
 }
 
+void ObjectFileELF::PrefetchSectionData(llvm::ArrayRef<SectionSP> sections) {
+  // Reading the compressed data is cheap, as it comes from the mapped file, so
+  // it is done serially. Only decompression is spread across threads.
+  std::vector<Section *> compressed_sections;
+  std::vector<DataExtractor> compressed_data;
+  for (const SectionSP &section_sp : sections) {
+    if (!section_sp || section_sp->GetObjectFile() != this ||
+        !llvm::object::Decompressor::isCompressedELFSection(
+            section_sp->Get(), section_sp->GetName().GetStringRef()))
+      continue;
+    {
+      std::lock_guard<std::mutex> guard(m_decompressed_sections_mutex);
+      if (m_decompressed_sections.count(section_sp->GetID()))
+        continue;
+    }
+    DataExtractor data;
+    if (ObjectFile::ReadSectionData(section_sp.get(), data) == 0)
+      continue;
+    compressed_sections.push_back(section_sp.get());
+    compressed_data.push_back(data);
+  }
+
+  // A single section is decompressed when it is read.
+  if (compressed_sections.size() < 2)
+    return;
+
+  const bool is_little_endian = GetByteOrder() == eByteOrderLittle;
+  const bool is_64bit = GetAddressByteSize() == 8;
+  const UUID uuid = GetUUID();
+  std::vector<DataBufferSP> results(compressed_sections.size());
+  std::vector<std::string> errors(compressed_sections.size());
+
+  llvm::ThreadPool pool(llvm::optimal_concurrency(compressed_sections.size()));
+  for (size_t i = 0; i < compressed_sections.size(); ++i) {
+    pool.async([&, i]() {
+      llvm::Expected<DataBufferSP> data_or_err = DecompressSection(
+          compressed_sections[i]->GetName().GetStringRef(), compressed_data[i],
+          uuid, is_little_endian, is_64bit);
+      if (data_or_err)
+        results[i] = *data_or_err;
+      else
+        errors[i] = llvm::toString(data_or_err.takeError());
+    });
+  }
+  pool.wait();
+
+  std::lock_guard<std::mutex> guard(m_decompressed_sections_mutex);
+  for (size_t i = 0; i < compressed_sections.size(); ++i) {
+    if (!errors[i].empty())
+      GetModule()->ReportWarning("%s", errors[i].c_str());
+    m_decompressed_sections.emplace(compressed_sections[i]->GetID(),
+                                    results[i]);
+  }
+}
+
 llvm::ArrayRef<ELFProgramHeader> ObjectFileELF::ProgramHeaders() {
   ParseProgramHeaders();
   return m_program_headers;
@@ -11,6 +11,8 @@
 
 #include <stdint.h>
 
+#include <map>
+#include <mutex>
 #include <vector>
 
 #include "lldb/Symbol/ObjectFile.h"
@@ -146,6 +148,8 @@ public:
   size_t ReadSectionData(lldb_private::Section *section,
                          lldb_private::DataExtractor &section_data) override;
 
+  void PrefetchSectionData(llvm::ArrayRef<lldb::SectionSP> sections) override;
+
   llvm::ArrayRef<elf::ELFProgramHeader> ProgramHeaders();
   lldb_private::DataExtractor GetSegmentData(const elf::ELFProgramHeader &H);
 
@@ -225,6 +229,30 @@ private:
   /// The address class for each symbol in the elf file
   FileAddressToAddressClassMap m_address_class_map;
 
+  /// Decompressed contents of the compressed sections, indexed by section id.
+  /// A null buffer means that the section couldn't be decompressed.
+  std::map<lldb::user_id_t, lldb::DataBufferSP> m_decompressed_sections;
+  std::mutex m_decompressed_sections_mutex;
+
+  /// Set once m_data no longer refers to the mapping of the file shared with
+  /// the other object files, before the first relocation is applied to it.
+  std::once_flag m_private_data_once;
+
+  /// Get the decompressed contents of a compressed section, decompressing it
+  /// only the first time.
+  ///
+  /// \param[in] section
+  ///     The compressed section.
+  ///
+  /// \param[in] compressed_data
+  ///     The raw contents of the section in the object file.
+  ///
+  /// \return
+  ///     The decompressed contents, or nullptr if decompression failed.
+  lldb::DataBufferSP
+  GetDecompressedSectionData(lldb_private::Section &section,
+                             const lldb_private::DataExtractor &compressed_data);
+
   /// Returns the index of the given section header.
   size_t SectionIndex(const SectionHeaderCollIter &I);
 
@@ -303,6 +331,11 @@ private:
   void ParseUnwindSymbols(lldb_private::Symtab *symbol_table,
                           lldb_private::DWARFCallFrameInfo *eh_frame);
 
+  /// Replace m_data with a private copy of the file contents, which can be
+  /// relocated in place without changing the data seen by the other object
+  /// files that share the mapping of the file.
+  void MakeDataPrivate();
+
   /// Relocates debug sections
   unsigned RelocateDebugSections(const elf::ELFSectionHeader *rel_hdr,
                                  lldb::user_id_t rel_id,
@@ -738,6 +738,13 @@ void NativeProcessLinux::MonitorTrace(NativeThreadLinux &thread) {
   // This thread is currently stopped.
   thread.SetStoppedByTrace();
 
+  if (m_step_over && m_step_over->stepping &&
+      m_step_over->tid == thread.GetID()) {
+    // The thread stepped over a breakpoint whose conditions are false.
+    FinishBreakpointStepOver(/*resume=*/true);
+    return;
+  }
+
   StopRunningThreads(thread.GetID());
 }
 
@@ -746,13 +753,31 @@ void NativeProcessLinux::MonitorBreakpoint(NativeThreadLinux &thread) {
       GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
   LLDB_LOG(log, "received breakpoint event, pid = {0}", thread.GetID());
 
+  const bool was_running = thread.GetState() == eStateRunning;
+
   // Mark the thread as stopped at breakpoint.
   thread.SetStoppedByBreakpoint();
   FixupBreakpointPCAsNeeded(thread);
 
   if (m_threads_stepping_with_breakpoint.find(thread.GetID()) !=
-      m_threads_stepping_with_breakpoint.end())
+      m_threads_stepping_with_breakpoint.end()) {
     thread.SetStoppedByTrace();
+  } else if (was_running && !m_step_over &&
+             m_pending_notification_tid == LLDB_INVALID_THREAD_ID &&
+             SupportHardwareSingleStepping()) {
+    // Step over breakpoints whose conditions are false instead of reporting
+    // the stop. The other threads are stopped while the trap is removed, so
+    // that they can't run past the breakpoint.
+    const lldb::addr_t pc = thread.GetRegisterContext().GetPC();
+    if (!BreakpointConditionsSayStop(thread, pc)) {
+      m_step_over = BreakpointStepOver{thread.GetID(), pc, {}};
+      for (const auto &thread_up : m_threads) {
+        if (StateIsRunningState(thread_up->GetState()))
+          m_step_over->threads_to_resume.emplace_back(thread_up->GetID(),
+                                                      thread_up->GetState());
+      }
+    }
+  }
 
   StopRunningThreads(thread.GetID());
 }
@@ -1677,6 +1702,9 @@ bool NativeProcessLinux::StopTrackingThread(lldb::tid_t thread_id) {
 
   if (found)
     StopTracingForThread(thread_id);
+  if (found && m_step_over && m_step_over->stepping &&
+      m_step_over->tid == thread_id)
+    FinishBreakpointStepOver(/*resume=*/true);
   SignalIfAllThreadsStopped();
   return found;
 }
@@ -1826,6 +1854,17 @@ void NativeProcessLinux::SignalIfAllThreadsStopped() {
       return; // Some threads are still running. Don't signal yet.
   }
 
+  if (m_step_over) {
+    if (!m_step_over->stepping &&
+        m_pending_notification_tid == m_step_over->tid &&
+        StartBreakpointStepOver())
+      return;
+    // Another thread stopped, or the stepping thread stopped for another
+    // reason. The thread that hit the breakpoint reports it, and the client
+    // evaluates its conditions again.
+    FinishBreakpointStepOver(/*resume=*/false);
+  }
+
   // We have a pending notification and all threads have stopped.
   Log *log(
       GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS | LIBLLDB_LOG_BREAKPOINTS));
@@ -1854,10 +1893,65 @@ void NativeProcessLinux::ThreadWasCreated(NativeThreadLinux &thread) {
       StateIsRunningState(thread.GetState())) {
     // We will need to wait for this new thread to stop as well before firing
     // the notification.
+    if (m_step_over && !m_step_over->stepping)
+      m_step_over->threads_to_resume.emplace_back(thread.GetID(),
+                                                  thread.GetState());
     thread.RequestStop();
   }
 }
 
+bool NativeProcessLinux::StartBreakpointStepOver() {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  NativeThreadLinux *thread = GetThreadByID(m_step_over->tid);
+  if (!thread)
+    return false;
+
+  Status error =
+      SetSoftwareBreakpointTrapInserted(m_step_over->addr, /*inserted=*/false);
+  if (error.Success()) {
+    m_pending_notification_tid = LLDB_INVALID_THREAD_ID;
+    error = ResumeThread(*thread, eStateStepping, LLDB_INVALID_SIGNAL_NUMBER);
+    m_step_over->stepping = true;
+  }
+  if (error.Fail()) {
+    LLDB_LOG(log, "tid {0}: failed to step over breakpoint at {1:x}: {2}",
+             thread->GetID(), m_step_over->addr, error);
+    m_pending_notification_tid = thread->GetID();
+    return false;
+  }
+  LLDB_LOG(log, "tid {0}: stepping over breakpoint at {1:x}",
+           thread->GetID(), m_step_over->addr);
+  return true;
+}
+
+void NativeProcessLinux::FinishBreakpointStepOver(bool resume) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  BreakpointStepOver step_over = std::move(*m_step_over);
+  m_step_over.reset();
+
+  if (step_over.stepping) {
+    Status error =
+        SetSoftwareBreakpointTrapInserted(step_over.addr, /*inserted=*/true);
+    if (error.Fail())
+      LLDB_LOG(log, "failed to reinsert breakpoint at {0:x}: {1}",
+               step_over.addr, error);
+  }
+  if (!resume)
+    return;
+
+  step_over.threads_to_resume.emplace_back(step_over.tid, eStateRunning);
+  for (const auto &tid_and_state : step_over.threads_to_resume) {
+    NativeThreadLinux *thread = GetThreadByID(tid_and_state.first);
+    if (!thread || !StateIsStoppedState(thread->GetState(), false))
+      continue;
+    Status error = ResumeThread(*thread, tid_and_state.second,
+                                LLDB_INVALID_SIGNAL_NUMBER);
+    if (error.Fail())
+      LLDB_LOG(log, "failed to resume thread {0}: {1}", thread->GetID(),
+               error);
+  }
+}
+
 void NativeProcessLinux::SigchldHandler() {
   Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
   // Process all pending waitpid notifications.
@@ -1945,6 +2039,19 @@ NativeProcessLinux::LookupProcessorTraceInstance(lldb::user_id_t traceid,
   return Status("tracing not active for this thread").ToError();
 }
 
+Status NativeProcessLinux::ReadData(
+    lldb::user_id_t traceid, lldb::tid_t thread, size_t size, size_t offset,
+    llvm::function_ref<void(llvm::ArrayRef<uint8_t>)> callback) {
+  auto perf_monitor = LookupProcessorTraceInstance(traceid, thread);
+  if (!perf_monitor)
+    return Status(perf_monitor.takeError());
+  // Pass the new data straight from the aux buffer instead of copying it.
+  if ((*perf_monitor).IsIncremental())
+    return (*perf_monitor).ConsumePerfTraceAux(size, callback);
+  return NativeProcessProtocol::ReadData(traceid, thread, size, offset,
+                                         callback);
+}
+
 Status NativeProcessLinux::GetMetaData(lldb::user_id_t traceid,
                                        lldb::tid_t thread,
                                        llvm::MutableArrayRef<uint8_t> &buffer,
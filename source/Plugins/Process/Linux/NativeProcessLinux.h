@@ -115,6 +115,10 @@ public:
                      llvm::MutableArrayRef<uint8_t> &buffer,
                      size_t offset = 0) override;
 
+  Status ReadData(
+      lldb::user_id_t traceid, lldb::tid_t thread, size_t size, size_t offset,
+      llvm::function_ref<void(llvm::ArrayRef<uint8_t>)> callback) override;
+
   Status GetTraceConfig(lldb::user_id_t traceid, TraceOptions &config) override;
 
   virtual llvm::Expected<TraceTypeInfo> GetSupportedTraceType() override;
@@ -145,6 +149,19 @@ private:
   // the relevan breakpoint
   std::map<lldb::tid_t, lldb::addr_t> m_threads_stepping_with_breakpoint;
 
+  /// A thread that hit a breakpoint whose conditions are false, and which is
+  /// stepped over the breakpoint while the other threads are stopped.
+  struct BreakpointStepOver {
+    lldb::tid_t tid;
+    lldb::addr_t addr;
+    /// The threads that were running or stepping when the breakpoint was
+    /// hit, and their state, which are resumed after the step.
+    std::vector<std::pair<lldb::tid_t, lldb::StateType>> threads_to_resume;
+    /// Whether the trap was removed and the thread is stepping.
+    bool stepping = false;
+  };
+  llvm::Optional<BreakpointStepOver> m_step_over;
+
   /// Inferior memory (allocated by us) and its size.
   llvm::DenseMap<lldb::addr_t, lldb::addr_t> m_allocated_memory;
 
@@ -175,6 +192,22 @@ private:
 
   Status SetupSoftwareSingleStepping(NativeThreadLinux &thread);
 
+  /// Step the thread of m_step_over over its breakpoint, once all the other
+  /// threads are stopped.
+  ///
+  /// \return
+  ///     False if the thread couldn't be stepped, in which case the stop
+  ///     must be reported.
+  bool StartBreakpointStepOver();
+
+  /// Put the trap of the breakpoint of m_step_over back in place if it was
+  /// removed and forget about the step over.
+  ///
+  /// \param[in] resume
+  ///     Whether to resume the thread that stepped and the threads that were
+  ///     stopped for the step.
+  void FinishBreakpointStepOver(bool resume);
+
   bool HasThreadNoLock(lldb::tid_t thread_id);
 
   bool StopTrackingThread(lldb::tid_t thread_id);
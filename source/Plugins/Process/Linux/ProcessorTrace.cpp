@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 
 #include "llvm/ADT/StringRef.h"
@@ -29,6 +30,17 @@ lldb::user_id_t ProcessorTraceMonitor::m_trace_num = 1;
 const char *kOSEventIntelPTTypeFile =
     "/sys/bus/event_source/devices/intel_pt/type";
 
+// Custom trace parameters understood by this class.
+const char *kIncrementalParam = "incremental";
+
+static bool GetBooleanTraceParam(const TraceOptions &config,
+                                 llvm::StringRef key) {
+  bool value = false;
+  if (const StructuredData::DictionarySP &params = config.getTraceParams())
+    params->GetValueForKeyAsBoolean(key, value);
+  return value;
+}
+
 Status ProcessorTraceMonitor::GetTraceConfig(TraceOptions &config) const {
 #ifndef PERF_ATTR_SIZE_VER5
   llvm_unreachable("perf event not supported");
@@ -146,8 +158,14 @@ Status ProcessorTraceMonitor::StartTrace(lldb::pid_t pid, lldb::tid_t tid,
   m_mmap_meta->aux_offset = m_mmap_meta->data_offset + m_mmap_meta->data_size;
   m_mmap_meta->aux_size = bufsize;
 
+  // A read-only aux mapping makes the kernel overwrite the oldest data once
+  // the buffer is full. A writable one makes it honor aux_tail, which lets us
+  // consume the buffer incrementally.
+  m_incremental = GetBooleanTraceParam(config, kIncrementalParam);
+  int aux_prot = m_incremental ? PROT_READ | PROT_WRITE : PROT_READ;
+
   errno = 0;
-  auto mmap_aux = mmap(nullptr, bufsize, PROT_READ, MAP_SHARED, fd,
+  auto mmap_aux = mmap(nullptr, bufsize, aux_prot, MAP_SHARED, fd,
                        static_cast<long int>(m_mmap_meta->aux_offset));
 
   if (mmap_aux == MAP_FAILED) {
@@ -281,12 +299,61 @@ ProcessorTraceMonitor::Create(lldb::pid_t pid, lldb::tid_t tid,
   return std::move(pt_monitor_up);
 }
 
+Status ProcessorTraceMonitor::ConsumePerfTraceAux(
+    size_t size, llvm::function_ref<void(llvm::ArrayRef<uint8_t>)> callback) {
+#ifndef PERF_ATTR_SIZE_VER5
+  llvm_unreachable("perf event not supported");
+#else
+  if (!m_incremental)
+    return Status("the trace buffer isn't read incrementally");
+
+  // Flush the internal buffer of the CPU, see ReadPerfTraceAux.
+  ioctl(*m_fd, PERF_EVENT_IOC_DISABLE);
+
+  Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PTRACE));
+  uint64_t head = m_mmap_meta->aux_head;
+  // The kernel publishes aux_head after writing the data, so we need an
+  // acquire barrier before reading the data, and a full barrier before
+  // publishing aux_tail so that the kernel doesn't overwrite the data while
+  // the callback still reads it. No locking is needed besides that.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t tail = m_mmap_meta->aux_tail;
+  LLDB_LOG(log, "Aux size -{0} , Head - {1} , Tail - {2}",
+           m_mmap_meta->aux_size, head, tail);
+
+  llvm::ArrayRef<uint8_t> first_part, second_part;
+  tail = GetRingBufferData(GetAuxBuffer(), tail, head, size, first_part,
+                           second_part);
+  if (!first_part.empty())
+    callback(first_part);
+  if (!second_part.empty())
+    callback(second_part);
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  m_mmap_meta->aux_tail = tail;
+
+  ioctl(*m_fd, PERF_EVENT_IOC_ENABLE);
+  return Status();
+#endif
+}
+
 Status
 ProcessorTraceMonitor::ReadPerfTraceAux(llvm::MutableArrayRef<uint8_t> &buffer,
                                         size_t offset) {
 #ifndef PERF_ATTR_SIZE_VER5
   llvm_unreachable("perf event not supported");
 #else
+  if (m_incremental) {
+    size_t bytes_read = 0;
+    Status error = ConsumePerfTraceAux(
+        buffer.size(), [&](llvm::ArrayRef<uint8_t> data) {
+          std::copy(data.begin(), data.end(), buffer.begin() + bytes_read);
+          bytes_read += data.size();
+        });
+    buffer = buffer.take_front(bytes_read);
+    return error;
+  }
+
   // Disable the perf event to force a flush out of the CPU's internal buffer.
   // Besides, we can guarantee that the CPU won't override any data as we are
   // reading the buffer.
@@ -426,3 +493,38 @@ void ProcessorTraceMonitor::ReadCyclicBuffer(
   }
   dst = dst.drop_back(bytes_left);
 }
+
+uint64_t ProcessorTraceMonitor::GetRingBufferData(
+    llvm::ArrayRef<uint8_t> src, uint64_t tail, uint64_t head, size_t size,
+    llvm::ArrayRef<uint8_t> &first_part, llvm::ArrayRef<uint8_t> &second_part) {
+  first_part = second_part = llvm::ArrayRef<uint8_t>();
+  if (src.empty() || head <= tail)
+    return tail;
+
+  // The producer overwrote data we didn't consume, so we skip to the oldest
+  // byte that is still in the buffer.
+  if (head - tail > src.size())
+    tail = head - src.size();
+
+  size_t bytes_to_read = std::min<uint64_t>(head - tail, size);
+  size_t start = tail % src.size();
+  size_t first_part_size = std::min(bytes_to_read, src.size() - start);
+
+  first_part = src.slice(start, first_part_size);
+  second_part = src.take_front(bytes_to_read - first_part_size);
+  return tail + bytes_to_read;
+}
+
+uint64_t ProcessorTraceMonitor::ReadRingBuffer(
+    llvm::MutableArrayRef<uint8_t> &dst, llvm::ArrayRef<uint8_t> src,
+    uint64_t tail, uint64_t head) {
+  llvm::ArrayRef<uint8_t> first_part, second_part;
+  tail = GetRingBufferData(src, tail, head, dst.size(), first_part,
+                           second_part);
+
+  auto next = std::copy(first_part.begin(), first_part.end(), dst.begin());
+  std::copy(second_part.begin(), second_part.end(), next);
+
+  dst = dst.take_front(first_part.size() + second_part.size());
+  return tail;
+}
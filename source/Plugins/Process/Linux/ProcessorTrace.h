@@ -14,6 +14,7 @@
 #include "lldb/lldb-types.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
 
 #include <linux/perf_event.h>
 #include <sys/mman.h>
@@ -73,6 +74,9 @@ class ProcessorTraceMonitor {
   // perf_event_mmap_page *m_mmap_base;
   lldb::user_id_t m_traceid;
   lldb::tid_t m_thread_id;
+  // Whether the aux buffer is consumed as a ring buffer, i.e. each read only
+  // returns the data produced since the previous read.
+  bool m_incremental;
 
   // Counter to track trace instances.
   static lldb::user_id_t m_trace_num;
@@ -88,7 +92,8 @@ class ProcessorTraceMonitor {
   ProcessorTraceMonitor()
       : m_mmap_meta(nullptr, munmap_delete(0)),
         m_mmap_aux(nullptr, munmap_delete(0)), m_fd(nullptr, file_close()),
-        m_traceid(LLDB_INVALID_UID), m_thread_id(LLDB_INVALID_THREAD_ID){};
+        m_traceid(LLDB_INVALID_UID), m_thread_id(LLDB_INVALID_THREAD_ID),
+        m_incremental(false){};
 
   void SetThreadID(lldb::tid_t tid) { m_thread_id = tid; }
 
@@ -103,9 +108,25 @@ public:
   Create(lldb::pid_t pid, lldb::tid_t tid, const TraceOptions &config,
          bool useProcessSettings);
 
+  /// Read the trace collected in the aux buffer.
+  ///
+  /// In incremental mode, the aux buffer is consumed as a ring buffer, see
+  /// \a ConsumePerfTraceAux, so \p offset is ignored and each byte of trace
+  /// is transferred only once.
   Status ReadPerfTraceAux(llvm::MutableArrayRef<uint8_t> &buffer,
                           size_t offset = 0);
 
+  /// Consume up to \p size bytes of the trace produced since the previous
+  /// read, in incremental mode.
+  ///
+  /// \p callback is called with the parts of the mmap'ed aux area holding
+  /// the data, which are handed back to the kernel once it returns. The data
+  /// isn't copied, so it is only valid during the call.
+  Status ConsumePerfTraceAux(
+      size_t size, llvm::function_ref<void(llvm::ArrayRef<uint8_t>)> callback);
+
+  bool IsIncremental() const { return m_incremental; }
+
   Status ReadPerfTraceData(llvm::MutableArrayRef<uint8_t> &buffer,
                            size_t offset = 0);
 
@@ -134,6 +155,43 @@ public:
   static void ReadCyclicBuffer(llvm::MutableArrayRef<uint8_t> &dst,
                                llvm::MutableArrayRef<uint8_t> src,
                                size_t src_cyc_index, size_t offset);
+
+  /// Read the unconsumed data of a perf ring buffer, whose head and tail
+  /// pointers increase monotonically and are wrapped by the size of the
+  /// buffer.
+  ///
+  /// \param[in] [out] dst
+  ///     Destination buffer, the buffer will be truncated to written size.
+  ///
+  /// \param[in] src
+  ///     Source ring buffer.
+  ///
+  /// \param[in] tail
+  ///     The position of the first byte not consumed yet.
+  ///
+  /// \param[in] head
+  ///     The position after the last byte produced.
+  ///
+  /// \return
+  ///     The new tail, i.e. the position after the last byte read. If the
+  ///     producer overwrote unconsumed data, the oldest data that is still
+  ///     available is read instead.
+  static uint64_t ReadRingBuffer(llvm::MutableArrayRef<uint8_t> &dst,
+                                 llvm::ArrayRef<uint8_t> src, uint64_t tail,
+                                 uint64_t head);
+
+  /// Same as \a ReadRingBuffer, but return the parts of \p src holding up
+  /// to \p size bytes of unconsumed data instead of copying them.
+  ///
+  /// \param[out] first_part
+  ///     The data up to the end of \p src.
+  ///
+  /// \param[out] second_part
+  ///     The data that wrapped around to the beginning of \p src.
+  static uint64_t GetRingBufferData(llvm::ArrayRef<uint8_t> src,
+                                    uint64_t tail, uint64_t head, size_t size,
+                                    llvm::ArrayRef<uint8_t> &first_part,
+                                    llvm::ArrayRef<uint8_t> &second_part);
 };
 } // namespace process_linux
 } // namespace lldb_private
@@ -88,6 +88,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_jLoadedDynamicLibrariesInfos(eLazyBoolCalculate),
       m_supports_jGetSharedCacheInfo(eLazyBoolCalculate),
       m_supports_QPassSignals(eLazyBoolCalculate),
+      m_supports_conditional_breakpoints(eLazyBoolCalculate),
       m_supports_error_string_reply(eLazyBoolCalculate),
       m_supports_qProcessInfoPID(true), m_supports_qfProcessInfo(true),
       m_supports_qUserName(true), m_supports_qGroupName(true),
@@ -157,6 +158,13 @@ bool GDBRemoteCommunicationClient::GetQPassSignalsSupported() {
   return m_supports_QPassSignals == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetConditionalBreakpointsSupported() {
+  if (m_supports_conditional_breakpoints == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_conditional_breakpoints == eLazyBoolYes;
+}
+
 bool GDBRemoteCommunicationClient::GetAugmentedLibrariesSVR4ReadSupported() {
   if (m_supports_augmented_libraries_svr4_read == eLazyBoolCalculate) {
     GetRemoteQSupported();
@@ -433,6 +441,11 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
     else
       m_supports_QPassSignals = eLazyBoolNo;
 
+    if (::strstr(response_cstr, "ConditionalBreakpoints+"))
+      m_supports_conditional_breakpoints = eLazyBoolYes;
+    else
+      m_supports_conditional_breakpoints = eLazyBoolNo;
+
     const char *packet_size_str = ::strstr(response_cstr, "PacketSize=");
     if (packet_size_str) {
       StringExtractorGDBRemote packet_response(packet_size_str +
@@ -2707,7 +2720,8 @@ bool GDBRemoteCommunicationClient::GetThreadStopInfo(
 }
 
 uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
-    GDBStoppointType type, bool insert, addr_t addr, uint32_t length) {
+    GDBStoppointType type, bool insert, addr_t addr, uint32_t length,
+    llvm::ArrayRef<std::vector<uint8_t>> conditions) {
   Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
   LLDB_LOGF(log, "GDBRemoteCommunicationClient::%s() %s at addr = 0x%" PRIx64,
             __FUNCTION__, insert ? "add" : "remove", addr);
@@ -2716,19 +2730,24 @@ uint8_t GDBRemoteCommunicationClient::SendGDBStoppointTypePacket(
   if (!SupportsGDBStoppointPacket(type))
     return UINT8_MAX;
   // Construct the breakpoint packet
-  char packet[64];
-  const int packet_len =
-      ::snprintf(packet, sizeof(packet), "%c%i,%" PRIx64 ",%x",
-                 insert ? 'Z' : 'z', type, addr, length);
-  // Check we haven't overwritten the end of the packet buffer
-  assert(packet_len + 1 < (int)sizeof(packet));
-  UNUSED_IF_ASSERT_DISABLED(packet_len);
+  StreamString packet;
+  packet.Printf("%c%i,%" PRIx64 ",%x", insert ? 'Z' : 'z', type, addr,
+                length);
+  // Append the conditions of the breakpoint as agent expressions.
+  if (!conditions.empty()) {
+    assert(insert && "conditions of a breakpoint being removed");
+    packet.PutChar(';');
+    for (const std::vector<uint8_t> &condition : conditions) {
+      packet.Printf("X%zx,", condition.size());
+      packet.PutBytesAsRawHex8(condition.data(), condition.size());
+    }
+  }
   StringExtractorGDBRemote response;
   // Make sure the response is either "OK", "EXX" where XX are two hex digits,
   // or "" (unsupported)
   response.SetResponseValidatorToOKErrorNotSupported();
   // Try to send the breakpoint packet, and check that it was correctly sent
-  if (SendPacketAndWaitForResponse(packet, response, true) ==
+  if (SendPacketAndWaitForResponse(packet.GetString(), response, true) ==
       PacketResult::Success) {
     // Receive and OK packet when the breakpoint successfully placed
     if (response.IsOKResponse())
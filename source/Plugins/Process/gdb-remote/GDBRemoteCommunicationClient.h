@@ -319,7 +319,10 @@ public:
       GDBStoppointType type, // Type of breakpoint or watchpoint
       bool insert,           // Insert or remove?
       lldb::addr_t addr,     // Address of breakpoint or watchpoint
-      uint32_t length);      // Byte Size of breakpoint or watchpoint
+      uint32_t length,       // Byte Size of breakpoint or watchpoint
+      // Agent expressions one of which must be true for a software
+      // breakpoint to stop
+      llvm::ArrayRef<std::vector<uint8_t>> conditions = {});
 
   bool SetNonStopMode(const bool enable);
 
@@ -352,6 +355,10 @@ public:
 
   bool GetQPassSignalsSupported();
 
+  /// Whether the remote evaluates the conditions sent with Z0 packets and
+  /// only reports the hits of breakpoints whose conditions are true.
+  bool GetConditionalBreakpointsSupported();
+
   bool GetAugmentedLibrariesSVR4ReadSupported();
 
   bool GetQXferFeaturesReadSupported();
@@ -557,6 +564,7 @@ protected:
   LazyBool m_supports_jLoadedDynamicLibrariesInfos;
   LazyBool m_supports_jGetSharedCacheInfo;
   LazyBool m_supports_QPassSignals;
+  LazyBool m_supports_conditional_breakpoints;
   LazyBool m_supports_error_string_reply;
 
   bool m_supports_qProcessInfoPID : 1, m_supports_qfProcessInfo : 1,
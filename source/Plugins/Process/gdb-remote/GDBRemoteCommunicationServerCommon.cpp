@@ -848,6 +848,10 @@ GDBRemoteCommunicationServerCommon::Handle_qSupported(
   response.PutCString(";qXfer:auxv:read+");
   response.PutCString(";qXfer:libraries-svr4:read+");
 #endif
+#if defined(__linux__)
+  // Breakpoint conditions are evaluated when a breakpoint is hit.
+  response.PutCString(";ConditionalBreakpoints+");
+#endif
 
   return SendPacketNoLock(response.GetString());
 }
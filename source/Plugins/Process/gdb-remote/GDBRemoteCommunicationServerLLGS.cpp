@@ -1396,26 +1396,34 @@ GDBRemoteCommunicationServerLLGS::Handle_jTraceRead(
 
   json_dict->GetValueForKeyAsInteger("threadid", tid);
 
-  // Allocate the response buffer.
-  std::unique_ptr<uint8_t[]> buffer (new (std::nothrow) uint8_t[byte_count]);
-  if (!buffer)
-    return SendErrorResponse(0x78);
-
   StreamGDBRemote response;
   Status error;
-  llvm::MutableArrayRef<uint8_t> buf(buffer.get(), byte_count);
 
-  if (tracetype == BufferData)
-    error = m_debugged_process_up->GetData(uid, tid, buf, offset);
-  else if (tracetype == MetaData)
+  if (tracetype == BufferData) {
+    // The trace data is encoded as it is read, so incremental trace buffers
+    // don't need to be copied.
+    auto encode = [&response](llvm::ArrayRef<uint8_t> data) {
+      for (auto i : data)
+        response.PutHex8(i);
+    };
+    error = m_debugged_process_up->ReadData(uid, tid, byte_count, offset,
+                                            encode);
+  } else if (tracetype == MetaData) {
+    // Allocate the response buffer.
+    std::unique_ptr<uint8_t[]> buffer(new (std::nothrow) uint8_t[byte_count]);
+    if (!buffer)
+      return SendErrorResponse(0x78);
+
+    llvm::MutableArrayRef<uint8_t> buf(buffer.get(), byte_count);
     error = m_debugged_process_up->GetMetaData(uid, tid, buf, offset);
+    if (error.Success())
+      for (auto i : buf)
+        response.PutHex8(i);
+  }
 
   if (error.Fail())
     return SendErrorResponse(error);
 
-  for (auto i : buf)
-    response.PutHex8(i);
-
   StreamGDBRemote escaped_response;
   escaped_response.PutEscapedBytes(response.GetData(), response.GetSize());
   return SendPacketNoLock(escaped_response.GetString());
@@ -2742,10 +2750,41 @@ GDBRemoteCommunicationServerLLGS::Handle_Z(StringExtractorGDBRemote &packet) {
     return SendIllFormedResponse(
         packet, "Malformed Z packet, failed to parse size argument");
 
+  // Parse out the conditions, a list of agent expressions following a
+  // semicolon, each of them encoded as X<length>,<hex bytes>.
+  std::vector<std::vector<uint8_t>> conditions;
+  if (packet.GetBytesLeft() > 0) {
+    if (packet.GetChar() != ';')
+      return SendIllFormedResponse(
+          packet, "Malformed Z packet, expecting semicolon after size");
+    while (packet.GetBytesLeft() > 0) {
+      if (packet.PeekChar() == ';')
+        packet.GetChar();
+      if (packet.GetChar() != 'X')
+        return SendIllFormedResponse(
+            packet, "Malformed Z packet, expecting a condition");
+      const uint32_t length = packet.GetHexMaxU32(false, 0);
+      if (length == 0 || packet.GetChar() != ',')
+        return SendIllFormedResponse(
+            packet, "Malformed Z packet, invalid condition length");
+      std::vector<uint8_t> bytecode(length);
+      if (packet.GetHexBytes(bytecode, 0) != length)
+        return SendIllFormedResponse(
+            packet, "Malformed Z packet, condition is too short");
+      conditions.push_back(std::move(bytecode));
+    }
+    if (!want_breakpoint || want_hardware)
+      return SendIllFormedResponse(
+          packet, "Conditions are only supported by software breakpoints");
+  }
+
   if (want_breakpoint) {
     // Try to set the breakpoint.
-    const Status error =
+    Status error =
         m_debugged_process_up->SetBreakpoint(addr, size, want_hardware);
+    if (error.Success() && !conditions.empty())
+      error = m_debugged_process_up->SetBreakpointConditions(
+          addr, std::move(conditions));
     if (error.Success())
       return SendOKResponse();
     Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
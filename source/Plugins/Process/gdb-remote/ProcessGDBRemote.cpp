@@ -164,6 +164,13 @@ public:
     const uint32_t idx = ePropertyUseGPacketForReading;
     return m_collection_sp->GetPropertyAtIndexAsBoolean(nullptr, idx, true);
   }
+
+  bool GetUseAgentConditions() const {
+    const uint32_t idx = ePropertyUseAgentConditions;
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, idx,
+        g_processgdbremote_properties[idx].default_uint_value != 0);
+  }
 };
 
 typedef std::shared_ptr<PluginProperties> ProcessKDPPropertiesSP;
@@ -3111,9 +3118,11 @@ Status ProcessGDBRemote::EnableBreakpointSite(BreakpointSite *bp_site) {
   // breakpoints.
   if (m_gdb_comm.SupportsGDBStoppointPacket(eBreakpointSoftware) &&
       (!bp_site->HardwareRequired())) {
-    // Try to send off a software breakpoint packet ($Z0)
+    // Try to send off a software breakpoint packet ($Z0), with the
+    // conditions the site had when it was disabled.
     uint8_t error_no = m_gdb_comm.SendGDBStoppointTypePacket(
-        eBreakpointSoftware, true, addr, bp_op_size);
+        eBreakpointSoftware, true, addr, bp_op_size,
+        bp_site->GetAgentConditions());
     if (error_no == 0) {
       // The breakpoint was placed successfully
       bp_site->SetEnabled(true);
@@ -3195,6 +3204,52 @@ Status ProcessGDBRemote::EnableBreakpointSite(BreakpointSite *bp_site) {
   return EnableSoftwareBreakpoint(bp_site);
 }
 
+bool ProcessGDBRemote::SupportsBreakpointSiteConditions() {
+  return GetGlobalPluginProperties()->GetUseAgentConditions() &&
+         m_gdb_comm.GetConditionalBreakpointsSupported();
+}
+
+Status ProcessGDBRemote::SetBreakpointSiteConditions(
+    BreakpointSite &bp_site, std::vector<std::vector<uint8_t>> conditions) {
+  if (!conditions.empty()) {
+    if (!SupportsBreakpointSiteConditions())
+      return Status("the remote doesn't support breakpoint conditions");
+    if (bp_site.GetType() != BreakpointSite::eExternal)
+      return Status("conditions are only supported by software breakpoints "
+                    "inserted by the remote");
+  }
+  if (conditions.empty() && bp_site.GetAgentConditions().empty())
+    return Status();
+
+  bp_site.SetAgentConditions(std::move(conditions));
+  // The conditions are sent when the site is enabled.
+  if (!bp_site.IsEnabled() || bp_site.GetType() != BreakpointSite::eExternal)
+    return Status();
+
+  // Insert the breakpoint again with its new conditions. The process is
+  // stopped, so no thread can miss the breakpoint meanwhile.
+  const addr_t addr = bp_site.GetLoadAddress();
+  const size_t bp_op_size = GetSoftwareBreakpointTrapOpcode(&bp_site);
+  if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, false, addr,
+                                            bp_op_size))
+    return Status("error removing the breakpoint at 0x%" PRIx64, addr);
+  if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr,
+                                            bp_op_size,
+                                            bp_site.GetAgentConditions()) ==
+      0)
+    return Status();
+
+  bp_site.SetAgentConditions({});
+  if (m_gdb_comm.SendGDBStoppointTypePacket(eBreakpointSoftware, true, addr,
+                                            bp_op_size) == 0)
+    return Status("the remote rejected the conditions of the breakpoint at "
+                  "0x%" PRIx64,
+                  addr);
+  bp_site.SetEnabled(false);
+  return Status("error inserting the breakpoint at 0x%" PRIx64 " again",
+                addr);
+}
+
 Status ProcessGDBRemote::DisableBreakpointSite(BreakpointSite *bp_site) {
   Status error;
   assert(bp_site != nullptr);
@@ -156,6 +156,12 @@ public:
 
   Status DisableBreakpointSite(BreakpointSite *bp_site) override;
 
+  bool SupportsBreakpointSiteConditions() override;
+
+  Status SetBreakpointSiteConditions(
+      BreakpointSite &bp_site,
+      std::vector<std::vector<uint8_t>> conditions) override;
+
   // Process Watchpoints
   Status EnableWatchpoint(Watchpoint *wp, bool notify = true) override;
 
@@ -12,6 +12,7 @@
 #include "DWARFDebugInfo.h"
 #include "DWARFDeclContext.h"
 #include "DWARFDefines.h"
+#include "DWARFSharedTypeSystem.h"
 #include "SymbolFileDWARF.h"
 #include "SymbolFileDWARFDebugMap.h"
 #include "SymbolFileDWARFDwo.h"
@@ -1082,7 +1083,17 @@ TypeSP DWARFASTParserClang::ParseSubroutine(const DWARFDIE &die,
             CompilerType class_opaque_type =
                 class_type->GetForwardCompilerType();
             if (TypeSystemClang::IsCXXClassType(class_opaque_type)) {
-              if (class_opaque_type.IsBeingDefined() || alternate_defn) {
+              // Methods whose parsing was deferred when their class was
+              // completed are added to its complete definition.
+              const clang::CXXRecordDecl *class_record_decl =
+                  m_ast.GetAsCXXRecordDecl(
+                      class_opaque_type.GetOpaqueQualType());
+              const bool is_deferred_method =
+                  m_records_parsing_deferred_members.count(
+                      class_record_decl) ||
+                  TakeDeferredMember(class_record_decl, die);
+              if (class_opaque_type.IsBeingDefined() || alternate_defn ||
+                  is_deferred_method) {
                 if (!is_static && !die.HasChildren()) {
                   // We have a C++ member function with no children (this
                   // pointer!) and clang will get mad if we try and make
@@ -1426,6 +1437,7 @@ DWARFASTParserClang::ParseStructureLikeDIE(const SymbolContext &sc,
 
   ConstString unique_typename(attrs.name);
   Declaration unique_decl(attrs.decl);
+  uint64_t structure_hash = 0;
 
   if (attrs.name) {
     if (Language::LanguageIsCPlusPlus(cu_language)) {
@@ -1438,10 +1450,39 @@ DWARFASTParserClang::ParseStructureLikeDIE(const SymbolContext &sc,
       unique_decl.Clear();
     }
 
+    // Types of different modules are only the same type if their layouts
+    // match.
+    if (dwarf->GetSharedTypeSystem() && !attrs.is_forward_declaration)
+      structure_hash = UniqueDWARFASTType::HashStructure(die);
+
     if (dwarf->GetUniqueDWARFASTTypeMap().Find(
             unique_typename, die, unique_decl, attrs.byte_size.getValueOr(-1),
-            *unique_ast_entry_up)) {
+            structure_hash, *unique_ast_entry_up)) {
       type_sp = unique_ast_entry_up->m_type_sp;
+      DWARFSharedTypeSystem *shared_type_system = dwarf->GetSharedTypeSystem();
+      if (type_sp && shared_type_system &&
+          unique_ast_entry_up->m_die.GetModule() != die.GetModule()) {
+        // The type belongs to the symbol file of another module, which can
+        // be destroyed before this one, so give this symbol file its own
+        // type of the same clang type.
+        CompilerType clang_type = type_sp->GetForwardCompilerType();
+        type_sp = std::make_shared<Type>(
+            die.GetID(), dwarf, attrs.name, attrs.byte_size, nullptr,
+            LLDB_INVALID_UID, Type::eEncodingIsUID, &attrs.decl, clang_type,
+            Type::ResolveState::Forward,
+            TypePayloadClang(OptionalClangModuleID(),
+                             attrs.is_complete_objc_class));
+        // Let this symbol file complete the type as well, in case the other
+        // one is destroyed before the type is completed.
+        if (!attrs.is_forward_declaration &&
+            shared_type_system->HasForwardDeclForClangType(clang_type)) {
+          dwarf->GetForwardDeclDieToClangType()[die.GetDIE()] =
+              clang_type.GetOpaqueQualType();
+          dwarf->GetForwardDeclClangTypeToDie().try_emplace(
+              ClangUtil::RemoveFastQualifiers(clang_type).GetOpaqueQualType(),
+              *die.GetDIERef());
+        }
+      }
       if (type_sp) {
         dwarf->GetDIEToType()[die.GetDIE()] = type_sp.get();
         LinkDeclContextToDIE(
@@ -1664,6 +1705,7 @@ DWARFASTParserClang::ParseStructureLikeDIE(const SymbolContext &sc,
   unique_ast_entry_up->m_die = die;
   unique_ast_entry_up->m_declaration = unique_decl;
   unique_ast_entry_up->m_byte_size = attrs.byte_size.getValueOr(0);
+  unique_ast_entry_up->m_structure_hash = structure_hash;
   dwarf->GetUniqueDWARFASTTypeMap().Insert(unique_typename,
                                            *unique_ast_entry_up);
 
@@ -1954,6 +1996,7 @@ bool DWARFASTParserClang::CompleteRecordType(const DWARFDIE &die,
   SymbolFileDWARF *dwarf = die.GetDWARF();
 
   ClangASTImporter::LayoutInfo layout_info;
+  NamedDIEList deferred_dies;
 
   if (die.HasChildren()) {
     const bool type_is_objc_object_or_interface =
@@ -1988,6 +2031,11 @@ bool DWARFASTParserClang::CompleteRecordType(const DWARFDIE &die,
                       member_function_dies, delayed_properties,
                       default_accessibility, is_a_class, layout_info);
 
+    if (!type_is_objc_object_or_interface &&
+        SymbolFileDWARF::GetLazyMemberCompletion() &&
+        m_ast.GetAsCXXRecordDecl(clang_type.GetOpaqueQualType()))
+      DeferMembers(die, member_function_dies, deferred_dies);
+
     // Now parse any methods if there were any...
     for (const DWARFDIE &die : member_function_dies)
       dwarf->ResolveType(die);
@@ -2052,6 +2100,26 @@ bool DWARFASTParserClang::CompleteRecordType(const DWARFDIE &die,
   TypeSystemClang::BuildIndirectFields(clang_type);
   TypeSystemClang::CompleteTagDeclarationDefinition(clang_type);
 
+  const size_t num_deferred_dies = deferred_dies.size();
+  if (num_deferred_dies) {
+    clang::CXXRecordDecl *record_decl =
+        m_ast.GetAsCXXRecordDecl(clang_type.GetOpaqueQualType());
+    // Lookups of the names the record doesn't declare yet go to the external
+    // AST source, which parses the deferred members with that name.
+    record_decl->setHasExternalVisibleStorage(true);
+    m_deferred_member_dies[record_decl] = std::move(deferred_dies);
+  }
+
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_TYPE_COMPLETION);
+  if (log)
+    dwarf->GetObjectFile()->GetModule()->LogMessage(
+        log,
+        "0x%8.8" PRIx64 ": completed '%s' deferring %" PRIu64
+        " members, AST memory: %" PRIu64 " bytes",
+        die.GetID(), clang_type.GetTypeName().AsCString(""),
+        static_cast<uint64_t>(num_deferred_dies),
+        static_cast<uint64_t>(m_ast.getASTContext().getASTAllocatedMemory()));
+
   if (!layout_info.field_offsets.empty() || !layout_info.base_offsets.empty() ||
       !layout_info.vbase_offsets.empty()) {
     if (type)
@@ -2069,6 +2137,153 @@ bool DWARFASTParserClang::CompleteRecordType(const DWARFDIE &die,
   return (bool)clang_type;
 }
 
+void DWARFASTParserClang::DeferMembers(
+    const DWARFDIE &die, std::vector<DWARFDIE> &member_function_dies,
+    NamedDIEList &deferred_dies) {
+  // Clang needs the virtual functions to lay out the class and the special
+  // member functions to know which implicit ones it must declare, so only
+  // the other methods are deferred. Clang stops looking for a name once the
+  // record declares it, so the methods of a name are deferred together.
+  llvm::StringRef class_name = llvm::StringRef(die.GetName()).split('<').first;
+  auto must_parse_now = [&](const DWARFDIE &method_die) {
+    llvm::StringRef name(method_die.GetName());
+    return name.empty() || name == class_name || name.startswith("~") ||
+           name.startswith("operator") || name.contains('<') ||
+           method_die.GetAttributeValueAsUnsigned(DW_AT_virtuality, 0) ||
+           method_die.GetAttributeValueAsUnsigned(DW_AT_artificial, 0);
+  };
+
+  llvm::SmallPtrSet<const char *, 16> names_to_parse;
+  for (const DWARFDIE &method_die : member_function_dies)
+    if (must_parse_now(method_die))
+      names_to_parse.insert(ConstString(method_die.GetName()).GetCString());
+
+  llvm::erase_if(member_function_dies, [&](const DWARFDIE &method_die) {
+    ConstString name(method_die.GetName());
+    if (names_to_parse.count(name.GetCString()))
+      return false;
+    deferred_dies.emplace_back(name, method_die);
+    return true;
+  });
+
+  // Nested types are only parsed when something refers to them, so defer
+  // the ones that weren't to let lookups of their name find them.
+  SymbolFileDWARF *dwarf = die.GetDWARF();
+  for (DWARFDIE child_die = die.GetFirstChild(); child_die;
+       child_die = child_die.GetSibling()) {
+    switch (child_die.Tag()) {
+    case DW_TAG_class_type:
+    case DW_TAG_structure_type:
+    case DW_TAG_union_type:
+    case DW_TAG_enumeration_type:
+    case DW_TAG_typedef:
+      if (child_die.GetName() &&
+          !dwarf->GetDIEToType().count(child_die.GetDIE()))
+        deferred_dies.emplace_back(ConstString(child_die.GetName()),
+                                   child_die);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+bool DWARFASTParserClang::TakeDeferredMember(
+    const clang::CXXRecordDecl *record_decl, const DWARFDIE &die) {
+  auto pos = m_deferred_member_dies.find(record_decl);
+  if (pos == m_deferred_member_dies.end())
+    return false;
+
+  NamedDIEList &dies = pos->second;
+  auto die_pos = llvm::find_if(
+      dies, [&die](const std::pair<ConstString, DWARFDIE> &deferred) {
+        return deferred.second == die;
+      });
+  if (die_pos == dies.end())
+    return false;
+
+  dies.erase(die_pos);
+  if (dies.empty()) {
+    m_deferred_member_dies.erase(pos);
+    record_decl->setHasExternalVisibleStorage(false);
+  }
+  return true;
+}
+
+void DWARFASTParserClang::ParseDeferredMembers(
+    clang::CXXRecordDecl *record_decl, ConstString name) {
+  auto pos = m_deferred_member_dies.find(record_decl);
+  if (pos == m_deferred_member_dies.end())
+    return;
+
+  std::vector<DWARFDIE> dies;
+  for (const auto &deferred : pos->second)
+    if (!name || deferred.first == name)
+      dies.push_back(deferred.second);
+  if (dies.empty())
+    return;
+
+  SymbolFileDWARF *dwarf = dies.front().GetDWARF();
+  std::lock_guard<std::recursive_mutex> guard(dwarf->GetModuleMutex());
+
+  // Take the DIEs out of the list first, as adding a method to the record
+  // looks up its name again.
+  for (const DWARFDIE &die : dies)
+    TakeDeferredMember(record_decl, die);
+
+  const bool inserted =
+      m_records_parsing_deferred_members.insert(record_decl).second;
+  for (const DWARFDIE &die : dies)
+    die.ResolveType();
+  if (inserted)
+    m_records_parsing_deferred_members.erase(record_decl);
+
+  Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_TYPE_COMPLETION);
+  if (log)
+    dwarf->GetObjectFile()->GetModule()->LogMessage(
+        log,
+        "parsed %" PRIu64 " deferred members named '%s' of '%s', AST memory: "
+        "%" PRIu64 " bytes",
+        static_cast<uint64_t>(dies.size()), name.AsCString("<all>"),
+        record_decl->getName().str().c_str(),
+        static_cast<uint64_t>(m_ast.getASTContext().getASTAllocatedMemory()));
+}
+
+void DWARFASTParserClang::RemoveDIEs(
+    const llvm::DenseSet<const DWARFDebugInfoEntry *> &dies) {
+  for (const DWARFDebugInfoEntry *die : dies) {
+    auto pos = m_die_to_decl.find(die);
+    if (pos != m_die_to_decl.end()) {
+      auto decl_pos = m_decl_to_die.find(pos->second);
+      if (decl_pos != m_decl_to_die.end())
+        decl_pos->second.erase(die);
+      m_die_to_decl.erase(pos);
+    }
+    m_die_to_decl_ctx.erase(die);
+    m_die_to_module.erase(die);
+  }
+
+  for (auto pos = m_decl_ctx_to_die.begin(); pos != m_decl_ctx_to_die.end();) {
+    if (dies.count(pos->second.GetDIE()))
+      pos = m_decl_ctx_to_die.erase(pos);
+    else
+      ++pos;
+  }
+
+  for (auto pos = m_deferred_member_dies.begin();
+       pos != m_deferred_member_dies.end();) {
+    auto current = pos++;
+    llvm::erase_if(current->second,
+                   [&](const std::pair<ConstString, DWARFDIE> &deferred) {
+                     return dies.count(deferred.second.GetDIE());
+                   });
+    if (current->second.empty()) {
+      current->first->setHasExternalVisibleStorage(false);
+      m_deferred_member_dies.erase(current);
+    }
+  }
+}
+
 bool DWARFASTParserClang::CompleteEnumType(const DWARFDIE &die,
                                            lldb_private::Type *type,
                                            CompilerType &clang_type) {
@@ -11,6 +11,7 @@
 
 #include "clang/AST/CharUnits.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 
@@ -67,6 +68,19 @@ public:
 
   lldb_private::ClangASTImporter &GetClangASTImporter();
 
+  /// Parse the member functions and nested types of \a record_decl that
+  /// were deferred when it was completed.
+  ///
+  /// \param[in] name
+  ///     The name of the members to parse, or an empty string to parse all
+  ///     of the deferred members.
+  void ParseDeferredMembers(clang::CXXRecordDecl *record_decl,
+                            lldb_private::ConstString name);
+
+  /// Forget the decls and deferred members parsed from \a dies, whose symbol
+  /// file is being destroyed, while the clang types they created stay.
+  void RemoveDIEs(const llvm::DenseSet<const DWARFDebugInfoEntry *> &dies);
+
 protected:
   /// Protected typedefs and members.
   /// @{
@@ -84,6 +98,10 @@ protected:
   typedef llvm::DenseMap<const DWARFDebugInfoEntry *, clang::Decl *>
       DIEToDeclMap;
   typedef llvm::DenseMap<const clang::Decl *, DIEPointerSet> DeclToDIEMap;
+  typedef std::vector<std::pair<lldb_private::ConstString, DWARFDIE>>
+      NamedDIEList;
+  typedef llvm::DenseMap<const clang::CXXRecordDecl *, NamedDIEList>
+      RecordToDeferredDIEMap;
 
   lldb_private::TypeSystemClang &m_ast;
   DIEToDeclMap m_die_to_decl;
@@ -91,6 +109,13 @@ protected:
   DIEToDeclContextMap m_die_to_decl_ctx;
   DeclContextToDIEMap m_decl_ctx_to_die;
   DIEToModuleMap m_die_to_module;
+  /// The member functions and nested types of the completed records that
+  /// are parsed when they are looked up by name.
+  RecordToDeferredDIEMap m_deferred_member_dies;
+  /// The records whose deferred members are being parsed, to which
+  /// ParseSubroutine adds methods even though their definition is complete.
+  llvm::SmallPtrSet<const clang::CXXRecordDecl *, 4>
+      m_records_parsing_deferred_members;
   std::unique_ptr<lldb_private::ClangASTImporter> m_clang_ast_importer_up;
   /// @}
 
@@ -202,6 +227,20 @@ private:
 
   bool CompleteRecordType(const DWARFDIE &die, lldb_private::Type *type,
                           lldb_private::CompilerType &clang_type);
+
+  /// Move the member functions and nested types of the class \a die that
+  /// clang doesn't need to lay it out from \a member_function_dies to
+  /// \a deferred_dies.
+  void DeferMembers(const DWARFDIE &die,
+                    std::vector<DWARFDIE> &member_function_dies,
+                    NamedDIEList &deferred_dies);
+
+  /// Remove \a die from the deferred members of \a record_decl.
+  ///
+  /// \return
+  ///     True if \a die was a deferred member of \a record_decl.
+  bool TakeDeferredMember(const clang::CXXRecordDecl *record_decl,
+                          const DWARFDIE &die);
   bool CompleteEnumType(const DWARFDIE &die, lldb_private::Type *type,
                         lldb_private::CompilerType &clang_type);
 
@@ -9,6 +9,9 @@
 #include "DWARFContext.h"
 
 #include "lldb/Core/Section.h"
+#include "lldb/Symbol/ObjectFile.h"
+
+#include <map>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -40,6 +43,29 @@ DWARFContext::LoadOrGetSection(llvm::Optional<SectionType> main_section_type,
   return data.data;
 }
 
+void DWARFContext::PrefetchSections() {
+  // The sections of .dwo files are small and are read as needed.
+  if (isDwo() || !m_main_section_list)
+    return;
+
+  // A module's section list may contain the sections of several object
+  // files, e.g. of a stripped executable and of its separate debug file.
+  std::map<ObjectFile *, std::vector<SectionSP>> sections_by_file;
+  for (SectionType section_type :
+       {eSectionTypeDWARFDebugInfo, eSectionTypeDWARFDebugAbbrev,
+        eSectionTypeDWARFDebugStr, eSectionTypeDWARFDebugStrOffsets,
+        eSectionTypeDWARFDebugLine, eSectionTypeDWARFDebugLineStr,
+        eSectionTypeDWARFDebugAddr, eSectionTypeDWARFDebugRanges,
+        eSectionTypeDWARFDebugRngLists}) {
+    SectionSP section_sp =
+        m_main_section_list->FindSectionByType(section_type, true);
+    if (section_sp && section_sp->GetObjectFile())
+      sections_by_file[section_sp->GetObjectFile()].push_back(section_sp);
+  }
+  for (auto &entry : sections_by_file)
+    entry.first->PrefetchSectionData(entry.second);
+}
+
 const DWARFDataExtractor &DWARFContext::getOrLoadCuIndexData() {
   return LoadOrGetSection(llvm::None, eSectionTypeDWARFDebugCuIndex,
                           m_data_debug_cu_index);
@@ -76,6 +76,10 @@ public:
 
   bool isDwo() { return m_dwo_section_list != nullptr; }
 
+  /// Let the object files prepare the sections that parsing the debug info
+  /// needs right away, so that they can e.g. be decompressed in parallel.
+  void PrefetchSections();
+
   llvm::DWARFContext &GetAsLLVM();
 };
 } // namespace lldb_private
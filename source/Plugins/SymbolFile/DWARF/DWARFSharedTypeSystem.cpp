@@ -0,0 +1,135 @@
+//===-- DWARFSharedTypeSystem.cpp -----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "DWARFSharedTypeSystem.h"
+
+#include "Plugins/ExpressionParser/Clang/ClangUtil.h"
+#include "Plugins/TypeSystem/Clang/TypeSystemClang.h"
+#include "lldb/Utility/ArchSpec.h"
+
+#include "DWARFASTParserClang.h"
+#include "DWARFDebugInfo.h"
+#include "DWARFUnit.h"
+#include "SymbolFileDWARF.h"
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+struct SharedTypeSystems {
+  std::mutex mutex;
+  /// The shared type systems keyed by the triple of their architecture. The
+  /// symbol files using them own them.
+  std::map<std::string, std::weak_ptr<DWARFSharedTypeSystem>> map;
+};
+} // namespace
+
+static SharedTypeSystems &GetSharedTypeSystems() {
+  static SharedTypeSystems g_shared_type_systems;
+  return g_shared_type_systems;
+}
+
+DWARFSharedTypeSystem::DWARFSharedTypeSystem(const ArchSpec &arch)
+    : m_type_system_sp(std::make_shared<TypeSystemClang>(
+          "ASTContext shared by the modules of " + arch.GetTriple().str(),
+          arch.GetTriple())) {}
+
+std::shared_ptr<DWARFSharedTypeSystem>
+DWARFSharedTypeSystem::Get(const ArchSpec &arch) {
+  if (!arch.IsValid())
+    return nullptr;
+
+  SharedTypeSystems &shared_type_systems = GetSharedTypeSystems();
+  std::lock_guard<std::mutex> guard(shared_type_systems.mutex);
+  std::weak_ptr<DWARFSharedTypeSystem> &shared_type_system_wp =
+      shared_type_systems.map[arch.GetTriple().str()];
+  std::shared_ptr<DWARFSharedTypeSystem> shared_type_system_sp =
+      shared_type_system_wp.lock();
+  if (!shared_type_system_sp) {
+    shared_type_system_sp.reset(new DWARFSharedTypeSystem(arch));
+    shared_type_system_wp = shared_type_system_sp;
+  }
+  return shared_type_system_sp;
+}
+
+void DWARFSharedTypeSystem::Terminate() {
+  SharedTypeSystems &shared_type_systems = GetSharedTypeSystems();
+  std::lock_guard<std::mutex> guard(shared_type_systems.mutex);
+  shared_type_systems.map.clear();
+}
+
+void DWARFSharedTypeSystem::AddSymbolFile(SymbolFileDWARF &dwarf) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  m_symbol_files.push_back(&dwarf);
+  // The type system completes its types with any of the symbol files, which
+  // hand them to the one that created them.
+  if (!m_type_system_sp->GetSymbolFile())
+    m_type_system_sp->SetSymbolFile(&dwarf);
+}
+
+void DWARFSharedTypeSystem::RemoveSymbolFile(SymbolFileDWARF &dwarf) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  llvm::erase_if(m_symbol_files, [&](SymbolFileDWARF *symbol_file) {
+    return symbol_file == &dwarf;
+  });
+  if (m_type_system_sp->GetSymbolFile() == &dwarf)
+    m_type_system_sp->SetSymbolFile(
+        m_symbol_files.empty() ? nullptr : m_symbol_files.front());
+
+  // Forget the DIEs of the symbol file, as the other symbol files keep
+  // parsing into the same maps.
+  llvm::DenseSet<const DWARFDebugInfoEntry *> dies;
+  DWARFDebugInfo &debug_info = dwarf.DebugInfo();
+  for (size_t idx = 0; idx < debug_info.GetNumUnits(); ++idx)
+    debug_info.GetUnitAtIndex(idx)->ForEachExtractedDIE(
+        [&](const DWARFDebugInfoEntry &die) { dies.insert(&die); });
+  m_unique_ast_type_map.RemoveIf([&](const UniqueDWARFASTType &udt) {
+    return dies.count(udt.m_die.GetDIE()) != 0;
+  });
+  if (auto *ast_parser = static_cast<DWARFASTParserClang *>(
+          m_type_system_sp->GetDWARFParser()))
+    ast_parser->RemoveDIEs(dies);
+}
+
+bool DWARFSharedTypeSystem::HasForwardDeclForClangType(
+    const CompilerType &compiler_type) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  return llvm::any_of(m_symbol_files, [&](SymbolFileDWARF *dwarf) {
+    return dwarf->HasForwardDeclForClangType(compiler_type);
+  });
+}
+
+bool DWARFSharedTypeSystem::CompleteType(CompilerType &compiler_type) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  for (SymbolFileDWARF *dwarf : m_symbol_files)
+    if (dwarf->HasForwardDeclForClangType(compiler_type))
+      return dwarf->CompleteType(compiler_type);
+  // No symbol file has a forward declaration of the type left, so it has
+  // already been completed.
+  return true;
+}
+
+bool DWARFSharedTypeSystem::ClaimForwardDecl(
+    SymbolFileDWARF &dwarf, const CompilerType &compiler_type) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (!dwarf.HasForwardDeclForClangType(compiler_type))
+    return false;
+  void *opaque_type =
+      ClangUtil::RemoveFastQualifiers(compiler_type).GetOpaqueQualType();
+  for (SymbolFileDWARF *symbol_file : m_symbol_files)
+    if (symbol_file != &dwarf)
+      symbol_file->GetForwardDeclClangTypeToDie().erase(opaque_type);
+  return true;
+}
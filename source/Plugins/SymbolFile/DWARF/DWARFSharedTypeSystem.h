@@ -0,0 +1,98 @@
+//===-- DWARFSharedTypeSystem.h ---------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_SOURCE_PLUGINS_SYMBOLFILE_DWARF_DWARFSHAREDTYPESYSTEM_H
+#define LLDB_SOURCE_PLUGINS_SYMBOLFILE_DWARF_DWARFSHAREDTYPESYSTEM_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "lldb/lldb-forward.h"
+
+#include "UniqueDWARFASTType.h"
+
+class SymbolFileDWARF;
+
+namespace lldb_private {
+class ArchSpec;
+class CompilerType;
+} // namespace lldb_private
+
+/// \class DWARFSharedTypeSystem DWARFSharedTypeSystem.h
+/// The C family type system that the DWARF symbol files of all modules with
+/// the same architecture parse their types into when
+/// plugin.symbol-file.dwarf.shared-type-system is set.
+///
+/// Without it every module has its own AST with a copy of the types it
+/// shares with the other modules, like the standard library types or the
+/// types of the headers of a framework, and the expression parser imports
+/// each of these copies. The symbol files instead share a UniqueDWARFASTTypeMap
+/// in which the types are matched by qualified name, byte size and a hash of
+/// their layout, so a type that is defined the same way in several modules is
+/// parsed once and all of them refer to the same clang type.
+///
+/// Each symbol file has its own lldb_private::Type of a shared type, so a
+/// module can be unloaded while the others keep using the types it parsed. The
+/// symbol files own the shared type system, which is destroyed with the last
+/// of them.
+class DWARFSharedTypeSystem {
+public:
+  /// Return the shared type system for modules with the architecture \a
+  /// arch, creating it if no symbol file uses it.
+  static std::shared_ptr<DWARFSharedTypeSystem>
+  Get(const lldb_private::ArchSpec &arch);
+
+  /// Forget the shared type systems, so that the symbol files created
+  /// afterwards get new ones. The existing symbol files keep theirs.
+  static void Terminate();
+
+  /// Parse the C family types of \a dwarf into the shared type system.
+  void AddSymbolFile(SymbolFileDWARF &dwarf);
+
+  /// Forget the types and DIEs of \a dwarf, which is being destroyed. The
+  /// clang types it created stay in the AST.
+  void RemoveSymbolFile(SymbolFileDWARF &dwarf);
+
+  lldb_private::TypeSystem &GetTypeSystem() { return *m_type_system_sp; }
+
+  UniqueDWARFASTTypeMap &GetUniqueDWARFASTTypeMap() {
+    return m_unique_ast_type_map;
+  }
+
+  /// The mutex that the symbol files lock instead of the mutex of their
+  /// module, as they all parse into the same AST.
+  std::recursive_mutex &GetMutex() { return m_mutex; }
+
+  /// Returns true if a symbol file can complete \a compiler_type.
+  bool
+  HasForwardDeclForClangType(const lldb_private::CompilerType &compiler_type);
+
+  /// Complete \a compiler_type with a symbol file that has a forward
+  /// declaration of it.
+  bool CompleteType(lldb_private::CompilerType &compiler_type);
+
+  /// Let \a dwarf complete \a compiler_type if it has a forward declaration of
+  /// it, and make the other symbol files forget theirs, so that the type is
+  /// completed once.
+  ///
+  /// \return
+  ///     True if \a dwarf has a forward declaration of the type.
+  bool ClaimForwardDecl(SymbolFileDWARF &dwarf,
+                        const lldb_private::CompilerType &compiler_type);
+
+private:
+  DWARFSharedTypeSystem(const lldb_private::ArchSpec &arch);
+
+  std::recursive_mutex m_mutex;
+  lldb::TypeSystemSP m_type_system_sp;
+  UniqueDWARFASTTypeMap m_unique_ast_type_map;
+  std::vector<SymbolFileDWARF *> m_symbol_files;
+};
+
+#endif // LLDB_SOURCE_PLUGINS_SYMBOLFILE_DWARF_DWARFSHAREDTYPESYSTEM_H
@@ -139,6 +139,22 @@ DWARFUnit::ScopedExtractDIEs &DWARFUnit::ScopedExtractDIEs::operator=(
   return *this;
 }
 
+void DWARFUnit::ForEachExtractedDIE(
+    llvm::function_ref<void(const DWARFDebugInfoEntry &)> callback) {
+  {
+    llvm::sys::ScopedReader first_die_lock(m_first_die_mutex);
+    if (m_first_die)
+      callback(m_first_die);
+  }
+  {
+    llvm::sys::ScopedReader lock(m_die_array_mutex);
+    for (const DWARFDebugInfoEntry &die : m_die_array)
+      callback(die);
+  }
+  if (m_dwo)
+    m_dwo->ForEachExtractedDIE(callback);
+}
+
 // Parses a compile unit and indexes its DIEs, m_die_array_mutex must be
 // held R/W and m_die_array must be empty.
 void DWARFUnit::ExtractDIEsRWLocked() {
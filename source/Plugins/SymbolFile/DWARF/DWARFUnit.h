@@ -13,6 +13,7 @@
 #include "DWARFDebugInfoEntry.h"
 #include "lldb/lldb-enumerations.h"
 #include "lldb/Utility/XcodeSDK.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/RWMutex.h"
 #include <atomic>
 
@@ -216,6 +217,11 @@ public:
     return die_iterator_range(m_die_array.begin(), m_die_array.end());
   }
 
+  /// Calls \a callback with the DIEs of this unit and of its .dwo unit that
+  /// were extracted so far, without extracting any of them.
+  void ForEachExtractedDIE(
+      llvm::function_ref<void(const DWARFDebugInfoEntry &)> callback);
+
   DIERef::Section GetDebugSection() const { return m_section; }
 
   uint8_t GetUnitType() const { return m_header.GetUnitType(); }
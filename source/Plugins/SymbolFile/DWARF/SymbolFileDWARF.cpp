@@ -64,6 +64,7 @@
 #include "DWARFDebugRanges.h"
 #include "DWARFDeclContext.h"
 #include "DWARFFormValue.h"
+#include "DWARFSharedTypeSystem.h"
 #include "DWARFTypeUnit.h"
 #include "DWARFUnit.h"
 #include "DebugNamesDWARFIndex.h"
@@ -141,6 +142,16 @@ public:
     return m_collection_sp->GetPropertyAtIndexAsBoolean(
         nullptr, ePropertyIgnoreIndexes, false);
   }
+
+  bool LazyMemberCompletion() const {
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertyLazyMemberCompletion, false);
+  }
+
+  bool SharedTypeSystem() const {
+    return m_collection_sp->GetPropertyAtIndexAsBoolean(
+        nullptr, ePropertySharedTypeSystem, false);
+  }
 };
 
 typedef std::shared_ptr<PluginProperties> SymbolFileDWARFPropertiesSP;
@@ -269,6 +280,7 @@ void SymbolFileDWARF::DebuggerInitialize(Debugger &debugger) {
 }
 
 void SymbolFileDWARF::Terminate() {
+  DWARFSharedTypeSystem::Terminate();
   SymbolFileDWARFDebugMap::Terminate();
   PluginManager::UnregisterPlugin(CreateInstance);
   LogChannelDWARF::Terminate();
@@ -435,7 +447,10 @@ SymbolFileDWARF::SymbolFileDWARF(ObjectFileSP objfile_sp,
       m_fetched_external_modules(false),
       m_supports_DW_AT_APPLE_objc_complete_type(eLazyBoolCalculate) {}
 
-SymbolFileDWARF::~SymbolFileDWARF() {}
+SymbolFileDWARF::~SymbolFileDWARF() {
+  if (m_shared_type_system_sp)
+    m_shared_type_system_sp->RemoveSymbolFile(*this);
+}
 
 static ConstString GetDWARFMachOSegmentName() {
   static ConstString g_dwarf_section_name("__DWARF");
@@ -446,15 +461,37 @@ UniqueDWARFASTTypeMap &SymbolFileDWARF::GetUniqueDWARFASTTypeMap() {
   SymbolFileDWARFDebugMap *debug_map_symfile = GetDebugMapSymfile();
   if (debug_map_symfile)
     return debug_map_symfile->GetUniqueDWARFASTTypeMap();
+  else if (DWARFSharedTypeSystem *shared_type_system = GetSharedTypeSystem())
+    return shared_type_system->GetUniqueDWARFASTTypeMap();
   else
     return m_unique_ast_type_map;
 }
 
+DWARFSharedTypeSystem *SymbolFileDWARF::GetSharedTypeSystem() {
+  return m_shared_type_system_sp.get();
+}
+
+void SymbolFileDWARF::SetDebugMapModule(const lldb::ModuleSP &module_sp) {
+  m_debug_map_module_wp = module_sp;
+  // The symbol files of a debug map already share the type system of the
+  // module of the debug map. The debug map sets its module before it parses
+  // anything with this symbol file.
+  if (m_shared_type_system_sp) {
+    m_shared_type_system_sp->RemoveSymbolFile(*this);
+    m_shared_type_system_sp.reset();
+  }
+}
+
 llvm::Expected<TypeSystem &>
 SymbolFileDWARF::GetTypeSystemForLanguage(LanguageType language) {
   if (SymbolFileDWARFDebugMap *debug_map_symfile = GetDebugMapSymfile())
     return debug_map_symfile->GetTypeSystemForLanguage(language);
 
+  if (TypeSystemClang::GetSupportedLanguagesForTypes()[language]) {
+    if (DWARFSharedTypeSystem *shared_type_system = GetSharedTypeSystem())
+      return shared_type_system->GetTypeSystem();
+  }
+
   auto type_system_or_err =
       m_objfile_sp->GetModule()->GetTypeSystemForLanguage(language);
   if (type_system_or_err) {
@@ -466,6 +503,15 @@ SymbolFileDWARF::GetTypeSystemForLanguage(LanguageType language) {
 void SymbolFileDWARF::InitializeObject() {
   Log *log = LogChannelDWARF::GetLogIfAll(DWARF_LOG_DEBUG_INFO);
 
+  // Join the shared type system before anything is parsed, so the type
+  // system and the mutex of this symbol file stay the same while it is used.
+  if (GetGlobalPluginProperties()->SharedTypeSystem()) {
+    m_shared_type_system_sp = DWARFSharedTypeSystem::Get(
+        m_objfile_sp->GetModule()->GetArchitecture());
+    if (m_shared_type_system_sp)
+      m_shared_type_system_sp->AddSymbolFile(*this);
+  }
+
   if (!GetGlobalPluginProperties()->IgnoreFileIndexes()) {
     DWARFDataExtractor apple_names, apple_namespaces, apple_types, apple_objc;
     LoadSectionData(eSectionTypeDWARFAppleNames, apple_names);
@@ -626,6 +672,7 @@ DWARFDebugInfo &SymbolFileDWARF::DebugInfo() {
   llvm::call_once(m_info_once_flag, [&] {
     LLDB_SCOPED_TIMERF("%s this = %p", LLVM_PRETTY_FUNCTION,
                        static_cast<void *>(this));
+    m_context.PrefetchSections();
     m_info = std::make_unique<DWARFDebugInfo>(*this, m_context);
   });
   return *m_info;
@@ -1254,6 +1301,10 @@ bool SymbolFileDWARF::ClassOrStructIsVirtual(const DWARFDIE &parent_die) {
   return false;
 }
 
+bool SymbolFileDWARF::GetLazyMemberCompletion() {
+  return GetGlobalPluginProperties()->LazyMemberCompletion();
+}
+
 void SymbolFileDWARF::ParseDeclsForContext(CompilerDeclContext decl_ctx) {
   auto *type_system = decl_ctx.GetTypeSystem();
   if (type_system != nullptr)
@@ -1453,6 +1504,14 @@ bool SymbolFileDWARF::CompleteType(CompilerType &compiler_type) {
       return ast_parser->GetClangASTImporter().CompleteType(compiler_type);
   }
 
+  // The forward declarations of a shared type system can come from the
+  // symbol files of several modules using it, and only one of them may
+  // complete the type.
+  DWARFSharedTypeSystem *shared_type_system = GetSharedTypeSystem();
+  if (shared_type_system &&
+      !shared_type_system->ClaimForwardDecl(*this, compiler_type))
+    return shared_type_system->CompleteType(compiler_type);
+
   // We have a struct/union/class/enum that needs to be fully resolved.
   CompilerType compiler_type_no_qualifiers =
       ClangUtil::RemoveFastQualifiers(compiler_type);
@@ -2043,6 +2102,8 @@ std::recursive_mutex &SymbolFileDWARF::GetModuleMutex() const {
   lldb::ModuleSP module_sp(m_debug_map_module_wp.lock());
   if (module_sp)
     return module_sp->GetMutex();
+  if (m_shared_type_system_sp)
+    return m_shared_type_system_sp->GetMutex();
   return GetObjectFile()->GetModule()->GetMutex();
 }
 
@@ -48,6 +48,7 @@ class DWARFDebugLine;
 class DWARFDebugRanges;
 class DWARFDeclContext;
 class DWARFFormValue;
+class DWARFSharedTypeSystem;
 class DWARFTypeUnit;
 class SymbolFileDWARFDebugMap;
 class SymbolFileDWARFDwo;
@@ -75,6 +76,7 @@ public:
   friend class DWARFCompileUnit;
   friend class DWARFDIE;
   friend class DWARFASTParserClang;
+  friend class DWARFSharedTypeSystem;
 
   // Static Functions
   static void Initialize();
@@ -304,6 +306,16 @@ public:
 
   static DWARFASTParser *GetDWARFParser(DWARFUnit &unit);
 
+  /// Whether the type parsers should defer parsing the non-virtual member
+  /// functions and the nested types of C++ classes until they are looked up
+  /// by name (plugin.symbol-file.dwarf.lazy-member-completion).
+  static bool GetLazyMemberCompletion();
+
+  /// The type system shared with the other modules that this symbol file
+  /// parses its C family types into, or null if it uses the type system of
+  /// its module (plugin.symbol-file.dwarf.shared-type-system).
+  virtual DWARFSharedTypeSystem *GetSharedTypeSystem();
+
   // CompilerDecl related functions
 
   static lldb_private::CompilerDecl GetDecl(const DWARFDIE &die);
@@ -408,9 +420,7 @@ protected:
   lldb::TypeSP GetTypeForDIE(const DWARFDIE &die,
                              bool resolve_function_context = false);
 
-  void SetDebugMapModule(const lldb::ModuleSP &module_sp) {
-    m_debug_map_module_wp = module_sp;
-  }
+  void SetDebugMapModule(const lldb::ModuleSP &module_sp);
 
   SymbolFileDWARFDebugMap *GetDebugMapSymfile();
 
@@ -504,6 +514,8 @@ protected:
   std::unique_ptr<lldb_private::DWARFIndex> m_index;
   bool m_fetched_external_modules : 1;
   lldb_private::LazyBool m_supports_DW_AT_APPLE_objc_complete_type;
+  // Set by InitializeObject(), before the symbol file parses anything.
+  std::shared_ptr<DWARFSharedTypeSystem> m_shared_type_system_sp;
 
   typedef std::set<DIERef> DIERefSet;
   typedef llvm::StringMap<DIERefSet> NameToOffsetMap;
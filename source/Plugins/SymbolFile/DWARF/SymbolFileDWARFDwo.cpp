@@ -122,6 +122,14 @@ SymbolFileDWARFDwo::GetTypeSystemForLanguage(LanguageType language) {
   return GetBaseSymbolFile().GetTypeSystemForLanguage(language);
 }
 
+DWARFSharedTypeSystem *SymbolFileDWARFDwo::GetSharedTypeSystem() {
+  return GetBaseSymbolFile().GetSharedTypeSystem();
+}
+
+std::recursive_mutex &SymbolFileDWARFDwo::GetModuleMutex() const {
+  return m_base_symbol_file.GetModuleMutex();
+}
+
 DWARFDIE
 SymbolFileDWARFDwo::GetDIE(const DIERef &die_ref) {
   if (die_ref.dwo_num() == GetDwoNum())
@@ -37,6 +37,10 @@ public:
   llvm::Expected<lldb_private::TypeSystem &>
   GetTypeSystemForLanguage(lldb::LanguageType language) override;
 
+  DWARFSharedTypeSystem *GetSharedTypeSystem() override;
+
+  std::recursive_mutex &GetModuleMutex() const override;
+
   DWARFDIE
   GetDIE(const DIERef &die_ref) override;
 
@@ -8,13 +8,72 @@
 
 #include "UniqueDWARFASTType.h"
 
+#include "SymbolFileDWARF.h"
+
 #include "lldb/Symbol/Declaration.h"
 
+#include "llvm/ADT/Hashing.h"
+
+/// Hash the name of \a type_die, or of the type it modifies if it is a
+/// pointer, reference, const or volatile type without a name.
+static llvm::hash_code HashTypeName(DWARFDIE type_die) {
+  llvm::hash_code hash = 0;
+  // Limit the depth in case of broken DWARF with cyclic type references.
+  for (unsigned depth = 0; type_die && depth < 8; ++depth) {
+    const char *name = type_die.GetName();
+    hash = llvm::hash_combine(hash, type_die.Tag(), llvm::StringRef(name));
+    if (name)
+      break;
+    type_die = type_die.GetAttributeValueAsReferenceDIE(DW_AT_type);
+  }
+  return hash;
+}
+
+uint64_t UniqueDWARFASTType::HashStructure(const DWARFDIE &die) {
+  llvm::hash_code hash = llvm::hash_value(die.Tag());
+  for (DWARFDIE child = die.GetFirstChild(); child;
+       child = child.GetSibling()) {
+    // Member functions are left out as the compiler only emits the implicit
+    // ones that the compile unit uses.
+    switch (child.Tag()) {
+    case DW_TAG_inheritance:
+    case DW_TAG_member:
+    case DW_TAG_template_type_parameter:
+    case DW_TAG_template_value_parameter:
+      break;
+    default:
+      continue;
+    }
+    hash = llvm::hash_combine(
+        hash, child.Tag(), llvm::StringRef(child.GetName()),
+        child.GetAttributeValueAsUnsigned(DW_AT_data_member_location, 0),
+        child.GetAttributeValueAsUnsigned(DW_AT_data_bit_offset, 0),
+        child.GetAttributeValueAsUnsigned(DW_AT_bit_size, 0),
+        child.GetAttributeValueAsUnsigned(DW_AT_const_value, 0),
+        HashTypeName(child.GetAttributeValueAsReferenceDIE(DW_AT_type)));
+  }
+  // Zero means that the hash wasn't computed.
+  const uint64_t result = hash;
+  return result ? result : 1;
+}
+
 bool UniqueDWARFASTTypeList::Find(const DWARFDIE &die,
                                   const lldb_private::Declaration &decl,
                                   const int32_t byte_size,
+                                  uint64_t structure_hash,
                                   UniqueDWARFASTType &entry) const {
+  // The modules of a shared type system share this list.
+  lldb::ModuleSP module_sp;
+  if (die.GetDWARF()->GetSharedTypeSystem())
+    module_sp = die.GetModule();
   for (const UniqueDWARFASTType &udt : m_collection) {
+    // Types with the same name in different modules don't need to be the
+    // same type, so make sure their layouts match. A forward declaration has
+    // no layout, so it only matches the types of its own module.
+    if (module_sp &&
+        (!structure_hash || udt.m_structure_hash != structure_hash) &&
+        udt.m_die.GetModule() != module_sp)
+      continue;
     // Make sure the tags match
     if (udt.m_die.Tag() == die.Tag()) {
       // Validate byte sizes of both types only if both are valid.
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
 
 #include "DWARFDIE.h"
 #include "lldb/Symbol/Declaration.h"
@@ -22,17 +23,19 @@ public:
   UniqueDWARFASTType()
       : m_type_sp(), m_die(), m_declaration(),
         m_byte_size(
-            -1) // Set to negative value to make sure we have a valid value
-  {}
+            -1), // Set to negative value to make sure we have a valid value
+        m_structure_hash(0) {}
 
   UniqueDWARFASTType(lldb::TypeSP &type_sp, const DWARFDIE &die,
-                     const lldb_private::Declaration &decl, int32_t byte_size)
+                     const lldb_private::Declaration &decl, int32_t byte_size,
+                     uint64_t structure_hash = 0)
       : m_type_sp(type_sp), m_die(die), m_declaration(decl),
-        m_byte_size(byte_size) {}
+        m_byte_size(byte_size), m_structure_hash(structure_hash) {}
 
   UniqueDWARFASTType(const UniqueDWARFASTType &rhs)
       : m_type_sp(rhs.m_type_sp), m_die(rhs.m_die),
-        m_declaration(rhs.m_declaration), m_byte_size(rhs.m_byte_size) {}
+        m_declaration(rhs.m_declaration), m_byte_size(rhs.m_byte_size),
+        m_structure_hash(rhs.m_structure_hash) {}
 
   ~UniqueDWARFASTType() {}
 
@@ -42,14 +45,22 @@ public:
       m_die = rhs.m_die;
       m_declaration = rhs.m_declaration;
       m_byte_size = rhs.m_byte_size;
+      m_structure_hash = rhs.m_structure_hash;
     }
     return *this;
   }
 
+  /// Hash the layout of the structure, union or class \a die: the names,
+  /// offsets and type names of its bases, fields and template parameters.
+  /// Never returns zero.
+  static uint64_t HashStructure(const DWARFDIE &die);
+
   lldb::TypeSP m_type_sp;
   DWARFDIE m_die;
   lldb_private::Declaration m_declaration;
   int32_t m_byte_size;
+  /// The HashStructure of m_die, or zero if it wasn't computed.
+  uint64_t m_structure_hash;
 };
 
 class UniqueDWARFASTTypeList {
@@ -64,8 +75,19 @@ public:
     m_collection.push_back(entry);
   }
 
+  /// Find the entry describing the same type as \a die.
+  ///
+  /// \param[in] structure_hash
+  ///     The HashStructure of \a die, or zero if it wasn't computed. Entries
+  ///     of other modules only match if they have the same non-zero hash.
   bool Find(const DWARFDIE &die, const lldb_private::Declaration &decl,
-            const int32_t byte_size, UniqueDWARFASTType &entry) const;
+            const int32_t byte_size, uint64_t structure_hash,
+            UniqueDWARFASTType &entry) const;
+
+  /// Remove the entries of the DIEs for which \a remove returns true.
+  void RemoveIf(llvm::function_ref<bool(const UniqueDWARFASTType &)> remove) {
+    llvm::erase_if(m_collection, remove);
+  }
 
 protected:
   typedef std::vector<UniqueDWARFASTType> collection;
@@ -85,15 +107,21 @@ public:
 
   bool Find(lldb_private::ConstString name, const DWARFDIE &die,
             const lldb_private::Declaration &decl, const int32_t byte_size,
-            UniqueDWARFASTType &entry) const {
+            uint64_t structure_hash, UniqueDWARFASTType &entry) const {
     const char *unique_name_cstr = name.GetCString();
     collection::const_iterator pos = m_collection.find(unique_name_cstr);
     if (pos != m_collection.end()) {
-      return pos->second.Find(die, decl, byte_size, entry);
+      return pos->second.Find(die, decl, byte_size, structure_hash, entry);
     }
     return false;
   }
 
+  /// Remove the entries of the DIEs for which \a remove returns true.
+  void RemoveIf(llvm::function_ref<bool(const UniqueDWARFASTType &)> remove) {
+    for (auto &name_and_types : m_collection)
+      name_and_types.second.RemoveIf(remove);
+  }
+
 protected:
   // A unique name string should be used
   typedef llvm::DenseMap<const char *, UniqueDWARFASTTypeList> collection;
@@ -38,6 +38,16 @@ Expected<lldb::addr_t> IntelPTInstruction::GetLoadAddress() const {
   return m_pt_insn.ip;
 }
 
+pt_insn_class IntelPTInstruction::GetInstructionClass() const {
+  if (IsError())
+    return ptic_error;
+  return m_pt_insn.iclass;
+}
+
+Optional<uint64_t> IntelPTInstruction::GetTimestampCounter() const {
+  return m_timestamp;
+}
+
 Error IntelPTInstruction::ToError() const {
   if (!IsError())
     return Error::success();
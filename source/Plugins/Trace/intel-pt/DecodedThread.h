@@ -11,6 +11,7 @@
 
 #include <vector>
 
+#include "llvm/ADT/Optional.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/Error.h"
 
@@ -62,6 +63,12 @@ class IntelPTInstruction {
 public:
   IntelPTInstruction(const pt_insn &pt_insn) : m_pt_insn(pt_insn) {}
 
+  /// \param[in] timestamp
+  ///     The value of the Time Stamp Counter at the moment the instruction was
+  ///     executed, as reported by libipt.
+  IntelPTInstruction(const pt_insn &pt_insn, uint64_t timestamp)
+      : m_pt_insn(pt_insn), m_timestamp(timestamp) {}
+
   /// Error constructor
   ///
   /// libipt errors should use the underlying \a IntelPTError class.
@@ -83,6 +90,16 @@ public:
   ///     error.
   llvm::Expected<lldb::addr_t> GetLoadAddress() const;
 
+  /// \return
+  ///     The libipt class of the instruction, e.g. \a ptic_call or \a
+  ///     ptic_return, or \a ptic_error if this object represents an error.
+  pt_insn_class GetInstructionClass() const;
+
+  /// \return
+  ///     The Time Stamp Counter value associated with this instruction, or \b
+  ///     llvm::None if the trace doesn't contain timing information.
+  llvm::Optional<uint64_t> GetTimestampCounter() const;
+
   /// \return
   ///     An \a llvm::Error object if this class corresponds to an Error, or an
   ///     \a llvm::Error::success otherwise.
@@ -95,6 +112,7 @@ private:
   const IntelPTInstruction &operator=(const IntelPTInstruction &other) = delete;
 
   pt_insn m_pt_insn;
+  llvm::Optional<uint64_t> m_timestamp;
   std::unique_ptr<llvm::ErrorInfoBase> m_error;
 };
 
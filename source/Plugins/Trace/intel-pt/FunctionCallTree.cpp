@@ -0,0 +1,246 @@
+//===-- FunctionCallTree.cpp ----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "FunctionCallTree.h"
+
+#include "llvm/ADT/STLExtras.h"
+
+#include "lldb/Core/Module.h"
+#include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Target/SectionLoadList.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Utility/Stream.h"
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::trace_intel_pt;
+using namespace llvm;
+
+static bool IsCall(pt_insn_class iclass) {
+  return iclass == ptic_call || iclass == ptic_far_call;
+}
+
+static bool IsReturn(pt_insn_class iclass) {
+  return iclass == ptic_return || iclass == ptic_far_return;
+}
+
+FunctionCallTree::FunctionCallTree(Target &target,
+                                   const DecodedThread &decoded_thread)
+    : m_target(target) {
+  // The root is an artificial node that is parent of itself.
+  m_nodes.emplace_back(ConstString(), 0);
+
+  // Stack of node indices representing the active call path. It always
+  // contains at least the root.
+  std::vector<size_t> stack = {0};
+  pt_insn_class prev_class = ptic_error;
+  Optional<uint64_t> prev_tsc;
+
+  for (const IntelPTInstruction &instruction :
+       decoded_thread.GetInstructions()) {
+    Expected<addr_t> load_address = instruction.GetLoadAddress();
+    if (!load_address) {
+      // A gap in the trace invalidates the call path we were tracking.
+      consumeError(load_address.takeError());
+      stack.resize(1);
+      prev_class = ptic_error;
+      prev_tsc = None;
+      continue;
+    }
+
+    ConstString name = LookupFunction(*load_address);
+    if (IsCall(prev_class)) {
+      stack.push_back(EnterFunction(stack.back(), name));
+    } else {
+      if (IsReturn(prev_class) && stack.size() > 1)
+        stack.pop_back();
+      // Either we returned to a caller that is not part of the trace, or we
+      // jumped into another function, e.g. via a tail call or a PLT stub. In
+      // both cases the new function replaces the current frame.
+      if (stack.size() == 1) {
+        stack.push_back(EnterFunction(0, name));
+      } else if (m_nodes[stack.back()].name != name) {
+        size_t parent = m_nodes[stack.back()].parent;
+        stack.back() = EnterFunction(parent, name);
+      }
+    }
+
+    size_t current = stack.back();
+    m_nodes[current].exclusive_instructions++;
+
+    // The time elapsed between two instructions is attributed to the function
+    // of the second one, which is the one whose execution consumed it.
+    Optional<uint64_t> tsc = instruction.GetTimestampCounter();
+    if (tsc) {
+      m_has_timing = true;
+      if (prev_tsc && *tsc >= *prev_tsc)
+        m_nodes[current].exclusive_tsc += *tsc - *prev_tsc;
+    }
+    prev_tsc = tsc;
+    prev_class = instruction.GetInstructionClass();
+  }
+
+  // Children are always created after their parents, so a single backwards
+  // pass is enough to accumulate the inclusive values.
+  for (size_t i = m_nodes.size(); i-- > 0;) {
+    Node &node = m_nodes[i];
+    node.inclusive_instructions += node.exclusive_instructions;
+    node.inclusive_tsc += node.exclusive_tsc;
+    if (i == 0)
+      break;
+    m_nodes[node.parent].inclusive_instructions += node.inclusive_instructions;
+    m_nodes[node.parent].inclusive_tsc += node.inclusive_tsc;
+  }
+}
+
+size_t FunctionCallTree::EnterFunction(size_t parent, ConstString name) {
+  auto it = m_nodes[parent].children.find(name);
+  size_t index;
+  if (it != m_nodes[parent].children.end()) {
+    index = it->second;
+  } else {
+    index = m_nodes.size();
+    m_nodes[parent].children.emplace(name, index);
+    m_nodes.emplace_back(name, parent);
+  }
+  m_nodes[index].call_count++;
+  return index;
+}
+
+ConstString FunctionCallTree::LookupFunction(addr_t load_address) {
+  if (Optional<ConstString> name = m_function_ranges.Lookup(load_address))
+    return *name;
+
+  Address address;
+  SymbolContext sc;
+  if (m_target.GetSectionLoadList().ResolveLoadAddress(load_address, address))
+    address.CalculateSymbolContext(&sc, eSymbolContextModule |
+                                            eSymbolContextFunction |
+                                            eSymbolContextSymbol);
+
+  std::string name;
+  if (!sc.module_sp)
+    name = "(none)";
+  else if (!sc.function && !sc.symbol)
+    name = (sc.module_sp->GetFileSpec().GetFilename().GetStringRef() +
+            "`(none)")
+               .str();
+  else
+    name = (sc.module_sp->GetFileSpec().GetFilename().GetStringRef() + "`" +
+            sc.GetFunctionName().GetStringRef())
+               .str();
+
+  ConstString function_name(name);
+  m_function_ranges.Insert(load_address, sc, function_name, &m_target);
+  return function_name;
+}
+
+/// \return
+///     The indices of the given children sorted by decreasing inclusive
+///     instruction count.
+static std::vector<size_t>
+GetSortedChildren(ArrayRef<FunctionCallTree::Node> nodes,
+                  const FunctionCallTree::Node &node) {
+  std::vector<size_t> children;
+  for (const auto &child : node.children)
+    children.push_back(child.second);
+  llvm::stable_sort(children, [&](size_t lhs, size_t rhs) {
+    return nodes[lhs].inclusive_instructions >
+           nodes[rhs].inclusive_instructions;
+  });
+  return children;
+}
+
+void FunctionCallTree::DumpNode(Stream &s, size_t index, size_t depth,
+                                size_t max_depth) const {
+  const Node &node = m_nodes[index];
+  s.Indent();
+  s.Printf("%s: calls = %" PRIu64 ", instructions = %" PRIu64
+           " (self %" PRIu64 ")",
+           node.name.AsCString("(none)"), node.call_count,
+           node.inclusive_instructions, node.exclusive_instructions);
+  if (m_has_timing)
+    s.Printf(", tsc = %" PRIu64 " (self %" PRIu64 ")", node.inclusive_tsc,
+             node.exclusive_tsc);
+  s.EOL();
+
+  if (depth >= max_depth)
+    return;
+
+  s.IndentMore();
+  for (size_t child : GetSortedChildren(m_nodes, node))
+    DumpNode(s, child, depth + 1, max_depth);
+  s.IndentLess();
+}
+
+void FunctionCallTree::Dump(Stream &s, size_t max_depth) const {
+  s.IndentMore();
+  for (size_t child : GetSortedChildren(m_nodes, m_nodes[0]))
+    DumpNode(s, child, 1, max_depth);
+  s.IndentLess();
+}
+
+void FunctionCallTree::DumpFlatProfile(Stream &s, size_t count) const {
+  struct FunctionProfile {
+    ConstString name;
+    uint64_t call_count = 0;
+    uint64_t exclusive_instructions = 0;
+    uint64_t inclusive_instructions = 0;
+    uint64_t exclusive_tsc = 0;
+    uint64_t inclusive_tsc = 0;
+  };
+
+  std::map<ConstString, FunctionProfile> profiles;
+  for (size_t i = 1; i < m_nodes.size(); i++) {
+    const Node &node = m_nodes[i];
+    FunctionProfile &profile = profiles[node.name];
+    profile.name = node.name;
+    profile.call_count += node.call_count;
+    profile.exclusive_instructions += node.exclusive_instructions;
+    profile.exclusive_tsc += node.exclusive_tsc;
+
+    // Recursive calls are already accounted for in the inclusive values of
+    // the outermost invocation.
+    bool is_recursive = false;
+    for (size_t parent = node.parent; parent != 0;
+         parent = m_nodes[parent].parent) {
+      if (m_nodes[parent].name == node.name) {
+        is_recursive = true;
+        break;
+      }
+    }
+    if (!is_recursive) {
+      profile.inclusive_instructions += node.inclusive_instructions;
+      profile.inclusive_tsc += node.inclusive_tsc;
+    }
+  }
+
+  std::vector<FunctionProfile> sorted_profiles;
+  for (const auto &entry : profiles)
+    sorted_profiles.push_back(entry.second);
+  llvm::stable_sort(sorted_profiles, [](const FunctionProfile &lhs,
+                                        const FunctionProfile &rhs) {
+    return lhs.exclusive_instructions > rhs.exclusive_instructions;
+  });
+
+  s.Printf("  %12s %12s", "self insns", "total insns");
+  if (m_has_timing)
+    s.Printf(" %14s %14s", "self tsc", "total tsc");
+  s.Printf(" %8s  %s\n", "calls", "function");
+
+  for (size_t i = 0; i < sorted_profiles.size() && i < count; i++) {
+    const FunctionProfile &profile = sorted_profiles[i];
+    s.Printf("  %12" PRIu64 " %12" PRIu64, profile.exclusive_instructions,
+             profile.inclusive_instructions);
+    if (m_has_timing)
+      s.Printf(" %14" PRIu64 " %14" PRIu64, profile.exclusive_tsc,
+               profile.inclusive_tsc);
+    s.Printf(" %8" PRIu64 "  %s\n", profile.call_count,
+             profile.name.AsCString("(none)"));
+  }
+}
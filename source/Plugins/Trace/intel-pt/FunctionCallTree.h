@@ -0,0 +1,115 @@
+//===-- FunctionCallTree.h --------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLDB_SOURCE_PLUGINS_TRACE_INTEL_PT_FUNCTIONCALLTREE_H
+#define LLDB_SOURCE_PLUGINS_TRACE_INTEL_PT_FUNCTIONCALLTREE_H
+
+#include <map>
+#include <vector>
+
+#include "DecodedThread.h"
+#include "lldb/Symbol/FunctionRangeCache.h"
+#include "lldb/Utility/ConstString.h"
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+namespace trace_intel_pt {
+
+/// \class FunctionCallTree
+/// Function call hierarchy reconstructed from the instructions of a \a
+/// DecodedThread.
+///
+/// Calls and returns are detected using the libipt instruction class of each
+/// traced instruction. Every node of the tree represents a function invoked
+/// from a given call path and keeps track of the number of instructions
+/// executed in it and, if the trace has timing information, of the Time Stamp
+/// Counter ticks spent in it. Functions whose calls are not part of the trace,
+/// e.g. the ones active when tracing started, appear as roots of the tree.
+///
+/// Symbol lookups are the most expensive part of building the tree, so the
+/// address range of each resolved function is cached and consecutive
+/// instructions inside the same range don't trigger new lookups.
+class FunctionCallTree {
+public:
+  struct Node {
+    Node(ConstString name, size_t parent) : name(name), parent(parent) {}
+
+    /// Name of the function in the form module`function.
+    ConstString name;
+    /// Index of the parent node. The root node is its own parent.
+    size_t parent;
+    /// Number of times this function was entered from its parent.
+    uint64_t call_count = 0;
+    uint64_t exclusive_instructions = 0;
+    uint64_t inclusive_instructions = 0;
+    uint64_t exclusive_tsc = 0;
+    uint64_t inclusive_tsc = 0;
+    /// Indices of the children nodes indexed by function name.
+    std::map<ConstString, size_t> children;
+  };
+
+  /// Build the call tree of a decoded thread.
+  ///
+  /// \param[in] target
+  ///     The target used for symbolicating the traced instructions.
+  ///
+  /// \param[in] decoded_thread
+  ///     The decoded instructions to analyze.
+  FunctionCallTree(Target &target, const DecodedThread &decoded_thread);
+
+  /// Dump the call tree, with each node followed by its callees sorted by
+  /// inclusive instruction count.
+  ///
+  /// \param[in] s
+  ///     The stream object where the tree is printed.
+  ///
+  /// \param[in] max_depth
+  ///     Nodes deeper than this value are not printed.
+  void Dump(Stream &s, size_t max_depth) const;
+
+  /// Dump a flat profile of the functions in the trace sorted by exclusive
+  /// instruction count, i.e. the hottest functions first.
+  ///
+  /// \param[in] s
+  ///     The stream object where the profile is printed.
+  ///
+  /// \param[in] count
+  ///     The maximum number of functions to print.
+  void DumpFlatProfile(Stream &s, size_t count) const;
+
+  /// \return
+  ///     The nodes of the tree. The first node is an artificial root whose
+  ///     children are the outermost traced functions.
+  llvm::ArrayRef<Node> GetNodes() const { return m_nodes; }
+
+  /// \return
+  ///     \b true if any instruction of the trace had timing information.
+  bool HasTimingInformation() const { return m_has_timing; }
+
+private:
+  /// Find the function containing the given load address, resolving its
+  /// symbol context only if the address is not covered by a cached range.
+  ConstString LookupFunction(lldb::addr_t load_address);
+
+  /// Get the child of \a parent corresponding to the given function, creating
+  /// it if needed, and increase its call count.
+  size_t EnterFunction(size_t parent, ConstString name);
+
+  void DumpNode(Stream &s, size_t index, size_t depth, size_t max_depth) const;
+
+  Target &m_target;
+  std::vector<Node> m_nodes;
+  /// Address to function cache indexed by load address.
+  FunctionRangeCache m_function_ranges;
+  bool m_has_timing = false;
+};
+
+} // namespace trace_intel_pt
+} // namespace lldb_private
+
+#endif // LLDB_SOURCE_PLUGINS_TRACE_INTEL_PT_FUNCTIONCALLTREE_H
@@ -135,7 +135,12 @@ DecodeInstructions(pt_insn_decoder &decoder) {
         break;
       }
 
-      instructions.emplace_back(insn);
+      uint64_t timestamp;
+      if (pt_insn_time(&decoder, &timestamp, /*lost_mtc*/ nullptr,
+                       /*lost_cyc*/ nullptr) >= 0)
+        instructions.emplace_back(insn, timestamp);
+      else
+        instructions.emplace_back(insn);
     }
   }
 
@@ -9,6 +9,7 @@
 #include "TraceIntelPT.h"
 
 #include "CommandObjectTraceStartIntelPT.h"
+#include "FunctionCallTree.h"
 #include "TraceIntelPTSessionFileParser.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Target/Process.h"
@@ -112,3 +113,23 @@ size_t TraceIntelPT::GetInstructionCount(const Thread &thread) {
   else
     return 0;
 }
+
+Error TraceIntelPT::DumpTraceFunctionCalls(Thread &thread, Stream &s,
+                                           bool flat, size_t count) {
+  const DecodedThread *decoded_thread = Decode(thread);
+  if (!decoded_thread)
+    return createStringError(inconvertibleErrorCode(),
+                             "thread %" PRIu64 " is not traced",
+                             thread.GetID());
+
+  FunctionCallTree call_tree(thread.GetProcess()->GetTarget(),
+                             *decoded_thread);
+  s.Printf("thread #%u: tid = %" PRIu64 ", total instructions = %zu\n",
+           thread.GetIndexID(), thread.GetID(),
+           decoded_thread->GetInstructions().size());
+  if (flat)
+    call_tree.DumpFlatProfile(s, count);
+  else
+    call_tree.Dump(s, count);
+  return Error::success();
+}
@@ -62,6 +62,9 @@ public:
 
   size_t GetInstructionCount(const Thread &thread) override;
 
+  llvm::Error DumpTraceFunctionCalls(Thread &thread, Stream &s, bool flat,
+                                     size_t count) override;
+
   size_t GetCursorPosition(const Thread &thread) override;
 
 private:
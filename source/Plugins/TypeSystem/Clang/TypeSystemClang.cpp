@@ -4253,9 +4253,13 @@ TypeSystemClang::GetNumMemberFunctions(lldb::opaque_compiler_type_t type) {
         assert(record_decl);
         const clang::CXXRecordDecl *cxx_record_decl =
             llvm::dyn_cast<clang::CXXRecordDecl>(record_decl);
-        if (cxx_record_decl)
+        if (cxx_record_decl) {
+          CompleteDeferredMembers(
+              const_cast<clang::CXXRecordDecl *>(cxx_record_decl),
+              ConstString());
           num_functions = std::distance(cxx_record_decl->method_begin(),
                                         cxx_record_decl->method_end());
+        }
       }
       break;
 
@@ -4318,6 +4322,9 @@ TypeSystemClang::GetMemberFunctionAtIndex(lldb::opaque_compiler_type_t type,
         const clang::CXXRecordDecl *cxx_record_decl =
             llvm::dyn_cast<clang::CXXRecordDecl>(record_decl);
         if (cxx_record_decl) {
+          CompleteDeferredMembers(
+              const_cast<clang::CXXRecordDecl *>(cxx_record_decl),
+              ConstString());
           auto method_iter = cxx_record_decl->method_begin();
           auto method_end = cxx_record_decl->method_end();
           if (idx <
@@ -8966,11 +8973,14 @@ void TypeSystemClang::DumpTypeDescription(lldb::opaque_compiler_type_t type,
         record_decl->dump(llvm_ostrm);
       else {
         if (auto *cxx_record_decl =
-                llvm::dyn_cast<clang::CXXRecordDecl>(record_decl))
+                llvm::dyn_cast<clang::CXXRecordDecl>(record_decl)) {
+          CompleteDeferredMembers(
+              const_cast<clang::CXXRecordDecl *>(cxx_record_decl),
+              ConstString());
           cxx_record_decl->print(llvm_ostrm,
                                  getASTContext().getPrintingPolicy(),
                                  s->GetIndentLevel());
-        else
+        } else
           record_decl->print(llvm_ostrm, getASTContext().getPrintingPolicy(),
                              s->GetIndentLevel());
       }
@@ -9099,6 +9109,12 @@ void TypeSystemClang::CompleteTagDecl(clang::TagDecl *decl) {
   }
 }
 
+void TypeSystemClang::CompleteDeferredMembers(
+    clang::CXXRecordDecl *record_decl, ConstString name) {
+  if (m_dwarf_ast_parser_up && record_decl->hasExternalVisibleStorage())
+    m_dwarf_ast_parser_up->ParseDeferredMembers(record_decl, name);
+}
+
 void TypeSystemClang::CompleteObjCInterfaceDecl(
     clang::ObjCInterfaceDecl *decl) {
   SymbolFile *sym_file = GetSymbolFile();
@@ -458,6 +458,12 @@ public:
 
   void CompleteObjCInterfaceDecl(clang::ObjCInterfaceDecl *);
 
+  /// Parse the members of \a record_decl named \a name, or all of them if
+  /// \a name is empty, that the symbol file deferred when it completed the
+  /// record (see plugin.symbol-file.dwarf.lazy-member-completion).
+  void CompleteDeferredMembers(clang::CXXRecordDecl *record_decl,
+                               ConstString name);
+
   bool LayoutRecordType(
       const clang::RecordDecl *record_decl, uint64_t &size, uint64_t &alignment,
       llvm::DenseMap<const clang::FieldDecl *, uint64_t> &field_offsets,
@@ -0,0 +1,225 @@
+//===-- BuildIDIndex.cpp --------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Symbol/BuildIDIndex.h"
+
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Utility/DataBufferLLVM.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/DJB.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <map>
+#include <memory>
+
+using namespace lldb;
+using namespace lldb_private;
+
+/// First line of the index cache files, to be bumped whenever their format
+/// changes.
+static const char *g_index_header = "lldb-build-id-index 1";
+
+namespace {
+struct BuildIDIndexes {
+  std::mutex mutex;
+  /// The indexes keyed by the path of their symbol store.
+  std::map<std::string, std::shared_ptr<BuildIDIndex>> map;
+};
+} // namespace
+
+static BuildIDIndexes &GetBuildIDIndexes() {
+  static BuildIDIndexes g_indexes;
+  return g_indexes;
+}
+
+std::shared_ptr<BuildIDIndex>
+BuildIDIndex::GetIndexForDirectory(const FileSpec &directory) {
+  BuildIDIndexes &indexes = GetBuildIDIndexes();
+  std::lock_guard<std::mutex> guard(indexes.mutex);
+  std::shared_ptr<BuildIDIndex> &index_sp = indexes.map[directory.GetPath()];
+  if (!index_sp)
+    index_sp.reset(new BuildIDIndex(directory));
+  return index_sp;
+}
+
+void BuildIDIndex::Clear() {
+  BuildIDIndexes &indexes = GetBuildIDIndexes();
+  std::lock_guard<std::mutex> guard(indexes.mutex);
+  indexes.map.clear();
+}
+
+BuildIDIndex::BuildIDIndex(const FileSpec &directory)
+    : m_build_id_dir(directory) {
+  m_build_id_dir.AppendPathComponent(".build-id");
+  m_exists = FileSystem::Instance().IsDirectory(m_build_id_dir);
+  if (m_exists)
+    LoadIndex();
+}
+
+std::vector<FileSpec> BuildIDIndex::Lookup(llvm::ArrayRef<UUID> uuids) {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  std::vector<FileSpec> result;
+  result.reserve(uuids.size());
+  for (const UUID &uuid : uuids)
+    result.push_back(LookupLocked(uuid));
+  return result;
+}
+
+FileSpec BuildIDIndex::Lookup(const UUID &uuid) {
+  return Lookup(llvm::makeArrayRef(uuid)).front();
+}
+
+void BuildIDIndex::Save() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  if (m_dirty)
+    SaveIndex();
+}
+
+FileSpec BuildIDIndex::LookupLocked(const UUID &uuid) {
+  if (!m_exists || !uuid.IsValid())
+    return FileSpec();
+
+  std::string uuid_str = llvm::toHex(uuid.GetBytes(), /*LowerCase*/ true);
+  llvm::StringRef bucket_name = llvm::StringRef(uuid_str).take_front(2);
+  std::string file_name = uuid_str.substr(2) + ".debug";
+  if (!GetValidatedBucket(bucket_name).files.count(file_name))
+    return FileSpec();
+
+  FileSpec file_spec = m_build_id_dir;
+  file_spec.AppendPathComponent(bucket_name);
+  file_spec.AppendPathComponent(file_name);
+  return file_spec;
+}
+
+BuildIDIndex::Bucket &BuildIDIndex::GetValidatedBucket(llvm::StringRef name) {
+  Bucket &bucket = m_buckets[name];
+  if (bucket.validated)
+    return bucket;
+  bucket.validated = true;
+
+  FileSystem &fs = FileSystem::Instance();
+  FileSpec bucket_dir = m_build_id_dir;
+  bucket_dir.AppendPathComponent(name);
+  // Missing directories have the epoch as modification time, which matches
+  // the one of a bucket that was never indexed.
+  llvm::sys::TimePoint<> mod_time = fs.GetModificationTime(bucket_dir);
+  if (mod_time == bucket.mod_time)
+    return bucket;
+
+  bucket.mod_time = mod_time;
+  bucket.files.clear();
+  std::error_code ec;
+  for (llvm::vfs::directory_iterator it = fs.DirBegin(bucket_dir, ec), end;
+       !ec && it != end; it.increment(ec))
+    bucket.files.insert(llvm::sys::path::filename(it->path()));
+  m_dirty = true;
+  return bucket;
+}
+
+FileSpec BuildIDIndex::GetIndexCacheFile() const {
+  FileSpec cache_dir =
+      ModuleList::GetGlobalModuleListProperties().GetBuildIDIndexCachePath();
+  if (!cache_dir)
+    return FileSpec();
+  std::string store_path = m_build_id_dir.GetPath();
+  cache_dir.AppendPathComponent(llvm::utohexstr(llvm::djbHash(store_path)) +
+                                ".index");
+  return cache_dir;
+}
+
+// The index cache file has a line for each bucket with its name, modification
+// time and the names of its files, all separated by spaces:
+//
+//   lldb-build-id-index 1
+//   ff 1611860384000000000 e7fe727889ad82bb153de2ad065b2189693315.debug
+void BuildIDIndex::LoadIndex() {
+  FileSpec cache_file = GetIndexCacheFile();
+  if (!cache_file || !FileSystem::Instance().Exists(cache_file))
+    return;
+  std::shared_ptr<DataBufferLLVM> data_sp =
+      FileSystem::Instance().CreateDataBuffer(cache_file);
+  if (!data_sp)
+    return;
+
+  llvm::StringRef contents(data_sp->GetChars(), data_sp->GetByteSize());
+  llvm::StringRef line;
+  std::tie(line, contents) = contents.split('\n');
+  if (line != g_index_header)
+    return;
+
+  FileSystem &fs = FileSystem::Instance();
+  while (!contents.empty()) {
+    std::tie(line, contents) = contents.split('\n');
+    llvm::SmallVector<llvm::StringRef, 8> fields;
+    line.split(fields, ' ', /*MaxSplit*/ -1, /*KeepEmpty*/ false);
+    int64_t mod_time;
+    if (fields.size() < 2 || fields[1].getAsInteger(10, mod_time))
+      continue;
+
+    // Buckets that changed since the index was saved are listed again when
+    // they are used.
+    llvm::sys::TimePoint<> saved_mod_time{std::chrono::nanoseconds(mod_time)};
+    FileSpec bucket_dir = m_build_id_dir;
+    bucket_dir.AppendPathComponent(fields[0]);
+    if (fs.GetModificationTime(bucket_dir) != saved_mod_time) {
+      m_dirty = true;
+      continue;
+    }
+
+    Bucket &bucket = m_buckets[fields[0]];
+    bucket.mod_time = saved_mod_time;
+    bucket.validated = true;
+    for (llvm::StringRef file : llvm::makeArrayRef(fields).drop_front(2))
+      bucket.files.insert(file);
+  }
+}
+
+void BuildIDIndex::SaveIndex() {
+  m_dirty = false;
+  FileSpec cache_file = GetIndexCacheFile();
+  if (!cache_file)
+    return;
+
+  Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_SYMBOLS);
+  std::string path = cache_file.GetPath();
+  if (std::error_code ec = llvm::sys::fs::create_directories(
+          cache_file.GetDirectory().GetStringRef())) {
+    LLDB_LOG(log, "failed to create directory for {0}: {1}", path,
+             ec.message());
+    return;
+  }
+
+  llvm::Error error = llvm::writeFileAtomically(
+      path + "-%%%%%%.tmp", path, [this](llvm::raw_ostream &os) {
+        os << g_index_header << '\n';
+        for (const auto &entry : m_buckets) {
+          const Bucket &bucket = entry.second;
+          // Buckets that were never checked against the store have no
+          // contents worth saving.
+          if (bucket.mod_time == llvm::sys::TimePoint<>())
+            continue;
+          os << entry.first() << ' '
+             << std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    bucket.mod_time.time_since_epoch())
+                    .count();
+          for (const auto &file : bucket.files)
+            os << ' ' << file.first();
+          os << '\n';
+        }
+        return llvm::Error::success();
+      });
+  if (error)
+    LLDB_LOG_ERROR(log, std::move(error), "failed to save {1}: {0}", path);
+}
@@ -0,0 +1,161 @@
+//===-- CompiledUnwindTable.cpp -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Symbol/CompiledUnwindTable.h"
+
+#include "lldb/Core/AddressRange.h"
+#include "lldb/Symbol/DWARFCallFrameInfo.h"
+#include "lldb/Symbol/UnwindPlan.h"
+
+#include <algorithm>
+
+using namespace lldb;
+using namespace lldb_private;
+
+CompiledUnwindTable::CompiledUnwindTable(DWARFCallFrameInfo &eh_frame)
+    : m_eh_frame(eh_frame) {}
+
+UnwindPlanSP CompiledUnwindTable::GetUnwindPlanAtCallSite(const Address &addr) {
+  addr_t file_addr = addr.GetFileAddress();
+  if (file_addr == LLDB_INVALID_ADDRESS)
+    return nullptr;
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  const Function *function = GetFunction(addr, file_addr);
+  if (!function || function->num_rows == 0)
+    return nullptr;
+
+  auto begin = m_rows.begin() + function->first_row;
+  auto end = begin + function->num_rows;
+  auto pos = std::upper_bound(
+      begin, end, file_addr,
+      [](addr_t file_addr, const Row &row) { return file_addr < row.start; });
+  if (pos == begin)
+    return nullptr;
+  --pos;
+
+  UnwindPlanSP &plan_sp = m_row_plans[pos - m_rows.begin()];
+  if (!plan_sp)
+    plan_sp = CreateUnwindPlanForRow(*pos);
+  return plan_sp;
+}
+
+const CompiledUnwindTable::Function *
+CompiledUnwindTable::GetFunction(const Address &addr, addr_t file_addr) {
+  auto pos = std::upper_bound(m_functions.begin(), m_functions.end(),
+                              file_addr,
+                              [](addr_t file_addr, const Function &function) {
+                                return file_addr < function.start;
+                              });
+  if (pos != m_functions.begin() && file_addr < std::prev(pos)->end)
+    return &*std::prev(pos);
+
+  AddressRange range;
+  if (!m_eh_frame.GetAddressRange(addr, range))
+    return nullptr;
+
+  UnwindPlan plan(eRegisterKindGeneric);
+  if (!m_eh_frame.GetUnwindPlan(range, plan))
+    return nullptr;
+  if (plan.GetAddressRange().GetBaseAddress().IsValid())
+    range = plan.GetAddressRange();
+
+  Function function;
+  function.start = range.GetBaseAddress().GetFileAddress();
+  function.end = function.start + range.GetByteSize();
+  if (file_addr < function.start || file_addr >= function.end)
+    return nullptr;
+
+  function.first_row = m_rows.size();
+  const size_t first_saved_register = m_saved_registers.size();
+  if (CompileUnwindPlan(plan, function.start)) {
+    function.num_rows = m_rows.size() - function.first_row;
+  } else {
+    // Keep the function around without rows, so that we don't try to compile
+    // it again.
+    m_rows.resize(function.first_row);
+    m_row_plans.resize(function.first_row);
+    m_saved_registers.resize(first_saved_register);
+    function.num_rows = 0;
+  }
+
+  pos = std::upper_bound(m_functions.begin(), m_functions.end(),
+                         function.start,
+                         [](addr_t start, const Function &function) {
+                           return start < function.start;
+                         });
+  return &*m_functions.insert(pos, function);
+}
+
+bool CompiledUnwindTable::CompileUnwindPlan(UnwindPlan &plan,
+                                            addr_t function_start) {
+  // Signal trampolines need the special handling of the full plan.
+  if (plan.GetUnwindPlanForSignalTrap() == eLazyBoolYes ||
+      plan.GetRowCount() == 0)
+    return false;
+  m_register_kind = plan.GetRegisterKind();
+
+  for (int i = 0; i < plan.GetRowCount(); ++i) {
+    UnwindPlan::RowSP row_sp = plan.GetRowAtIndex(i);
+    UnwindPlan::Row::FAValue &cfa = row_sp->GetCFAValue();
+    if (!cfa.IsRegisterPlusOffset() || !row_sp->GetAFAValue().IsUnspecified())
+      return false;
+
+    Row row;
+    row.start = function_start + row_sp->GetOffset();
+    row.cfa_reg_num = cfa.GetRegisterNumber();
+    row.cfa_offset = cfa.GetOffset();
+    row.return_addr_reg_num = plan.GetReturnAddressRegister();
+    row.first_saved_register = m_saved_registers.size();
+
+    bool is_compact = true;
+    row_sp->ForEachRegisterLocation(
+        [&](uint32_t reg_num,
+            const UnwindPlan::Row::RegisterLocation &location) {
+          if (location.IsAtCFAPlusOffset())
+            m_saved_registers.push_back({reg_num, location.GetOffset(), false});
+          else if (location.IsSame())
+            m_saved_registers.push_back({reg_num, 0, true});
+          else if (!location.IsUnspecified())
+            is_compact = false;
+        });
+    if (!is_compact)
+      return false;
+
+    row.num_saved_registers =
+        m_saved_registers.size() - row.first_saved_register;
+    m_rows.push_back(row);
+    m_row_plans.emplace_back();
+  }
+  return true;
+}
+
+UnwindPlanSP CompiledUnwindTable::CreateUnwindPlanForRow(const Row &row) {
+  auto row_sp = std::make_shared<UnwindPlan::Row>();
+  row_sp->SetOffset(0);
+  row_sp->GetCFAValue().SetIsRegisterPlusOffset(row.cfa_reg_num,
+                                                row.cfa_offset);
+  for (uint32_t i = 0; i < row.num_saved_registers; ++i) {
+    const SavedRegister &saved =
+        m_saved_registers[row.first_saved_register + i];
+    if (saved.same)
+      row_sp->SetRegisterLocationToSame(saved.reg_num, /*must_replace*/ false);
+    else
+      row_sp->SetRegisterLocationToAtCFAPlusOffset(
+          saved.reg_num, saved.cfa_offset, /*can_replace*/ true);
+  }
+
+  auto plan_sp = std::make_shared<UnwindPlan>(m_register_kind);
+  plan_sp->AppendRow(row_sp);
+  plan_sp->SetReturnAddressRegister(row.return_addr_reg_num);
+  plan_sp->SetSourceName("compiled eh_frame CFI");
+  plan_sp->SetSourcedFromCompiler(eLazyBoolYes);
+  plan_sp->SetUnwindPlanValidAtAllInstructions(eLazyBoolNo);
+  plan_sp->SetUnwindPlanForSignalTrap(eLazyBoolNo);
+  return plan_sp;
+}
@@ -8,8 +8,10 @@
 
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Core/dwarf.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/UnwindPlan.h"
@@ -18,6 +20,12 @@
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/Timer.h"
+
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/xxhash.h"
+
 #include <list>
 #include <cstring>
 
@@ -145,7 +153,13 @@ GetGNUEHPointer(const DataExtractor &DE, offset_t *offset_ptr,
 
 DWARFCallFrameInfo::DWARFCallFrameInfo(ObjectFile &objfile,
                                        SectionSP &section_sp, Type type)
-    : m_objfile(objfile), m_section_sp(section_sp), m_type(type) {}
+    : m_objfile(objfile), m_section_sp(section_sp), m_type(type) {
+  if (ArchSpec arch = m_objfile.GetArchitecture()) {
+    if (arch.GetTriple().getArch() == llvm::Triple::arm ||
+        arch.GetTriple().getArch() == llvm::Triple::thumb)
+      m_clear_address_zeroth_bit = true;
+  }
+}
 
 bool DWARFCallFrameInfo::GetUnwindPlan(const Address &addr,
                                        UnwindPlan &unwind_plan) {
@@ -180,9 +194,17 @@ bool DWARFCallFrameInfo::GetAddressRange(Address addr, AddressRange &range) {
 
   if (m_section_sp.get() == nullptr || m_section_sp->IsEncrypted())
     return false;
-  GetFDEIndex();
-  FDEEntryMap::Entry *fde_entry =
-      m_fde_index.FindEntryThatContains(addr.GetFileAddress());
+
+  llvm::Optional<FDEEntryMap::Entry> fde_entry;
+  if (HasEHFrameHdrTable()) {
+    fde_entry = FindFDEEntryInEHFrameHdr(addr.GetFileAddress(),
+                                         /*or_follows*/ false);
+  } else {
+    GetFDEIndex();
+    if (const FDEEntryMap::Entry *entry =
+            m_fde_index.FindEntryThatContains(addr.GetFileAddress()))
+      fde_entry = *entry;
+  }
   if (!fde_entry)
     return false;
 
@@ -196,14 +218,19 @@ DWARFCallFrameInfo::GetFirstFDEEntryInRange(const AddressRange &range) {
   if (!m_section_sp || m_section_sp->IsEncrypted())
     return llvm::None;
 
-  GetFDEIndex();
-
   addr_t start_file_addr = range.GetBaseAddress().GetFileAddress();
-  const FDEEntryMap::Entry *fde =
-      m_fde_index.FindEntryThatContainsOrFollows(start_file_addr);
+  llvm::Optional<FDEEntryMap::Entry> fde;
+  if (HasEHFrameHdrTable()) {
+    fde = FindFDEEntryInEHFrameHdr(start_file_addr, /*or_follows*/ true);
+  } else {
+    GetFDEIndex();
+    if (const FDEEntryMap::Entry *entry =
+            m_fde_index.FindEntryThatContainsOrFollows(start_file_addr))
+      fde = *entry;
+  }
   if (fde && fde->DoesIntersect(
                  FDEEntryMap::Range(start_file_addr, range.GetByteSize())))
-    return *fde;
+    return fde;
 
   return llvm::None;
 }
@@ -228,24 +255,46 @@ void DWARFCallFrameInfo::GetFunctionAddressAndSizeVector(
 
 const DWARFCallFrameInfo::CIE *
 DWARFCallFrameInfo::GetCIE(dw_offset_t cie_offset) {
+  std::lock_guard<std::mutex> guard(m_cie_map_mutex);
   cie_map_t::iterator pos = m_cie_map.find(cie_offset);
 
-  if (pos != m_cie_map.end()) {
-    // Parse and cache the CIE
-    if (pos->second == nullptr)
-      pos->second = ParseCIE(cie_offset);
+  if (pos == m_cie_map.end()) {
+    // The CIEs are only all known once the section was scanned, FDEs found
+    // through .eh_frame_hdr or a cached index refer to CIEs not parsed yet.
+    if (!IsCIE(cie_offset))
+      return nullptr;
+    pos = m_cie_map.emplace(cie_offset, nullptr).first;
+  }
+
+  // Parse and cache the CIE
+  if (pos->second == nullptr)
+    pos->second = ParseCIE(cie_offset);
 
-    return pos->second.get();
+  return pos->second.get();
+}
+
+bool DWARFCallFrameInfo::IsCIE(dw_offset_t offset) {
+  GetCFIData();
+  lldb::offset_t data_offset = offset;
+  if (!m_cfi_data.ValidOffsetForDataOfSize(data_offset, 8))
+    return false;
+  uint64_t length = m_cfi_data.GetU32(&data_offset);
+  dw_offset_t cie_id;
+  if (length == UINT32_MAX) {
+    length = m_cfi_data.GetU64(&data_offset);
+    cie_id = m_cfi_data.GetU64(&data_offset);
+  } else {
+    cie_id = m_cfi_data.GetU32(&data_offset);
   }
-  return nullptr;
+  return length > 0 && ((m_type == DWARF && cie_id == UINT32_MAX) ||
+                        (m_type == EH && cie_id == 0ul));
 }
 
 DWARFCallFrameInfo::CIESP
 DWARFCallFrameInfo::ParseCIE(const dw_offset_t cie_offset) {
   CIESP cie_sp(new CIE(cie_offset));
   lldb::offset_t offset = cie_offset;
-  if (!m_cfi_data_initialized)
-    GetCFIData();
+  GetCFIData();
   uint32_t length = m_cfi_data.GetU32(&offset);
   dw_offset_t cie_id, end_offset;
   bool is_64bit = (length == UINT32_MAX);
@@ -395,13 +444,242 @@ DWARFCallFrameInfo::ParseCIE(const dw_offset_t cie_offset) {
 }
 
 void DWARFCallFrameInfo::GetCFIData() {
-  if (!m_cfi_data_initialized) {
+  llvm::call_once(m_cfi_data_once, [this]() {
     Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_UNWIND));
     if (log)
       m_objfile.GetModule()->LogMessage(log, "Reading EH frame info");
     m_objfile.ReadSectionData(m_section_sp.get(), m_cfi_data);
-    m_cfi_data_initialized = true;
+  });
+}
+
+// The .eh_frame_hdr section starts with a version byte and the encodings of
+// the fields that follow: a pointer to the eh_frame section, the number of
+// FDEs and a table of (start address, FDE address) pairs sorted by start
+// address. Only tables whose entries are 4 byte offsets from the start of the
+// section, which is what linkers produce, are binary searched in place.
+bool DWARFCallFrameInfo::HasEHFrameHdrTable() {
+  llvm::call_once(m_eh_frame_hdr_once, [this]() {
+    if (m_type != EH)
+      return;
+    SectionList *section_list = m_objfile.GetSectionList();
+    if (!section_list)
+      return;
+    SectionSP hdr_sp =
+        section_list->FindSectionByName(ConstString(".eh_frame_hdr"));
+    if (!hdr_sp || hdr_sp->IsEncrypted())
+      return;
+
+    DataExtractor hdr;
+    if (m_objfile.ReadSectionData(hdr_sp.get(), hdr) < 4)
+      return;
+    lldb::offset_t offset = 0;
+    uint8_t version = hdr.GetU8(&offset);
+    uint8_t eh_frame_ptr_enc = hdr.GetU8(&offset);
+    uint8_t fde_count_enc = hdr.GetU8(&offset);
+    uint8_t table_enc = hdr.GetU8(&offset);
+    if (version != 1 || eh_frame_ptr_enc == DW_EH_PE_omit ||
+        fde_count_enc == DW_EH_PE_omit ||
+        table_enc != (DW_EH_PE_datarel | DW_EH_PE_sdata4))
+      return;
+
+    const addr_t hdr_addr = hdr_sp->GetFileAddress();
+    addr_t eh_frame_addr =
+        GetGNUEHPointer(hdr, &offset, eh_frame_ptr_enc, hdr_addr, hdr_addr,
+                        hdr_addr);
+    uint64_t fde_count = GetGNUEHPointer(hdr, &offset, fde_count_enc,
+                                         hdr_addr, hdr_addr, hdr_addr);
+    // The table must describe this eh_frame section and fit in the header.
+    if (eh_frame_addr != m_section_sp->GetFileAddress() ||
+        fde_count > UINT32_MAX ||
+        !hdr.ValidOffsetForDataOfSize(offset, fde_count * 8))
+      return;
+
+    Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_UNWIND);
+    LLDB_LOG(log, "using the .eh_frame_hdr table of {0} ({1} FDEs)",
+             m_objfile.GetFileSpec(), fde_count);
+    m_eh_frame_hdr_table = DataExtractor(hdr, offset, fde_count * 8);
+    m_eh_frame_hdr_addr = hdr_addr;
+    m_eh_frame_hdr_fde_count = fde_count;
+  });
+  return m_eh_frame_hdr_fde_count > 0;
+}
+
+std::pair<addr_t, addr_t>
+DWARFCallFrameInfo::GetEHFrameHdrEntry(uint32_t idx) {
+  lldb::offset_t offset = idx * 8;
+  int32_t start = m_eh_frame_hdr_table.GetU32(&offset);
+  int32_t fde = m_eh_frame_hdr_table.GetU32(&offset);
+  addr_t start_addr = m_eh_frame_hdr_addr + start;
+  if (m_clear_address_zeroth_bit)
+    start_addr &= ~1ull;
+  return {start_addr,
+          m_eh_frame_hdr_addr + fde - m_section_sp->GetFileAddress()};
+}
+
+llvm::Optional<DWARFCallFrameInfo::FDEEntryMap::Entry>
+DWARFCallFrameInfo::FindFDEEntryInEHFrameHdr(addr_t file_addr,
+                                             bool or_follows) {
+  // Find the last function starting at or before the address.
+  uint32_t low = 0;
+  uint32_t high = m_eh_frame_hdr_fde_count;
+  while (low < high) {
+    uint32_t mid = low + (high - low) / 2;
+    if (GetEHFrameHdrEntry(mid).first <= file_addr)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  if (low > 0) {
+    llvm::Optional<FDEEntryMap::Entry> entry =
+        ParseFDEEntry(GetEHFrameHdrEntry(low - 1).second);
+    if (entry && entry->Contains(file_addr))
+      return entry;
+  }
+  if (or_follows && low < m_eh_frame_hdr_fde_count)
+    return ParseFDEEntry(GetEHFrameHdrEntry(low).second);
+  return llvm::None;
+}
+
+llvm::Optional<DWARFCallFrameInfo::FDEEntryMap::Entry>
+DWARFCallFrameInfo::ParseFDEEntry(dw_offset_t fde_offset) {
+  GetCFIData();
+  lldb::offset_t offset = fde_offset;
+  if (!m_cfi_data.ValidOffsetForDataOfSize(offset, 8))
+    return llvm::None;
+
+  dw_offset_t cie_id, cie_offset;
+  uint32_t len = m_cfi_data.GetU32(&offset);
+  if (len == UINT32_MAX) {
+    m_cfi_data.GetU64(&offset);
+    cie_id = m_cfi_data.GetU64(&offset);
+    cie_offset = fde_offset + 12 - cie_id;
+  } else {
+    cie_id = m_cfi_data.GetU32(&offset);
+    cie_offset = fde_offset + 4 - cie_id;
+  }
+  if (m_type == DWARF)
+    cie_offset = cie_id;
+
+  const CIE *cie = GetCIE(cie_offset);
+  if (!cie)
+    return llvm::None;
+
+  const lldb::addr_t pc_rel_addr = m_section_sp->GetFileAddress();
+  lldb::addr_t addr =
+      GetGNUEHPointer(m_cfi_data, &offset, cie->ptr_encoding, pc_rel_addr,
+                      LLDB_INVALID_ADDRESS, LLDB_INVALID_ADDRESS);
+  if (m_clear_address_zeroth_bit)
+    addr &= ~1ull;
+  lldb::addr_t length = GetGNUEHPointer(
+      m_cfi_data, &offset, cie->ptr_encoding & DW_EH_PE_MASK_ENCODING,
+      pc_rel_addr, LLDB_INVALID_ADDRESS, LLDB_INVALID_ADDRESS);
+  return FDEEntryMap::Entry(addr, length, fde_offset);
+}
+
+/// \return
+///     The file where the index of this section is cached, or an empty
+///     FileSpec if the cache is disabled or the object file has no build-id.
+FileSpec DWARFCallFrameInfo::GetFDEIndexCacheFile() const {
+  FileSpec cache_dir =
+      ModuleList::GetGlobalModuleListProperties().GetUnwindIndexCachePath();
+  UUID uuid = m_objfile.GetUUID();
+  if (!cache_dir || !uuid.IsValid())
+    return FileSpec();
+  FileSpec cache_file = cache_dir.CopyByAppendingPathComponent(
+      uuid.GetAsString(/*separator*/ ""));
+  cache_file.AppendPathComponent(
+      (m_section_sp->GetName().GetStringRef() + ".fde-index").str());
+  return cache_file;
+}
+
+// The index cache file starts with a header line followed by the file offset,
+// size and xxHash64 of the contents of the indexed section, the number of
+// entries and the entries themselves, all little endian:
+//
+//   "lldb-fde-index 2\n"
+//   u64 section file offset, u64 section file size, u64 section hash,
+//   u32 entry count
+//   u64 function address, u32 function size, u32 FDE offset (per entry)
+//
+// The hash keeps a rebuilt file that kept its build-id from using the index
+// of the old one.
+static const char *g_fde_index_header = "lldb-fde-index 2\n";
+
+static uint64_t HashSectionData(const DataExtractor &data) {
+  return llvm::xxHash64(
+      llvm::StringRef(reinterpret_cast<const char *>(data.GetDataStart()),
+                      data.GetByteSize()));
+}
+
+bool DWARFCallFrameInfo::LoadFDEIndex() {
+  FileSpec cache_file = GetFDEIndexCacheFile();
+  if (!cache_file || !FileSystem::Instance().Exists(cache_file))
+    return false;
+  std::shared_ptr<DataBufferLLVM> data_sp =
+      FileSystem::Instance().CreateDataBuffer(cache_file);
+  if (!data_sp)
+    return false;
+
+  llvm::StringRef header(g_fde_index_header);
+  DataExtractor data(data_sp, eByteOrderLittle, 8);
+  lldb::offset_t offset = header.size();
+  if (!data.ValidOffsetForDataOfSize(0, header.size() + 28) ||
+      llvm::StringRef(data.PeekCStr(0), header.size()) != header)
+    return false;
+  if (data.GetU64(&offset) != m_section_sp->GetFileOffset() ||
+      data.GetU64(&offset) != m_section_sp->GetFileSize())
+    return false;
+  GetCFIData();
+  if (data.GetU64(&offset) != HashSectionData(m_cfi_data))
+    return false;
+  uint32_t count = data.GetU32(&offset);
+  if (!data.ValidOffsetForDataOfSize(offset, uint64_t(count) * 16))
+    return false;
+
+  for (uint32_t i = 0; i < count; ++i) {
+    lldb::addr_t base = data.GetU64(&offset);
+    uint32_t size = data.GetU32(&offset);
+    dw_offset_t fde_offset = data.GetU32(&offset);
+    m_fde_index.Append(FDEEntryMap::Entry(base, size, fde_offset));
   }
+  m_fde_index.Sort();
+  return true;
+}
+
+void DWARFCallFrameInfo::SaveFDEIndex() {
+  FileSpec cache_file = GetFDEIndexCacheFile();
+  if (!cache_file)
+    return;
+
+  Log *log = GetLogIfAllCategoriesSet(LIBLLDB_LOG_UNWIND);
+  std::string path = cache_file.GetPath();
+  if (std::error_code ec = llvm::sys::fs::create_directories(
+          cache_file.GetDirectory().GetStringRef())) {
+    LLDB_LOG(log, "failed to create directory for {0}: {1}", path,
+             ec.message());
+    return;
+  }
+
+  GetCFIData();
+  llvm::Error error = llvm::writeFileAtomically(
+      path + "-%%%%%%.tmp", path, [this](llvm::raw_ostream &os) {
+        llvm::support::endian::Writer writer(os, llvm::support::little);
+        os << g_fde_index_header;
+        writer.write<uint64_t>(m_section_sp->GetFileOffset());
+        writer.write<uint64_t>(m_section_sp->GetFileSize());
+        writer.write<uint64_t>(HashSectionData(m_cfi_data));
+        writer.write<uint32_t>(m_fde_index.GetSize());
+        for (size_t i = 0, e = m_fde_index.GetSize(); i < e; ++i) {
+          const FDEEntryMap::Entry &entry = m_fde_index.GetEntryRef(i);
+          writer.write<uint64_t>(entry.base);
+          writer.write<uint32_t>(entry.size);
+          writer.write<uint32_t>(entry.data);
+        }
+        return llvm::Error::success();
+      });
+  if (error)
+    LLDB_LOG_ERROR(log, std::move(error), "failed to save {1}: {0}", path);
 }
 // Scan through the eh_frame or debug_frame section looking for FDEs and noting
 // the start/end addresses of the functions and a pointer back to the
@@ -422,16 +700,26 @@ void DWARFCallFrameInfo::GetFDEIndex() {
   LLDB_SCOPED_TIMERF("%s - %s", LLVM_PRETTY_FUNCTION,
                      m_objfile.GetFileSpec().GetFilename().AsCString(""));
 
-  bool clear_address_zeroth_bit = false;
-  if (ArchSpec arch = m_objfile.GetArchitecture()) {
-    if (arch.GetTriple().getArch() == llvm::Triple::arm ||
-        arch.GetTriple().getArch() == llvm::Triple::thumb)
-      clear_address_zeroth_bit = true;
+  if (LoadFDEIndex()) {
+    m_fde_index_initialized = true;
+    return;
+  }
+
+  // The .eh_frame_hdr table already lists the FDEs in order, which saves
+  // walking all the CIEs and FDEs of the section.
+  if (HasEHFrameHdrTable()) {
+    for (uint32_t i = 0; i < m_eh_frame_hdr_fde_count; ++i)
+      if (llvm::Optional<FDEEntryMap::Entry> entry =
+              ParseFDEEntry(GetEHFrameHdrEntry(i).second))
+        m_fde_index.Append(*entry);
+    m_fde_index.Sort();
+    SaveFDEIndex();
+    m_fde_index_initialized = true;
+    return;
   }
 
   lldb::offset_t offset = 0;
-  if (!m_cfi_data_initialized)
-    GetCFIData();
+  GetCFIData();
   while (m_cfi_data.ValidOffsetForDataOfSize(offset, 8)) {
     const dw_offset_t current_entry = offset;
     dw_offset_t cie_id, next_entry, cie_offset;
@@ -473,7 +761,10 @@ void DWARFCallFrameInfo::GetFDEIndex() {
         return;
       }
 
-      m_cie_map[current_entry] = std::move(cie_sp);
+      // Keep the CIE if it was already parsed on demand, its users may still
+      // reference it.
+      std::lock_guard<std::mutex> guard(m_cie_map_mutex);
+      m_cie_map.emplace(current_entry, std::move(cie_sp));
       offset = next_entry;
       continue;
     }
@@ -502,7 +793,7 @@ void DWARFCallFrameInfo::GetFDEIndex() {
       lldb::addr_t addr =
           GetGNUEHPointer(m_cfi_data, &offset, cie->ptr_encoding, pc_rel_addr,
                           text_addr, data_addr);
-      if (clear_address_zeroth_bit)
+      if (m_clear_address_zeroth_bit)
         addr &= ~1ull;
 
       lldb::addr_t length = GetGNUEHPointer(
@@ -519,6 +810,7 @@ void DWARFCallFrameInfo::GetFDEIndex() {
     offset = next_entry;
   }
   m_fde_index.Sort();
+  SaveFDEIndex();
   m_fde_index_initialized = true;
 }
 
@@ -532,8 +824,7 @@ bool DWARFCallFrameInfo::FDEToUnwindPlan(dw_offset_t dwarf_offset,
   if (m_section_sp.get() == nullptr || m_section_sp->IsEncrypted())
     return false;
 
-  if (!m_cfi_data_initialized)
-    GetCFIData();
+  GetCFIData();
 
   uint32_t length = m_cfi_data.GetU32(&offset);
   dw_offset_t cie_offset;
@@ -0,0 +1,56 @@
+//===-- FunctionRangeCache.cpp --------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Symbol/FunctionRangeCache.h"
+#include "lldb/Core/AddressRange.h"
+#include "lldb/Symbol/SymbolContext.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+llvm::Optional<ConstString> FunctionRangeCache::Lookup(addr_t addr) {
+  if (m_last_range != m_ranges.end() && m_last_range->first <= addr &&
+      addr < m_last_range->second.first)
+    return m_last_range->second.second;
+
+  auto it = m_ranges.upper_bound(addr);
+  if (it == m_ranges.begin())
+    return llvm::None;
+  --it;
+  if (addr >= it->second.first)
+    return llvm::None;
+  m_last_range = it;
+  return it->second.second;
+}
+
+void FunctionRangeCache::Insert(addr_t addr, const SymbolContext &sc,
+                                ConstString name, Target *target) {
+  addr_t start = addr;
+  addr_t end = addr + 1;
+  AddressRange range;
+  if (sc.GetAddressRange(eSymbolContextFunction | eSymbolContextSymbol, 0,
+                         /*use_inline_block_range*/ false, range)) {
+    addr_t range_start = target
+                             ? range.GetBaseAddress().GetLoadAddress(target)
+                             : range.GetBaseAddress().GetFileAddress();
+    if (range_start != LLDB_INVALID_ADDRESS && range_start <= addr &&
+        addr < range_start + range.GetByteSize()) {
+      start = range_start;
+      end = range_start + range.GetByteSize();
+    }
+  }
+  auto inserted = m_ranges.emplace(start, std::make_pair(end, name));
+  if (!inserted.second)
+    inserted.first->second = std::make_pair(end, name);
+  m_last_range = inserted.first;
+}
+
+void FunctionRangeCache::Clear() {
+  m_ranges.clear();
+  m_last_range = m_ranges.end();
+}
@@ -8,9 +8,12 @@
 
 #include "lldb/Symbol/LocateSymbolFile.h"
 
+#include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
+#include "lldb/Core/Section.h"
 #include "lldb/Host/FileSystem.h"
+#include "lldb/Symbol/BuildIDIndex.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Utility/ArchSpec.h"
 #include "lldb/Utility/DataBuffer.h"
@@ -23,6 +26,8 @@
 
 #include "llvm/Support/FileSystem.h"
 
+#include <map>
+
 // From MacOSX system header "mach/machine.h"
 typedef int cpu_type_t;
 typedef int cpu_subtype_t;
@@ -253,81 +258,91 @@ ModuleSpec Symbols::LocateExecutableObjectFile(const ModuleSpec &module_spec) {
 
 // Keep "symbols.enable-external-lookup" description in sync with this function.
 
-FileSpec
-Symbols::LocateExecutableSymbolFile(const ModuleSpec &module_spec,
-                                    const FileSpecList &default_search_paths) {
-  FileSpec symbol_file_spec = module_spec.GetSymbolFileSpec();
-  if (symbol_file_spec.IsAbsolute() &&
-      FileSystem::Instance().Exists(symbol_file_spec))
-    return symbol_file_spec;
-
-  FileSpecList debug_file_search_paths = default_search_paths;
-
-  // Add module directory.
-  FileSpec module_file_spec = module_spec.GetFileSpec();
-  // We keep the unresolved pathname if it fails.
-  FileSystem::Instance().ResolveSymbolicLink(module_file_spec,
-                                             module_file_spec);
+static void AppendExternalDebugFileSearchPaths(FileSpecList &search_paths) {
+  if (!ModuleList::GetGlobalModuleListProperties().GetEnableExternalLookup())
+    return;
 
-  ConstString file_dir = module_file_spec.GetDirectory();
+  // Add current working directory.
   {
-    FileSpec file_spec(file_dir.AsCString("."));
+    FileSpec file_spec(".");
     FileSystem::Instance().Resolve(file_spec);
-    debug_file_search_paths.AppendIfUnique(file_spec);
+    search_paths.AppendIfUnique(file_spec);
   }
 
-  if (ModuleList::GetGlobalModuleListProperties().GetEnableExternalLookup()) {
-
-    // Add current working directory.
-    {
-      FileSpec file_spec(".");
-      FileSystem::Instance().Resolve(file_spec);
-      debug_file_search_paths.AppendIfUnique(file_spec);
-    }
-
 #ifndef _WIN32
 #if defined(__NetBSD__)
-    // Add /usr/libdata/debug directory.
-    {
-      FileSpec file_spec("/usr/libdata/debug");
-      FileSystem::Instance().Resolve(file_spec);
-      debug_file_search_paths.AppendIfUnique(file_spec);
-    }
+  // Add /usr/libdata/debug directory.
+  {
+    FileSpec file_spec("/usr/libdata/debug");
+    FileSystem::Instance().Resolve(file_spec);
+    search_paths.AppendIfUnique(file_spec);
+  }
 #else
-    // Add /usr/lib/debug directory.
-    {
-      FileSpec file_spec("/usr/lib/debug");
-      FileSystem::Instance().Resolve(file_spec);
-      debug_file_search_paths.AppendIfUnique(file_spec);
-    }
+  // Add /usr/lib/debug directory.
+  {
+    FileSpec file_spec("/usr/lib/debug");
+    FileSystem::Instance().Resolve(file_spec);
+    search_paths.AppendIfUnique(file_spec);
+  }
 #endif
 #endif // _WIN32
-  }
+}
 
-  std::string uuid_str;
-  const UUID &module_uuid = module_spec.GetUUID();
-  if (module_uuid.IsValid()) {
-    // Some debug files are stored in the .build-id directory like this:
-    //   /usr/lib/debug/.build-id/ff/e7fe727889ad82bb153de2ad065b2189693315.debug
-    uuid_str = module_uuid.GetAsString("");
-    std::transform(uuid_str.begin(), uuid_str.end(), uuid_str.begin(),
-                   ::tolower);
-    uuid_str.insert(2, 1, '/');
-    uuid_str = uuid_str + ".debug";
+/// Get the existing directories to search for the symbol file of the module
+/// \a module_file_spec: the default ones, the directory of the module and the
+/// external ones.
+static FileSpecList
+GetDebugFileSearchPaths(const FileSpec &module_file_spec,
+                        const FileSpecList &default_search_paths) {
+  FileSpecList debug_file_search_paths = default_search_paths;
+
+  // Add module directory.
+  {
+    FileSpec file_spec(module_file_spec.GetDirectory().AsCString("."));
+    FileSystem::Instance().Resolve(file_spec);
+    debug_file_search_paths.AppendIfUnique(file_spec);
   }
 
+  AppendExternalDebugFileSearchPaths(debug_file_search_paths);
+
+  FileSpecList result;
   size_t num_directories = debug_file_search_paths.GetSize();
   for (size_t idx = 0; idx < num_directories; ++idx) {
     FileSpec dirspec = debug_file_search_paths.GetFileSpecAtIndex(idx);
     FileSystem::Instance().Resolve(dirspec);
-    if (!FileSystem::Instance().IsDirectory(dirspec))
-      continue;
+    if (FileSystem::Instance().IsDirectory(dirspec))
+      result.Append(dirspec);
+  }
+  return result;
+}
+
+/// Locate the symbol file of \a module_spec in \a debug_file_search_paths.
+///
+/// \param[in] build_id_files
+///     The debug files of the build-id of the module in the symbol stores of
+///     \a debug_file_search_paths, indexed by the path of the store.
+static FileSpec
+LocateSymbolFileInSearchPaths(const ModuleSpec &module_spec,
+                              const FileSpec &module_file_spec,
+                              const FileSpecList &debug_file_search_paths,
+                              const std::map<std::string, FileSpec>
+                                  &build_id_files) {
+  FileSpec symbol_file_spec = module_spec.GetSymbolFileSpec();
+  ConstString file_dir = module_file_spec.GetDirectory();
+  const UUID &module_uuid = module_spec.GetUUID();
 
+  size_t num_directories = debug_file_search_paths.GetSize();
+  for (size_t idx = 0; idx < num_directories; ++idx) {
+    FileSpec dirspec = debug_file_search_paths.GetFileSpecAtIndex(idx);
     std::vector<std::string> files;
     std::string dirname = dirspec.GetPath();
 
-    if (!uuid_str.empty())
-      files.push_back(dirname + "/.build-id/" + uuid_str);
+    // Some debug files are stored in the .build-id directory like this:
+    //   /usr/lib/debug/.build-id/ff/e7fe727889ad82bb153de2ad065b2189693315.debug
+    // These were already looked up in the index of the directory.
+    auto build_id_file = build_id_files.find(dirname);
+    if (build_id_file != build_id_files.end() && build_id_file->second)
+      files.push_back(build_id_file->second.GetPath());
     if (symbol_file_spec.GetFilename()) {
       files.push_back(dirname + "/" +
                       symbol_file_spec.GetFilename().GetCString());
@@ -374,6 +389,91 @@ Symbols::LocateExecutableSymbolFile(const ModuleSpec &module_spec,
   return LocateExecutableSymbolFileDsym(module_spec);
 }
 
+FileSpec
+Symbols::LocateExecutableSymbolFile(const ModuleSpec &module_spec,
+                                    const FileSpecList &default_search_paths) {
+  return LocateExecutableSymbolFiles(module_spec, default_search_paths)
+      .front();
+}
+
+std::vector<FileSpec> Symbols::LocateExecutableSymbolFiles(
+    llvm::ArrayRef<ModuleSpec> module_specs,
+    const FileSpecList &default_search_paths) {
+  std::vector<FileSpec> result(module_specs.size());
+  std::vector<FileSpec> module_file_specs(module_specs.size());
+  std::vector<FileSpecList> search_paths(module_specs.size());
+  // The build-ids to look up in each of the search paths.
+  std::map<std::string, std::vector<UUID>> uuids_by_dir;
+
+  for (size_t i = 0; i < module_specs.size(); ++i) {
+    const ModuleSpec &module_spec = module_specs[i];
+    FileSpec symbol_file_spec = module_spec.GetSymbolFileSpec();
+    if (symbol_file_spec.IsAbsolute() &&
+        FileSystem::Instance().Exists(symbol_file_spec)) {
+      result[i] = symbol_file_spec;
+      continue;
+    }
+
+    // We keep the unresolved pathname if it fails.
+    module_file_specs[i] = module_spec.GetFileSpec();
+    FileSystem::Instance().ResolveSymbolicLink(module_file_specs[i],
+                                               module_file_specs[i]);
+    search_paths[i] =
+        GetDebugFileSearchPaths(module_file_specs[i], default_search_paths);
+    if (!module_spec.GetUUID().IsValid())
+      continue;
+    for (size_t idx = 0; idx < search_paths[i].GetSize(); ++idx)
+      uuids_by_dir[search_paths[i].GetFileSpecAtIndex(idx).GetPath()]
+          .push_back(module_spec.GetUUID());
+  }
+
+  // Look up the build-ids of all the modules at once in each symbol store, so
+  // that the store is indexed and its index saved once for the whole batch.
+  std::map<UUID, std::map<std::string, FileSpec>> build_id_files;
+  for (const auto &entry : uuids_by_dir) {
+    const std::vector<UUID> &uuids = entry.second;
+    std::shared_ptr<BuildIDIndex> index_sp =
+        BuildIDIndex::GetIndexForDirectory(FileSpec(entry.first));
+    std::vector<FileSpec> files = index_sp->Lookup(uuids);
+    index_sp->Save();
+    for (size_t idx = 0; idx < uuids.size(); ++idx)
+      build_id_files[uuids[idx]][entry.first] = files[idx];
+  }
+
+  for (size_t i = 0; i < module_specs.size(); ++i)
+    if (!result[i])
+      result[i] = LocateSymbolFileInSearchPaths(
+          module_specs[i], module_file_specs[i], search_paths[i],
+          build_id_files[module_specs[i].GetUUID()]);
+  return result;
+}
+
+void Symbols::LocateSymbolFilesForModules(
+    const ModuleList &module_list, const FileSpecList &default_search_paths) {
+  std::vector<ModuleSP> modules;
+  std::vector<ModuleSpec> module_specs;
+  for (const ModuleSP &module_sp : module_list.Modules()) {
+    if (!module_sp || !module_sp->GetUUID().IsValid() ||
+        module_sp->GetSymbolFileFileSpec() ||
+        module_sp->GetSymbolFile(/*can_create*/ false))
+      continue;
+    SectionList *section_list = module_sp->GetSectionList();
+    if (!section_list ||
+        section_list->FindSectionByType(eSectionTypeDWARFDebugInfo, true))
+      continue;
+    modules.push_back(module_sp);
+    module_specs.emplace_back(module_sp->GetFileSpec(), module_sp->GetUUID());
+  }
+  if (module_specs.empty())
+    return;
+
+  std::vector<FileSpec> symbol_files =
+      LocateExecutableSymbolFiles(module_specs, default_search_paths);
+  for (size_t i = 0; i < modules.size(); ++i)
+    if (symbol_files[i])
+      modules[i]->SetSymbolFileFileSpec(symbol_files[i]);
+}
+
 #if !defined(__APPLE__)
 
 FileSpec Symbols::FindSymbolFileInBundle(const FileSpec &symfile_bundle,
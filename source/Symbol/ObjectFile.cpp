@@ -661,7 +661,8 @@ void ObjectFile::RelocateSection(lldb_private::Section *section)
 
 DataBufferSP ObjectFile::MapFileData(const FileSpec &file, uint64_t Size,
                                      uint64_t Offset) {
-  return FileSystem::Instance().CreateDataBuffer(file.GetPath(), Size, Offset);
+  return FileSystem::Instance().CreateSharedDataBuffer(file.GetPath(), Size,
+                                                       Offset);
 }
 
 void llvm::format_provider<ObjectFile::Type>::format(
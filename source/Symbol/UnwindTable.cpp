@@ -15,12 +15,15 @@
 #include "lldb/Symbol/ArmUnwindInfo.h"
 #include "lldb/Symbol/CallFrameInfo.h"
 #include "lldb/Symbol/CompactUnwindInfo.h"
+#include "lldb/Symbol/CompiledUnwindTable.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/SymbolContext.h"
 #include "lldb/Symbol/SymbolVendor.h"
 
+#include "llvm/ADT/ScopeExit.h"
+
 // There is one UnwindTable object per ObjectFile. It contains a list of Unwind
 // objects -- one per function, populated lazily -- for the ObjectFile. Each
 // Unwind object has multiple UnwindPlans for different scenarios.
@@ -40,11 +43,14 @@ void UnwindTable::Initialize() {
   if (m_initialized)
     return;
 
-  std::lock_guard<std::mutex> guard(m_mutex);
+  llvm::sys::ScopedWriter guard(m_mutex);
 
   if (m_initialized) // check again once we've acquired the lock
     return;
-  m_initialized = true;
+  // Only publish the initialization once all the members are set up, other
+  // threads read them without taking the lock.
+  auto set_initialized =
+      llvm::make_scope_exit([this] { m_initialized = true; });
   ObjectFile *object_file = m_module.GetObjectFile();
   if (!object_file)
     return;
@@ -81,6 +87,12 @@ void UnwindTable::Initialize() {
           std::make_unique<ArmUnwindInfo>(*object_file, sect, sect_extab);
     }
   }
+
+  // The object file and debug_frame unwind information are preferred over
+  // eh_frame at call sites, see FuncUnwinders::GetUnwindPlanAtCallSite().
+  if (m_eh_frame_up && !m_object_file_unwind_up && !m_debug_frame_up)
+    m_compiled_unwind_up =
+        std::make_unique<CompiledUnwindTable>(*m_eh_frame_up);
 }
 
 UnwindTable::~UnwindTable() {}
@@ -111,37 +123,48 @@ llvm::Optional<AddressRange> UnwindTable::GetAddressRange(const Address &addr,
   return llvm::None;
 }
 
+FuncUnwindersSP UnwindTable::FindFuncUnwinders(const Address &addr) {
+  // There is an UnwindTable per object file, so we can safely use file handles
+  addr_t file_addr = addr.GetFileAddress();
+  if (m_unwinds.empty())
+    return nullptr;
+
+  const_iterator pos = m_unwinds.lower_bound(file_addr);
+  if ((pos == m_unwinds.end()) ||
+      (pos != m_unwinds.begin() &&
+       pos->second->GetFunctionStartAddress() != addr))
+    --pos;
+
+  if (pos->second->ContainsAddress(addr))
+    return pos->second;
+  return nullptr;
+}
+
 FuncUnwindersSP
 UnwindTable::GetFuncUnwindersContainingAddress(const Address &addr,
                                                SymbolContext &sc) {
   Initialize();
 
-  std::lock_guard<std::mutex> guard(m_mutex);
-
-  // There is an UnwindTable per object file, so we can safely use file handles
-  addr_t file_addr = addr.GetFileAddress();
-  iterator end = m_unwinds.end();
-  iterator insert_pos = end;
-  if (!m_unwinds.empty()) {
-    insert_pos = m_unwinds.lower_bound(file_addr);
-    iterator pos = insert_pos;
-    if ((pos == m_unwinds.end()) ||
-        (pos != m_unwinds.begin() &&
-         pos->second->GetFunctionStartAddress() != addr))
-      --pos;
-
-    if (pos->second->ContainsAddress(addr))
-      return pos->second;
+  {
+    llvm::sys::ScopedReader guard(m_mutex);
+    if (FuncUnwindersSP func_unwinder_sp = FindFuncUnwinders(addr))
+      return func_unwinder_sp;
   }
 
+  // Computing the range of the function doesn't need the lock, so that other
+  // threads can keep using the table in the meantime.
   auto range_or = GetAddressRange(addr, sc);
   if (!range_or)
     return nullptr;
 
+  llvm::sys::ScopedWriter guard(m_mutex);
+  // Another thread may have added the function while the lock wasn't held.
+  if (FuncUnwindersSP func_unwinder_sp = FindFuncUnwinders(addr))
+    return func_unwinder_sp;
+
   FuncUnwindersSP func_unwinder_sp(new FuncUnwinders(*this, *range_or));
-  m_unwinds.insert(insert_pos,
-                   std::make_pair(range_or->GetBaseAddress().GetFileAddress(),
-                                  func_unwinder_sp));
+  m_unwinds.emplace(range_or->GetBaseAddress().GetFileAddress(),
+                    func_unwinder_sp);
   return func_unwinder_sp;
 }
 
@@ -162,7 +185,7 @@ UnwindTable::GetUncachedFuncUnwindersContainingAddress(const Address &addr,
 }
 
 void UnwindTable::Dump(Stream &s) {
-  std::lock_guard<std::mutex> guard(m_mutex);
+  llvm::sys::ScopedReader guard(m_mutex);
   s.Format("UnwindTable for '{0}':\n", m_module.GetFileSpec());
   const_iterator begin = m_unwinds.begin();
   const_iterator end = m_unwinds.end();
@@ -188,6 +211,11 @@ DWARFCallFrameInfo *UnwindTable::GetDebugFrameInfo() {
   return m_debug_frame_up.get();
 }
 
+CompiledUnwindTable *UnwindTable::GetCompiledUnwindTable() {
+  Initialize();
+  return m_compiled_unwind_up.get();
+}
+
 CompactUnwindInfo *UnwindTable::GetCompactUnwindInfo() {
   Initialize();
   return m_compact_unwind_up.get();
@@ -62,12 +62,14 @@
 #include "lldb/Target/ThreadPlanCallFunction.h"
 #include "lldb/Target/ThreadPlanStack.h"
 #include "lldb/Target/UnixSignals.h"
+#include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/Event.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/NameMatches.h"
 #include "lldb/Utility/ProcessInfo.h"
 #include "lldb/Utility/SelectHelper.h"
 #include "lldb/Utility/State.h"
+#include "lldb/Utility/StringScan.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -1930,10 +1932,9 @@ size_t Process::ReadStringFromMemory(addr_t addr, char *dst, size_t max_bytes,
     memset(dst, 0, max_bytes);
     size_t bytes_left = max_bytes - type_width;
 
-    const char terminator[4] = {'\0', '\0', '\0', '\0'};
-    assert(sizeof(terminator) >= type_width && "Attempting to validate a "
-                                               "string with more than 4 bytes "
-                                               "per character!");
+    assert((type_width == 1 || type_width == 2 || type_width == 4) &&
+           "Attempting to validate a string with an unsupported number of "
+           "bytes per character!");
 
     addr_t curr_addr = addr;
     const size_t cache_line_size = m_memory_cache.GetMemoryCacheLineSize();
@@ -1953,12 +1954,14 @@ size_t Process::ReadStringFromMemory(addr_t addr, char *dst, size_t max_bytes,
       // Search for a null terminator of correct size and alignment in
       // bytes_read
       size_t aligned_start = total_bytes_read - total_bytes_read % type_width;
-      for (size_t i = aligned_start;
-           i + type_width <= total_bytes_read + bytes_read; i += type_width)
-        if (::memcmp(&dst[i], terminator, type_width) == 0) {
-          error.Clear();
-          return i;
-        }
+      llvm::ArrayRef<uint8_t> bytes(
+          reinterpret_cast<const uint8_t *>(dst) + aligned_start,
+          total_bytes_read + bytes_read - aligned_start);
+      size_t terminator_offset = FindStringTerminator(bytes, type_width);
+      if (terminator_offset + type_width <= bytes.size()) {
+        error.Clear();
+        return aligned_start + terminator_offset;
+      }
 
       total_bytes_read += bytes_read;
       curr_dst += bytes_read;
@@ -2044,6 +2047,18 @@ size_t Process::ReadMemoryFromInferior(addr_t addr, void *buf, size_t size,
   return bytes_read;
 }
 
+bool Process::PrefetchMemory(addr_t addr, size_t size, Status &error) {
+  error.Clear();
+  if (GetDisableMemoryCache() || size == 0)
+    return false;
+
+  DataBufferSP data_sp(new DataBufferHeap(size, 0));
+  if (ReadMemoryFromInferior(addr, data_sp->GetBytes(), size, error) != size)
+    return false;
+  m_memory_cache.AddL1CacheData(addr, data_sp);
+  return true;
+}
+
 uint64_t Process::ReadUnsignedIntegerFromMemory(lldb::addr_t vm_addr,
                                                 size_t integer_byte_size,
                                                 uint64_t fail_value,
@@ -2981,6 +2996,10 @@ Status Process::PrivateResume() {
   // filters before resuming.
   UpdateAutomaticSignalFiltering();
 
+  // Breakpoints whose conditions changed must not be filtered by the process
+  // anymore, as it won't report the hits the new conditions would stop at.
+  UpdateBreakpointSiteConditions();
+
   Status error(WillResume());
   // Tell the process it is about to resume before the thread list
   if (error.Success()) {
@@ -5952,6 +5971,36 @@ Status Process::UpdateAutomaticSignalFiltering() {
   return Status();
 }
 
+void Process::UpdateBreakpointSiteConditions() {
+  if (!SupportsBreakpointSiteConditions())
+    return;
+
+  std::vector<lldb::break_id_t> stale_site_ids;
+  m_breakpoint_site_list.ForEach([&](BreakpointSite *bp_site) {
+    if (bp_site->GetAgentConditions().empty())
+      return;
+    const size_t num_owners = bp_site->GetNumberOfOwners();
+    for (size_t i = 0; i < num_owners; ++i) {
+      BreakpointLocationSP location_sp = bp_site->GetOwnerAtIndex(i);
+      if (!location_sp || !location_sp->HasCurrentAgentCondition()) {
+        stale_site_ids.push_back(bp_site->GetID());
+        return;
+      }
+    }
+  });
+
+  Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_BREAKPOINTS));
+  for (lldb::break_id_t site_id : stale_site_ids) {
+    BreakpointSiteSP bp_site_sp = m_breakpoint_site_list.FindByID(site_id);
+    if (!bp_site_sp)
+      continue;
+    Status error = SetBreakpointSiteConditions(*bp_site_sp, {});
+    LLDB_LOGF(log, "Process::%s cleared the conditions of site %d: %s",
+              __FUNCTION__, site_id,
+              error.Success() ? "success" : error.AsCString());
+  }
+}
+
 UtilityFunction *Process::GetLoadImageUtilityFunction(
     Platform *platform,
     llvm::function_ref<std::unique_ptr<UtilityFunction>()> factory) {
@@ -14,6 +14,7 @@
 #include "lldb/Expression/DWARFExpression.h"
 #include "lldb/Symbol/ArmUnwindInfo.h"
 #include "lldb/Symbol/CallFrameInfo.h"
+#include "lldb/Symbol/CompiledUnwindTable.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
 #include "lldb/Symbol/FuncUnwinders.h"
 #include "lldb/Symbol/Function.h"
@@ -647,17 +648,44 @@ UnwindPlanSP RegisterContextUnwind::GetFastUnwindPlanForFrame() {
   if (IsFrameZero())
     return unwind_plan_sp;
 
+  // If we're in _sigtramp(), unwinding past this frame requires special
+  // knowledge.
+  if (m_frame_type == eTrapHandlerFrame || m_frame_type == eDebuggerFrame)
+    return unwind_plan_sp;
+
+  // A frame whose callee was a regular function is stopped at a call site,
+  // where the module's compiled eh_frame rules usually apply. Looking them up
+  // is much cheaper than creating the FuncUnwinders of the function, which
+  // remains available through the full UnwindPlan if these rules turn out to
+  // be insufficient.
+  RegisterContextUnwind::SharedPtr next_frame = GetNextFrame();
+  if (next_frame && next_frame->m_frame_type != eTrapHandlerFrame &&
+      next_frame->m_frame_type != eDebuggerFrame) {
+    if (CompiledUnwindTable *compiled_unwind =
+            pc_module_sp->GetUnwindTable().GetCompiledUnwindTable()) {
+      // The return address is right after the call instruction, which might
+      // be the last one of the function. Unless the pc was already backed up
+      // to find the function, look up the rules of the call instruction.
+      Address call_site_addr = m_current_pc;
+      if (!m_sym_ctx_valid ||
+          m_current_offset_backed_up_one == m_current_offset)
+        call_site_addr.Slide(-1);
+      unwind_plan_sp = compiled_unwind->GetUnwindPlanAtCallSite(call_site_addr);
+      if (unwind_plan_sp) {
+        UnwindLogMsgVerbose("frame uses %s for fast UnwindPlan",
+                            unwind_plan_sp->GetSourceName().GetCString());
+        m_frame_type = eNormalFrame;
+        return unwind_plan_sp;
+      }
+    }
+  }
+
   FuncUnwindersSP func_unwinders_sp(
       pc_module_sp->GetUnwindTable().GetFuncUnwindersContainingAddress(
           m_current_pc, m_sym_ctx));
   if (!func_unwinders_sp)
     return unwind_plan_sp;
 
-  // If we're in _sigtramp(), unwinding past this frame requires special
-  // knowledge.
-  if (m_frame_type == eTrapHandlerFrame || m_frame_type == eDebuggerFrame)
-    return unwind_plan_sp;
-
   unwind_plan_sp = func_unwinders_sp->GetUnwindPlanFastUnwind(
       *m_thread.CalculateTarget(), m_thread);
   if (unwind_plan_sp) {
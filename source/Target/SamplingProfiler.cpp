@@ -0,0 +1,312 @@
+//===-- SamplingProfiler.cpp ----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Target/SamplingProfiler.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/StackFrame.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+#include "lldb/Target/UnwindFramePointer.h"
+#include "lldb/Utility/Listener.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
+#include "lldb/Utility/State.h"
+#include "lldb/Utility/Stream.h"
+
+#include "llvm/ADT/StringMap.h"
+
+#include <algorithm>
+
+using namespace lldb;
+using namespace lldb_private;
+
+Status SamplingProfiler::Profile(Process &process, const Options &options) {
+  if (!StateIsStoppedState(process.GetState(), /*must_exist*/ true))
+    return Status("the process must be stopped to be profiled");
+
+  m_interval = options.interval;
+  m_stopped_early = false;
+
+  // The state changes of the samples are hidden from the debugger, which
+  // only gets the last stop event once the profile is complete.
+  ListenerSP listener_sp(
+      Listener::MakeListener("lldb.process.profile_listener"));
+  process.HijackProcessEvents(listener_sp);
+
+  Status error;
+  EventSP event_sp;
+  for (uint32_t i = 0; i < options.sample_count; i++) {
+    error = process.Resume();
+    if (error.Fail())
+      break;
+
+    // Anything that stops the process before the end of the interval, like a
+    // breakpoint or the process exiting, ends the profile.
+    StateType state = process.WaitForProcessToStop(options.interval,
+                                                   &event_sp, true,
+                                                   listener_sp);
+    if (state != eStateInvalid) {
+      m_stopped_early = true;
+      break;
+    }
+
+    auto pause_start = std::chrono::steady_clock::now();
+    process.SendAsyncInterrupt();
+    state = process.WaitForProcessToStop(std::chrono::seconds(10), &event_sp,
+                                         true, listener_sp);
+    if (state == eStateInvalid) {
+      error.SetErrorString("timed out interrupting the process");
+      break;
+    }
+    if (!StateIsStoppedState(state, /*must_exist*/ true)) {
+      m_stopped_early = true;
+      break;
+    }
+
+    CollectStacks(process, options);
+    AddPause(std::chrono::steady_clock::now() - pause_start);
+  }
+
+  process.RestoreProcessEvents();
+  if (event_sp)
+    process.BroadcastEvent(event_sp);
+  return error;
+}
+
+void SamplingProfiler::CollectStacks(Process &process,
+                                     const Options &options) {
+  Target &target = process.GetTarget();
+  std::vector<addr_t> addresses;
+  std::vector<Frame> frames;
+  for (ThreadSP thread_sp : process.Threads()) {
+    addresses.clear();
+    if (options.use_frame_pointers) {
+      llvm::Expected<std::vector<addr_t>> pcs =
+          UnwindFramePointer::GetBacktrace(*thread_sp, options.max_depth);
+      if (!pcs) {
+        LLDB_LOG_ERROR(GetLogIfAllCategoriesSet(LIBLLDB_LOG_UNWIND),
+                       pcs.takeError(), "thread {1:x}: {0}",
+                       thread_sp->GetID());
+        continue;
+      }
+      addresses = std::move(*pcs);
+    } else {
+      // Inlined frames share the pc of their concrete frame and only the
+      // latter is collected.
+      for (uint32_t idx = 0; addresses.size() < options.max_depth; idx++) {
+        StackFrameSP frame_sp = thread_sp->GetStackFrameAtIndex(idx);
+        if (!frame_sp)
+          break;
+        if (!frame_sp->IsInlined())
+          addresses.push_back(
+              frame_sp->GetFrameCodeAddress().GetLoadAddress(&target));
+      }
+    }
+
+    // Return addresses may be right past the end of a function ending with a
+    // call, so the frames above frame zero are symbolized with the call
+    // instruction.
+    frames.clear();
+    for (size_t i = 0; i < addresses.size(); i++) {
+      if (addresses[i] == LLDB_INVALID_ADDRESS)
+        break;
+      addr_t address = i == 0 ? addresses[i] : addresses[i] - 1;
+      auto it = m_frame_names.find(address);
+      frames.push_back(
+          {address, it != m_frame_names.end()
+                        ? it->second
+                        : target.SymbolizeLoadAddress(addresses[i], i != 0)});
+    }
+    AddStack(frames);
+  }
+}
+
+void SamplingProfiler::AddStack(llvm::ArrayRef<Frame> frames) {
+  if (frames.empty())
+    return;
+  std::vector<addr_t> stack;
+  stack.reserve(frames.size());
+  for (const Frame &frame : frames) {
+    stack.push_back(frame.address);
+    m_frame_names.emplace(frame.address, frame.name);
+  }
+  m_stacks[std::move(stack)]++;
+}
+
+void SamplingProfiler::AddPause(std::chrono::nanoseconds pause) {
+  m_pauses.push_back(pause);
+}
+
+void SamplingProfiler::DumpFoldedStacks(Stream &s) const {
+  // Different addresses of the same functions fold into the same line.
+  std::map<std::string, uint64_t> folded_stacks;
+  for (const auto &entry : m_stacks) {
+    std::string folded;
+    for (addr_t address : llvm::reverse(entry.first)) {
+      if (!folded.empty())
+        folded += ';';
+      folded += m_frame_names.find(address)->second;
+    }
+    folded_stacks[folded] += entry.second;
+  }
+
+  for (const auto &entry : folded_stacks)
+    s.Printf("%s %" PRIu64 "\n", entry.first.c_str(), entry.second);
+}
+
+namespace {
+/// A minimal encoder for the protocol buffer messages of pprof profiles.
+class ProtobufMessage {
+public:
+  void AddVarint(uint32_t field, uint64_t value) {
+    AppendVarint(field << 3);
+    AppendVarint(value);
+  }
+
+  void AddBytes(uint32_t field, llvm::StringRef bytes) {
+    AppendVarint(field << 3 | 2);
+    AppendVarint(bytes.size());
+    m_buffer.append(bytes.begin(), bytes.end());
+  }
+
+  void AddMessage(uint32_t field, const ProtobufMessage &message) {
+    AddBytes(field, message.m_buffer);
+  }
+
+  void AddPackedVarints(uint32_t field, llvm::ArrayRef<uint64_t> values) {
+    ProtobufMessage packed;
+    for (uint64_t value : values)
+      packed.AppendVarint(value);
+    AddMessage(field, packed);
+  }
+
+  llvm::StringRef GetBuffer() const { return m_buffer; }
+
+private:
+  void AppendVarint(uint64_t value) {
+    do {
+      uint8_t byte = value & 0x7f;
+      value >>= 7;
+      if (value)
+        byte |= 0x80;
+      m_buffer.push_back(byte);
+    } while (value);
+  }
+
+  std::string m_buffer;
+};
+
+/// The string table of a profile, whose first string must be empty.
+class StringTable {
+public:
+  StringTable() { GetIndex(""); }
+
+  uint64_t GetIndex(llvm::StringRef str) {
+    auto it = m_indexes.try_emplace(str, m_strings.size());
+    if (it.second)
+      m_strings.push_back(str.str());
+    return it.first->second;
+  }
+
+  llvm::ArrayRef<std::string> GetStrings() const { return m_strings; }
+
+private:
+  llvm::StringMap<uint64_t> m_indexes;
+  std::vector<std::string> m_strings;
+};
+} // namespace
+
+// The field numbers are the ones of the Profile message and its submessages
+// in profile.proto, see https://github.com/google/pprof.
+void SamplingProfiler::WritePprof(Stream &s) const {
+  ProtobufMessage profile;
+  StringTable strings;
+
+  ProtobufMessage sample_type;
+  sample_type.AddVarint(/*type*/ 1, strings.GetIndex("samples"));
+  sample_type.AddVarint(/*unit*/ 2, strings.GetIndex("count"));
+  profile.AddMessage(/*sample_type*/ 1, sample_type);
+
+  // Locations are numbered after the frame addresses and functions after
+  // their names, starting at 1.
+  std::map<addr_t, uint64_t> location_ids;
+  std::map<std::string, uint64_t> function_ids;
+  for (const auto &entry : m_frame_names) {
+    location_ids.emplace(entry.first, location_ids.size() + 1);
+    function_ids.emplace(entry.second, 0);
+  }
+  uint64_t next_function_id = 1;
+  for (auto &entry : function_ids)
+    entry.second = next_function_id++;
+
+  for (const auto &entry : m_stacks) {
+    std::vector<uint64_t> ids;
+    for (addr_t address : entry.first)
+      ids.push_back(location_ids[address]);
+    ProtobufMessage sample;
+    sample.AddPackedVarints(/*location_id*/ 1, ids);
+    sample.AddPackedVarints(/*value*/ 2, {entry.second});
+    profile.AddMessage(/*sample*/ 2, sample);
+  }
+
+  for (const auto &entry : location_ids) {
+    ProtobufMessage line;
+    line.AddVarint(/*function_id*/ 1,
+                   function_ids[m_frame_names.find(entry.first)->second]);
+    ProtobufMessage location;
+    location.AddVarint(/*id*/ 1, entry.second);
+    location.AddVarint(/*address*/ 3, entry.first);
+    location.AddMessage(/*line*/ 4, line);
+    profile.AddMessage(/*location*/ 4, location);
+  }
+
+  for (const auto &entry : function_ids) {
+    ProtobufMessage function;
+    function.AddVarint(/*id*/ 1, entry.second);
+    function.AddVarint(/*name*/ 2, strings.GetIndex(entry.first));
+    profile.AddMessage(/*function*/ 5, function);
+  }
+
+  ProtobufMessage period_type;
+  period_type.AddVarint(/*type*/ 1, strings.GetIndex("wall"));
+  period_type.AddVarint(/*unit*/ 2, strings.GetIndex("nanoseconds"));
+  uint64_t period =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(m_interval)
+          .count();
+
+  // The string table has to be complete before it's written.
+  for (const std::string &str : strings.GetStrings())
+    profile.AddBytes(/*string_table*/ 6, str);
+  profile.AddVarint(/*duration_nanos*/ 10, period * m_pauses.size());
+  profile.AddMessage(/*period_type*/ 11, period_type);
+  profile.AddVarint(/*period*/ 12, period);
+
+  llvm::StringRef buffer = profile.GetBuffer();
+  s.Write(buffer.data(), buffer.size());
+}
+
+void SamplingProfiler::DumpStatistics(Stream &s) const {
+  uint64_t stack_count = 0;
+  for (const auto &entry : m_stacks)
+    stack_count += entry.second;
+  s.Printf("%zu samples, %" PRIu64 " stacks (%zu distinct)\n", m_pauses.size(),
+           stack_count, m_stacks.size());
+  if (m_pauses.empty())
+    return;
+
+  std::chrono::nanoseconds total(0);
+  for (std::chrono::nanoseconds pause : m_pauses)
+    total += pause;
+  auto ToMilliseconds = [](std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+  s.Printf("pause time per sample: min %.3f ms, avg %.3f ms, max %.3f ms\n",
+           ToMilliseconds(*std::min_element(m_pauses.begin(), m_pauses.end())),
+           ToMilliseconds(total / m_pauses.size()),
+           ToMilliseconds(*std::max_element(m_pauses.begin(), m_pauses.end())));
+}
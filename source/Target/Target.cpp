@@ -31,6 +31,7 @@
 #include "lldb/Expression/ExpressionVariable.h"
 #include "lldb/Expression/REPL.h"
 #include "lldb/Expression/UserExpression.h"
+#include "lldb/Expression/UserExpressionCache.h"
 #include "lldb/Expression/UtilityFunction.h"
 #include "lldb/Host/Host.h"
 #include "lldb/Host/PosixApi.h"
@@ -60,6 +61,7 @@
 #include "lldb/Utility/Timer.h"
 
 #include "llvm/ADT/ScopeExit.h"
+#include "llvm/Support/FormatVariadic.h"
 
 #include <memory>
 #include <mutex>
@@ -99,6 +101,7 @@ Target::Target(Debugger &debugger, const ArchSpec &target_arch,
       m_is_dummy_target(is_dummy_target),
       m_frame_recognizer_manager_up(
           std::make_unique<StackFrameRecognizerManager>()),
+      m_user_expression_cache_up(std::make_unique<UserExpressionCache>()),
       m_stats_storage(static_cast<int>(StatisticKind::StatisticMax))
 
 {
@@ -181,6 +184,8 @@ void Target::CleanupProcess() {
   DisableAllWatchpoints(false);
   ClearAllWatchpointHitCounts();
   ClearAllWatchpointHistoricValues();
+  // The cached expressions are tied to the process they were compiled for.
+  m_user_expression_cache_up->Clear();
 }
 
 void Target::DeleteCurrentProcess() {
@@ -282,6 +287,7 @@ void Target::Destroy() {
   m_stop_hooks.clear();
   m_stop_hook_next_id = 0;
   m_suppress_stop_hooks = false;
+  m_user_expression_cache_up->Clear();
 }
 
 BreakpointList &Target::GetBreakpointList(bool internal) {
@@ -1617,6 +1623,7 @@ void Target::ModulesDidLoad(ModuleList &module_list) {
       ModuleSP module_sp(module_list.GetModuleAtIndex(idx));
       LoadScriptingResourceForModule(module_sp, this);
     }
+    m_user_expression_cache_up->Clear();
     m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
     m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
     if (m_process_sp) {
@@ -1629,6 +1636,7 @@ void Target::ModulesDidLoad(ModuleList &module_list) {
 
 void Target::SymbolsDidLoad(ModuleList &module_list) {
   if (m_valid && module_list.GetSize()) {
+    m_user_expression_cache_up->Clear();
     if (m_process_sp) {
       for (LanguageRuntime *runtime : m_process_sp->GetLanguageRuntimes()) {
         runtime->SymbolsDidLoad(module_list);
@@ -1645,6 +1653,7 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
   if (m_valid && module_list.GetSize()) {
     UnloadModuleSections(module_list);
+    m_user_expression_cache_up->Clear();
     m_breakpoint_list.UpdateBreakpoints(module_list, false, delete_locations);
     m_internal_breakpoint_list.UpdateBreakpoints(module_list, false,
                                                  delete_locations);
@@ -2819,6 +2828,25 @@ bool Target::ResolveLoadAddress(addr_t load_addr, Address &so_addr,
   return m_section_load_history.ResolveLoadAddress(stop_id, load_addr, so_addr);
 }
 
+std::string Target::SymbolizeLoadAddress(addr_t load_addr,
+                                         bool is_return_address) {
+  Address so_addr;
+  ModuleSP module_sp;
+  addr_t lookup_addr = is_return_address ? load_addr - 1 : load_addr;
+  if (ResolveLoadAddress(lookup_addr, so_addr))
+    module_sp = so_addr.GetModule();
+  if (!module_sp)
+    return llvm::formatv("{0:x}", load_addr);
+
+  llvm::StringRef module_name =
+      module_sp->GetFileSpec().GetFilename().GetStringRef();
+  ConstString function_name =
+      module_sp->GetFunctionNameAtFileAddress(so_addr.GetFileAddress());
+  if (function_name)
+    return llvm::formatv("{0}`{1}", module_name, function_name);
+  return llvm::formatv("{0}`{1:x}", module_name, load_addr);
+}
+
 bool Target::ResolveFileAddress(lldb::addr_t file_addr,
                                 Address &resolved_addr) {
   return m_images.ResolveFileAddress(file_addr, resolved_addr);
@@ -4013,6 +4041,12 @@ bool TargetProperties::GetEnableNotifyAboutFixIts() const {
       nullptr, idx, g_target_properties[idx].default_uint_value != 0);
 }
 
+bool TargetProperties::GetEnableExpressionCache() const {
+  const uint32_t idx = ePropertyExpressionCache;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 bool TargetProperties::GetEnableSaveObjects() const {
   const uint32_t idx = ePropertySaveObjects;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
@@ -4025,6 +4059,12 @@ bool TargetProperties::GetEnableSyntheticValue() const {
       nullptr, idx, g_target_properties[idx].default_uint_value != 0);
 }
 
+bool TargetProperties::GetIncrementalValueUpdates() const {
+  const uint32_t idx = ePropertyIncrementalValueUpdates;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 uint32_t TargetProperties::GetMaxZeroPaddingInFloatFormat() const {
   const uint32_t idx = ePropertyMaxZeroPaddingInFloatFormat;
   return m_collection_sp->GetPropertyAtIndexAsUInt64(
@@ -4043,6 +4083,25 @@ uint32_t TargetProperties::GetMaximumSizeOfStringSummary() const {
       nullptr, idx, g_target_properties[idx].default_uint_value);
 }
 
+std::chrono::milliseconds TargetProperties::GetMaximumValuePrintTime() const {
+  const uint32_t idx = ePropertyMaxValuePrintTime;
+  return std::chrono::milliseconds(
+      m_collection_sp->GetPropertyAtIndexAsUInt64(
+          nullptr, idx, g_target_properties[idx].default_uint_value));
+}
+
+uint64_t TargetProperties::GetMaximumValuePrintBytes() const {
+  const uint32_t idx = ePropertyMaxValuePrintBytes;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_target_properties[idx].default_uint_value);
+}
+
+uint64_t TargetProperties::GetMaximumValuePrintValues() const {
+  const uint32_t idx = ePropertyMaxValuePrintValues;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_target_properties[idx].default_uint_value);
+}
+
 uint32_t TargetProperties::GetMaximumMemReadSize() const {
   const uint32_t idx = ePropertyMaxMemReadSize;
   return m_collection_sp->GetPropertyAtIndexAsSInt64(
@@ -4109,6 +4168,18 @@ uint64_t TargetProperties::GetExprErrorLimit() const {
       nullptr, idx, g_target_properties[idx].default_uint_value);
 }
 
+uint64_t TargetProperties::GetExprInterpreterInstructionLimit() const {
+  const uint32_t idx = ePropertyExprInterpreterInstructionLimit;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_target_properties[idx].default_uint_value);
+}
+
+bool TargetProperties::GetExprPrecompilePrefix() const {
+  const uint32_t idx = ePropertyExprPrecompilePrefix;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_target_properties[idx].default_uint_value != 0);
+}
+
 bool TargetProperties::GetBreakpointsConsultPlatformAvoidList() {
   const uint32_t idx = ePropertyBreakpointUseAvoidList;
   return m_collection_sp->GetPropertyAtIndexAsBoolean(
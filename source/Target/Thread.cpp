@@ -42,6 +42,7 @@
 #include "lldb/Target/ThreadPlanStepThrough.h"
 #include "lldb/Target/ThreadPlanStepUntil.h"
 #include "lldb/Target/ThreadSpec.h"
+#include "lldb/Target/UnwindFramePointer.h"
 #include "lldb/Target/UnwindLLDB.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/RegularExpression.h"
@@ -152,6 +153,12 @@ uint64_t ThreadProperties::GetMaxBacktraceDepth() const {
       nullptr, idx, g_thread_properties[idx].default_uint_value != 0);
 }
 
+bool ThreadProperties::GetFramePointerUnwind() const {
+  const uint32_t idx = ePropertyFramePointerUnwind;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_thread_properties[idx].default_uint_value != 0);
+}
+
 // Thread Event Data
 
 ConstString Thread::ThreadEventData::GetFlavorString() {
@@ -1434,6 +1441,15 @@ StackFrameListSP Thread::GetStackFrameList() {
 void Thread::ClearStackFrames() {
   std::lock_guard<std::recursive_mutex> guard(m_frame_mutex);
 
+  // The frames made by the previous unwinder may reference it and can't be
+  // compared with the ones of the new unwinder, so they go away with it.
+  if (m_unwinder_up && m_unwinder_is_frame_pointer != eLazyBoolCalculate &&
+      (m_unwinder_is_frame_pointer == eLazyBoolYes) !=
+          GetFramePointerUnwind()) {
+    m_curr_frames_sp.reset();
+    m_prev_frames_sp.reset();
+    m_unwinder_up.reset();
+  }
   GetUnwinder().Clear();
 
   // Only store away the old "reference" StackFrameList if we got all its
@@ -1868,8 +1884,15 @@ size_t Thread::GetStackFrameStatus(Stream &strm, uint32_t first_frame,
 }
 
 Unwind &Thread::GetUnwinder() {
-  if (!m_unwinder_up)
-    m_unwinder_up = std::make_unique<UnwindLLDB>(*this);
+  if (!m_unwinder_up) {
+    if (GetFramePointerUnwind()) {
+      m_unwinder_is_frame_pointer = eLazyBoolYes;
+      m_unwinder_up = std::make_unique<UnwindFramePointer>(*this);
+    } else {
+      m_unwinder_is_frame_pointer = eLazyBoolNo;
+      m_unwinder_up = std::make_unique<UnwindLLDB>(*this);
+    }
+  }
   return *m_unwinder_up;
 }
 
@@ -18,6 +18,9 @@
 #include "lldb/Utility/LLDBAssert.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/State.h"
+#include "lldb/Utility/Timer.h"
+
+#include "llvm/Support/ThreadPool.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -745,6 +748,56 @@ void ThreadList::Flush() {
     (*pos)->Flush();
 }
 
+static void UnwindThread(Thread &thread, uint32_t num_frames) {
+  if (num_frames == UINT32_MAX)
+    thread.GetStackFrameCount();
+  else
+    thread.GetStackFrameAtIndex(num_frames - 1);
+}
+
+void ThreadList::ComputeStackFrames(llvm::ArrayRef<lldb::tid_t> tids,
+                                    uint32_t num_frames) {
+  if (num_frames == 0)
+    return;
+  LLDB_SCOPED_TIMER();
+
+  // Don't hold the thread list mutex while the workers run, the unwinders may
+  // need it.
+  std::vector<ThreadSP> threads;
+  {
+    std::lock_guard<std::recursive_mutex> guard(GetMutex());
+    for (lldb::tid_t tid : tids)
+      if (ThreadSP thread_sp = FindThreadByID(tid, /*can_update*/ false))
+        threads.push_back(thread_sp);
+  }
+
+  // Create the lazily initialized parts of the process that the unwinders
+  // share before they run concurrently.
+  m_process->GetABI();
+  m_process->GetDynamicLoader();
+
+  // Finding the frame zero of a thread may need its stop info and inlined
+  // depth, which in turn can look at the other threads, so do it here. The
+  // rest of the walk only reads memory and the unwind information of the
+  // modules, which is safe to do for several threads at once.
+  for (const ThreadSP &thread_sp : threads)
+    thread_sp->GetStackFrameAtIndex(0);
+  if (num_frames == 1)
+    return;
+
+  if (threads.size() < 2) {
+    for (const ThreadSP &thread_sp : threads)
+      UnwindThread(*thread_sp, num_frames);
+    return;
+  }
+
+  llvm::ThreadPool pool(llvm::optimal_concurrency(threads.size()));
+  for (const ThreadSP &thread_sp : threads)
+    pool.async(
+        [thread_sp, num_frames] { UnwindThread(*thread_sp, num_frames); });
+  pool.wait();
+}
+
 std::recursive_mutex &ThreadList::GetMutex() const {
   return m_process->m_thread_mutex;
 }
@@ -0,0 +1,203 @@
+//===-- UnwindFramePointer.cpp --------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Target/UnwindFramePointer.h"
+#include "Plugins/Process/Utility/RegisterContextHistory.h"
+#include "lldb/Target/ABI.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StackFrame.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
+#include "lldb/Utility/Status.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+/// The stack is read in blocks of this size, aligned to it. The page
+/// containing a valid frame pointer is always readable, so the blocks never
+/// need to be read partially.
+static const addr_t g_stack_block_size = 4096;
+
+UnwindFramePointer::UnwindFramePointer(Thread &thread) : Unwind(thread) {}
+
+llvm::Expected<std::vector<addr_t>>
+UnwindFramePointer::GetBacktrace(Thread &thread, uint32_t max_frames) {
+  UnwindFramePointer unwinder(thread);
+  if (llvm::Error error = unwinder.Initialize())
+    return std::move(error);
+  if (max_frames > 0)
+    unwinder.UnwindUpTo(max_frames - 1);
+
+  std::vector<addr_t> pcs;
+  pcs.reserve(std::min<size_t>(unwinder.m_frames.size(), max_frames));
+  for (const Frame &frame : unwinder.m_frames) {
+    if (pcs.size() == max_frames)
+      break;
+    pcs.push_back(frame.pc);
+  }
+  return pcs;
+}
+
+void UnwindFramePointer::DoClear() {
+  m_frames.clear();
+  m_initialized = false;
+  m_complete = false;
+  m_block_addr = LLDB_INVALID_ADDRESS;
+  m_block.clear();
+}
+
+llvm::Error UnwindFramePointer::Initialize() {
+  m_initialized = true;
+  // An architecture that is not supported still gets its frame zero, like
+  // with any other unwinder.
+  m_complete = true;
+
+  ProcessSP process_sp = m_thread.GetProcess();
+  if (!process_sp)
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "invalid process");
+  RegisterContextSP reg_ctx_sp = m_thread.GetRegisterContext();
+  if (!reg_ctx_sp)
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "no register context for thread");
+  addr_t pc = reg_ctx_sp->GetPC();
+  if (pc == LLDB_INVALID_ADDRESS)
+    return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                   "can't read the pc of the thread");
+  m_frames.push_back({LLDB_INVALID_ADDRESS, pc});
+
+  // These are the architectures whose frame records are made of the saved
+  // frame pointer followed by the return address.
+  const ArchSpec &arch = process_sp->GetTarget().GetArchitecture();
+  switch (arch.GetMachine()) {
+  case llvm::Triple::x86:
+  case llvm::Triple::x86_64:
+  case llvm::Triple::aarch64:
+  case llvm::Triple::aarch64_32:
+    break;
+  default:
+    return llvm::createStringError(
+        llvm::inconvertibleErrorCode(),
+        "frame pointer unwinding is not supported for %s",
+        arch.GetArchitectureName());
+  }
+
+  addr_t fp = reg_ctx_sp->GetFP();
+  if (fp == LLDB_INVALID_ADDRESS)
+    return llvm::createStringError(
+        llvm::inconvertibleErrorCode(),
+        "can't read the frame pointer of the thread");
+  m_frames.back().fp = fp;
+  m_addr_size = process_sp->GetAddressByteSize();
+  m_byte_order = process_sp->GetByteOrder();
+  m_complete = false;
+  return llvm::Error::success();
+}
+
+void UnwindFramePointer::UnwindUpTo(uint32_t frame_idx) {
+  if (!m_initialized) {
+    if (llvm::Error error = Initialize()) {
+      Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_UNWIND));
+      LLDB_LOG_ERROR(log, std::move(error),
+                     "thread {1:x}: {0}", m_thread.GetID());
+    }
+  }
+
+  ProcessSP process_sp = m_thread.GetProcess();
+  ABISP abi_sp = process_sp ? process_sp->GetABI() : ABISP();
+  const uint64_t max_frames = m_thread.GetMaxBacktraceDepth();
+  while (!m_complete && m_frames.size() <= frame_idx) {
+    const addr_t fp = m_frames.back().fp;
+    addr_t caller_fp, return_addr;
+    if (m_frames.size() >= max_frames || fp == 0 || fp % m_addr_size != 0 ||
+        !ReadPointer(fp, caller_fp) ||
+        !ReadPointer(fp + m_addr_size, return_addr)) {
+      m_complete = true;
+      break;
+    }
+    if (abi_sp)
+      return_addr = abi_sp->FixCodeAddress(return_addr);
+    if (return_addr == 0) {
+      m_complete = true;
+      break;
+    }
+    m_frames.push_back({caller_fp, return_addr});
+    // The stack grows down, so the frames of the callers must be above the
+    // current one. Anything else is the end of the chain or garbage, and the
+    // frame just added is the last one.
+    if (caller_fp <= fp)
+      m_complete = true;
+  }
+}
+
+bool UnwindFramePointer::ReadPointer(addr_t addr, addr_t &value) {
+  if (m_block_addr == LLDB_INVALID_ADDRESS || addr < m_block_addr ||
+      addr + m_addr_size > m_block_addr + m_block.size()) {
+    ProcessSP process_sp = m_thread.GetProcess();
+    if (!process_sp)
+      return false;
+    m_block_addr = addr & ~(g_stack_block_size - 1);
+    m_block.resize(g_stack_block_size);
+    Status error;
+    size_t bytes_read = process_sp->ReadMemory(m_block_addr, m_block.data(),
+                                               m_block.size(), error);
+    m_block.resize(bytes_read);
+    if (addr + m_addr_size > m_block_addr + m_block.size())
+      return false;
+  }
+
+  DataExtractor data(m_block.data(), m_block.size(), m_byte_order,
+                     m_addr_size);
+  offset_t offset = addr - m_block_addr;
+  value = data.GetAddress(&offset);
+  return true;
+}
+
+uint32_t UnwindFramePointer::DoGetFrameCount() {
+  UnwindUpTo(UINT32_MAX);
+  return m_frames.size();
+}
+
+bool UnwindFramePointer::DoGetFrameInfoAtIndex(
+    uint32_t frame_idx, addr_t &cfa, addr_t &pc,
+    bool &behaves_like_zeroth_frame) {
+  UnwindUpTo(frame_idx);
+  if (frame_idx >= m_frames.size())
+    return false;
+
+  const Frame &frame = m_frames[frame_idx];
+  // The canonical frame address is right above the frame record. A frame
+  // whose frame pointer couldn't be read is identified by its index instead.
+  if (frame.fp == LLDB_INVALID_ADDRESS)
+    cfa = frame_idx;
+  else
+    cfa = frame.fp + 2 * m_addr_size;
+  pc = frame.pc;
+  behaves_like_zeroth_frame = frame_idx == 0;
+  return true;
+}
+
+RegisterContextSP
+UnwindFramePointer::DoCreateRegisterContextForFrame(StackFrame *frame) {
+  if (!frame)
+    return RegisterContextSP();
+  uint32_t frame_idx = frame->GetConcreteFrameIndex();
+  if (frame_idx == 0)
+    return m_thread.GetRegisterContext();
+
+  // The callers only know their pc.
+  UnwindUpTo(frame_idx);
+  if (frame_idx >= m_frames.size())
+    return RegisterContextSP();
+  return std::make_shared<RegisterContextHistory>(
+      m_thread, frame_idx, m_addr_size, m_frames[frame_idx].pc);
+}
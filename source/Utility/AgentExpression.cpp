@@ -0,0 +1,355 @@
+//===-- AgentExpression.cpp -----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/AgentExpression.h"
+
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace lldb;
+using namespace lldb_private;
+
+static llvm::Error MakeError(const char *message, size_t pc) {
+  return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                 "%s at offset %zu", message, pc);
+}
+
+static uint64_t SignExtend(uint64_t value, uint8_t bits) {
+  if (bits == 0 || bits >= 64)
+    return value;
+  return static_cast<uint64_t>(llvm::SignExtend64(value, bits));
+}
+
+static uint64_t ZeroExtend(uint64_t value, uint8_t bits) {
+  if (bits >= 64)
+    return value;
+  return value & llvm::maskTrailingOnes<uint64_t>(bits);
+}
+
+llvm::Expected<uint64_t>
+AgentExpression::Evaluate(llvm::ArrayRef<uint8_t> bytecode,
+                          RegisterReader read_register,
+                          MemoryReader read_memory) {
+  std::vector<uint64_t> stack;
+  size_t pc = 0;
+
+  // Read the big endian operand of the instruction at op_pc.
+  auto read_operand = [&](size_t op_pc,
+                          size_t byte_size) -> llvm::Expected<uint64_t> {
+    if (bytecode.size() - pc < byte_size)
+      return MakeError("truncated instruction", op_pc);
+    uint64_t value = 0;
+    for (size_t i = 0; i < byte_size; ++i)
+      value = (value << 8) | bytecode[pc++];
+    return value;
+  };
+
+  for (size_t steps = 0; steps < kMaxSteps; ++steps) {
+    if (pc >= bytecode.size())
+      return MakeError("missing end instruction", pc);
+    const size_t op_pc = pc;
+    const uint8_t op = bytecode[pc++];
+
+    // Check that the stack holds the operands of the instruction.
+    auto require = [&](size_t count) -> llvm::Error {
+      if (stack.size() < count)
+        return MakeError("stack underflow", op_pc);
+      return llvm::Error::success();
+    };
+    auto push = [&](uint64_t value) -> llvm::Error {
+      if (stack.size() >= kMaxStackSize)
+        return MakeError("stack overflow", op_pc);
+      stack.push_back(value);
+      return llvm::Error::success();
+    };
+
+    switch (op) {
+    case eOpAdd:
+    case eOpSub:
+    case eOpMul:
+    case eOpDivSigned:
+    case eOpDivUnsigned:
+    case eOpRemSigned:
+    case eOpRemUnsigned:
+    case eOpLsh:
+    case eOpRshSigned:
+    case eOpRshUnsigned:
+    case eOpBitAnd:
+    case eOpBitOr:
+    case eOpBitXor:
+    case eOpEqual:
+    case eOpLessSigned:
+    case eOpLessUnsigned: {
+      if (llvm::Error error = require(2))
+        return std::move(error);
+      const uint64_t b = stack.back();
+      stack.pop_back();
+      const uint64_t a = stack.back();
+      const int64_t sa = static_cast<int64_t>(a);
+      const int64_t sb = static_cast<int64_t>(b);
+      uint64_t result = 0;
+      switch (op) {
+      case eOpAdd:
+        result = a + b;
+        break;
+      case eOpSub:
+        result = a - b;
+        break;
+      case eOpMul:
+        result = a * b;
+        break;
+      case eOpDivSigned:
+      case eOpRemSigned:
+        if (b == 0)
+          return MakeError("division by zero", op_pc);
+        // The only signed division that overflows.
+        if (sa == INT64_MIN && sb == -1)
+          result = op == eOpDivSigned ? a : 0;
+        else
+          result = static_cast<uint64_t>(op == eOpDivSigned ? sa / sb
+                                                            : sa % sb);
+        break;
+      case eOpDivUnsigned:
+      case eOpRemUnsigned:
+        if (b == 0)
+          return MakeError("division by zero", op_pc);
+        result = op == eOpDivUnsigned ? a / b : a % b;
+        break;
+      case eOpLsh:
+        result = b >= 64 ? 0 : a << b;
+        break;
+      case eOpRshSigned:
+        result = static_cast<uint64_t>(sa >> (b >= 64 ? 63 : b));
+        break;
+      case eOpRshUnsigned:
+        result = b >= 64 ? 0 : a >> b;
+        break;
+      case eOpBitAnd:
+        result = a & b;
+        break;
+      case eOpBitOr:
+        result = a | b;
+        break;
+      case eOpBitXor:
+        result = a ^ b;
+        break;
+      case eOpEqual:
+        result = a == b;
+        break;
+      case eOpLessSigned:
+        result = sa < sb;
+        break;
+      case eOpLessUnsigned:
+        result = a < b;
+        break;
+      }
+      stack.back() = result;
+      break;
+    }
+
+    case eOpLogNot:
+    case eOpBitNot:
+      if (llvm::Error error = require(1))
+        return std::move(error);
+      stack.back() = op == eOpLogNot ? stack.back() == 0 : ~stack.back();
+      break;
+
+    case eOpExt:
+    case eOpZeroExt: {
+      llvm::Expected<uint64_t> bits = read_operand(op_pc, 1);
+      if (!bits)
+        return bits.takeError();
+      if (llvm::Error error = require(1))
+        return std::move(error);
+      stack.back() = op == eOpExt ? SignExtend(stack.back(), *bits)
+                                  : ZeroExtend(stack.back(), *bits);
+      break;
+    }
+
+    case eOpRef8:
+    case eOpRef16:
+    case eOpRef32:
+    case eOpRef64: {
+      if (llvm::Error error = require(1))
+        return std::move(error);
+      const uint32_t byte_size = 1u << (op - eOpRef8);
+      llvm::Expected<uint64_t> value = read_memory(stack.back(), byte_size);
+      if (!value)
+        return value.takeError();
+      stack.back() = *value;
+      break;
+    }
+
+    case eOpIfGoto:
+    case eOpGoto: {
+      llvm::Expected<uint64_t> target = read_operand(op_pc, 2);
+      if (!target)
+        return target.takeError();
+      bool jump = true;
+      if (op == eOpIfGoto) {
+        if (llvm::Error error = require(1))
+          return std::move(error);
+        jump = stack.back() != 0;
+        stack.pop_back();
+      }
+      if (jump)
+        pc = *target;
+      break;
+    }
+
+    case eOpConst8:
+    case eOpConst16:
+    case eOpConst32:
+    case eOpConst64: {
+      llvm::Expected<uint64_t> value =
+          read_operand(op_pc, 1u << (op - eOpConst8));
+      if (!value)
+        return value.takeError();
+      if (llvm::Error error = push(*value))
+        return std::move(error);
+      break;
+    }
+
+    case eOpReg: {
+      llvm::Expected<uint64_t> reg_num = read_operand(op_pc, 2);
+      if (!reg_num)
+        return reg_num.takeError();
+      llvm::Expected<uint64_t> value = read_register(*reg_num);
+      if (!value)
+        return value.takeError();
+      if (llvm::Error error = push(*value))
+        return std::move(error);
+      break;
+    }
+
+    case eOpEnd:
+      if (stack.empty())
+        return MakeError("empty stack", op_pc);
+      return stack.back();
+
+    case eOpDup:
+      if (llvm::Error error = require(1))
+        return std::move(error);
+      if (llvm::Error error = push(stack.back()))
+        return std::move(error);
+      break;
+
+    case eOpPop:
+      if (llvm::Error error = require(1))
+        return std::move(error);
+      stack.pop_back();
+      break;
+
+    case eOpSwap:
+      if (llvm::Error error = require(2))
+        return std::move(error);
+      std::swap(stack[stack.size() - 1], stack[stack.size() - 2]);
+      break;
+
+    case eOpPick: {
+      llvm::Expected<uint64_t> index = read_operand(op_pc, 1);
+      if (!index)
+        return index.takeError();
+      if (llvm::Error error = require(*index + 1))
+        return std::move(error);
+      if (llvm::Error error = push(stack[stack.size() - 1 - *index]))
+        return std::move(error);
+      break;
+    }
+
+    case eOpRot: {
+      // a b c => c a b
+      if (llvm::Error error = require(3))
+        return std::move(error);
+      std::rotate(stack.end() - 3, stack.end() - 1, stack.end());
+      break;
+    }
+
+    default:
+      return MakeError("unsupported instruction", op_pc);
+    }
+  }
+  return MakeError("too many instructions executed", pc);
+}
+
+void AgentExpression::AppendBigEndian(uint64_t value, size_t byte_size) {
+  for (size_t i = byte_size; i > 0; --i)
+    m_bytecode.push_back(static_cast<uint8_t>(value >> ((i - 1) * 8)));
+}
+
+void AgentExpression::AppendConstant(uint64_t value) {
+  if (llvm::isUInt<8>(value)) {
+    AppendOpcode(eOpConst8);
+    AppendBigEndian(value, 1);
+  } else if (llvm::isUInt<16>(value)) {
+    AppendOpcode(eOpConst16);
+    AppendBigEndian(value, 2);
+  } else if (llvm::isUInt<32>(value)) {
+    AppendOpcode(eOpConst32);
+    AppendBigEndian(value, 4);
+  } else {
+    AppendOpcode(eOpConst64);
+    AppendBigEndian(value, 8);
+  }
+}
+
+void AgentExpression::AppendRegister(uint32_t reg_num) {
+  assert(llvm::isUInt<16>(reg_num) && "register number out of range");
+  AppendOpcode(eOpReg);
+  AppendBigEndian(reg_num, 2);
+}
+
+void AgentExpression::AppendReference(uint32_t byte_size) {
+  switch (byte_size) {
+  case 1:
+    AppendOpcode(eOpRef8);
+    break;
+  case 2:
+    AppendOpcode(eOpRef16);
+    break;
+  case 4:
+    AppendOpcode(eOpRef32);
+    break;
+  default:
+    assert(byte_size == 8 && "unsupported reference size");
+    AppendOpcode(eOpRef64);
+    break;
+  }
+}
+
+void AgentExpression::AppendSignExtend(uint8_t bits) {
+  AppendOpcode(eOpExt);
+  m_bytecode.push_back(bits);
+}
+
+void AgentExpression::AppendZeroExtend(uint8_t bits) {
+  AppendOpcode(eOpZeroExt);
+  m_bytecode.push_back(bits);
+}
+
+size_t AgentExpression::AppendJump(Opcode op) {
+  assert((op == eOpGoto || op == eOpIfGoto) && "not a jump");
+  AppendOpcode(op);
+  const size_t label = m_bytecode.size();
+  AppendBigEndian(0, 2);
+  return label;
+}
+
+void AgentExpression::SetJumpTarget(size_t label) {
+  const size_t target = m_bytecode.size();
+  assert(llvm::isUInt<16>(target) && "expression too large");
+  m_bytecode[label] = static_cast<uint8_t>(target >> 8);
+  m_bytecode[label + 1] = static_cast<uint8_t>(target);
+}
+
+std::vector<uint8_t> AgentExpression::Finish() {
+  AppendOpcode(eOpEnd);
+  return std::move(m_bytecode);
+}
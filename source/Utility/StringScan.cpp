@@ -0,0 +1,95 @@
+//===-- StringScan.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/StringScan.h"
+
+#include <cassert>
+#include <cstring>
+
+using namespace lldb_private;
+
+// The helpers below test the 8 bytes of a word at once, with the usual bit
+// tricks, which work whatever the byte order of the host. A test may be
+// wrong about which lane matches, because of the borrows from the lower
+// lanes, but never about whether one does.
+
+static constexpr uint64_t g_ones = 0x0101010101010101ULL;
+static constexpr uint64_t g_highs = 0x8080808080808080ULL;
+
+static inline uint64_t Load(const uint8_t *data) {
+  uint64_t word;
+  memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+// Non-zero if a byte of \a word is less than \a n, which must be at most 128.
+static inline uint64_t HasByteLessThan(uint64_t word, uint8_t n) {
+  return (word - g_ones * n) & ~word & g_highs;
+}
+
+// Non-zero if a byte of \a word is \a byte.
+static inline uint64_t HasByte(uint64_t word, uint8_t byte) {
+  return HasByteLessThan(word ^ (g_ones * byte), 1);
+}
+
+// Non-zero if a 2 byte lane of \a word is zero.
+static inline uint64_t HasZero16(uint64_t word) {
+  return (word - 0x0001000100010001ULL) & ~word & 0x8000800080008000ULL;
+}
+
+// Non-zero if a 4 byte lane of \a word is zero.
+static inline uint64_t HasZero32(uint64_t word) {
+  return (word - 0x0000000100000001ULL) & ~word & 0x8000000080000000ULL;
+}
+
+static inline bool IsPlainASCII(uint8_t byte) {
+  return byte >= ' ' && byte <= '~' && byte != '"' && byte != '\'' &&
+         byte != '\\';
+}
+
+size_t lldb_private::FindStringTerminator(llvm::ArrayRef<uint8_t> data,
+                                          size_t char_size) {
+  assert((char_size == 1 || char_size == 2 || char_size == 4) &&
+         "unsupported character size");
+  const size_t size = data.size() - data.size() % char_size;
+  const uint8_t *bytes = data.data();
+  if (char_size == 1) {
+    // The C library already scans a word or a vector at a time.
+    const void *zero = memchr(bytes, 0, size);
+    return zero ? static_cast<const uint8_t *>(zero) - bytes : size;
+  }
+
+  uint64_t (*has_zero)(uint64_t) = char_size == 2 ? HasZero16 : HasZero32;
+  size_t offset = 0;
+  while (offset + sizeof(uint64_t) <= size && !has_zero(Load(bytes + offset)))
+    offset += sizeof(uint64_t);
+  // Find the terminator in the word that has one, or in the last bytes.
+  for (; offset < size; offset += char_size) {
+    bool is_zero = true;
+    for (size_t i = 0; i < char_size; ++i)
+      is_zero &= bytes[offset + i] == 0;
+    if (is_zero)
+      return offset;
+  }
+  return size;
+}
+
+size_t lldb_private::GetPlainASCIIPrefixLength(llvm::ArrayRef<uint8_t> data) {
+  const uint8_t *bytes = data.data();
+  const size_t size = data.size();
+  size_t offset = 0;
+  for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+    uint64_t word = Load(bytes + offset);
+    if ((word & g_highs) || HasByteLessThan(word, ' ') || HasByte(word, 0x7f) ||
+        HasByte(word, '"') || HasByte(word, '\'') || HasByte(word, '\\'))
+      break;
+  }
+  while (offset < size && IsPlainASCII(bytes[offset]))
+    ++offset;
+  return offset;
+}
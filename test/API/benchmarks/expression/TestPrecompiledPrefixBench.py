@@ -0,0 +1,60 @@
+"""
+Benchmark parsing repeated expressions with and without a precompiled
+expression prefix.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class PrecompiledPrefixBench(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.count = 200
+
+    def time_expressions(self, frame, precompile):
+        self.runCmd("settings set target.expr-precompile-prefix %s" %
+                    ("true" if precompile else "false"))
+        sw = Stopwatch()
+        for i in range(self.count):
+            # Every expression has a different text, so each of them is
+            # parsed.
+            with sw:
+                value = frame.EvaluateExpression(
+                    "ptr[%d]->point.x + %d" % (i, i))
+            self.assertSuccess(value.GetError())
+        return sw
+
+    @benchmarks_test
+    def test_repeated_expressions(self):
+        """Benchmark repeated expressions with and without a precompiled prefix."""
+        self.build()
+        target, process, thread, bkpt = lldbutil.run_to_source_breakpoint(
+            self, "// Set breakpoint here.", lldb.SBFileSpec("main.cpp"))
+        self.runCmd("settings set target.expression-cache false")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.expression-cache"))
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.expr-precompile-prefix"))
+        frame = thread.GetFrameAtIndex(0)
+
+        # The first expression also pays for loading the debug information,
+        # which is left out of both measurements.
+        self.assertSuccess(frame.EvaluateExpression("ptr[0]->id").GetError())
+
+        parsed = self.time_expressions(frame, precompile=False)
+        precompiled = self.time_expressions(frame, precompile=True)
+
+        print()
+        print("prefix parsed with every expression:", parsed)
+        print("precompiled prefix:", precompiled)
+        print("speedup: %.2fx" % (parsed.avg() / precompiled.avg()))
@@ -0,0 +1,63 @@
+"""
+Benchmark the std::vector data formatter (libc++) on a large vector.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestBenchmarkLibcxxVector(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        # Call super's setUp().
+        BenchBase.setUp(self)
+
+    def print_points(self, label):
+        sw = Stopwatch()
+        sw.start()
+        self.expect('frame variable -A points',
+                    substrs=['[99999] = (x = 99999, y = 199998)'])
+        sw.stop()
+        print("%s: time to print: %s" % (label, sw))
+
+    @benchmarks_test
+    def test_live_process(self):
+        """Benchmark the std::vector data formatter on a live process"""
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "break here",
+                                          lldb.SBFileSpec("main.cpp"))
+        self.runCmd("settings set target.max-children-count 100000")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings set target.max-children-count 256", check=False))
+
+        self.print_points("live process")
+
+    @benchmarks_test
+    @skipUnlessDarwin
+    def test_core_file(self):
+        """Benchmark the std::vector data formatter on a core file"""
+        self.build()
+        core = self.getBuildArtifact("core")
+        (target, process, _, _) = lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.cpp"))
+        self.assertTrue(process.SaveCore(core).Success())
+        self.assertTrue(process.Kill().Success())
+        self.dbg.DeleteTarget(target)
+
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        process = target.LoadCore(core)
+        self.assertTrue(process.IsValid())
+        process.GetSelectedThread().SetSelectedFrame(0)
+        self.runCmd("settings set target.max-children-count 100000")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings set target.max-children-count 256", check=False))
+
+        self.print_points("core file")
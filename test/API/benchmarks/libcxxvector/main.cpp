@@ -0,0 +1,13 @@
+#include <vector>
+
+struct Point {
+  int x;
+  int y;
+};
+
+int main() {
+  std::vector<Point> points;
+  for (int i = 0; i < 100000; i++)
+    points.push_back({i, i * 2});
+  return points.size(); // break here
+}
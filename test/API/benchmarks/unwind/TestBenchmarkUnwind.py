@@ -0,0 +1,36 @@
+"""
+Benchmark unwinding the stacks of many threads.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestBenchmarkUnwind(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    @benchmarks_test
+    def test_backtrace_all(self):
+        """Benchmark unwinding all the threads of a process at every stop."""
+        self.build()
+        target, process, thread, bkpt = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.cpp"))
+
+        sw = Stopwatch()
+        num_frames = 0
+        while process.GetState() == lldb.eStateStopped:
+            # Every stop discards the frames of the previous one, so each
+            # iteration unwinds all the threads from scratch.
+            with sw:
+                for t in process:
+                    num_frames += t.GetNumFrames()
+            process.Continue()
+
+        print("unwound %d frames, time to unwind: %s" % (num_frames, sw))
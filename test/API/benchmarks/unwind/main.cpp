@@ -0,0 +1,35 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static std::atomic<bool> g_done(false);
+static std::atomic<int> g_ready(0);
+
+__attribute__((noinline)) int recurse(int depth) {
+  if (depth == 0) {
+    g_ready++;
+    while (!g_done)
+      std::this_thread::yield();
+    return 0;
+  }
+  return recurse(depth - 1) + 1;
+}
+
+int main() {
+  const int num_threads = 64;
+  const int depth = 100;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++)
+    threads.emplace_back(recurse, depth);
+  while (g_ready != num_threads)
+    std::this_thread::yield();
+
+  int stops = 0;
+  for (int i = 0; i < 10; i++)
+    stops++; // break here
+
+  g_done = true;
+  for (std::thread &thread : threads)
+    thread.join();
+  return stops;
+}
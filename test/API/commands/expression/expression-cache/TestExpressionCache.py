@@ -0,0 +1,64 @@
+"""
+Test that expressions evaluated again in the same context reuse their parsed
+code and still see the current values of the variables they use.
+"""
+
+import re
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ExpressionCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def get_cache_stats(self):
+        interp = self.dbg.GetCommandInterpreter()
+        result = lldb.SBCommandReturnObject()
+        interp.HandleCommand("statistics dump", result)
+        self.assertTrue(result.Succeeded())
+        output = result.GetOutput()
+        hits = re.search("reusing a parsed expression : (\d+)", output)
+        misses = re.search("parsing an expression : (\d+)", output)
+        return int(hits.group(1)), int(misses.group(1))
+
+    @no_debug_info_test
+    def test_cache(self):
+        self.build()
+        target, process, thread, bkpt = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.c"))
+
+        self.runCmd("statistics enable")
+        for i in range(3):
+            frame = thread.GetFrameAtIndex(0)
+            self.assertEqual(frame.EvaluateExpression(
+                "square(i) + sum").GetValueAsUnsigned(), i * i + sum(
+                    j * j for j in range(i)))
+            self.assertEqual(frame.EvaluateExpression(
+                "square(i) + sum").GetValueAsUnsigned(), i * i + sum(
+                    j * j for j in range(i)))
+            if i < 2:
+                process.Continue()
+
+        # Only the first evaluation at the breakpoint parsed the expression.
+        self.assertEqual(self.get_cache_stats(), (5, 1))
+
+        # Expressions using persistent variables are always parsed.
+        self.expect_expr("int $value = 1; $value", result_value="1")
+        self.expect_expr("int $value = 2; $value", result_value="2")
+        self.assertEqual(self.get_cache_stats(), (5, 1))
+
+    @no_debug_info_test
+    def test_disabled(self):
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "// break here",
+                                          lldb.SBFileSpec("main.c"))
+
+        self.runCmd("settings set target.expression-cache false")
+        self.runCmd("statistics enable")
+        self.expect_expr("square(3)", result_value="9")
+        self.expect_expr("square(3)", result_value="9")
+        self.assertEqual(self.get_cache_stats(), (0, 0))
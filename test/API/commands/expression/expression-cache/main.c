@@ -0,0 +1,9 @@
+int square(int x) { return x * x; }
+
+int main(int argc, char **argv) {
+  int sum = 0;
+  for (int i = 0; i < 3; i++) {
+    sum += square(i); // break here
+  }
+  return sum;
+}
@@ -0,0 +1,107 @@
+"""
+Test that expressions with loops, switches, vectors, struct copies and calls
+to C library functions without side effects are evaluated by the IR
+interpreter, without running any code in the process.
+"""
+
+import re
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class IRInterpreterCoverageTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def get_execution_stats(self):
+        interp = self.dbg.GetCommandInterpreter()
+        result = lldb.SBCommandReturnObject()
+        interp.HandleCommand("statistics dump", result)
+        self.assertTrue(result.Succeeded())
+        output = result.GetOutput()
+        interpreted = re.search("by the IR interpreter : (\d+)", output)
+        jit = re.search("of JIT compiled code : (\d+)", output)
+        return int(interpreted.group(1)), int(jit.group(1))
+
+    @no_debug_info_test
+    def test_interpreted_expressions(self):
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "// break here",
+                                          lldb.SBFileSpec("main.c"))
+        self.runCmd("settings set target.expression-cache false")
+        self.runCmd("statistics enable")
+
+        # A loop running more than the 4096 instructions the interpreter used
+        # to allow.
+        self.expect_expr(
+            "int sum = 0; for (int i = 0; i < 1000; ++i) sum += i; sum",
+            result_type="int", result_value="499500")
+        self.expect_expr(
+            "int r = 0; switch (value) { case 1: r = 10; break; "
+            "case 2: r = 20; break; default: r = 30; } r",
+            result_type="int", result_value="20")
+        self.expect_expr("vec.y + vec[3]", result_type="int",
+                         result_value="60")
+        self.expect_expr("int4 copy = vec; copy.z = 7; copy.z + copy.x",
+                         result_type="int", result_value="17")
+        self.expect_expr("struct point p = points[1]; p.x + p.y",
+                         result_type="int", result_value="7")
+        self.expect_expr("int zeros[16] = {0}; zeros[5] + zeros[15]",
+                         result_type="int", result_value="0")
+        self.expect_expr("(unsigned long)strlen(name)",
+                         result_type="unsigned long", result_value="11")
+        self.expect_expr("(int)strcmp(name, other) > 0", result_type="bool",
+                         result_value="true")
+        self.expect_expr("(int)strncmp(name, other, 9)", result_type="int",
+                         result_value="0")
+        self.expect_expr("(int)memcmp(name, other, 5)", result_type="int",
+                         result_value="0")
+        self.expect_expr("(int)abs(-value)", result_type="int",
+                         result_value="2")
+
+        interpreted, jit = self.get_execution_stats()
+        self.assertEqual(jit, 0)
+        self.assertEqual(interpreted, 11)
+
+    @no_debug_info_test
+    def test_instruction_limit(self):
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "// break here",
+                                          lldb.SBFileSpec("main.c"))
+        self.runCmd(
+            "settings set target.expr-interpreter-instruction-limit 100")
+        self.expect(
+            "expression -- int sum = 0; "
+            "for (int i = 0; i < 1000; ++i) sum += i; sum",
+            error=True, substrs=["too many cycles"])
+
+    @no_debug_info_test
+    def test_large_comparisons(self):
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "// break here",
+                                          lldb.SBFileSpec("main.c"))
+        self.runCmd("settings set target.expression-cache false")
+        self.runCmd("statistics enable")
+
+        # Comparisons whose constant size is larger than what the
+        # interpreter reads run in the JIT.
+        self.expect_expr("(int)memcmp(big_lhs, big_rhs, sizeof(big_lhs)) > 0",
+                         result_type="bool", result_value="true")
+        self.expect_expr(
+            "(int)strncmp(big_lhs, big_rhs, sizeof(big_lhs)) > 0",
+            result_type="bool", result_value="true")
+        interpreted, jit = self.get_execution_stats()
+        self.assertEqual(jit, 2)
+        self.assertEqual(interpreted, 0)
+
+        # The interpreter fails instead of only comparing the beginning of
+        # the memory when the size is only known at run time.
+        self.expect("expression -- (int)strcmp(big_lhs, big_rhs)",
+                    error=True, substrs=["comparison is too long"])
+        self.expect(
+            "expression -- unsigned long size = sizeof(big_lhs); "
+            "(int)memcmp(big_lhs, big_rhs, size)",
+            error=True, substrs=["comparison is too long"])
@@ -0,0 +1,26 @@
+#include <string.h>
+
+typedef int int4 __attribute__((ext_vector_type(4)));
+
+struct point {
+  int x;
+  int y;
+};
+
+// Strings that only differ after the first MiB, the most the interpreter
+// reads for a single call.
+#define BIG_SIZE ((1 << 20) + 16)
+char big_lhs[BIG_SIZE];
+char big_rhs[BIG_SIZE];
+
+int main(int argc, char **argv) {
+  const char *name = "interpreter";
+  const char *other = "interpret";
+  struct point points[2] = {{1, 2}, {3, 4}};
+  int4 vec = {10, 20, 30, 40};
+  int value = 2;
+  memset(big_lhs, 'a', BIG_SIZE - 1);
+  memset(big_rhs, 'a', BIG_SIZE - 1);
+  big_lhs[BIG_SIZE - 2] = 'b';
+  return (int)strlen(name) + points[argc].x + vec.y + value; // break here
+}
@@ -0,0 +1,73 @@
+"""
+Test that expressions reuse the precompiled prefix shared by all of them,
+including the contents of target.expr-prefix.
+"""
+
+import re
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class PrecompiledPrefixTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def get_prefix_stats(self):
+        interp = self.dbg.GetCommandInterpreter()
+        result = lldb.SBCommandReturnObject()
+        interp.HandleCommand("statistics dump", result)
+        self.assertTrue(result.Succeeded())
+        output = result.GetOutput()
+        precompiled = re.search("expr prefixes precompiled : (\d+)", output)
+        reused = re.search("reusing a precompiled prefix : (\d+)", output)
+        return int(precompiled.group(1)), int(reused.group(1))
+
+    @no_debug_info_test
+    def test_reuse(self):
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "// break here",
+                                          lldb.SBFileSpec("main.c"))
+
+        self.runCmd("statistics enable")
+        self.expect_expr("value + 1", result_value="8")
+        self.expect_expr("square(value)", result_value="49")
+        self.expect_expr("(int)sizeof(int32_t)", result_value="4")
+        self.assertEqual(self.get_prefix_stats(), (1, 2))
+
+        # A new prefix is precompiled once as well.
+        self.runCmd("settings set target.expr-prefix " +
+                    self.getSourcePath("expr-prefix.h"))
+        self.expect_expr("TWICE(value)", result_value="14")
+        self.expect_expr("add_one(value)", result_value="8")
+        self.expect_expr("TWICE(add_one(value))", result_value="16")
+        self.assertEqual(self.get_prefix_stats(), (2, 4))
+
+    @no_debug_info_test
+    def test_prefix_using_program(self):
+        """A prefix that needs the declarations of the program can't be
+        precompiled and is parsed with every expression instead."""
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "// break here",
+                                          lldb.SBFileSpec("main.c"))
+
+        self.runCmd("settings set target.expr-prefix " +
+                    self.getSourcePath("bad-prefix.h"))
+        self.runCmd("statistics enable")
+        self.expect_expr("value", result_value="7")
+        self.expect_expr("prefix_uses_program()", result_value="42")
+        self.assertEqual(self.get_prefix_stats(), (0, 0))
+
+    @no_debug_info_test
+    def test_disabled(self):
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "// break here",
+                                          lldb.SBFileSpec("main.c"))
+
+        self.runCmd("settings set target.expr-precompile-prefix false")
+        self.runCmd("statistics enable")
+        self.expect_expr("value + 1", result_value="8")
+        self.expect_expr("square(value)", result_value="49")
+        self.assertEqual(self.get_prefix_stats(), (0, 0))
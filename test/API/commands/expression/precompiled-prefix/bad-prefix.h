@@ -0,0 +1 @@
+static int prefix_uses_program(void) { return value_from_program; }
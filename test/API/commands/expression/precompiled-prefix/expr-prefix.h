@@ -0,0 +1,3 @@
+#define TWICE(x) ((x) * 2)
+
+static int add_one(int x) { return x + 1; }
@@ -0,0 +1,8 @@
+int value_from_program = 42;
+
+int square(int x) { return x * x; }
+
+int main(int argc, char **argv) {
+  int value = 7;
+  return square(value); // break here
+}
@@ -0,0 +1,46 @@
+"""
+Test the process profile command.
+"""
+
+import os
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ProcessProfileTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        TestBase.setUp(self)
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "// Set breakpoint here",
+                                          lldb.SBFileSpec("main.c"))
+
+    def test_folded_stacks(self):
+        self.expect("process profile --count 10 --rate 200",
+                    substrs=["a.out`main;a.out`spin ",
+                             "10 samples",
+                             "pause time per sample: min "])
+        # The process is left stopped.
+        process = self.dbg.GetSelectedTarget().GetProcess()
+        self.assertEqual(process.GetState(), lldb.eStateStopped)
+
+    @skipIf(archs=no_match(["x86_64", "i386", "arm64", "aarch64"]))
+    def test_frame_pointers(self):
+        self.expect("process profile -c 5 --frame-pointers",
+                    substrs=["a.out`spin ", "5 samples"])
+
+    def test_pprof(self):
+        self.expect("process profile --pprof", error=True,
+                    substrs=["the pprof format requires an output file"])
+
+        outfile = self.getBuildArtifact("profile.pb")
+        self.expect("process profile -c 5 --pprof -o " + outfile,
+                    substrs=["Profile written to", "5 samples"])
+        self.assertTrue(os.path.exists(outfile))
+        with open(outfile, "rb") as f:
+            self.assertIn(b"a.out`spin", f.read())
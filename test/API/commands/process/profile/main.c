@@ -0,0 +1,12 @@
+static volatile int g_done = 0;
+
+static void __attribute__((noinline)) spin(void) {
+  while (!g_done)
+    ;
+}
+
+int main(int argc, char **argv) {
+  int result = argc; // Set breakpoint here
+  spin();
+  return result;
+}
@@ -44,3 +44,8 @@ class TestCase(TestBase):
         self.expect("statistics disable")
         self.expect("statistics dump", substrs=['frame var successes : 1\n',
                                                 'frame var failures : 0\n'])
+
+        # The formatters of 'patatino' were looked up by the 'frame var'
+        # commands above, so the last one found them in the format cache.
+        self.expect("statistics dump", patterns=[
+            'Number of formatter lookups answered by the format cache : [1-9]'])
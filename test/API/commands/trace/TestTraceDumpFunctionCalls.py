@@ -0,0 +1,54 @@
+import lldb
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+from lldbsuite.test.decorators import *
+
+class TestTraceDumpFunctionCalls(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def setUp(self):
+        TestBase.setUp(self)
+        if 'intel-pt' not in configuration.enabled_plugins:
+            self.skipTest("The intel-pt test plugin is not enabled")
+
+    def testErrorMessages(self):
+        self.expect("thread trace dump function-calls",
+            substrs=["error: invalid target, create a target using the 'target create' command"],
+            error=True)
+
+    def testSingleFunction(self):
+        self.expect("trace load -v " +
+            os.path.join(self.getSourceDir(), "intelpt-trace", "trace.json"))
+
+        self.expect("thread trace dump function-calls",
+            substrs=["thread #1: tid = 3842849, total instructions = 21",
+                     "  a.out`main: calls = 1, instructions = 21 (self 21)"])
+
+    def testMultiFileCallTree(self):
+        self.expect("trace load " +
+            os.path.join(self.getSourceDir(), "intelpt-trace-multi-file", "multi-file-no-ld.json"))
+
+        # The gap in the trace after the first call to the dynamic linker resets
+        # the call path, so main is entered twice. The calls to foo and bar go
+        # through PLT stubs, which are replaced by the actual functions in the
+        # call tree.
+        self.expect("thread trace dump function-calls",
+            substrs=["thread #1: tid = 815455, total instructions = 46",
+                     "\n  a.out`main: calls = 2, instructions = 45 (self 17)",
+                     "\n    libfoo.so`foo(): calls = 1, instructions = 22 (self 12)",
+                     "\n      libbar.so`bar(): calls = 1, instructions = 9 (self 9)"])
+
+        # The depth of the tree can be limited.
+        self.expect("thread trace dump function-calls --count 1",
+            substrs=["a.out`main: calls = 2"],
+            matching=True)
+        self.expect("thread trace dump function-calls --count 1",
+            substrs=["libfoo.so`foo()"],
+            matching=False)
+
+        # The flat profile sorts the functions by exclusive instruction count.
+        self.expect("thread trace dump function-calls --flat --count 2",
+            patterns=["self insns +total insns",
+                      "17 +45 .* a.out`main\n +12 +22 .* libfoo.so`foo\(\)\n"])
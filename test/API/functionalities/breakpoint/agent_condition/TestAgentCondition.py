@@ -0,0 +1,76 @@
+"""
+Test that lldb-server evaluates the breakpoint conditions it is given as
+agent expressions, and only reports the hits for which they are true.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class AgentConditionTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def check_condition(self, condition, expected_i, use_agent_conditions):
+        self.build()
+        self.runCmd(
+            "settings set plugin.process.gdb-remote.use-agent-conditions %s" %
+            ("true" if use_agent_conditions else "false"))
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear plugin.process.gdb-remote.use-agent-conditions"))
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(target, VALID_TARGET)
+        bkpt = target.BreakpointCreateBySourceRegex(
+            "// break here", lldb.SBFileSpec("main.c"))
+        bkpt.SetCondition(condition)
+
+        log_file = self.getBuildArtifact("breakpoint-%d.log" % expected_i)
+        self.runCmd("log enable -f '%s' lldb break" % log_file)
+        process = target.LaunchSimple(None, None,
+                                      self.get_process_working_directory())
+        thread = lldbutil.get_one_thread_stopped_at_breakpoint(process, bkpt)
+        self.assertTrue(thread, "stopped at the breakpoint")
+        frame = thread.GetFrameAtIndex(0)
+        self.assertEqual(
+            frame.FindVariable("i").GetValueAsSigned(), expected_i)
+        self.assertEqual(bkpt.GetHitCount(), 1)
+        self.runCmd("log disable lldb break")
+
+        with open(log_file) as f:
+            log = f.read()
+        # Without agent conditions, lldb evaluates the condition at every
+        # hit. With them, it only evaluates it at the first hit, which gives
+        # the condition to the breakpoint site, and at the hit that stops.
+        num_false = log.count("without the expression parser, result is false")
+        if use_agent_conditions:
+            self.assertIn("Giving the condition to breakpoint site", log)
+            self.assertEqual(num_false, 1 if expected_i else 0, log)
+        else:
+            self.assertEqual(num_false, expected_i, log)
+
+    @skipUnlessPlatform(["linux"])
+    @skipIfRemote
+    @no_debug_info_test
+    def test_comparison(self):
+        self.check_condition("i == 42", 42, True)
+
+    @skipUnlessPlatform(["linux"])
+    @skipIfRemote
+    @no_debug_info_test
+    def test_member_access(self):
+        self.check_condition(
+            "ptr->state != 0 && ptr->values[3] == 7 && i > 10", 11, True)
+
+    @skipUnlessPlatform(["linux"])
+    @skipIfRemote
+    @no_debug_info_test
+    def test_signed_comparison(self):
+        self.check_condition("-i < -59 && nodes[0].state == 0", 60, True)
+
+    @skipUnlessPlatform(["linux"])
+    @skipIfRemote
+    @no_debug_info_test
+    def test_setting_disabled(self):
+        self.check_condition("i == 42", 42, False)
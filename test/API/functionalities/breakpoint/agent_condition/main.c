@@ -0,0 +1,14 @@
+struct node {
+  int state;
+  long values[4];
+};
+
+int main(int argc, char **argv) {
+  struct node nodes[2] = {{0, {0, 1, 2, 3}}, {3, {4, 5, 6, 7}}};
+  long sum = 0;
+  for (int i = 0; i < 100; i++) {
+    struct node *ptr = &nodes[i % 2];
+    sum += ptr->values[i % 4]; // break here
+  }
+  return sum;
+}
@@ -0,0 +1,56 @@
+"""
+Test that breakpoint conditions that only compare variables with constants
+are evaluated without the expression parser, with the same results.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class SimpleConditionTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def check_condition(self, condition, expected_i, simple):
+        self.build()
+        target = self.dbg.CreateTarget(self.getBuildArtifact("a.out"))
+        self.assertTrue(target, VALID_TARGET)
+        bkpt = target.BreakpointCreateBySourceRegex(
+            "// break here", lldb.SBFileSpec("main.c"))
+        bkpt.SetCondition(condition)
+
+        log_file = self.getBuildArtifact("breakpoint-%d.log" % expected_i)
+        self.runCmd("log enable -f '%s' lldb break" % log_file)
+        process = target.LaunchSimple(None, None,
+                                      self.get_process_working_directory())
+        thread = lldbutil.get_one_thread_stopped_at_breakpoint(process, bkpt)
+        self.assertTrue(thread, "stopped at the breakpoint")
+        frame = thread.GetFrameAtIndex(0)
+        self.assertEqual(
+            frame.FindVariable("i").GetValueAsSigned(), expected_i)
+        self.runCmd("log disable lldb break")
+
+        with open(log_file) as f:
+            log = f.read()
+        self.assertEqual(
+            "Condition evaluated without the expression parser" in log,
+            simple, log)
+
+    @no_debug_info_test
+    def test_comparison(self):
+        self.check_condition("i == 42", 42, True)
+
+    @no_debug_info_test
+    def test_member_access(self):
+        self.check_condition(
+            "ptr->state != 0 && ptr->values[3] == 7 && i > 10", 11, True)
+
+    @no_debug_info_test
+    def test_array_index(self):
+        self.check_condition("nodes[1].state == 3 && !(i < 20)", 20, True)
+
+    @no_debug_info_test
+    def test_expression_parser_fallback(self):
+        self.check_condition("square(i) == 49", 7, False)
@@ -0,0 +1,60 @@
+"""
+Test that printing a value stops at the budget of the target settings.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class DataFormatterPrintBudgetTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def test(self):
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "// break here",
+                                          lldb.SBFileSpec("main.cpp"))
+
+        def cleanup():
+            self.runCmd('settings clear target.max-value-print-values',
+                        check=False)
+            self.runCmd('settings clear target.max-value-print-bytes',
+                        check=False)
+
+        self.addTearDownHook(cleanup)
+
+        # Without a budget, all the children are printed.
+        self.expect("frame variable numbers", substrs=["[99] = 99"])
+        self.expect("frame variable numbers", matching=False,
+                    substrs=["elided"])
+
+        # The array and its first four elements are printed.
+        self.runCmd("settings set target.max-value-print-values 5")
+        self.expect("frame variable numbers",
+                    substrs=["[3] = 3", "...",
+                             "*** Some children were elided after printing 5 "
+                             "values, the value of "
+                             "target.max-value-print-values."])
+        self.expect("frame variable numbers", matching=False,
+                    substrs=["[4] = 4"])
+
+        # The budget covers the nested children. The members of the points
+        # are printed on one line, as a part of the point.
+        self.expect("frame variable shape",
+                    substrs=["id = 1", "[1] = (x = 1, y = -1)",
+                             "target.max-value-print-values"])
+        self.expect("frame variable shape", matching=False,
+                    substrs=["[2] = "])
+
+        # The budget is per value.
+        self.expect("frame variable shape.id numbers",
+                    substrs=["(int) shape.id = 1", "[3] = 3"])
+
+        self.runCmd("settings clear target.max-value-print-values")
+        self.runCmd("settings set target.max-value-print-bytes 200")
+        self.expect("frame variable numbers",
+                    substrs=["target.max-value-print-bytes"])
+        self.expect("frame variable numbers", matching=False,
+                    substrs=["[99] = 99"])
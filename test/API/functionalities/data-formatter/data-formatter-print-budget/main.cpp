@@ -0,0 +1,22 @@
+struct Point {
+  int x;
+  int y;
+};
+
+struct Shape {
+  int id;
+  Point points[100];
+};
+
+int main() {
+  Shape shape;
+  shape.id = 1;
+  for (int i = 0; i < 100; ++i) {
+    shape.points[i].x = i;
+    shape.points[i].y = -i;
+  }
+  int numbers[100];
+  for (int i = 0; i < 100; ++i)
+    numbers[i] = i;
+  return shape.id + numbers[0]; // break here
+}
@@ -0,0 +1,54 @@
+"""
+Test getting the children of libc++ containers a page at a time.
+"""
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class LibcxxChildrenInRangeTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def check_page(self, container, start, count, get_value):
+        children = container.GetChildrenInRange(start, count)
+        expected = max(0, min(count, container.GetNumChildren() - start))
+        self.assertEqual(children.GetSize(), expected)
+        for i in range(children.GetSize()):
+            child = children.GetValueAtIndex(i)
+            self.assertEqual(child.GetName(), "[%d]" % (start + i))
+            self.assertEqual(get_value(child), start + i)
+
+    def check_pages(self, container, get_value):
+        self.assertEqual(container.GetNumChildren(), 1000)
+        # Start in the middle, go back to the beginning, then read past the
+        # end.
+        self.check_page(container, 500, 100, get_value)
+        self.check_page(container, 0, 100, get_value)
+        self.check_page(container, 550, 100, get_value)
+        self.check_page(container, 950, 100, get_value)
+        self.check_page(container, 1000, 10, get_value)
+        # The children are the same as the ones GetChildAtIndex returns.
+        self.assertEqual(get_value(container.GetChildAtIndex(975)), 975)
+        self.assertEqual(
+            container.GetChildrenInRange(600, 1).GetValueAtIndex(0).GetID(),
+            container.GetChildAtIndex(600).GetID())
+
+    @add_test_categories(["libc++"])
+    def test(self):
+        self.build()
+        (_, _, thread, _) = lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.cpp"))
+        frame = thread.GetFrameAtIndex(0)
+
+        self.check_pages(
+            frame.FindVariable("map"),
+            lambda child: -child.GetChildMemberWithName(
+                "second").GetValueAsSigned())
+        self.check_pages(frame.FindVariable("list"),
+                         lambda child: child.GetValueAsSigned())
+        self.check_pages(frame.FindVariable("vector"),
+                         lambda child: child.GetValueAsSigned())
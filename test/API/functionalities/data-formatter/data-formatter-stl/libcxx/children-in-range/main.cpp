@@ -0,0 +1,15 @@
+#include <list>
+#include <map>
+#include <vector>
+
+int main() {
+  std::map<int, int> map;
+  std::list<int> list;
+  std::vector<int> vector;
+  for (int i = 0; i < 1000; i++) {
+    map[i] = -i;
+    list.push_back(i);
+    vector.push_back(i);
+  }
+  return map.size() + list.size() + vector.size(); // break here
+}
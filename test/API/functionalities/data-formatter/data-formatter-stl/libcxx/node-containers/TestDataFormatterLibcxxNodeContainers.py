@@ -0,0 +1,83 @@
+"""
+Test the children of large libc++ containers made of nodes, and of ones whose
+nodes are linked in a cycle (which can appear as a result of e.g. memory
+corruption).
+"""
+
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class LibcxxNodeContainersDataFormatterTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def check_children(self, container, expected, get_value):
+        self.assertEqual(container.GetNumChildren(), len(expected))
+        children = container.GetChildrenInRange(0, len(expected))
+        self.assertEqual(children.GetSize(), len(expected))
+        values = [get_value(children.GetValueAtIndex(i))
+                  for i in range(children.GetSize())]
+        self.assertEqual(values, expected)
+        # Going back to an earlier child gives the same value.
+        self.assertEqual(get_value(container.GetChildAtIndex(1)), expected[1])
+
+    @add_test_categories(["libc++"])
+    def test(self):
+        self.build()
+        target, process, thread, bkpt = lldbutil.run_to_source_breakpoint(
+            self, "// Set break point at this line.",
+            lldb.SBFileSpec("main.cpp", False))
+        self.runCmd("settings set target.max-children-count 3000")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.max-children-count"))
+        frame = thread.GetFrameAtIndex(0)
+
+        def key(child):
+            return child.GetChildMemberWithName("first").GetValueAsSigned()
+
+        def value(child):
+            return child.GetValueAsSigned()
+
+        # The elements of the map are in the order of their keys, not in the
+        # order of their nodes in memory.
+        map_value = frame.FindVariable("map")
+        self.check_children(map_value, list(range(10000)), key)
+        last = map_value.GetChildAtIndex(9999)
+        self.assertEqual(
+            last.GetChildMemberWithName("second").GetValueAsSigned(), -9999)
+
+        self.check_children(frame.FindVariable("list"),
+                            list(range(9998, -1, -2)) +
+                            list(range(1, 10000, 2)), value)
+        self.check_children(frame.FindVariable("forward_list"),
+                            list(range(2000)), value)
+
+        # Corrupt the small containers.
+        bkpt = target.BreakpointCreateBySourceRegex(
+            "// Set second break point at this line.",
+            lldb.SBFileSpec("main.cpp", False))
+        lldbutil.continue_to_breakpoint(process, bkpt)
+        frame = thread.GetFrameAtIndex(0)
+
+        # Going up from the first node of the map never ends. The walk gives
+        # up instead of looping, and the other children are missing.
+        small_map = frame.FindVariable("small_map").Dereference()
+        self.assertEqual(small_map.GetNumChildren(), 10)
+        self.assertEqual(key(small_map.GetChildAtIndex(0)), 0)
+        self.assertFalse(small_map.GetChildAtIndex(1).IsValid())
+        self.assertFalse(small_map.GetChildAtIndex(9).IsValid())
+        self.expect("frame variable *small_map", substrs=["[0] = "])
+
+        # The forward list ends where its nodes start repeating.
+        small_forward_list = frame.FindVariable(
+            "small_forward_list").Dereference()
+        self.check_children(small_forward_list, [0, 1, 2, 3, 4], value)
+        self.expect("frame variable *small_forward_list",
+                    substrs=["size=5", "[4] = 4"])
+
+        process.Kill()
@@ -0,0 +1,54 @@
+// To simulate memory corruption, the test changes the links between the nodes
+// of the containers, which are internals of libc++.
+#define private public
+#define protected public
+
+#include <forward_list>
+#include <list>
+#include <map>
+
+int main() {
+  // Insert the keys out of order, so the nodes of the map aren't allocated in
+  // the order of the keys.
+  std::map<int, int> map;
+  for (int i = 0; i < 10000; i++) {
+    int key = (i * 7919) % 10000;
+    map[key] = -key;
+  }
+  // The even numbers in decreasing order, then the odd numbers in increasing
+  // order.
+  std::list<int> list;
+  for (int i = 0; i < 10000; i++) {
+    if (i % 2)
+      list.push_back(i);
+    else
+      list.push_front(i);
+  }
+  std::forward_list<int> forward_list;
+  for (int i = 1999; i >= 0; i--)
+    forward_list.push_front(i);
+
+  auto *small_map = new std::map<int, int>;
+  auto *small_forward_list = new std::forward_list<int>;
+  for (int i = 0; i < 10; i++) {
+    (*small_map)[i] = -i;
+    small_forward_list->push_front(9 - i);
+  }
+
+  int result = map.size() + list.size(); // Set break point at this line.
+
+#ifdef LLDB_USING_LIBCPP
+  // The parent of the first node of the map is the node itself, so going up
+  // from it never ends.
+  auto *first_node = small_map->begin().__i_.__get_np();
+  first_node->__parent_ =
+      static_cast<decltype(first_node->__parent_)>(first_node);
+  // The fifth element of the forward list is followed by the third one.
+  auto *third_node = std::next(small_forward_list->begin(), 2).__ptr_;
+  auto *fifth_node = std::next(small_forward_list->begin(), 4).__ptr_;
+  fifth_node->__next_ = static_cast<decltype(fifth_node->__next_)>(third_node);
+#endif
+
+  // Freeing the corrupted containers would probably crash. Leak them.
+  return result; // Set second break point at this line.
+}
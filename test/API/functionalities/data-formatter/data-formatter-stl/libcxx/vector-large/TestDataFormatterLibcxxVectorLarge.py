@@ -0,0 +1,58 @@
+"""
+Test that the children of a large std::vector, which are read a window of
+elements at a time, have the right values and addresses.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class LibcxxVectorLargeDataFormatterTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def check_point(self, points, index, x, y):
+        point = points.GetChildAtIndex(index)
+        self.assertTrue(point.IsValid())
+        self.assertEqual(point.GetName(), "[%d]" % index)
+        self.assertEqual(point.GetChildMemberWithName("x").GetValueAsSigned(),
+                         x)
+        self.assertEqual(point.GetChildMemberWithName("y").GetValueAsSigned(),
+                         y)
+        return point
+
+    @add_test_categories(["libc++"])
+    def test(self):
+        self.build()
+        target, process, thread, bkpt = lldbutil.run_to_source_breakpoint(
+            self, "break here", lldb.SBFileSpec("main.cpp", False))
+
+        points = thread.GetFrameAtIndex(0).FindVariable("points")
+        self.assertEqual(points.GetNumChildren(), 20000)
+        data = points.GetChildAtIndex(0).GetLoadAddress()
+        self.assertNotEqual(data, lldb.LLDB_INVALID_ADDRESS)
+
+        # Elements at the start and end of the windows of 64 KiB.
+        for index in [0, 1, 8191, 8192, 16383, 16384, 19999]:
+            point = self.check_point(points, index, index, -index)
+            self.assertEqual(point.GetLoadAddress(), data + index * 8)
+
+        self.expect("frame variable points[8192]",
+                    substrs=["x = 8192", "y = -8192"])
+        self.expect_expr("points[19999].y", result_value="-19999")
+
+        # Setting a child writes to the memory of the process.
+        y = points.GetChildAtIndex(9000).GetChildMemberWithName("y")
+        error = lldb.SBError()
+        self.assertTrue(y.SetValueFromCString("1234", error),
+                        error.GetCString())
+        self.check_point(points, 9000, 9000, 1234)
+
+        # The children are read again once the process changed the vector.
+        lldbutil.continue_to_breakpoint(process, bkpt)
+        points = thread.GetFrameAtIndex(0).FindVariable("points")
+        self.check_point(points, 8192, 42, -8192)
+        self.check_point(points, 8191, 8191, -8191)
+        self.expect_expr("read_back", result_value="1234")
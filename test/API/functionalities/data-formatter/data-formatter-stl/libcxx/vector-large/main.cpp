@@ -0,0 +1,16 @@
+#include <vector>
+
+struct Point {
+  int x;
+  int y;
+};
+
+int main() {
+  // Large enough to span several windows of the bulk read.
+  std::vector<Point> points;
+  for (int i = 0; i < 20000; ++i)
+    points.push_back({i, -i});
+  points[8192].x = 42; // break here
+  int read_back = points[9000].y;
+  return read_back + points[8192].x; // break here
+}
@@ -0,0 +1,74 @@
+"""
+Test synthetic children described by the layout of a type.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class DataFormatterSynthLayoutTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def test(self):
+        self.build()
+        lldbutil.run_to_source_breakpoint(self, "// break here",
+                                          lldb.SBFileSpec("main.cpp"))
+
+        def cleanup():
+            self.runCmd('type synth clear', check=False)
+
+        self.addTearDownHook(cleanup)
+
+        self.runCmd('type synthetic add SizedArray --layout '
+                    '\'{"kind": "array", "data": "points", "size": "count"}\'')
+        self.runCmd('type synthetic add RangeArray --layout '
+                    '\'{"kind": "array", "data": "begin", "end": "end"}\'')
+        self.runCmd('type synthetic add InlineArray --layout '
+                    '\'{"kind": "array", "data": "values", "size": "used"}\'')
+        self.runCmd('type synthetic add List --layout '
+                    '\'{"kind": "list", "head": "head", "next": "next", '
+                    '"value": "value"}\'')
+        self.runCmd('type synthetic add Ring --layout '
+                    '\'{"kind": "list", "head": "first", "next": "next", '
+                    '"value": "value", "size": "size", '
+                    '"element_type": "Id"}\'')
+
+        self.expect("type synthetic list",
+                    substrs=['layout {"kind": "array", "data": "points"'])
+
+        self.expect("frame variable sized",
+                    substrs=['[0] = (x = 1, y = 2)',
+                             '[1] = (x = 3, y = 4)',
+                             '[2] = (x = 5, y = 6)'])
+        self.expect("frame variable range",
+                    substrs=['[0] = (x = 3, y = 4)',
+                             '[1] = (x = 5, y = 6)'])
+        self.expect("frame variable range", substrs=['[2]'], matching=False)
+        self.expect("frame variable inline_array",
+                    substrs=['[0] = 10', '[1] = 20'])
+        self.expect("frame variable inline_array", substrs=['[2]'],
+                    matching=False)
+        self.expect("frame variable list",
+                    substrs=['[0] = 100', '[1] = 200', '[2] = 300'])
+        self.expect("frame variable list[1]", substrs=['200'])
+        self.expect("frame variable ring",
+                    substrs=['[0] = (number = 7)', '[1] = (number = 8)'])
+
+        ring = self.frame().FindVariable("ring")
+        self.assertEqual(ring.GetChildAtIndex(0).GetTypeName(), "Id")
+
+        empty_list = self.frame().FindVariable("empty_list")
+        self.assertEqual(empty_list.GetNumChildren(), 0)
+        sized = self.frame().FindVariable("sized")
+        self.assertEqual(sized.GetNumChildren(), 3)
+        self.assertEqual(sized.GetChildAtIndex(1).GetChildMemberWithName(
+            "y").GetValueAsUnsigned(), 4)
+
+        self.expect('type synthetic add Point --layout \'{"kind": "array"}\'',
+                    error=True, substrs=['invalid layout'])
+        self.expect('type synthetic add Point --layout '
+                    '\'{"kind": "tree", "data": "x"}\'',
+                    error=True, substrs=['unknown kind "tree"'])
@@ -0,0 +1,58 @@
+struct Point {
+  int x;
+  int y;
+};
+
+struct SizedArray {
+  unsigned count;
+  Point *points;
+};
+
+struct RangeArray {
+  Point *begin;
+  Point *end;
+};
+
+struct InlineArray {
+  int used;
+  int values[8];
+};
+
+struct Node {
+  Node *next;
+  long value;
+};
+
+struct List {
+  Node *head;
+};
+
+struct Id {
+  long number;
+};
+
+struct RingNode {
+  long value;
+  RingNode *next;
+};
+
+struct Ring {
+  RingNode *first;
+  unsigned size;
+};
+
+int main() {
+  Point points[3] = {{1, 2}, {3, 4}, {5, 6}};
+  SizedArray sized = {3, points};
+  RangeArray range = {points + 1, points + 3};
+  InlineArray inline_array = {2, {10, 20, 30}};
+
+  Node nodes[3] = {{&nodes[1], 100}, {&nodes[2], 200}, {nullptr, 300}};
+  List list = {nodes};
+  List empty_list = {nullptr};
+
+  RingNode ring_nodes[2] = {{7, &ring_nodes[1]}, {8, &ring_nodes[0]}};
+  Ring ring = {ring_nodes, 2};
+  Id id = {0};
+  return 0; // break here
+}
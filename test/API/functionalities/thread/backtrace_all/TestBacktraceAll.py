@@ -57,3 +57,27 @@ class BacktraceAllTestCase(TestBase):
 
         # Run to completion
         self.runCmd("continue")
+
+    @skipIfTargetAndroid(archs=["arm"])
+    def test_parallel(self):
+        """Test unwinding the threads in parallel."""
+        self.build(dictionary=self.getBuildFlags())
+        target, process, _, _ = lldbutil.run_to_source_breakpoint(
+            self, "// Set breakpoint here", lldb.SBFileSpec("ParallelTask.cpp"))
+
+        # Unwinding in parallel caches the same frames that are then shown by
+        # the regular backtrace.
+        self.assertSuccess(process.ComputeStackFrames(lldb.UINT32_MAX))
+        for thread in process:
+            self.assertGreater(thread.GetNumFrames(), 0)
+            self.assertTrue(thread.GetFrameAtIndex(0).IsValid())
+
+        self.runCmd("thread backtrace all --parallel")
+        parallel = self.res.GetOutput()
+        self.runCmd("thread backtrace all")
+        sequential = self.res.GetOutput()
+        self.assertEqual(parallel, sequential)
+        self.assertIn("stop reason = breakpoint 1.", parallel)
+
+        self.expect("thread backtrace unique --parallel",
+                    substrs=["stop reason = breakpoint 1."])
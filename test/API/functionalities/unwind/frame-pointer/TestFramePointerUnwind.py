@@ -0,0 +1,77 @@
+"""
+Test unwinding by following the chain of saved frame pointers.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class FramePointerUnwindTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    expected_functions = ["c", "b", "a", "main"]
+
+    @skipIf(archs=no_match(["x86_64", "i386", "arm64", "aarch64"]))
+    def test_backtrace_api(self):
+        """Test SBThread.GetFramePointerBacktrace and SBTarget.SymbolizeBacktrace."""
+        self.build()
+        target, process, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, "// Set breakpoint here", lldb.SBFileSpec("main.c"))
+
+        error = lldb.SBError()
+        pcs = thread.GetFramePointerBacktrace(128, error)
+        self.assertSuccess(error)
+        self.assertGreaterEqual(len(pcs.uint64s), len(self.expected_functions))
+
+        # The pc of frame zero and the return addresses match the frames of
+        # the regular unwinder.
+        for i in range(len(self.expected_functions)):
+            self.assertEqual(pcs.uint64s[i],
+                             thread.GetFrameAtIndex(i).GetPC())
+
+        names = target.SymbolizeBacktrace(pcs)
+        self.assertEqual(names.GetSize(), len(pcs.uint64s))
+        for i, function in enumerate(self.expected_functions):
+            self.assertEqual(names.GetStringAtIndex(i), "a.out`" + function)
+
+        # Return addresses outside of any module are described with the
+        # address itself, not with the address they are looked up at.
+        unmapped = lldb.SBData.CreateDataFromUInt64Array(
+            process.GetByteOrder(), process.GetAddressByteSize(),
+            [pcs.uint64s[0], 0x20, 0x40])
+        names = target.SymbolizeBacktrace(unmapped)
+        self.assertEqual(names.GetStringAtIndex(1), "0x20")
+        self.assertEqual(names.GetStringAtIndex(2), "0x40")
+
+        # The number of frames can be limited.
+        pcs = thread.GetFramePointerBacktrace(2, error)
+        self.assertSuccess(error)
+        self.assertEqual(len(pcs.uint64s), 2)
+
+    @skipIf(archs=no_match(["x86_64", "i386", "arm64", "aarch64"]))
+    def test_setting(self):
+        """Test the frames of a thread when frame pointer unwinding is enabled."""
+        self.build()
+        self.runCmd("settings set target.process.thread.frame-pointer-unwind true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.process.thread.frame-pointer-unwind"))
+        target, process, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, "// Set breakpoint here", lldb.SBFileSpec("main.c"))
+
+        for i, function in enumerate(self.expected_functions):
+            self.assertEqual(thread.GetFrameAtIndex(i).GetFunctionName(),
+                             function)
+
+        self.expect("thread backtrace", substrs=["a.out`c", "a.out`b",
+                                                 "a.out`a", "a.out`main"])
+
+        # Disabling the setting goes back to the regular unwinder the next
+        # time the process stops.
+        self.runCmd("settings set target.process.thread.frame-pointer-unwind false")
+        thread.StepInstruction(False)
+        for i, function in enumerate(self.expected_functions):
+            self.assertEqual(thread.GetFrameAtIndex(i).GetFunctionName(),
+                             function)
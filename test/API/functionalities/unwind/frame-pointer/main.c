@@ -0,0 +1,9 @@
+static int __attribute__((noinline)) c(int x) {
+  return x + 1; // Set breakpoint here
+}
+
+static int __attribute__((noinline)) b(int x) { return c(x) * 2; }
+
+static int __attribute__((noinline)) a(int x) { return b(x) + 3; }
+
+int main(int argc, char **argv) { return a(argc); }
@@ -0,0 +1,104 @@
+"""
+Test plugin.symbol-file.dwarf.lazy-member-completion, which completes C++
+classes without their ordinary member functions and nested types and parses
+them when the expression parser looks them up by name.
+"""
+
+import re
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class LazyMemberCompletionTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    setting = "plugin.symbol-file.dwarf.lazy-member-completion"
+
+    def set_lazy(self, lazy):
+        self.runCmd("settings set %s %s" % (self.setting,
+                                            "true" if lazy else "false"))
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear " + self.setting, check=False))
+
+    def get_ast_dump(self):
+        res = lldb.SBCommandReturnObject()
+        self.dbg.GetCommandInterpreter().HandleCommand(
+            "target modules dump ast a.out", res)
+        self.assertTrue(res.Succeeded())
+        return res.GetOutput()
+
+    @skipIf(debug_info="gmodules")
+    def test_lookup_by_name(self):
+        self.build()
+        self.set_lazy(True)
+        _, _, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.cpp"))
+
+        self.expect("frame variable big", substrs=["first = 1", "second = 2"])
+        ast = self.get_ast_dump()
+        self.assertIn("Virtual", ast)
+        self.assertNotIn("Method7", ast)
+
+        self.expect_expr("big.Method7(1)", result_type="int", result_value="8")
+        ast = self.get_ast_dump()
+        self.assertIn("Method7", ast)
+        self.assertNotIn("Method8", ast)
+
+        self.expect_expr("big.Overloaded(5)", result_type="int",
+                         result_value="5")
+        self.expect_expr("big.Overloaded(1.5)", result_type="int",
+                         result_value="2")
+        self.expect_expr("Big::Static()", result_type="int", result_value="3")
+        self.expect_expr("(int)Big::KindB", result_type="int",
+                         result_value="2")
+        self.expect_expr("Big::Inner{4}.value", result_type="int",
+                         result_value="4")
+
+        # The SB API lists all of the member functions. Big has more than 32
+        # of them, of which fewer than 10 were parsed so far.
+        big_type = thread.GetFrameAtIndex(0).FindVariable("big").GetType()
+        self.assertTrue(big_type.GetMemberFunctionAtIndex(31).IsValid())
+        names = [big_type.GetMemberFunctionAtIndex(i).GetName()
+                 for i in range(big_type.GetNumberOfMemberFunctions())]
+        self.assertIn("Method31", names)
+
+    def frame_variable_ast_memory(self, lazy):
+        """Return the number of deferred members of Big and the size of the
+        AST after completing it for 'frame variable'."""
+        self.set_lazy(lazy)
+        logfile = self.getBuildArtifact("dwarf-%s.log" % lazy)
+        self.runCmd("log enable -f %s dwarf comp" % logfile)
+        target, process, _, _ = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.cpp"))
+        self.expect("frame variable big", substrs=["first = 1"])
+        self.runCmd("log disable dwarf comp")
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+        # Drop the module so the next run parses the types again.
+        lldb.SBDebugger.MemoryPressureDetected()
+
+        with open(logfile, "r") as log:
+            for line in log:
+                match = re.search(r"completed 'Big' deferring (\d+) members, "
+                                  r"AST memory: (\d+) bytes", line)
+                if match:
+                    return int(match.group(1)), int(match.group(2))
+        self.fail("Big wasn't completed")
+
+    @skipIf(debug_info="gmodules")
+    def test_ast_memory(self):
+        self.build()
+        eager_deferred, eager_memory = self.frame_variable_ast_memory(False)
+        lazy_deferred, lazy_memory = self.frame_variable_ast_memory(True)
+        if self.TraceOn():
+            print("AST memory after frame variable: %d bytes eager, "
+                  "%d bytes lazy" % (eager_memory, lazy_memory))
+
+        self.assertEqual(eager_deferred, 0)
+        # The 32 MethodN, the 2 Overloaded, Static, Inner and Kind.
+        self.assertEqual(lazy_deferred, 37)
+        self.assertLess(lazy_memory, eager_memory)
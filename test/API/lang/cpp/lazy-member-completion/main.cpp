@@ -0,0 +1,42 @@
+#define FOR_EACH_METHOD(X)                                                     \
+  X(0) X(1) X(2) X(3) X(4) X(5) X(6) X(7) X(8) X(9) X(10) X(11) X(12) X(13)   \
+  X(14) X(15) X(16) X(17) X(18) X(19) X(20) X(21) X(22) X(23) X(24) X(25)     \
+  X(26) X(27) X(28) X(29) X(30) X(31)
+
+#define DECLARE_METHOD(N) int Method##N(int a) const;
+#define DEFINE_METHOD(N)                                                       \
+  int Big::Method##N(int a) const { return a + N; }
+
+struct Big {
+  struct Inner {
+    int value;
+  };
+  enum Kind { KindA = 1, KindB = 2 };
+
+  int first = 1;
+  int second = 2;
+
+  Big() = default;
+  virtual ~Big() = default;
+  virtual int Virtual() const;
+
+  FOR_EACH_METHOD(DECLARE_METHOD)
+
+  int Overloaded(int i) const;
+  int Overloaded(double d) const;
+  static int Static();
+};
+
+int Big::Virtual() const { return first; }
+FOR_EACH_METHOD(DEFINE_METHOD)
+int Big::Overloaded(int i) const { return i; }
+int Big::Overloaded(double d) const { return 2; }
+int Big::Static() { return 3; }
+
+// Keeps the nested types in the debug info without parsing them for main.
+int UseNested(Big::Inner inner, Big::Kind kind) { return inner.value + kind; }
+
+int main() {
+  Big big;
+  return big.Virtual() + UseNested(Big::Inner{0}, Big::KindA) - 2; // break here
+}
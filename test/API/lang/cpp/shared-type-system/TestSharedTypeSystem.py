@@ -0,0 +1,92 @@
+"""
+Test plugin.symbol-file.dwarf.shared-type-system, which parses the types of
+all modules into one type system, so that a type defined the same way in
+several shared libraries is parsed once.
+"""
+
+import re
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class SharedTypeSystemTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    setting = "plugin.symbol-file.dwarf.shared-type-system"
+
+    def read_globals(self, shared):
+        """Print the globals of the libraries and return the number of times
+        ns::Shared was completed and the memory used by the ASTs."""
+        self.runCmd("settings set %s %s" % (self.setting,
+                                            "true" if shared else "false"))
+        logfile = self.getBuildArtifact("dwarf-%s.log" % shared)
+        self.runCmd("log enable -f %s dwarf comp" % logfile)
+        target, process, _, _ = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.cpp"),
+            extra_images=["one", "two", "three"])
+
+        self.expect("target variable g_shared_one g_shared_two g_shared_three",
+                    substrs=["first = 1", "first = 5", "first = 9",
+                             '"three"'])
+        # The two Config types have the same name and size but not the same
+        # layout, so they must not be merged.
+        self.expect("target variable g_config_one g_config_two",
+                    substrs=["first = 1", "second = 2", "width = 3",
+                             "height = 4"])
+        self.expect_expr("g_shared_two.ints.second + g_shared_three.ints.first",
+                         result_type="int", result_value="15")
+
+        self.runCmd("log disable dwarf comp")
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+        # Drop the modules so the next run parses the types again.
+        lldb.SBDebugger.MemoryPressureDetected()
+
+        completions = 0
+        module_memory = {}
+        with open(logfile, "r") as log:
+            for line in log:
+                match = re.search(r"\) (.+): 0x[0-9a-f]+: completed '(.+)' "
+                                  r"deferring \d+ members, AST memory: (\d+) "
+                                  r"bytes", line)
+                if not match:
+                    continue
+                module, name, memory = match.groups()
+                if name == "ns::Shared":
+                    completions += 1
+                module_memory[module] = max(module_memory.get(module, 0),
+                                            int(memory))
+        self.assertTrue(module_memory, "No type was completed")
+        if shared:
+            # All modules report the memory of the same AST.
+            return completions, max(module_memory.values())
+        return completions, sum(module_memory.values())
+
+    # The symbol files of a debug map already share the type system of the
+    # module of the debug map.
+    @skipIfDarwin
+    @skipIfWindows
+    @skipIf(debug_info="gmodules")
+    def test(self):
+        self.build()
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear " + self.setting, check=False))
+
+        shared_completions, shared_memory = self.read_globals(True)
+        separate_completions, separate_memory = self.read_globals(False)
+        if self.TraceOn():
+            print("AST memory after reading the globals: %d bytes separate, "
+                  "%d bytes shared" % (separate_memory, shared_memory))
+
+        self.assertEqual(separate_completions, 3)
+        self.assertEqual(shared_completions, 1)
+        self.assertLess(shared_memory, separate_memory)
+
+        # The shared type system doesn't keep the modules loaded, so it is
+        # destroyed with them and the next run parses the types again.
+        shared_completions, _ = self.read_globals(True)
+        self.assertEqual(shared_completions, 1)
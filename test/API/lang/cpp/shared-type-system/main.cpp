@@ -0,0 +1,5 @@
+#include "shared.h"
+
+int main() {
+  return one() + two() + three(); // break here
+}
@@ -0,0 +1,13 @@
+#include "shared.h"
+
+// A type with the same name and size as the Config of libtwo, but a
+// different layout.
+struct Config {
+  int first;
+  int second;
+};
+
+Config g_config_one = {1, 2};
+ns::Shared g_shared_one = {{1, 2}, {3, 4}, {0.5, 1.5}, {1}, "one"};
+
+int one() { return g_shared_one.Sum() + g_config_one.first; }
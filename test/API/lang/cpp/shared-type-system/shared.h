@@ -0,0 +1,25 @@
+template <typename T> struct Pair {
+  T first;
+  T second;
+};
+
+namespace ns {
+struct Shared {
+  Pair<int> ints;
+  Pair<long> longs;
+  Pair<double> doubles;
+  int values[8];
+  const char *name;
+
+  int Sum() const {
+    int sum = ints.first + ints.second;
+    for (int value : values)
+      sum += value;
+    return sum;
+  }
+};
+} // namespace ns
+
+int one();
+int two();
+int three();
@@ -0,0 +1,5 @@
+#include "shared.h"
+
+ns::Shared g_shared_three = {{9, 10}, {11, 12}, {4.5, 5.5}, {3}, "three"};
+
+int three() { return g_shared_three.Sum(); }
@@ -0,0 +1,11 @@
+#include "shared.h"
+
+struct Config {
+  int width;
+  int height;
+};
+
+Config g_config_two = {3, 4};
+ns::Shared g_shared_two = {{5, 6}, {7, 8}, {2.5, 3.5}, {2}, "two"};
+
+int two() { return g_shared_two.Sum() + g_config_two.width; }
@@ -0,0 +1,75 @@
+"""
+Test that the values of variables are right after stepping with
+target.incremental-value-updates, which only updates the parts of a
+variable whose memory changed.
+"""
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ValueIncrementalUpdatesTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def check_values(self, outer, expected):
+        for path, value in expected.items():
+            child = outer.GetValueForExpressionPath(path)
+            self.assertTrue(child.IsValid(), path)
+            self.assertEqual(child.GetValueAsSigned(), value, path)
+
+    @add_test_categories(['pyapi'])
+    def test(self):
+        self.build()
+        self.runCmd("settings set target.incremental-value-updates true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.incremental-value-updates", check=False))
+
+        _, process, thread, _ = lldbutil.run_to_source_breakpoint(
+            self, "// break here", lldb.SBFileSpec("main.cpp"))
+        frame = thread.GetFrameAtIndex(0)
+        outer = frame.FindVariable("outer")
+        self.assertTrue(outer.IsValid())
+
+        expected = {
+            ".count": 1,
+            ".inner.a": 2,
+            ".inner.flag": 0,
+            ".inner.bits": 3,
+            ".values[0]": 4,
+            ".values[3]": 7,
+            ".node->value": 1,
+        }
+        self.check_values(outer, expected)
+
+        def step(changes, changed_paths):
+            thread.StepOver()
+            expected.update(changes)
+            self.check_values(outer, expected)
+            for path in changed_paths + [".count", ".values[0]"]:
+                child = outer.GetValueForExpressionPath(path)
+                self.assertEqual(child.GetValueDidChange(),
+                                 path in changed_paths, path)
+
+        # Nothing changes in the memory of outer.
+        step({}, [])
+        step({".inner.a": 20}, [".inner.a"])
+        step({".inner.bits": 30}, [".inner.bits"])
+        step({".values[3]": 70}, [".values[3]"])
+        # The pointee isn't in the memory of outer, but must be updated.
+        step({".node->value": 10}, [".node->value"])
+
+        # Writing a value updates the values that share its memory.
+        error = lldb.SBError()
+        self.assertTrue(outer.GetChildMemberWithName("count")
+                        .SetValueFromCString("42", error), error.GetCString())
+        self.assertEqual(
+            frame.FindVariable("outer").GetValueForExpressionPath(".count")
+            .GetValueAsSigned(), 42)
+        self.expect("frame variable outer.count", substrs=["42"])
+
+        thread.StepOver()
+        self.assertEqual(
+            outer.GetChildMemberWithName("node").GetValueAsUnsigned(), 0)
@@ -0,0 +1,28 @@
+struct Inner {
+  int a;
+  unsigned flag : 1;
+  unsigned bits : 7;
+};
+
+struct Node {
+  int value;
+};
+
+struct Outer {
+  int count;
+  Inner inner;
+  int values[4];
+  Node *node;
+};
+
+int main() {
+  Node node = {1};
+  Outer outer = {1, {2, 0, 3}, {4, 5, 6, 7}, &node};
+  outer.count = 1; // break here
+  outer.inner.a = 20;
+  outer.inner.bits = 30;
+  outer.values[3] = 70;
+  node.value = 10; // Only the pointee changes.
+  outer.node = nullptr;
+  return outer.count; // last line
+}
@@ -108,7 +108,10 @@ class TestVSCode_variables(lldbvscode_testcase.VSCodeTestCaseBase):
                 'children': {
                     'x': {'equals': {'type': 'int', 'value': '11'}},
                     'y': {'equals': {'type': 'int', 'value': '22'}},
-                    'buffer': {'children': buffer_children}
+                    'buffer': {
+                        'equals': {'indexedVariables': 32},
+                        'children': buffer_children
+                    }
                 }
             }
         }
@@ -154,6 +157,15 @@ class TestVSCode_variables(lldbvscode_testcase.VSCodeTestCaseBase):
         response = self.vscode.request_variables(varRef, start=32, count=1)
         self.assertTrue(len(response['body']['variables']) == 0,
                         'verify we get no variable back for invalid start')
+        # Verify the children of an array are only reported as indexed
+        # children
+        response = self.vscode.request_variables(varRef, start=30, count=5,
+                                                 filter='indexed')
+        self.verify_variables(make_buffer_verify_dict(30, 2),
+                              response['body']['variables'])
+        self.assertEqual(len(response['body']['variables']), 2)
+        response = self.vscode.request_variables(varRef, filter='named')
+        self.assertEqual(len(response['body']['variables']), 0)
 
         # Test evaluate
         expressions = {
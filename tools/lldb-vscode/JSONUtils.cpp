@@ -977,9 +977,13 @@ llvm::json::Value CreateVariable(lldb::SBValue v, int64_t variablesReference,
   EmplaceSafeString(object, "type", type_cstr ? type_cstr : NO_TYPENAME);
   if (varID != INT64_MAX)
     object.try_emplace("id", varID);
-  if (v.MightHaveChildren())
+  if (v.MightHaveChildren()) {
     object.try_emplace("variablesReference", variablesReference);
-  else
+    // Let the IDE page through the children of large containers instead of
+    // fetching all of them when the variable is expanded.
+    if (HasIndexedChildren(v))
+      object.try_emplace("indexedVariables", (int64_t)v.GetNumChildren());
+  } else
     object.try_emplace("variablesReference", (int64_t)0);
   lldb::SBStream evaluateStream;
   v.GetExpressionPath(evaluateStream);
@@ -989,6 +993,10 @@ llvm::json::Value CreateVariable(lldb::SBValue v, int64_t variablesReference,
   return llvm::json::Value(std::move(object));
 }
 
+bool HasIndexedChildren(lldb::SBValue v) {
+  return v.IsSynthetic() || v.GetType().IsArrayType();
+}
+
 llvm::json::Value CreateCompileUnit(lldb::SBCompileUnit unit) {
   llvm::json::Object object;
   char unit_path_arr[PATH_MAX];
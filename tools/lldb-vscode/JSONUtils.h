@@ -416,6 +416,8 @@ llvm::json::Value CreateThreadStopped(lldb::SBThread &thread, uint32_t stop_id);
 ///          the variable.
 ///   "evaluateName" - The name of the variable to use in expressions
 ///                    as a string.
+///   "indexedVariables" - The number of children of arrays and of values
+///          with synthetic children, see HasIndexedChildren().
 ///
 /// \param[in] v
 ///     The LLDB value to use when populating out the "Variable"
@@ -441,6 +443,17 @@ llvm::json::Value CreateThreadStopped(lldb::SBThread &thread, uint32_t stop_id);
 llvm::json::Value CreateVariable(lldb::SBValue v, int64_t variablesReference,
                                  int64_t varID, bool format_hex);
 
+/// Check if the children of a value are reported to the IDE as indexed
+/// variables, which it can fetch a page at a time.
+///
+/// \param[in] v
+///     The LLDB value to check.
+///
+/// \return
+///     \b true if \a v is an array or has synthetic children, like the
+///     standard containers, \b false otherwise.
+bool HasIndexedChildren(lldb::SBValue v);
+
 llvm::json::Value CreateCompileUnit(lldb::SBCompileUnit unit);
 
 /// Create a runInTerminal reverse request object
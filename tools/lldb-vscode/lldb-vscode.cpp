@@ -1366,6 +1366,12 @@ void request_initialize(const llvm::json::Object &request) {
     g_vsc.debugger.SetErrorFileHandle(out, false);
   }
 
+  // The IDE displays the same variables after every step, only update the
+  // parts of them whose memory changed. "initCommands" can turn this off.
+  lldb::SBDebugger::SetInternalVariable("target.incremental-value-updates",
+                                        "true",
+                                        g_vsc.debugger.GetInstanceName());
+
   // Start our event thread so we can receive events from the debugger, target,
   // process and more.
   g_vsc.event_thread = std::thread(EventThreadFunction);
@@ -2843,6 +2849,7 @@ void request_variables(const llvm::json::Object &request) {
       GetUnsigned(arguments, "variablesReference", 0);
   const int64_t start = GetSigned(arguments, "start", 0);
   const int64_t count = GetSigned(arguments, "count", 0);
+  const auto filter = GetString(arguments, "filter");
   bool hex = false;
   auto format = arguments->getObject("format");
   if (format)
@@ -2882,11 +2889,18 @@ void request_variables(const llvm::json::Object &request) {
     // children.
     const int64_t var_idx = VARREF_TO_VARIDX(variablesReference);
     lldb::SBValue variable = g_vsc.variables.GetValueAtIndex(var_idx);
-    if (variable.IsValid()) {
-      const auto num_children = variable.GetNumChildren();
-      const int64_t end_idx = start + ((count == 0) ? num_children : count);
-      for (auto i = start; i < end_idx; ++i) {
-        lldb::SBValue child = variable.GetChildAtIndex(i);
+    // All the children of a variable reported with "indexedVariables" are
+    // indexed, so it has no named children.
+    if (variable.IsValid() &&
+        !(filter == "named" && HasIndexedChildren(variable))) {
+      const int64_t num_children = variable.GetNumChildren();
+      const int64_t num_to_get = (count == 0) ? num_children - start : count;
+      // Get the whole page at once so that containers that have to walk a
+      // data structure to find their children only walk it once.
+      lldb::SBValueList children =
+          variable.GetChildrenInRange(start, std::max<int64_t>(num_to_get, 0));
+      for (uint32_t i = 0; i < children.GetSize(); ++i) {
+        lldb::SBValue child = children.GetValueAtIndex(i);
         if (!child.IsValid())
           break;
         if (child.MightHaveChildren()) {
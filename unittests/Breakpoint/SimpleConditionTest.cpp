@@ -0,0 +1,99 @@
+//===-- SimpleConditionTest.cpp -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Breakpoint/SimpleCondition.h"
+
+#include <map>
+#include <string>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+class SimpleConditionTest : public ::testing::Test {
+public:
+  llvm::Optional<bool> Evaluate(llvm::StringRef text) {
+    std::unique_ptr<SimpleCondition> condition = SimpleCondition::Parse(text);
+    EXPECT_TRUE(condition) << text.str();
+    if (!condition)
+      return llvm::None;
+    resolved.clear();
+    return condition->Evaluate([&](llvm::StringRef path) {
+      resolved.push_back(path.str());
+      auto it = values.find(path.str());
+      if (it == values.end())
+        return llvm::Optional<Scalar>();
+      return llvm::Optional<Scalar>(it->second);
+    });
+  }
+
+  std::map<std::string, Scalar> values = {
+      {"i", Scalar(42)},
+      {"u", Scalar(7u)},
+      {"d", Scalar(2.5)},
+      {"ptr", Scalar(0x1000ull)},
+      {"null_ptr", Scalar(0ull)},
+      {"ptr->state", Scalar(3)},
+      {"a.b[2]", Scalar(-1)},
+      {"*ptr", Scalar(5)}};
+  std::vector<std::string> resolved;
+};
+} // namespace
+
+TEST_F(SimpleConditionTest, Parse) {
+  EXPECT_TRUE(SimpleCondition::Parse("i == 42"));
+  EXPECT_TRUE(SimpleCondition::Parse("ptr->state != 3"));
+  EXPECT_TRUE(SimpleCondition::Parse("a . b [ 2 ] < -1 || !(i >= 0x10)"));
+  EXPECT_TRUE(SimpleCondition::Parse("*ptr <= 1.5f && ptr != nullptr"));
+  EXPECT_TRUE(SimpleCondition::Parse("this->m_count > 10ul"));
+  EXPECT_TRUE(SimpleCondition::Parse("flag"));
+
+  EXPECT_FALSE(SimpleCondition::Parse(""));
+  EXPECT_FALSE(SimpleCondition::Parse("i = 42"));
+  EXPECT_FALSE(SimpleCondition::Parse("i + 1 == 42"));
+  EXPECT_FALSE(SimpleCondition::Parse("i << 2"));
+  EXPECT_FALSE(SimpleCondition::Parse("i & 4"));
+  EXPECT_FALSE(SimpleCondition::Parse("--i"));
+  EXPECT_FALSE(SimpleCondition::Parse("i++ == 3"));
+  EXPECT_FALSE(SimpleCondition::Parse("strcmp(s, \"x\") == 0"));
+  EXPECT_FALSE(SimpleCondition::Parse("a[i] == 0"));
+  EXPECT_FALSE(SimpleCondition::Parse("ns::value == 0"));
+  EXPECT_FALSE(SimpleCondition::Parse("(int)d == 2"));
+  EXPECT_FALSE(SimpleCondition::Parse("(i == 42"));
+  EXPECT_FALSE(SimpleCondition::Parse("08 == i"));
+}
+
+TEST_F(SimpleConditionTest, Evaluate) {
+  EXPECT_EQ(true, Evaluate("i == 42"));
+  EXPECT_EQ(false, Evaluate("i != 42"));
+  EXPECT_EQ(true, Evaluate("ptr->state == 3 && a.b[2] < 0"));
+  EXPECT_EQ(true, Evaluate("a.b[2] == -1"));
+  EXPECT_EQ(true, Evaluate("u > 6 && u <= 7 && u >= 7 && u < 8"));
+  EXPECT_EQ(true, Evaluate("d > 2 && d < 3.0"));
+  EXPECT_EQ(true, Evaluate("ptr && !null_ptr"));
+  EXPECT_EQ(true, Evaluate("null_ptr == nullptr && ptr != NULL"));
+  EXPECT_EQ(true, Evaluate("*ptr == 5"));
+  EXPECT_EQ(true, Evaluate("i == 0x2a && i == 052"));
+  EXPECT_EQ(true, Evaluate("(i == 1 || i == 42) == true"));
+  EXPECT_EQ(false, Evaluate("!(i == 42)"));
+}
+
+TEST_F(SimpleConditionTest, ShortCircuit) {
+  EXPECT_EQ(false, Evaluate("null_ptr && null_ptr->state == 3"));
+  EXPECT_EQ(std::vector<std::string>{"null_ptr"}, resolved);
+
+  EXPECT_EQ(true, Evaluate("i == 42 || missing == 3"));
+  EXPECT_EQ(std::vector<std::string>{"i"}, resolved);
+}
+
+TEST_F(SimpleConditionTest, Unresolved) {
+  EXPECT_EQ(llvm::None, Evaluate("missing == 3"));
+  EXPECT_EQ(llvm::None, Evaluate("i == 42 && missing == 3"));
+}
@@ -0,0 +1,68 @@
+//===-- FormatCacheTest.cpp -----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/DataFormatters/FormatCache.h"
+#include "lldb/DataFormatters/TypeFormat.h"
+#include "lldb/DataFormatters/TypeSummary.h"
+
+#include "gtest/gtest.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+TEST(FormatCacheTest, MissIsNotCached) {
+  FormatCache cache;
+  ConstString type("Foo");
+  TypeFormatImplSP format_sp = std::make_shared<TypeFormatImpl_Format>();
+  EXPECT_FALSE(cache.Get(type, eNoDynamicValues, format_sp));
+  EXPECT_FALSE(format_sp);
+  EXPECT_FALSE(cache.Get(type, eNoDynamicValues, format_sp));
+  EXPECT_EQ(0u, cache.GetCacheHits());
+  EXPECT_EQ(2u, cache.GetCacheMisses());
+}
+
+TEST(FormatCacheTest, NegativeEntry) {
+  FormatCache cache;
+  ConstString type("Foo");
+  TypeFormatImplSP format_sp;
+  cache.Set(type, eNoDynamicValues, format_sp);
+
+  // The absence of a format is cached, but not the absence of a summary.
+  format_sp = std::make_shared<TypeFormatImpl_Format>();
+  EXPECT_TRUE(cache.Get(type, eNoDynamicValues, format_sp));
+  EXPECT_FALSE(format_sp);
+  TypeSummaryImplSP summary_sp;
+  EXPECT_FALSE(cache.Get(type, eNoDynamicValues, summary_sp));
+  EXPECT_EQ(1u, cache.GetCacheHits());
+  EXPECT_EQ(1u, cache.GetCacheMisses());
+}
+
+TEST(FormatCacheTest, DynamicValueTypeIsPartOfTheKey) {
+  FormatCache cache;
+  ConstString type("Foo");
+  TypeFormatImplSP hex_sp = std::make_shared<TypeFormatImpl_Format>(eFormatHex);
+  cache.Set(type, eNoDynamicValues, hex_sp);
+
+  TypeFormatImplSP format_sp;
+  EXPECT_TRUE(cache.Get(type, eNoDynamicValues, format_sp));
+  EXPECT_EQ(hex_sp, format_sp);
+  EXPECT_FALSE(cache.Get(type, eDynamicCanRunTarget, format_sp));
+  EXPECT_FALSE(format_sp);
+
+  TypeFormatImplSP octal_sp =
+      std::make_shared<TypeFormatImpl_Format>(eFormatOctal);
+  cache.Set(type, eDynamicCanRunTarget, octal_sp);
+  EXPECT_TRUE(cache.Get(type, eDynamicCanRunTarget, format_sp));
+  EXPECT_EQ(octal_sp, format_sp);
+  EXPECT_TRUE(cache.Get(type, eNoDynamicValues, format_sp));
+  EXPECT_EQ(hex_sp, format_sp);
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get(type, eNoDynamicValues, format_sp));
+  EXPECT_FALSE(cache.Get(type, eDynamicCanRunTarget, format_sp));
+}
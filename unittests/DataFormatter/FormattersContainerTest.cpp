@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "lldb/DataFormatters/FormattersContainer.h"
+#include "lldb/DataFormatters/TypeFormat.h"
 
 #include "gtest/gtest.h"
 
@@ -157,3 +158,64 @@ TEST(TypeMatcherTests, CreatedBySameMatchStringExactNamePrefixes) {
     EXPECT_TRUE(without_prefix.CreatedBySameMatchString(without_prefix));
   }
 }
+
+namespace {
+typedef FormattersContainer<TypeFormatImpl_Format> FormatContainer;
+
+lldb::Format GetFormat(FormatContainer &container, const char *type) {
+  FormatContainer::ValueSP entry;
+  if (!container.Get(ConstString(type), entry))
+    return lldb::eFormatInvalid;
+  return entry->GetFormat();
+}
+
+FormatContainer::ValueSP MakeFormat(lldb::Format format) {
+  return std::make_shared<TypeFormatImpl_Format>(format);
+}
+} // namespace
+
+// The formatter added last wins over the exact and regex matchers added
+// before it.
+TEST(FormattersContainerTests, LastAddedWins) {
+  FormatContainer container(nullptr);
+  container.Add(TypeMatcher(ConstString("Foo")), MakeFormat(eFormatHex));
+  EXPECT_EQ(eFormatHex, GetFormat(container, "Foo"));
+  EXPECT_EQ(eFormatHex, GetFormat(container, "struct Foo"));
+
+  container.Add(TypeMatcher(RegularExpression("^F")), MakeFormat(eFormatOctal));
+  EXPECT_EQ(eFormatOctal, GetFormat(container, "Foo"));
+  EXPECT_EQ(eFormatOctal, GetFormat(container, "Fab"));
+
+  container.Add(TypeMatcher(ConstString("class Foo")),
+                MakeFormat(eFormatBinary));
+  EXPECT_EQ(eFormatBinary, GetFormat(container, "Foo"));
+  EXPECT_EQ(eFormatOctal, GetFormat(container, "Fab"));
+
+  container.Add(TypeMatcher(RegularExpression("b$")),
+                MakeFormat(eFormatDecimal));
+  EXPECT_EQ(eFormatDecimal, GetFormat(container, "Fab"));
+  EXPECT_EQ(eFormatOctal, GetFormat(container, "Fa"));
+  EXPECT_EQ(eFormatBinary, GetFormat(container, "Foo"));
+  EXPECT_EQ(eFormatInvalid, GetFormat(container, "Bar"));
+
+  // Deleting a matcher makes the ones added before it visible again.
+  EXPECT_TRUE(container.Delete(TypeMatcher(ConstString("Foo"))));
+  EXPECT_EQ(eFormatOctal, GetFormat(container, "Foo"));
+  EXPECT_TRUE(container.Delete(TypeMatcher(RegularExpression("b$"))));
+  EXPECT_EQ(eFormatOctal, GetFormat(container, "Fab"));
+
+  container.Clear();
+  EXPECT_EQ(eFormatInvalid, GetFormat(container, "Foo"));
+}
+
+// Regexes that can't be combined into a single one are still matched.
+TEST(FormattersContainerTests, RegexBackReference) {
+  FormatContainer container(nullptr);
+  container.Add(TypeMatcher(RegularExpression("^(a)\\1$")),
+                MakeFormat(eFormatHex));
+  container.Add(TypeMatcher(RegularExpression("^(b)\\1$")),
+                MakeFormat(eFormatOctal));
+  EXPECT_EQ(eFormatHex, GetFormat(container, "aa"));
+  EXPECT_EQ(eFormatOctal, GetFormat(container, "bb"));
+  EXPECT_EQ(eFormatInvalid, GetFormat(container, "ab"));
+}
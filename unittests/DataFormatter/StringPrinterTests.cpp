@@ -12,8 +12,10 @@
 #include "lldb/Utility/StreamString.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
+#include <chrono>
 #include <string>
 
 using namespace lldb;
@@ -148,3 +150,68 @@ TEST(StringPrinterTests, SwiftUTF8) {
   EXPECT_EQ(fmt("\376"), QUOTE(R"(\u{fe})")); // \376 is 254 in decimal.
   EXPECT_EQ(fmt("\xfe"), QUOTE(R"(\u{fe})")); // \xfe is 254 in decimal.
 }
+
+// Test strings longer than the words the printer scans at once.
+TEST(StringPrinterTests, LongStrings) {
+  auto fmt = [](StringRef str) {
+    return format<StringPrinter::StringElementType::UTF8>(
+        str, StringPrinter::EscapeStyle::CXX);
+  };
+
+  std::string text = "The quick brown fox jumps over the lazy dog. ";
+  EXPECT_EQ(fmt(text + text), "\"" + text + text + "\"");
+  EXPECT_EQ(fmt(text + "\"quoted\"\n" + text),
+            "\"" + text + R"(\"quoted\"\n)" + text + "\"");
+  EXPECT_EQ(fmt(text + "\U00010348\xfe" + text),
+            "\"" + text + "\U00010348" + R"(\xfe)" + text + "\"");
+  EXPECT_EQ(fmt(text + std::string("\0", 1) + text), "\"" + text + "\"");
+}
+
+// Time the formatting of large strings. This isn't run by default, pass
+// --gtest_also_run_disabled_tests to run it.
+TEST(StringPrinterTests, DISABLED_Benchmark) {
+  constexpr size_t size = 1 << 20;
+  std::string ascii;
+  while (ascii.size() < size)
+    ascii += "The quick brown fox jumps over the lazy dog.\n";
+  ascii.resize(size);
+  std::string utf8;
+  while (utf8.size() < size)
+    utf8 += "Zwölf Boxkämpfer jagen Viktor quer über den großen Sylter Deich. ";
+  std::u16string utf16(ascii.begin(), ascii.end());
+
+  auto print_utf16 = [&]() {
+    StreamString out;
+    StringPrinter::ReadBufferAndDumpToStreamOptions opts;
+    opts.SetStream(&out);
+    opts.SetSourceSize(utf16.size());
+    opts.SetEscapeNonPrintables(true);
+    DataExtractor extractor(utf16.data(), utf16.size() * sizeof(char16_t),
+                            endian::InlHostByteOrder(), sizeof(void *));
+    opts.SetData(extractor);
+    return StringPrinter::ReadBufferAndDumpToStream<
+        StringPrinter::StringElementType::UTF16>(opts);
+  };
+
+  constexpr unsigned iterations = 20;
+  auto time = [&](StringRef name, auto print) {
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; ++i)
+      ASSERT_TRUE(print());
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    llvm::outs() << llvm::formatv("{0}: {1:f2} ms per string of 1MiB\n", name,
+                                  elapsed.count() / iterations);
+  };
+  time("ascii", [&] {
+    return format<StringPrinter::StringElementType::ASCII>(
+               ascii, StringPrinter::EscapeStyle::CXX)
+        .hasValue();
+  });
+  time("utf8", [&] {
+    return format<StringPrinter::StringElementType::UTF8>(
+               utf8, StringPrinter::EscapeStyle::CXX)
+        .hasValue();
+  });
+  time("utf16", print_utf16);
+}
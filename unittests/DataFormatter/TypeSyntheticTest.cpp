@@ -0,0 +1,70 @@
+//===-- TypeSyntheticTest.cpp ---------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/DataFormatters/TypeSynthetic.h"
+
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace lldb_private;
+
+typedef DeclarativeSyntheticChildren::Layout Layout;
+
+TEST(DeclarativeSyntheticChildrenTest, ParseArrayLayout) {
+  llvm::Expected<Layout> layout = DeclarativeSyntheticChildren::ParseLayout(
+      R"({"kind": "array", "data": "m_data", "size": "m_header.m_size",
+          "element_type": "Point"})");
+  ASSERT_THAT_EXPECTED(layout, llvm::Succeeded());
+  EXPECT_EQ(Layout::Kind::Array, layout->kind);
+  EXPECT_EQ("m_data", layout->data);
+  EXPECT_EQ("m_header.m_size", layout->size);
+  EXPECT_EQ("", layout->end);
+  EXPECT_EQ("Point", layout->element_type);
+
+  layout = DeclarativeSyntheticChildren::ParseLayout(
+      R"({"kind": "array", "data": "begin", "end": "end"})");
+  ASSERT_THAT_EXPECTED(layout, llvm::Succeeded());
+  EXPECT_EQ("end", layout->end);
+}
+
+TEST(DeclarativeSyntheticChildrenTest, ParseListLayout) {
+  llvm::Expected<Layout> layout = DeclarativeSyntheticChildren::ParseLayout(
+      R"({"kind": "list", "head": "->m_first", "next": "m_next",
+          "value": "m_value"})");
+  ASSERT_THAT_EXPECTED(layout, llvm::Succeeded());
+  EXPECT_EQ(Layout::Kind::List, layout->kind);
+  EXPECT_EQ("->m_first", layout->head);
+  EXPECT_EQ("m_next", layout->next);
+  EXPECT_EQ("m_value", layout->value);
+  EXPECT_EQ("", layout->size);
+}
+
+TEST(DeclarativeSyntheticChildrenTest, ParseInvalidLayout) {
+  auto parse = [](llvm::StringRef json) {
+    return DeclarativeSyntheticChildren::ParseLayout(json);
+  };
+  EXPECT_THAT_EXPECTED(parse("[]"), llvm::Failed());
+  EXPECT_THAT_EXPECTED(parse(R"({"data": "p", "size": "n"})"),
+                       llvm::Failed());
+  EXPECT_THAT_EXPECTED(parse(R"({"kind": "tree"})"), llvm::Failed());
+  EXPECT_THAT_EXPECTED(parse(R"({"kind": "array", "data": "p"})"),
+                       llvm::Failed());
+  EXPECT_THAT_EXPECTED(
+      parse(R"({"kind": "array", "data": "p", "size": "n", "end": "e"})"),
+      llvm::Failed());
+  EXPECT_THAT_EXPECTED(
+      parse(R"({"kind": "array", "data": "p", "size": "n", "next": "x"})"),
+      llvm::Failed());
+  EXPECT_THAT_EXPECTED(parse(R"({"kind": "list", "head": "h", "next": "n"})"),
+                       llvm::Failed());
+  EXPECT_THAT_EXPECTED(
+      parse(R"({"kind": "array", "data": "p", "size": 3})"), llvm::Failed());
+  EXPECT_THAT_EXPECTED(
+      parse(R"({"kind": "array", "data": "p", "size": "n", "stride": "4"})"),
+      llvm::Failed());
+}
@@ -11,6 +11,8 @@
 
 #include "lldb/Host/FileSystem.h"
 #include "llvm/Support/Errc.h"
+#include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/raw_ostream.h"
 
 extern const char *TestMainArgv0;
 
@@ -329,3 +331,40 @@ TEST(FileSystemTest, EmptyTest) {
   EXPECT_FALSE(fs.IsDirectory(spec));
   EXPECT_FALSE(fs.IsLocal(spec));
 }
+
+TEST(FileSystemTest, CreateSharedDataBuffer) {
+  const auto *Info = testing::UnitTest::GetInstance()->current_test_info();
+  llvm::SmallString<128> name;
+  int fd;
+  ASSERT_FALSE(llvm::sys::fs::createTemporaryFile(
+      llvm::Twine(Info->test_case_name()) + "-" + Info->name(), "test", fd,
+      name));
+  llvm::FileRemover remover(name);
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose*/ true);
+    os << "0123456789abcdef";
+  }
+
+  FileSystem fs;
+  std::shared_ptr<DataBufferLLVM> buffer_sp = fs.CreateSharedDataBuffer(name);
+  ASSERT_TRUE(buffer_sp);
+  EXPECT_EQ(16u, buffer_sp->GetByteSize());
+
+  // The same region of the same file is mapped only once.
+  EXPECT_EQ(buffer_sp, fs.CreateSharedDataBuffer(name));
+
+  // Other regions of the file get their own buffer.
+  std::shared_ptr<DataBufferLLVM> slice_sp =
+      fs.CreateSharedDataBuffer(name, 4, 8);
+  ASSERT_TRUE(slice_sp);
+  EXPECT_NE(buffer_sp, slice_sp);
+  EXPECT_EQ("89ab", llvm::StringRef(slice_sp->GetChars(), 4));
+
+  // Buffers are not kept alive by the file system.
+  std::weak_ptr<DataBufferLLVM> weak_buffer_wp = buffer_sp;
+  buffer_sp.reset();
+  EXPECT_TRUE(weak_buffer_wp.expired());
+  EXPECT_TRUE(fs.CreateSharedDataBuffer(name));
+
+  EXPECT_FALSE(fs.CreateSharedDataBuffer("/file/that/does/not/exist.txt"));
+}
@@ -12,14 +12,19 @@
 #include "TestingSupport/SubsystemRAII.h"
 #include "TestingSupport/TestUtilities.h"
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/HostInfo.h"
 #include "lldb/Utility/DataBufferHeap.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/Support/Compression.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/raw_ostream.h"
@@ -276,3 +281,228 @@ Sections:
   auto entry_point_addr = module_sp->GetObjectFile()->GetEntryPointAddress();
   ASSERT_EQ(entry_point_addr.GetAddressClass(), AddressClass::eCode);
 }
+
+static llvm::Expected<TestFile>
+CreateFileWithCompressedSection(llvm::StringRef compressed_content,
+                                llvm::StringRef extra_sections = "") {
+  return TestFile::fromYaml(llvm::formatv(R"(
+--- !ELF
+FileHeader:
+  Class:           ELFCLASS64
+  Data:            ELFDATA2LSB
+  Type:            ET_EXEC
+  Machine:         EM_X86_64
+Sections:
+  - Name:            .note.gnu.build-id
+    Type:            SHT_NOTE
+    Flags:           [ SHF_ALLOC ]
+    AddressAlign:    0x0000000000000004
+    Content:         040000001400000003000000474E55003F3EC29E3FD83E49D18C4D49CD8A730CC13117B6
+  - Name:            .zdebug_info
+    Type:            SHT_PROGBITS
+    Content:         5A4C49420000000000000008{0}
+{1}
+...
+)",
+                                          compressed_content, extra_sections)
+                                .str());
+}
+
+/// \return
+///     The names of the files in the decompressed section cache for the
+///     build-id of the test files.
+static std::vector<std::string>
+GetDecompressedSectionCacheFiles(llvm::StringRef cache_dir) {
+  FileSpec build_id_dir(cache_dir);
+  build_id_dir.AppendPathComponent("3F3EC29E3FD83E49D18C4D49CD8A730CC13117B6");
+  std::vector<std::string> names;
+  std::error_code ec;
+  for (llvm::sys::fs::directory_iterator it(build_id_dir.GetPath(), ec), end;
+       !ec && it != end; it.increment(ec))
+    names.push_back(it->path());
+  llvm::sort(names);
+  return names;
+}
+
+static std::vector<uint8_t> ReadDebugInfo(TestFile &file) {
+  auto module_sp = std::make_shared<Module>(file.moduleSpec());
+  SectionSP section_sp = module_sp->GetSectionList()->FindSectionByName(
+      ConstString(".zdebug_info"));
+  if (!section_sp)
+    return {};
+  DataExtractor data;
+  module_sp->GetObjectFile()->ReadSectionData(section_sp.get(), data);
+  return std::vector<uint8_t>(data.GetDataStart(), data.GetDataEnd());
+}
+
+TEST_F(ObjectFileELFTest, DecompressedSectionCache) {
+  if (!llvm::zlib::isAvailable())
+    return;
+
+  llvm::SmallString<128> cache_dir;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory(
+      "decompressed-section-cache", cache_dir));
+  ModuleListProperties &properties =
+      ModuleList::GetGlobalModuleListProperties();
+  properties.SetDecompressedSectionCachePath(FileSpec(cache_dir));
+  auto cleanup = llvm::make_scope_exit([&] {
+    properties.SetDecompressedSectionCachePath(FileSpec());
+    llvm::sys::fs::remove_directories(cache_dir);
+  });
+
+  auto ExpectedFile =
+      CreateFileWithCompressedSection("789c5330700848286898000009c802c1");
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+  const std::vector<uint8_t> expected = {0x20, 0x30, 0x40, 0x50,
+                                         0x60, 0x70, 0x80, 0x90};
+
+  // The first read stores the decompressed section in the cache.
+  EXPECT_EQ(expected, ReadDebugInfo(*ExpectedFile));
+  std::vector<std::string> cache_files =
+      GetDecompressedSectionCacheFiles(cache_dir);
+  ASSERT_EQ(1u, cache_files.size());
+  EXPECT_TRUE(llvm::StringRef(llvm::sys::path::filename(cache_files[0]))
+                  .startswith(".zdebug_info-"));
+
+  // The second read from a new module gets the contents from the cache, which
+  // is shown by changing the cached contents.
+  {
+    std::error_code ec;
+    llvm::raw_fd_ostream os(cache_files[0], ec);
+    ASSERT_FALSE(ec);
+    os << "cached!!";
+  }
+  EXPECT_EQ(std::vector<uint8_t>({'c', 'a', 'c', 'h', 'e', 'd', '!', '!'}),
+            ReadDebugInfo(*ExpectedFile));
+
+  // A file with the same build-id but other contents of the same size must not
+  // get the cached contents of the first file.
+  auto ExpectedOtherFile =
+      CreateFileWithCompressedSection("789c63646266616563e7000000800025");
+  ASSERT_THAT_EXPECTED(ExpectedOtherFile, llvm::Succeeded());
+  EXPECT_EQ(std::vector<uint8_t>({1, 2, 3, 4, 5, 6, 7, 8}),
+            ReadDebugInfo(*ExpectedOtherFile));
+}
+
+TEST_F(ObjectFileELFTest, RelocationsDoNotChangeSharedFileData) {
+  auto ExpectedFile = TestFile::fromYaml(R"(
+--- !ELF
+FileHeader:
+  Class:           ELFCLASS64
+  Data:            ELFDATA2LSB
+  Type:            ET_REL
+  Machine:         EM_X86_64
+Sections:
+  - Name:            .debug_str
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_MERGE, SHF_STRINGS ]
+    AddressAlign:    0x0000000000000001
+    Size:            0x50
+  - Name:            .debug_info
+    Type:            SHT_PROGBITS
+    AddressAlign:    0x0000000000000001
+    Content:         0000000000000000
+  - Name:            .rela.debug_info
+    Type:            SHT_RELA
+    Link:            .symtab
+    AddressAlign:    0x0000000000000008
+    Info:            .debug_info
+    Relocations:
+      - Offset:          0x0000000000000000
+        Symbol:          .debug_str
+        Type:            R_X86_64_32
+        Addend:          45
+Symbols:
+  - Name:            .debug_str
+    Type:            STT_SECTION
+    Section:         .debug_str
+  - Name:            .debug_info
+    Type:            STT_SECTION
+    Section:         .debug_info
+...
+)");
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+
+  // The mappings of files are only shared for modules created from a file.
+  llvm::SmallString<128> path;
+  ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("relocations", "o", path));
+  auto cleanup = llvm::make_scope_exit([&] { llvm::sys::fs::remove(path); });
+  {
+    DataBufferSP data_sp = ExpectedFile->moduleSpec().GetData();
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path, ec);
+    ASSERT_FALSE(ec);
+    os.write(reinterpret_cast<const char *>(data_sp->GetBytes()),
+             data_sp->GetByteSize());
+  }
+
+  ModuleSpec spec{FileSpec(path)};
+  auto module_sp = std::make_shared<Module>(spec);
+  auto other_module_sp = std::make_shared<Module>(spec);
+  ObjectFile *other_objfile = other_module_sp->GetObjectFile();
+  ASSERT_NE(nullptr, other_objfile);
+
+  // Reading the section from the first module relocates it.
+  SectionSP section_sp = module_sp->GetSectionList()->FindSectionByName(
+      ConstString(".debug_info"));
+  ASSERT_NE(nullptr, section_sp);
+  DataExtractor data;
+  ASSERT_EQ(8u, module_sp->GetObjectFile()->ReadSectionData(section_sp.get(),
+                                                            data));
+  lldb::offset_t offset = 0;
+  EXPECT_EQ(45u, data.GetU32(&offset));
+
+  // The raw data of the other module is left unchanged.
+  SectionSP other_section_sp =
+      other_module_sp->GetSectionList()->FindSectionByName(
+          ConstString(".debug_info"));
+  ASSERT_NE(nullptr, other_section_sp);
+  DataExtractor raw_data;
+  ASSERT_EQ(8u, other_objfile->GetData(other_section_sp->GetFileOffset(), 8,
+                                       raw_data));
+  offset = 0;
+  EXPECT_EQ(0u, raw_data.GetU32(&offset));
+}
+
+TEST_F(ObjectFileELFTest, PrefetchCompressedSections) {
+  if (!llvm::zlib::isAvailable())
+    return;
+
+  llvm::SmallString<128> cache_dir;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory(
+      "decompressed-section-cache", cache_dir));
+  ModuleListProperties &properties =
+      ModuleList::GetGlobalModuleListProperties();
+  properties.SetDecompressedSectionCachePath(FileSpec(cache_dir));
+  auto cleanup = llvm::make_scope_exit([&] {
+    properties.SetDecompressedSectionCachePath(FileSpec());
+    llvm::sys::fs::remove_directories(cache_dir);
+  });
+
+  auto ExpectedFile = CreateFileWithCompressedSection(
+      "789c5330700848286898000009c802c1", R"(
+  - Name:            .zdebug_abbrev
+    Type:            SHT_PROGBITS
+    Content:         5A4C49420000000000000008789c63646266616563e7000000800025)");
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+  auto module_sp = std::make_shared<Module>(ExpectedFile->moduleSpec());
+  SectionList *list = module_sp->GetSectionList();
+  ASSERT_NE(nullptr, list);
+  SectionSP info_sp = list->FindSectionByName(ConstString(".zdebug_info"));
+  SectionSP abbrev_sp = list->FindSectionByName(ConstString(".zdebug_abbrev"));
+  ASSERT_NE(nullptr, info_sp);
+  ASSERT_NE(nullptr, abbrev_sp);
+
+  // Both sections are decompressed, and cached, before they are read.
+  module_sp->GetObjectFile()->PrefetchSectionData({info_sp, abbrev_sp});
+  EXPECT_EQ(2u, GetDecompressedSectionCacheFiles(cache_dir).size());
+
+  DataExtractor data;
+  module_sp->GetObjectFile()->ReadSectionData(info_sp.get(), data);
+  EXPECT_EQ(std::vector<uint8_t>({0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80,
+                                  0x90}),
+            std::vector<uint8_t>(data.GetDataStart(), data.GetDataEnd()));
+  module_sp->GetObjectFile()->ReadSectionData(abbrev_sp.get(), data);
+  EXPECT_EQ(std::vector<uint8_t>({1, 2, 3, 4, 5, 6, 7, 8}),
+            std::vector<uint8_t>(data.GetDataStart(), data.GetDataEnd()));
+}
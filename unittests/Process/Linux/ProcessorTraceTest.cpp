@@ -145,3 +145,91 @@ TEST(CyclicBuffer, BiggerSizeBuffer) {
     ASSERT_STREQ(bigger_buffer, (cyclic + i));
   }
 }
+
+uint64_t ReadRingBufferWrapper(char *buf, size_t buf_size,
+                               const uint8_t *ring_buf, size_t ring_buf_size,
+                               uint64_t tail, uint64_t head,
+                               size_t &bytes_read) {
+  llvm::MutableArrayRef<uint8_t> dst(reinterpret_cast<uint8_t *>(buf),
+                                     buf_size);
+  llvm::ArrayRef<uint8_t> src(ring_buf, ring_buf_size);
+  uint64_t new_tail =
+      ProcessorTraceMonitor::ReadRingBuffer(dst, src, tail, head);
+  bytes_read = dst.size();
+  return new_tail;
+}
+
+TEST(RingBuffer, Incremental) {
+  size_t bytes_read;
+  uint8_t ring_buffer[6] = {'g', 'b', 'r', 'i', 'n', 'g'};
+
+  // Nothing new to read
+  {
+    char buffer[8] = {};
+    ASSERT_EQ(3u, ReadRingBufferWrapper(buffer, sizeof(buffer) - 1,
+                                        ring_buffer, sizeof(ring_buffer), 3, 3,
+                                        bytes_read));
+    ASSERT_EQ(0u, bytes_read);
+  }
+
+  // Data that doesn't wrap around
+  {
+    char buffer[8] = {};
+    ASSERT_EQ(5u, ReadRingBufferWrapper(buffer, sizeof(buffer) - 1,
+                                        ring_buffer, sizeof(ring_buffer), 3, 5,
+                                        bytes_read));
+    ASSERT_EQ(2u, bytes_read);
+    ASSERT_STREQ(buffer, "in");
+  }
+
+  // Data that wraps around, with pointers bigger than the buffer size
+  {
+    char buffer[8] = {};
+    ASSERT_EQ(14u, ReadRingBufferWrapper(buffer, sizeof(buffer) - 1,
+                                         ring_buffer, sizeof(ring_buffer), 9,
+                                         14, bytes_read));
+    ASSERT_EQ(5u, bytes_read);
+    ASSERT_STREQ(buffer, "inggb");
+  }
+
+  // A destination buffer smaller than the new data
+  {
+    char buffer[4] = {};
+    ASSERT_EQ(12u, ReadRingBufferWrapper(buffer, sizeof(buffer) - 1,
+                                         ring_buffer, sizeof(ring_buffer), 9,
+                                         14, bytes_read));
+    ASSERT_EQ(3u, bytes_read);
+    ASSERT_STREQ(buffer, "ing");
+  }
+
+  // The producer overwrote unconsumed data
+  {
+    char buffer[8] = {};
+    ASSERT_EQ(20u, ReadRingBufferWrapper(buffer, sizeof(buffer) - 1,
+                                         ring_buffer, sizeof(ring_buffer), 2,
+                                         20, bytes_read));
+    ASSERT_EQ(6u, bytes_read);
+    ASSERT_STREQ(buffer, "ringgb");
+  }
+}
+
+TEST(RingBuffer, DataIsNotCopied) {
+  uint8_t ring_buffer[6] = {'g', 'b', 'r', 'i', 'n', 'g'};
+  llvm::ArrayRef<uint8_t> src(ring_buffer, sizeof(ring_buffer));
+  llvm::ArrayRef<uint8_t> first_part, second_part;
+
+  // Data that wraps around is returned as two parts of the ring buffer.
+  ASSERT_EQ(14u, ProcessorTraceMonitor::GetRingBufferData(
+                     src, 9, 14, 8, first_part, second_part));
+  ASSERT_EQ(ring_buffer + 3, first_part.data());
+  ASSERT_EQ(3u, first_part.size());
+  ASSERT_EQ(ring_buffer, second_part.data());
+  ASSERT_EQ(2u, second_part.size());
+
+  // Data that doesn't wrap around only has a first part.
+  ASSERT_EQ(5u, ProcessorTraceMonitor::GetRingBufferData(
+                    src, 3, 5, 8, first_part, second_part));
+  ASSERT_EQ(ring_buffer + 3, first_part.data());
+  ASSERT_EQ(2u, first_part.size());
+  ASSERT_TRUE(second_part.empty());
+}
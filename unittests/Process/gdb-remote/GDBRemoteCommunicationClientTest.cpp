@@ -320,6 +320,22 @@ TEST_F(GDBRemoteCommunicationClientTest, SendSignalsToIgnore) {
   EXPECT_TRUE(result.get().Success());
 }
 
+TEST_F(GDBRemoteCommunicationClientTest, SendConditionalBreakpoint) {
+  std::future<uint8_t> result = std::async(std::launch::async, [&] {
+    return client.SendGDBStoppointTypePacket(eBreakpointSoftware, true, 0x1000,
+                                             1, {{0x22, 0x01, 0x27}, {0x27}});
+  });
+  HandlePacket(server, "Z0,1000,1;X3,220127X1,27", "OK");
+  EXPECT_EQ(0, result.get());
+
+  result = std::async(std::launch::async, [&] {
+    return client.SendGDBStoppointTypePacket(eBreakpointSoftware, false,
+                                             0x1000, 1);
+  });
+  HandlePacket(server, "z0,1000,1", "OK");
+  EXPECT_EQ(0, result.get());
+}
+
 TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegionInfo) {
   const lldb::addr_t addr = 0xa000;
   MemoryRegionInfo region_info;
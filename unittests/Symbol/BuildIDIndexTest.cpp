@@ -0,0 +1,140 @@
+//===-- BuildIDIndexTest.cpp ----------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "TestingSupport/SubsystemRAII.h"
+#include "TestingSupport/TestUtilities.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Host/FileSystem.h"
+#include "lldb/Symbol/BuildIDIndex.h"
+#include "lldb/Utility/Reproducer.h"
+
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace lldb_private;
+
+namespace {
+class BuildIDIndexTest : public ::testing::Test {
+public:
+  SubsystemRAII<repro::Reproducer, FileSystem> subsystems;
+  llvm::SmallString<128> m_store_dir;
+
+  void SetUp() override {
+    ASSERT_NO_ERROR(
+        llvm::sys::fs::createUniqueDirectory("BuildIDIndex", m_store_dir));
+    CreateDebugFile("ab", "cdef01.debug");
+    CreateDebugFile("ab", "cdef02.debug");
+    CreateDebugFile("12", "3456.debug");
+  }
+
+  void TearDown() override {
+    BuildIDIndex::Clear();
+    ASSERT_NO_ERROR(llvm::sys::fs::remove_directories(m_store_dir));
+  }
+
+  void CreateDebugFile(llvm::StringRef bucket, llvm::StringRef name) {
+    llvm::SmallString<128> path = m_store_dir;
+    llvm::sys::path::append(path, ".build-id", bucket);
+    ASSERT_NO_ERROR(llvm::sys::fs::create_directories(path));
+    llvm::sys::path::append(path, name);
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path, ec);
+    ASSERT_NO_ERROR(ec);
+  }
+};
+} // namespace
+
+static UUID MakeUUID(std::initializer_list<uint8_t> bytes) {
+  return UUID::fromData(llvm::makeArrayRef(bytes.begin(), bytes.size()));
+}
+
+TEST_F(BuildIDIndexTest, Lookup) {
+  std::shared_ptr<BuildIDIndex> index =
+      BuildIDIndex::GetIndexForDirectory(FileSpec(m_store_dir));
+
+  FileSpec found = index->Lookup(MakeUUID({0xab, 0xcd, 0xef, 0x01}));
+  llvm::SmallString<128> expected = m_store_dir;
+  llvm::sys::path::append(expected, ".build-id", "ab", "cdef01.debug");
+  EXPECT_EQ(FileSpec(expected), found);
+
+  // Missing files in existing and missing buckets.
+  EXPECT_FALSE(index->Lookup(MakeUUID({0xab, 0xcd, 0xef, 0x03})));
+  EXPECT_FALSE(index->Lookup(MakeUUID({0xff, 0xcd, 0xef, 0x01})));
+  EXPECT_FALSE(index->Lookup(UUID()));
+}
+
+TEST_F(BuildIDIndexTest, BatchedLookup) {
+  std::shared_ptr<BuildIDIndex> index =
+      BuildIDIndex::GetIndexForDirectory(FileSpec(m_store_dir));
+
+  std::vector<UUID> uuids = {MakeUUID({0x12, 0x34, 0x56}),
+                             MakeUUID({0x12, 0x34, 0x57}),
+                             MakeUUID({0xab, 0xcd, 0xef, 0x02})};
+  std::vector<FileSpec> files = index->Lookup(uuids);
+  ASSERT_EQ(3u, files.size());
+  EXPECT_EQ("3456.debug", files[0].GetFilename().GetStringRef());
+  EXPECT_FALSE(files[1]);
+  EXPECT_EQ("cdef02.debug", files[2].GetFilename().GetStringRef());
+}
+
+TEST_F(BuildIDIndexTest, MissingStore) {
+  llvm::SmallString<128> path = m_store_dir;
+  llvm::sys::path::append(path, "missing");
+  std::shared_ptr<BuildIDIndex> index =
+      BuildIDIndex::GetIndexForDirectory(FileSpec(path));
+  EXPECT_FALSE(index->Lookup(MakeUUID({0x12, 0x34, 0x56})));
+}
+
+TEST_F(BuildIDIndexTest, SavedIndexIsRevalidated) {
+  llvm::SmallString<128> cache_dir;
+  ASSERT_NO_ERROR(
+      llvm::sys::fs::createUniqueDirectory("BuildIDIndexCache", cache_dir));
+  ModuleListProperties &properties =
+      ModuleList::GetGlobalModuleListProperties();
+  properties.SetBuildIDIndexCachePath(FileSpec(cache_dir));
+  auto cleanup = llvm::make_scope_exit([&] {
+    properties.SetBuildIDIndexCachePath(FileSpec());
+    llvm::sys::fs::remove_directories(cache_dir);
+  });
+
+  // Index the "ab" bucket. The index is only written when it is saved.
+  std::shared_ptr<BuildIDIndex> saved_index =
+      BuildIDIndex::GetIndexForDirectory(FileSpec(m_store_dir));
+  EXPECT_TRUE(saved_index->Lookup(MakeUUID({0xab, 0xcd, 0xef, 0x01})));
+  std::error_code ec;
+  EXPECT_EQ(llvm::sys::fs::directory_iterator(cache_dir, ec),
+            llvm::sys::fs::directory_iterator());
+  saved_index->Save();
+  EXPECT_NE(llvm::sys::fs::directory_iterator(cache_dir, ec),
+            llvm::sys::fs::directory_iterator());
+  saved_index.reset();
+  BuildIDIndex::Clear();
+
+  // Add a file to the bucket, making sure its modification time changes even
+  // on file systems with a coarse time resolution.
+  CreateDebugFile("ab", "cdef03.debug");
+  llvm::SmallString<128> bucket_path = m_store_dir;
+  llvm::sys::path::append(bucket_path, ".build-id", "ab");
+  int fd;
+  ASSERT_NO_ERROR(llvm::sys::fs::openFileForRead(bucket_path, fd));
+  ec = llvm::sys::fs::setLastAccessAndModificationTime(
+      fd, llvm::sys::TimePoint<>(std::chrono::hours(1)));
+  llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+  ASSERT_NO_ERROR(ec);
+
+  // The new index loads the saved one, which no longer matches the bucket.
+  std::shared_ptr<BuildIDIndex> index =
+      BuildIDIndex::GetIndexForDirectory(FileSpec(m_store_dir));
+  EXPECT_TRUE(index->Lookup(MakeUUID({0xab, 0xcd, 0xef, 0x01})));
+  EXPECT_TRUE(index->Lookup(MakeUUID({0xab, 0xcd, 0xef, 0x03})));
+}
@@ -8,20 +8,32 @@
 
 #include "gtest/gtest.h"
 
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
 #include "TestingSupport/SubsystemRAII.h"
+#include "TestingSupport/TestUtilities.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/BuildIDIndex.h"
 #include "lldb/Symbol/LocateSymbolFile.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Utility/DataBuffer.h"
 #include "lldb/Utility/Reproducer.h"
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Testing/Support/Error.h"
 
 using namespace lldb_private;
 
 namespace {
 class SymbolsTest : public ::testing::Test {
 public:
-  SubsystemRAII<repro::Reproducer, FileSystem, HostInfo> subsystems;
+  SubsystemRAII<repro::Reproducer, FileSystem, HostInfo, ObjectFileELF>
+      subsystems;
 };
 } // namespace
 
@@ -46,3 +58,69 @@ TEST_F(SymbolsTest,
       Symbols::LocateExecutableSymbolFile(module_spec, search_paths);
   EXPECT_TRUE(symbol_file_spec.GetFilename().IsEmpty());
 }
+
+TEST_F(SymbolsTest, LocateExecutableSymbolFilesInBuildIDStore) {
+  auto ExpectedFile = TestFile::fromYaml(R"(
+--- !ELF
+FileHeader:
+  Class:           ELFCLASS64
+  Data:            ELFDATA2LSB
+  Type:            ET_EXEC
+  Machine:         EM_X86_64
+Sections:
+  - Name:            .note.gnu.build-id
+    Type:            SHT_NOTE
+    Flags:           [ SHF_ALLOC ]
+    AddressAlign:    0x0000000000000004
+    Content:         040000001400000003000000474E55003F3EC29E3FD83E49D18C4D49CD8A730CC13117B6
+...
+)");
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+
+  llvm::SmallString<128> store_dir;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("symbol-store", store_dir));
+  auto cleanup = llvm::make_scope_exit([&] {
+    BuildIDIndex::Clear();
+    llvm::sys::fs::remove_directories(store_dir);
+  });
+  llvm::SmallString<128> debug_file = store_dir;
+  llvm::sys::path::append(debug_file, ".build-id", "3f");
+  ASSERT_FALSE(llvm::sys::fs::create_directories(debug_file));
+  llvm::sys::path::append(debug_file,
+                          "3ec29e3fd83e49d18c4d49cd8a730cc13117b6.debug");
+  {
+    lldb::DataBufferSP data_sp = ExpectedFile->moduleSpec().GetData();
+    std::error_code ec;
+    llvm::raw_fd_ostream os(debug_file, ec);
+    ASSERT_FALSE(ec);
+    os.write(reinterpret_cast<const char *>(data_sp->GetBytes()),
+             data_sp->GetByteSize());
+  }
+
+  ModuleSpec found_spec(FileSpec("/missing/found.so"));
+  found_spec.GetUUID().SetFromStringRef(
+      "3F3EC29E3FD83E49D18C4D49CD8A730CC13117B6");
+  ModuleSpec missing_spec(FileSpec("/missing/missing.so"));
+  missing_spec.GetUUID().SetFromStringRef(
+      "3F3EC29E3FD83E49D18C4D49CD8A730CC13117B7");
+
+  FileSpecList search_paths;
+  search_paths.Append(FileSpec(store_dir));
+  std::vector<FileSpec> files = Symbols::LocateExecutableSymbolFiles(
+      {found_spec, missing_spec}, search_paths);
+  ASSERT_EQ(2u, files.size());
+  EXPECT_EQ(FileSpec(debug_file), files[0]);
+  EXPECT_FALSE(files[1]);
+
+  // Locating a single module gives the same result.
+  EXPECT_EQ(FileSpec(debug_file),
+            Symbols::LocateExecutableSymbolFile(found_spec, search_paths));
+
+  // The symbol files located for a list of loaded modules become the symbol
+  // files of the modules.
+  auto module_sp = std::make_shared<Module>(ExpectedFile->moduleSpec());
+  ModuleList module_list;
+  module_list.Append(module_sp);
+  Symbols::LocateSymbolFilesForModules(module_list, search_paths);
+  EXPECT_EQ(FileSpec(debug_file), module_sp->GetSymbolFileFileSpec());
+}
@@ -16,15 +16,22 @@
 #include "TestingSupport/TestUtilities.h"
 
 #include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/CompiledUnwindTable.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
 #include "lldb/Utility/StreamString.h"
 #include "llvm/Testing/Support/Error.h"
 
+#include "llvm/ADT/ScopeExit.h"
+
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/raw_ostream.h"
@@ -74,9 +81,11 @@ static UnwindPlan::Row GetExpectedRow2() {
   return row;
 }
 
-void DWARFCallFrameInfoTest::TestBasic(DWARFCallFrameInfo::Type type,
-                                       llvm::StringRef symbol) {
-  auto ExpectedFile = TestFile::fromYaml(R"(
+/// \param[in] extra_sections
+///     YAML of sections to add to the test file.
+static llvm::Expected<TestFile>
+CreateTestFile(llvm::StringRef extra_sections = "") {
+  return TestFile::fromYaml((R"(
 --- !ELF
 FileHeader:
   Class:           ELFCLASS64
@@ -197,6 +206,7 @@ Sections:
 #  DW_CFA_offset: r6 (rbp) at cfa-16
 #  DW_CFA_advance_loc: 3 to 0000000000000284
 #  DW_CFA_def_cfa_register: r6 (rbp)
+)" + extra_sections + R"(
 Symbols:
   - Name:            eh_frame
     Type:            STT_FUNC
@@ -217,7 +227,13 @@ Symbols:
     Size:            0x000000000000000C
     Binding:         STB_GLOBAL
 ...
-)");
+)")
+                                .str());
+}
+
+void DWARFCallFrameInfoTest::TestBasic(DWARFCallFrameInfo::Type type,
+                                       llvm::StringRef symbol) {
+  auto ExpectedFile = CreateTestFile();
   ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
 
   auto module_sp = std::make_shared<Module>(ExpectedFile->moduleSpec());
@@ -255,3 +271,187 @@ TEST_F(DWARFCallFrameInfoTest, Basic_dwarf4) {
 TEST_F(DWARFCallFrameInfoTest, Basic_eh) {
   TestBasic(DWARFCallFrameInfo::EH, "eh_frame");
 }
+
+TEST_F(DWARFCallFrameInfoTest, CompiledUnwindTable) {
+  auto ExpectedFile = CreateTestFile();
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+
+  auto module_sp = std::make_shared<Module>(ExpectedFile->moduleSpec());
+  SectionList *list = module_sp->GetSectionList();
+  ASSERT_NE(nullptr, list);
+
+  auto section_sp = list->FindSectionByType(eSectionTypeEHFrame, false);
+  ASSERT_NE(nullptr, section_sp);
+
+  DWARFCallFrameInfo cfi(*module_sp->GetObjectFile(), section_sp,
+                         DWARFCallFrameInfo::EH);
+  CompiledUnwindTable table(cfi);
+
+  // Each row of the eh_frame plan becomes a single row plan at offset 0.
+  UnwindPlan::Row expected_rows[] = {GetExpectedRow0(), GetExpectedRow1(),
+                                     GetExpectedRow2()};
+  for (UnwindPlan::Row &row : expected_rows)
+    row.SetOffset(0);
+
+  UnwindPlanSP plan_sp = table.GetUnwindPlanAtCallSite(Address(0x260, list));
+  ASSERT_NE(nullptr, plan_sp);
+  ASSERT_EQ(1, plan_sp->GetRowCount());
+  EXPECT_EQ(eRegisterKindEHFrame, plan_sp->GetRegisterKind());
+  EXPECT_EQ(expected_rows[0], *plan_sp->GetRowAtIndex(0));
+
+  plan_sp = table.GetUnwindPlanAtCallSite(Address(0x263, list));
+  ASSERT_NE(nullptr, plan_sp);
+  EXPECT_EQ(expected_rows[1], *plan_sp->GetRowAtIndex(0));
+
+  plan_sp = table.GetUnwindPlanAtCallSite(Address(0x267, list));
+  ASSERT_NE(nullptr, plan_sp);
+  EXPECT_EQ(expected_rows[2], *plan_sp->GetRowAtIndex(0));
+
+  // The plans of a row are shared by all its addresses.
+  EXPECT_EQ(plan_sp, table.GetUnwindPlanAtCallSite(Address(0x26a, list)));
+
+  // Only the first function has eh_frame rules.
+  EXPECT_EQ(nullptr, table.GetUnwindPlanAtCallSite(Address(0x274, list)));
+}
+
+TEST_F(DWARFCallFrameInfoTest, EHFrameHdr) {
+  // The lookup table has a single entry for the FDE at offset 0x18 of the
+  // eh_frame section, describing the function at 0x260.
+  auto ExpectedFile = CreateTestFile(R"(
+  - Name:            .eh_frame_hdr
+    Type:            SHT_PROGBITS
+    Flags:           [ SHF_ALLOC ]
+    Address:         0x00000000000002C8
+    AddressAlign:    0x0000000000000004
+    Content:         011B033BC4FFFFFF0100000098FFFFFFE0FFFFFF
+#  version:          1
+#  eh_frame_ptr_enc: DW_EH_PE_pcrel | DW_EH_PE_sdata4
+#  fde_count_enc:    DW_EH_PE_udata4
+#  table_enc:        DW_EH_PE_datarel | DW_EH_PE_sdata4
+#  eh_frame_ptr:     0x290
+#  fde_count:        1
+#  table:            0x260 -> 0x2a8
+)");
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+
+  auto module_sp = std::make_shared<Module>(ExpectedFile->moduleSpec());
+  SectionList *list = module_sp->GetSectionList();
+  ASSERT_NE(nullptr, list);
+
+  auto section_sp = list->FindSectionByType(eSectionTypeEHFrame, false);
+  ASSERT_NE(nullptr, section_sp);
+
+  DWARFCallFrameInfo cfi(*module_sp->GetObjectFile(), section_sp,
+                         DWARFCallFrameInfo::EH);
+
+  AddressRange range;
+  ASSERT_TRUE(cfi.GetAddressRange(Address(0x265, list), range));
+  EXPECT_EQ(0x260u, range.GetBaseAddress().GetFileAddress());
+  EXPECT_EQ(0xcu, range.GetByteSize());
+  EXPECT_FALSE(cfi.GetAddressRange(Address(0x25f, list), range));
+  EXPECT_FALSE(cfi.GetAddressRange(Address(0x270, list), range));
+
+  UnwindPlan plan(eRegisterKindGeneric);
+  ASSERT_TRUE(cfi.GetUnwindPlan(Address(0x260, list), plan));
+  ASSERT_EQ(3, plan.GetRowCount());
+  EXPECT_EQ(GetExpectedRow0(), *plan.GetRowAtIndex(0));
+  EXPECT_EQ(GetExpectedRow1(), *plan.GetRowAtIndex(1));
+  EXPECT_EQ(GetExpectedRow2(), *plan.GetRowAtIndex(2));
+
+  // The full index is built from the table too.
+  std::vector<std::tuple<addr_t, uint32_t, dw_offset_t>> entries;
+  cfi.ForEachFDEEntries([&](addr_t addr, uint32_t size, dw_offset_t offset) {
+    entries.emplace_back(addr, size, offset);
+    return true;
+  });
+  EXPECT_EQ(1u, entries.size());
+  EXPECT_EQ(std::make_tuple(addr_t(0x260), uint32_t(0xc), dw_offset_t(0x18)),
+            entries[0]);
+}
+
+TEST_F(DWARFCallFrameInfoTest, FDEIndexCache) {
+  llvm::SmallString<128> cache_dir;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("fde-index-cache", cache_dir));
+  ModuleListProperties &properties =
+      ModuleList::GetGlobalModuleListProperties();
+  properties.SetUnwindIndexCachePath(FileSpec(cache_dir));
+  auto cleanup = llvm::make_scope_exit([&] {
+    properties.SetUnwindIndexCachePath(FileSpec());
+    llvm::sys::fs::remove_directories(cache_dir);
+  });
+
+  auto ExpectedFile = CreateTestFile();
+  ASSERT_THAT_EXPECTED(ExpectedFile, llvm::Succeeded());
+
+  auto module_sp = std::make_shared<Module>(ExpectedFile->moduleSpec());
+  SectionList *list = module_sp->GetSectionList();
+  ASSERT_NE(nullptr, list);
+  auto section_sp = list->FindSectionByType(eSectionTypeDWARFDebugFrame, false);
+  ASSERT_NE(nullptr, section_sp);
+
+  // Indexing the section saves the index in the cache.
+  AddressRange range;
+  {
+    DWARFCallFrameInfo cfi(*module_sp->GetObjectFile(), section_sp,
+                           DWARFCallFrameInfo::DWARF);
+    ASSERT_TRUE(cfi.GetAddressRange(Address(0x285, list), range));
+  }
+  FileSpec cache_file(cache_dir);
+  cache_file.AppendPathComponent(
+      module_sp->GetObjectFile()->GetUUID().GetAsString(""));
+  cache_file.AppendPathComponent(".debug_frame.fde-index");
+  ASSERT_TRUE(FileSystem::Instance().Exists(cache_file));
+
+  // A new instance uses the cached index and parses the CIEs on demand.
+  DWARFCallFrameInfo cfi(*module_sp->GetObjectFile(), section_sp,
+                         DWARFCallFrameInfo::DWARF);
+  ASSERT_TRUE(cfi.GetAddressRange(Address(0x275, list), range));
+  EXPECT_EQ(0x270u, range.GetBaseAddress().GetFileAddress());
+  EXPECT_EQ(0xcu, range.GetByteSize());
+
+  UnwindPlan plan(eRegisterKindGeneric);
+  ASSERT_TRUE(cfi.GetUnwindPlan(Address(0x280, list), plan));
+  ASSERT_EQ(3, plan.GetRowCount());
+  EXPECT_EQ(GetExpectedRow0(), *plan.GetRowAtIndex(0));
+  EXPECT_EQ(GetExpectedRow1(), *plan.GetRowAtIndex(1));
+  EXPECT_EQ(GetExpectedRow2(), *plan.GetRowAtIndex(2));
+
+  // Make the cached functions larger than they are, which shows whether the
+  // cached index is used.
+  auto buffer_or_error = llvm::MemoryBuffer::getFile(cache_file.GetPath());
+  ASSERT_TRUE(bool(buffer_or_error));
+  std::string index = (*buffer_or_error)->getBuffer().str();
+  const size_t header_size = strlen("lldb-fde-index 2\n");
+  const size_t hash_offset = header_size + 16;
+  const size_t entries_offset = header_size + 28;
+  ASSERT_LT(entries_offset, index.size());
+  for (size_t offset = entries_offset + 8; offset + 4 <= index.size();
+       offset += 16)
+    llvm::support::endian::write32le(&index[offset], 0x100);
+  auto WriteIndex = [&] {
+    std::error_code ec;
+    llvm::raw_fd_ostream os(cache_file.GetPath(), ec);
+    ASSERT_FALSE(ec);
+    os << index;
+  };
+
+  // The index is used as long as the hash of the section matches.
+  WriteIndex();
+  {
+    DWARFCallFrameInfo cfi(*module_sp->GetObjectFile(), section_sp,
+                           DWARFCallFrameInfo::DWARF);
+    ASSERT_TRUE(cfi.GetAddressRange(Address(0x275, list), range));
+    EXPECT_EQ(0x100u, range.GetByteSize());
+  }
+
+  // An index built for other contents of the section is ignored.
+  index[hash_offset] ^= 1;
+  WriteIndex();
+  {
+    DWARFCallFrameInfo cfi(*module_sp->GetObjectFile(), section_sp,
+                           DWARFCallFrameInfo::DWARF);
+    ASSERT_TRUE(cfi.GetAddressRange(Address(0x275, list), range));
+    EXPECT_EQ(0xcu, range.GetByteSize());
+  }
+}
@@ -0,0 +1,71 @@
+//===-- SamplingProfilerTest.cpp ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Target/SamplingProfiler.h"
+#include "lldb/Utility/StreamString.h"
+#include "gtest/gtest.h"
+
+using namespace lldb_private;
+
+TEST(SamplingProfilerTest, FoldedStacks) {
+  SamplingProfiler profiler;
+  // Two stacks going through different addresses of the same functions.
+  profiler.AddStack(
+      {{0x10, "a.out`c"}, {0x20, "a.out`b"}, {0x30, "a.out`main"}});
+  profiler.AddStack(
+      {{0x10, "a.out`c"}, {0x20, "a.out`b"}, {0x30, "a.out`main"}});
+  profiler.AddStack(
+      {{0x11, "a.out`c"}, {0x20, "a.out`b"}, {0x30, "a.out`main"}});
+  profiler.AddStack({{0x40, "libc.so`read"}, {0x30, "a.out`main"}});
+  profiler.AddPause(std::chrono::milliseconds(1));
+  profiler.AddPause(std::chrono::milliseconds(3));
+
+  StreamString folded;
+  profiler.DumpFoldedStacks(folded);
+  EXPECT_EQ("a.out`main;a.out`b;a.out`c 3\n"
+            "a.out`main;libc.so`read 1\n",
+            folded.GetString());
+
+  StreamString statistics;
+  profiler.DumpStatistics(statistics);
+  EXPECT_EQ("2 samples, 4 stacks (3 distinct)\n"
+            "pause time per sample: min 1.000 ms, avg 2.000 ms, max 3.000 ms\n",
+            statistics.GetString());
+}
+
+TEST(SamplingProfilerTest, Pprof) {
+  SamplingProfiler profiler;
+  profiler.AddStack({{0x10, "f"}});
+
+  StreamString pprof;
+  profiler.WritePprof(pprof);
+  const char expected[] =
+      // sample_type { type: "samples" unit: "count" }
+      "\x0a\x04\x08\x01\x10\x02"
+      // sample { location_id: [1] value: [1] }
+      "\x12\x06\x0a\x01\x01\x12\x01\x01"
+      // location { id: 1 address: 0x10 line { function_id: 1 } }
+      "\x22\x08\x08\x01\x18\x10\x22\x02\x08\x01"
+      // function { id: 1 name: "f" }
+      "\x2a\x04\x08\x01\x10\x03"
+      // string_table
+      "\x32\x00"
+      "\x32\x07samples"
+      "\x32\x05" "count"
+      "\x32\x01" "f"
+      "\x32\x04wall"
+      "\x32\x0bnanoseconds"
+      // duration_nanos: 0
+      "\x50\x00"
+      // period_type { type: "wall" unit: "nanoseconds" }
+      "\x5a\x04\x08\x04\x10\x05"
+      // period: 0
+      "\x60\x00";
+  EXPECT_EQ(llvm::StringRef(expected, sizeof(expected) - 1),
+            pprof.GetString());
+}
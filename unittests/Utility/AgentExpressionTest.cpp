@@ -0,0 +1,158 @@
+//===-- AgentExpressionTest.cpp -------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Utility/AgentExpression.h"
+#include "llvm/Testing/Support/Error.h"
+
+#include <map>
+
+using namespace lldb_private;
+using namespace lldb;
+using llvm::Failed;
+using llvm::HasValue;
+
+namespace {
+class AgentExpressionTest : public ::testing::Test {
+protected:
+  llvm::Expected<uint64_t> Evaluate(llvm::ArrayRef<uint8_t> bytecode) {
+    return AgentExpression::Evaluate(
+        bytecode,
+        [this](uint32_t reg_num) -> llvm::Expected<uint64_t> {
+          auto it = registers.find(reg_num);
+          if (it == registers.end())
+            return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                           "no register %u", reg_num);
+          return it->second;
+        },
+        [this](addr_t addr, uint32_t byte_size) -> llvm::Expected<uint64_t> {
+          // Little endian memory.
+          uint64_t value = 0;
+          for (uint32_t i = byte_size; i > 0; --i) {
+            auto it = memory.find(addr + i - 1);
+            if (it == memory.end())
+              return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                             "no memory at 0x%" PRIx64,
+                                             addr + i - 1);
+            value = (value << 8) | it->second;
+          }
+          return value;
+        });
+  }
+
+  std::map<uint32_t, uint64_t> registers;
+  std::map<addr_t, uint8_t> memory;
+};
+} // namespace
+
+TEST_F(AgentExpressionTest, Constants) {
+  AgentExpression expr;
+  expr.AppendConstant(0x12);
+  EXPECT_EQ(std::vector<uint8_t>({0x22, 0x12}), expr.GetBytecode().vec());
+  EXPECT_THAT_EXPECTED(Evaluate(expr.Finish()), HasValue(0x12));
+
+  expr.AppendConstant(0x1234);
+  EXPECT_EQ(std::vector<uint8_t>({0x23, 0x12, 0x34}),
+            expr.GetBytecode().vec());
+  EXPECT_THAT_EXPECTED(Evaluate(expr.Finish()), HasValue(0x1234));
+
+  expr.AppendConstant(0x12345678);
+  EXPECT_THAT_EXPECTED(Evaluate(expr.Finish()), HasValue(0x12345678));
+
+  expr.AppendConstant(UINT64_MAX);
+  EXPECT_EQ(9u, expr.GetBytecode().size());
+  EXPECT_THAT_EXPECTED(Evaluate(expr.Finish()), HasValue(UINT64_MAX));
+}
+
+TEST_F(AgentExpressionTest, Arithmetic) {
+  // (7 - 10) / 3 == -1, signed.
+  EXPECT_THAT_EXPECTED(
+      Evaluate({0x22, 7, 0x22, 10, 0x03, 0x22, 3, 0x05, 0x27}),
+      HasValue(uint64_t(-1)));
+  // 0x80 sign extended from 8 bits, then zero extended from 16 bits.
+  EXPECT_THAT_EXPECTED(Evaluate({0x22, 0x80, 0x16, 8, 0x27}),
+                       HasValue(uint64_t(-128)));
+  EXPECT_THAT_EXPECTED(Evaluate({0x22, 0x80, 0x16, 8, 0x2a, 16, 0x27}),
+                       HasValue(0xff80));
+  // 1 << 4 | 3
+  EXPECT_THAT_EXPECTED(Evaluate({0x22, 1, 0x22, 4, 0x09, 0x22, 3, 0x10, 0x27}),
+                       HasValue(0x13));
+  EXPECT_THAT_EXPECTED(Evaluate({0x22, 1, 0x22, 0, 0x06, 0x27}), Failed());
+}
+
+TEST_F(AgentExpressionTest, Comparisons) {
+  // -1 < 1 signed, but not unsigned.
+  AgentExpression expr;
+  expr.AppendConstant(uint64_t(-1));
+  expr.AppendConstant(1);
+  expr.AppendOpcode(AgentExpression::eOpLessSigned);
+  EXPECT_THAT_EXPECTED(Evaluate(expr.Finish()), HasValue(1));
+
+  expr.AppendConstant(uint64_t(-1));
+  expr.AppendConstant(1);
+  expr.AppendOpcode(AgentExpression::eOpLessUnsigned);
+  EXPECT_THAT_EXPECTED(Evaluate(expr.Finish()), HasValue(0));
+
+  expr.AppendConstant(42);
+  expr.AppendConstant(42);
+  expr.AppendOpcode(AgentExpression::eOpEqual);
+  expr.AppendOpcode(AgentExpression::eOpLogNot);
+  EXPECT_THAT_EXPECTED(Evaluate(expr.Finish()), HasValue(0));
+}
+
+TEST_F(AgentExpressionTest, Jumps) {
+  // reg0 != 0 ? 5 : 9
+  AgentExpression expr;
+  expr.AppendRegister(0);
+  size_t if_true = expr.AppendJump(AgentExpression::eOpIfGoto);
+  expr.AppendConstant(9);
+  size_t end = expr.AppendJump(AgentExpression::eOpGoto);
+  expr.SetJumpTarget(if_true);
+  expr.AppendConstant(5);
+  expr.SetJumpTarget(end);
+  std::vector<uint8_t> bytecode = expr.Finish();
+
+  registers[0] = 0;
+  EXPECT_THAT_EXPECTED(Evaluate(bytecode), HasValue(9));
+  registers[0] = 3;
+  EXPECT_THAT_EXPECTED(Evaluate(bytecode), HasValue(5));
+
+  // An infinite loop is stopped.
+  EXPECT_THAT_EXPECTED(Evaluate({0x21, 0x00, 0x00}), Failed());
+}
+
+TEST_F(AgentExpressionTest, Memory) {
+  // *(int16_t *)(reg1 + 2)
+  memory = {{0x1002, 0xfe}, {0x1003, 0xff}};
+  registers[1] = 0x1000;
+  AgentExpression expr;
+  expr.AppendRegister(1);
+  expr.AppendConstant(2);
+  expr.AppendOpcode(AgentExpression::eOpAdd);
+  expr.AppendReference(2);
+  expr.AppendSignExtend(16);
+  std::vector<uint8_t> bytecode = expr.Finish();
+  EXPECT_THAT_EXPECTED(Evaluate(bytecode), HasValue(uint64_t(-2)));
+
+  registers[1] = 0x2000;
+  EXPECT_THAT_EXPECTED(Evaluate(bytecode), Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({0x26, 0x00, 0x07, 0x27}), Failed());
+}
+
+TEST_F(AgentExpressionTest, StackOperations) {
+  // 1 2 3 rot => 3 1 2, pick 2 => 3 1 2 3, swap => 3 1 3 2, sub => 3 1 1
+  EXPECT_THAT_EXPECTED(Evaluate({0x22, 1, 0x22, 2, 0x22, 3, 0x33, 0x32, 2,
+                                 0x2b, 0x03, 0x27}),
+                       HasValue(1));
+  EXPECT_THAT_EXPECTED(Evaluate({0x22, 1, 0x29, 0x27}), Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({0x02, 0x27}), Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({0x22}), Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({0x22, 1}), Failed());
+  EXPECT_THAT_EXPECTED(Evaluate({0x0d, 0x27}), Failed());
+}
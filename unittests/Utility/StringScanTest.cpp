@@ -0,0 +1,73 @@
+//===-- StringScanTest.cpp ------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Utility/StringScan.h"
+#include "llvm/ADT/StringRef.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace lldb_private;
+
+static llvm::ArrayRef<uint8_t> Bytes(llvm::StringRef str) {
+  return llvm::ArrayRef<uint8_t>(str.bytes_begin(), str.bytes_end());
+}
+
+TEST(StringScanTest, FindStringTerminator) {
+  EXPECT_EQ(0u, FindStringTerminator({}, 1));
+  EXPECT_EQ(3u, FindStringTerminator(Bytes("abc"), 1));
+  EXPECT_EQ(0u, FindStringTerminator(Bytes({"\0abc", 4}), 1));
+
+  // Terminators in every position of the first and second words.
+  for (size_t pos = 0; pos < 20; ++pos) {
+    std::vector<uint8_t> data(24, 'x');
+    data[pos] = 0;
+    EXPECT_EQ(pos, FindStringTerminator(data, 1));
+  }
+}
+
+TEST(StringScanTest, FindWideStringTerminator) {
+  // A zero byte isn't a terminator of a wider string, and the characters are
+  // aligned from the start of the buffer.
+  std::vector<uint8_t> data = {'a', 0, 0, 'b', 'c', 0, 0, 0};
+  EXPECT_EQ(6u, FindStringTerminator(data, 2));
+  EXPECT_EQ(8u, FindStringTerminator(data, 4));
+  data.insert(data.end(), {0, 0, 0, 0});
+  EXPECT_EQ(8u, FindStringTerminator(data, 4));
+
+  // An incomplete last character is ignored.
+  EXPECT_EQ(2u, FindStringTerminator({'a', 'b', 0}, 2));
+
+  for (size_t pos = 0; pos < 32; pos += 2) {
+    std::vector<uint8_t> data(40, 0xff);
+    data[pos] = data[pos + 1] = 0;
+    EXPECT_EQ(pos, FindStringTerminator(data, 2));
+  }
+  for (size_t pos = 0; pos < 32; pos += 4) {
+    std::vector<uint8_t> data(40, 0x01);
+    std::fill(data.begin() + pos, data.begin() + pos + 4, 0);
+    EXPECT_EQ(pos, FindStringTerminator(data, 4));
+  }
+}
+
+TEST(StringScanTest, GetPlainASCIIPrefixLength) {
+  EXPECT_EQ(0u, GetPlainASCIIPrefixLength({}));
+  EXPECT_EQ(5u, GetPlainASCIIPrefixLength(Bytes("hello")));
+  EXPECT_EQ(26u,
+            GetPlainASCIIPrefixLength(Bytes("The quick brown fox jumps.")));
+
+  for (char c : {'\0', '\n', '\x1f', '\x7f', '\x80', '\xff', '"', '\'', '\\'}) {
+    for (size_t pos = 0; pos < 20; ++pos) {
+      std::string str(24, 'a');
+      str[pos] = c;
+      EXPECT_EQ(pos, GetPlainASCIIPrefixLength(Bytes(str)))
+          << "character " << static_cast<int>(c);
+    }
+  }
+  EXPECT_EQ(3u, GetPlainASCIIPrefixLength(Bytes(" ~!")));
+}